@@ -43,6 +43,8 @@ def main():
 
     argparser.add_argument('-reaper32_dir', help='Path to reaper32 directory (for debugging and automatically copying DLL).', required=False)
     argparser.add_argument('-reaper64_dir', help='Path to reaper64 directory (for debugging and automatically copying DLL).', required=False)
+    argparser.add_argument('-refresh_akautobahn', action='store_true', help='Re-copy AkAutobahn from the Wwise SDK into ext/ (overwrites the local changes in ext/AkAutobahn/AkAutobahn).')
+    argparser.add_argument('-disable_tracing', action='store_true', help='Compile out trace event recording.')
 
     args = argparser.parse_args()
     
@@ -57,11 +59,16 @@ def main():
 
     print('Using Wwise SDK Dir: {}'.format(wwise_sdk_dir))
 
-    copy_akautobahn(wwise_sdk_dir)
+    if args.refresh_akautobahn:
+        copy_akautobahn(wwise_sdk_dir)
+
     cmake_vars = dict()
 
     cmake_vars['AKSDK_DIR'] = wwise_sdk_dir
 
+    if args.disable_tracing:
+        cmake_vars['WAAPI_TRANSFER_TRACING'] = 'OFF'
+
     if args.reaper32_dir:
         cmake_vars['REAPER32_PATH'] = args.reaper32_dir
 
@@ -0,0 +1,508 @@
+#include "AsyncLog.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+#include "AK/WwiseAuthoringAPI/AkAutobahn/Logger.h"
+
+namespace AK
+{
+	namespace WwiseAuthoringAPI
+	{
+		namespace AsyncLog
+		{
+			namespace
+			{
+				static_assert((RING_CAPACITY & (RING_CAPACITY - 1)) == 0, "RING_CAPACITY must be a power of two");
+
+				// how long the background thread sleeps when nothing wakes it, producers only wake it if it's idle
+				const int IDLE_WAIT_MS = 20;
+
+				struct Record
+				{
+					Severity severity = Severity::Info;
+					const char* category = "";
+					uint32_t threadId = 0;
+					uint16_t length = 0;
+
+					// the message goes on in the next cell, text isn't null terminated then
+					bool more = false;
+
+					// microseconds since the unix epoch
+					uint64_t timeUs = 0;
+					char text[MAX_MESSAGE_LENGTH];
+				};
+
+				// Bounded MPMC ring (Vyukov), used with a single consumer. A cell's sequence says whose turn it
+				// is: equal to the position when it's free for that producer, position + 1 once it's filled.
+				// A producer can take several consecutive cells at once: the consumer frees cells in order, so
+				// if the last of them is free the ones before it are too.
+				class Ring
+				{
+				public:
+					Ring()
+					{
+						for (size_t i = 0; i < RING_CAPACITY; ++i)
+						{
+							m_cells[i].sequence.store(i, std::memory_order_relaxed);
+						}
+					}
+
+					// in_fill(record, index) fills each of the in_numCells cells
+					template <typename Fill>
+					bool TryPush(size_t in_numCells, Fill in_fill)
+					{
+						size_t pos = m_enqueuePos.load(std::memory_order_relaxed);
+						for (;;)
+						{
+							const size_t last = pos + in_numCells - 1;
+							const size_t sequence = m_cells[last & (RING_CAPACITY - 1)].sequence.load(std::memory_order_acquire);
+							const intptr_t diff = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(last);
+							if (diff == 0)
+							{
+								if (m_enqueuePos.compare_exchange_weak(pos, pos + in_numCells, std::memory_order_relaxed))
+									break;
+							}
+							else if (diff < 0)
+							{
+								return false;
+							}
+							else
+							{
+								pos = m_enqueuePos.load(std::memory_order_relaxed);
+							}
+						}
+
+						for (size_t i = 0; i < in_numCells; ++i)
+						{
+							Cell& cell = m_cells[(pos + i) & (RING_CAPACITY - 1)];
+							in_fill(cell.record, i);
+							cell.sequence.store(pos + i + 1, std::memory_order_release);
+						}
+						return true;
+					}
+
+					// Consumer only
+					bool TryPop(Record& out_record)
+					{
+						Cell& cell = m_cells[m_dequeuePos & (RING_CAPACITY - 1)];
+						if (cell.sequence.load(std::memory_order_acquire) != m_dequeuePos + 1)
+						{
+							return false;
+						}
+
+						out_record = cell.record;
+						cell.sequence.store(m_dequeuePos + RING_CAPACITY, std::memory_order_release);
+						++m_dequeuePos;
+						return true;
+					}
+
+					size_t GetEnqueuePos() const { return m_enqueuePos.load(std::memory_order_acquire); }
+					size_t GetDequeuePos() const { return m_dequeuePos; }
+
+				private:
+					struct Cell
+					{
+						std::atomic<size_t> sequence;
+						Record record;
+					};
+
+					Cell m_cells[RING_CAPACITY];
+					std::atomic<size_t> m_enqueuePos{ 0 };
+					size_t m_dequeuePos = 0;
+				};
+
+				Ring s_ring;
+
+				std::atomic<uint8_t> s_minSeverity{ static_cast<uint8_t>(Severity::Info) };
+				std::atomic<uint64_t> s_numDropped{ 0 };
+
+				// background thread
+				std::mutex s_threadMutex;
+				std::atomic<bool> s_running{ false };
+				std::atomic<bool> s_stopping{ false };
+				std::atomic<bool> s_consumerIdle{ false };
+				std::mutex s_wakeMutex;
+				std::condition_variable s_wake;
+
+				// ring position the background thread has written up to, for Flush
+				std::atomic<size_t> s_writtenPos{ 0 };
+				std::condition_variable s_written;
+
+				struct WriterThread
+				{
+					std::thread thread;
+
+					// only reached while running if Shutdown was never called, don't terminate over it
+					~WriterThread()
+					{
+						if (thread.joinable())
+							thread.detach();
+					}
+				};
+				WriterThread s_writer;
+
+				// file sink
+				std::mutex s_fileMutex;
+				std::FILE* s_file = nullptr;
+				std::string s_filePath;
+				size_t s_fileBytes = 0;
+				size_t s_fileMaxBytes = 0;
+				int s_fileNumBackups = 0;
+
+				const char* GetSeverityTag(Severity in_severity)
+				{
+					switch (in_severity)
+					{
+					case Severity::Debug: return "D";
+					case Severity::Info: return "I";
+					case Severity::Warning: return "W";
+					case Severity::Error: return "E";
+					}
+					return "?";
+				}
+
+				uint64_t NowUs()
+				{
+					return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(
+						std::chrono::system_clock::now().time_since_epoch()).count());
+				}
+
+				// s_fileMutex held
+				void RotateFile()
+				{
+					std::fclose(s_file);
+					s_file = nullptr;
+
+					if (s_fileNumBackups > 0)
+					{
+						std::remove((s_filePath + "." + std::to_string(s_fileNumBackups)).c_str());
+						for (int i = s_fileNumBackups - 1; i >= 1; --i)
+						{
+							std::rename((s_filePath + "." + std::to_string(i)).c_str(), (s_filePath + "." + std::to_string(i + 1)).c_str());
+						}
+						std::rename(s_filePath.c_str(), (s_filePath + ".1").c_str());
+					}
+					else
+					{
+						std::remove(s_filePath.c_str());
+					}
+
+					s_file = std::fopen(s_filePath.c_str(), "ab");
+					s_fileBytes = 0;
+				}
+
+				void WriteToFile(const std::string& in_line)
+				{
+					std::lock_guard<std::mutex> lock(s_fileMutex);
+					if (!s_file)
+					{
+						return;
+					}
+
+					if (s_fileMaxBytes && s_fileBytes + in_line.size() > s_fileMaxBytes && s_fileBytes > 0)
+					{
+						RotateFile();
+						if (!s_file)
+						{
+							return;
+						}
+					}
+
+					std::fwrite(in_line.data(), 1, in_line.size(), s_file);
+					s_fileBytes += in_line.size();
+				}
+
+				void FlushFile()
+				{
+					std::lock_guard<std::mutex> lock(s_fileMutex);
+					if (s_file)
+					{
+						std::fflush(s_file);
+					}
+				}
+
+				// Background thread only: formats a record and hands it to the sinks
+				class Writer
+				{
+				public:
+					void Emit(const Record& in_record)
+					{
+						// the cells of a spilled message are consecutive, the last one completes it
+						m_text.append(in_record.text, in_record.length);
+						if (in_record.more)
+						{
+							return;
+						}
+
+						const bool repeated = m_hasLast &&
+							in_record.category == m_last.category &&
+							m_text == m_lastText &&
+							in_record.timeUs - m_last.timeUs < static_cast<uint64_t>(REPEAT_WINDOW_MS) * 1000;
+
+						if (repeated)
+						{
+							++m_numRepeats;
+							m_lastRepeatUs = in_record.timeUs;
+							m_text.clear();
+							return;
+						}
+
+						FlushRepeats();
+						Output(in_record.severity, in_record.category, in_record.threadId, in_record.timeUs, m_text.c_str());
+						m_last = in_record;
+						m_lastText.swap(m_text);
+						m_text.clear();
+						m_hasLast = true;
+					}
+
+					// Writes the pending "repeated" line once the repeats have stopped for a window
+					void Tick(uint64_t in_nowUs)
+					{
+						if (m_numRepeats && in_nowUs - m_lastRepeatUs >= static_cast<uint64_t>(REPEAT_WINDOW_MS) * 1000)
+						{
+							FlushRepeats();
+							m_hasLast = false;
+						}
+
+						const uint64_t numDropped = s_numDropped.load(std::memory_order_relaxed);
+						if (numDropped != m_numDroppedReported)
+						{
+							const std::string text = std::to_string(numDropped - m_numDroppedReported) + " log messages dropped, the log ring was full";
+							Output(Severity::Warning, "AsyncLog", 0, in_nowUs, text.c_str());
+							m_numDroppedReported = numDropped;
+						}
+					}
+
+					void FlushRepeats()
+					{
+						if (m_numRepeats)
+						{
+							const std::string text = "previous message repeated " + std::to_string(m_numRepeats) + " times";
+							Output(m_last.severity, m_last.category, m_last.threadId, m_lastRepeatUs, text.c_str());
+							m_numRepeats = 0;
+						}
+					}
+
+				private:
+					void Output(Severity in_severity, const char* in_category, uint32_t in_threadId, uint64_t in_timeUs, const char* in_text)
+					{
+						Logger::Get()->LogMessage(in_category, in_text);
+
+						const std::time_t seconds = static_cast<std::time_t>(in_timeUs / 1000000);
+						std::tm local{};
+#ifdef _WIN32
+						localtime_s(&local, &seconds);
+#else
+						localtime_r(&seconds, &local);
+#endif
+						char prefix[64];
+						const size_t timeLength = std::strftime(prefix, sizeof(prefix), "%Y-%m-%d %H:%M:%S", &local);
+						std::snprintf(prefix + timeLength, sizeof(prefix) - timeLength, ".%03u [%s] %08x ",
+							static_cast<unsigned>((in_timeUs / 1000) % 1000), GetSeverityTag(in_severity), in_threadId);
+
+						m_line.assign(prefix);
+						m_line += in_category;
+						m_line += ": ";
+						m_line += in_text;
+						m_line += '\n';
+						WriteToFile(m_line);
+					}
+
+					Record m_last;
+					std::string m_lastText;
+					std::string m_text;
+					bool m_hasLast = false;
+					uint64_t m_numRepeats = 0;
+					uint64_t m_lastRepeatUs = 0;
+					uint64_t m_numDroppedReported = 0;
+					std::string m_line;
+				};
+
+				void WriterLoop()
+				{
+					Writer writer;
+					Record record;
+
+					for (;;)
+					{
+						while (s_ring.TryPop(record))
+						{
+							writer.Emit(record);
+						}
+						writer.Tick(NowUs());
+
+						const bool stopping = s_stopping.load();
+						if (stopping)
+						{
+							writer.FlushRepeats();
+						}
+						FlushFile();
+
+						{
+							std::lock_guard<std::mutex> lock(s_wakeMutex);
+							s_writtenPos.store(s_ring.GetDequeuePos());
+						}
+						s_written.notify_all();
+
+						if (stopping)
+						{
+							return;
+						}
+
+						std::unique_lock<std::mutex> lock(s_wakeMutex);
+						s_consumerIdle.store(true);
+						s_wake.wait_for(lock, std::chrono::milliseconds(IDLE_WAIT_MS), []
+						{
+							return s_stopping.load() || s_ring.GetEnqueuePos() != s_ring.GetDequeuePos();
+						});
+						s_consumerIdle.store(false);
+					}
+				}
+
+				void StartWriter()
+				{
+					std::lock_guard<std::mutex> lock(s_threadMutex);
+					if (!s_running.load())
+					{
+						s_stopping.store(false);
+						s_writer.thread = std::thread(WriterLoop);
+						s_running.store(true);
+					}
+				}
+
+				void WakeWriter()
+				{
+					std::lock_guard<std::mutex> lock(s_wakeMutex);
+					s_wake.notify_one();
+				}
+			}
+
+			void Write(Severity in_severity, const char* in_category, const char* in_message)
+			{
+				if (static_cast<uint8_t>(in_severity) < s_minSeverity.load(std::memory_order_relaxed))
+				{
+					return;
+				}
+
+				if (!s_running.load(std::memory_order_acquire))
+				{
+					StartWriter();
+				}
+
+				const uint64_t timeUs = NowUs();
+				const uint32_t threadId = static_cast<uint32_t>(std::hash<std::thread::id>()(std::this_thread::get_id()));
+
+				const size_t messageLength = (std::min)(std::strlen(in_message), MAX_SPILL_CELLS * MAX_MESSAGE_LENGTH);
+				const size_t numCells = (std::max)(messageLength + MAX_MESSAGE_LENGTH - 1, MAX_MESSAGE_LENGTH) / MAX_MESSAGE_LENGTH;
+
+				const bool pushed = s_ring.TryPush(numCells, [&](Record& out_record, size_t in_cell)
+				{
+					const size_t offset = in_cell * MAX_MESSAGE_LENGTH;
+					const size_t length = (std::min)(messageLength - offset, MAX_MESSAGE_LENGTH);
+
+					out_record.severity = in_severity;
+					out_record.category = in_category;
+					out_record.threadId = threadId;
+					out_record.timeUs = timeUs;
+					out_record.length = static_cast<uint16_t>(length);
+					out_record.more = in_cell + 1 < numCells;
+					std::memcpy(out_record.text, in_message + offset, length);
+				});
+
+				if (!pushed)
+				{
+					s_numDropped.fetch_add(1, std::memory_order_relaxed);
+					return;
+				}
+
+				// errors go out right away, the rest waits for the writer's next pass
+				if (in_severity == Severity::Error && s_consumerIdle.load())
+				{
+					WakeWriter();
+				}
+			}
+
+			void SetMinSeverity(Severity in_severity)
+			{
+				s_minSeverity.store(static_cast<uint8_t>(in_severity));
+			}
+
+			bool OpenFile(const std::string& in_path, size_t in_maxBytes, int in_numBackups)
+			{
+				std::lock_guard<std::mutex> lock(s_fileMutex);
+				if (s_file)
+				{
+					std::fclose(s_file);
+				}
+
+				s_file = std::fopen(in_path.c_str(), "ab");
+				if (!s_file)
+				{
+					return false;
+				}
+
+				std::fseek(s_file, 0, SEEK_END);
+				s_fileBytes = static_cast<size_t>(std::max<long>(std::ftell(s_file), 0));
+				s_filePath = in_path;
+				s_fileMaxBytes = in_maxBytes;
+				s_fileNumBackups = in_numBackups;
+				return true;
+			}
+
+			void CloseFile()
+			{
+				Flush();
+
+				std::lock_guard<std::mutex> lock(s_fileMutex);
+				if (s_file)
+				{
+					std::fclose(s_file);
+					s_file = nullptr;
+				}
+			}
+
+			void Flush()
+			{
+				if (!s_running.load())
+				{
+					return;
+				}
+
+				const size_t target = s_ring.GetEnqueuePos();
+
+				std::unique_lock<std::mutex> lock(s_wakeMutex);
+				s_wake.notify_one();
+				// bounded, a producer that reserved a cell but never filled it would otherwise hold this forever
+				s_written.wait_for(lock, std::chrono::seconds(1), [target] { return s_writtenPos.load() >= target; });
+			}
+
+			void Shutdown()
+			{
+				std::lock_guard<std::mutex> lock(s_threadMutex);
+				if (!s_running.load())
+				{
+					return;
+				}
+
+				s_stopping.store(true);
+				WakeWriter();
+				s_writer.thread.join();
+				s_running.store(false);
+			}
+
+			uint64_t GetNumDropped()
+			{
+				return s_numDropped.load(std::memory_order_relaxed);
+			}
+		}
+	}
+}
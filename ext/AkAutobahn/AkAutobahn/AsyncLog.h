@@ -0,0 +1,59 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+// Asynchronous log for the WAMP client. Logger::LogMessage runs the installed logger function on the
+// calling thread, so the send and receive threads (and every failing Client::Call) used to wait on
+// whatever the sink did. Write only copies the message into a fixed size lock free ring, a background
+// thread formats it (timestamp, severity, thread) and hands it to the sinks: the SDK Logger and an
+// optional size rotated file.
+//
+// The ring never grows. A message longer than a cell spills over into the cells after it, up to
+// MAX_SPILL_CELLS, and is put back together by the background thread. When the ring is full the message is
+// dropped and counted, the count is reported in the log once there is room again. A message repeating within REPEAT_WINDOW_MS is written once, followed by
+// how many times it repeated.
+
+namespace AK
+{
+	namespace WwiseAuthoringAPI
+	{
+		namespace AsyncLog
+		{
+			enum class Severity : uint8_t
+			{
+				Debug,
+				Info,
+				Warning,
+				Error
+			};
+
+			static const size_t RING_CAPACITY = 1024;
+			static const size_t MAX_MESSAGE_LENGTH = 240;
+
+			// longer messages are truncated to MAX_SPILL_CELLS * MAX_MESSAGE_LENGTH
+			static const size_t MAX_SPILL_CELLS = RING_CAPACITY / 16;
+			static const int REPEAT_WINDOW_MS = 2000;
+
+			// Any thread, never blocks. in_category must outlive the log (a string literal).
+			void Write(Severity in_severity, const char* in_category, const char* in_message);
+
+			// Messages below in_severity are discarded before they reach the ring, Info by default
+			void SetMinSeverity(Severity in_severity);
+
+			// Also writes to in_path, appending. Once the file reaches in_maxBytes it's renamed to in_path.1
+			// (in_path.1 to in_path.2 and so on, keeping in_numBackups) and a new one started.
+			bool OpenFile(const std::string& in_path, size_t in_maxBytes, int in_numBackups);
+			void CloseFile();
+
+			// Blocks until everything written before the call has reached the sinks
+			void Flush();
+
+			// Flushes and stops the background thread, it's started again by the next Write
+			void Shutdown();
+
+			uint64_t GetNumDropped();
+		}
+	}
+}
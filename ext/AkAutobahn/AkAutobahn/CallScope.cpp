@@ -0,0 +1,54 @@
+#include "CallScope.h"
+
+#include <algorithm>
+
+namespace AK
+{
+	namespace WwiseAuthoringAPI
+	{
+		namespace
+		{
+			thread_local const CallScope* t_currentScope = nullptr;
+		}
+
+		CallScope::CallScope(const CancellationToken* in_token, int in_timeoutMs)
+			: m_token(in_token)
+			, m_deadline(in_timeoutMs >= 0 ? Clock::now() + std::chrono::milliseconds(in_timeoutMs) : Clock::time_point::max())
+			, m_enclosing(t_currentScope)
+		{
+			t_currentScope = this;
+		}
+
+		CallScope::~CallScope()
+		{
+			t_currentScope = m_enclosing;
+		}
+
+		const CallScope* CallScope::GetCurrent()
+		{
+			return t_currentScope;
+		}
+
+		bool CallScope::IsCancelled() const
+		{
+			for (const CallScope* scope = this; scope; scope = scope->m_enclosing)
+			{
+				if (scope->m_token && scope->m_token->IsCancelled())
+				{
+					return true;
+				}
+			}
+			return false;
+		}
+
+		CallScope::Clock::time_point CallScope::GetDeadline() const
+		{
+			Clock::time_point deadline = Clock::time_point::max();
+			for (const CallScope* scope = this; scope; scope = scope->m_enclosing)
+			{
+				deadline = (std::min)(deadline, scope->m_deadline);
+			}
+			return deadline;
+		}
+	}
+}
@@ -0,0 +1,120 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <exception>
+#include <future>
+
+// Deadlines and cancellation for Client calls. Client::Call only takes a timeout and blocks in GetFuture,
+// so a CallScope on the calling thread bounds every call made while it is alive: waits give up at the
+// scope's deadline, or within WAIT_SLICE_MS of its token being cancelled, whatever timeout the call was
+// given. The request is then removed from the session's pending table, its late response is dropped.
+
+namespace AK
+{
+	namespace WwiseAuthoringAPI
+	{
+		// Shared between the thread making calls and whoever can cancel them (the UI)
+		class CancellationToken
+		{
+		public:
+			void Cancel() { m_cancelled.store(true); }
+			void Reset() { m_cancelled.store(false); }
+			bool IsCancelled() const { return m_cancelled.load(); }
+
+		private:
+			std::atomic<bool> m_cancelled{ false };
+		};
+
+		class CallScope
+		{
+		public:
+			using Clock = std::chrono::steady_clock;
+
+			// in_token may be null, in_timeoutMs < 0 means no deadline. Scopes nest: the innermost deadline
+			// and any cancelled token of an enclosing scope apply.
+			explicit CallScope(const CancellationToken* in_token, int in_timeoutMs = -1);
+			~CallScope();
+
+			CallScope(const CallScope&) = delete;
+			CallScope& operator=(const CallScope&) = delete;
+
+			// The calling thread's innermost scope, null if there is none
+			static const CallScope* GetCurrent();
+
+			bool IsCancelled() const;
+
+			// Earliest deadline of this and the enclosing scopes, Clock::time_point::max() if none
+			Clock::time_point GetDeadline() const;
+
+		private:
+			const CancellationToken* m_token;
+			Clock::time_point m_deadline;
+			const CallScope* m_enclosing;
+		};
+
+		enum class CallWait
+		{
+			Ready,
+			TimedOut,
+			Cancelled
+		};
+
+		static const int WAIT_SLICE_MS = 20;
+
+		// GetFuture honouring the current CallScope. Without a scope it's a plain wait with in_timeoutMs.
+		template <typename T>
+		CallWait WaitForFuture(std::future<T>& in_future, int in_timeoutMs, T& out_value)
+		{
+			using Clock = CallScope::Clock;
+
+			const CallScope* scope = CallScope::GetCurrent();
+
+			Clock::time_point deadline = scope ? scope->GetDeadline() : Clock::time_point::max();
+			if (in_timeoutMs >= 0)
+			{
+				deadline = (std::min)(deadline, Clock::now() + std::chrono::milliseconds(in_timeoutMs));
+			}
+
+			for (;;)
+			{
+				if (scope && scope->IsCancelled())
+				{
+					return CallWait::Cancelled;
+				}
+
+				const Clock::time_point now = Clock::now();
+				if (now >= deadline)
+				{
+					return CallWait::TimedOut;
+				}
+
+				// without a scope nothing can cancel, so wait all the way to the deadline
+				Clock::time_point waitUntil = deadline;
+				if (scope && deadline - now > std::chrono::milliseconds(WAIT_SLICE_MS))
+				{
+					waitUntil = now + std::chrono::milliseconds(WAIT_SLICE_MS);
+				}
+
+				const std::future_status status = waitUntil == Clock::time_point::max()
+					? (in_future.wait(), std::future_status::ready)
+					: in_future.wait_until(waitUntil);
+
+				if (status == std::future_status::ready)
+				{
+					try
+					{
+						out_value = in_future.get();
+						return CallWait::Ready;
+					}
+					catch (const std::exception&)
+					{
+						// broken promise, the session went away without answering
+						return CallWait::TimedOut;
+					}
+				}
+			}
+		}
+	}
+}
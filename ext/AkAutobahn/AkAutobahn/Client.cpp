@@ -18,8 +18,13 @@ Copyright (c) 2020 Audiokinetic Inc.
 #include <string>
 #include <sstream>
 
+#include "AsyncLog.h"
+#include "CallScope.h"
+#include "EventDispatcher.h"
 #include "JSONHelpers.h"
-#include "AK/WwiseAuthoringAPI/AkAutobahn/Logger.h"
+#include "PendingTable.h"
+#include "Tracing.h"
+#include "WampMetrics.h"
 
 namespace AK
 {
@@ -32,6 +37,7 @@ namespace AK
 
 		Client::~Client()
 		{
+			EventDispatcher::CloseAll(m_ws);
 			delete m_ws;
 
 			// IMPORTANT: In theory, deleting the websocket will hang the thread until the receiver thread has exited,
@@ -41,7 +47,7 @@ namespace AK
 
 		void Client::Log(const char* log)
 		{
-			Logger::Get()->LogMessage("AkAutobahn", log);
+			AsyncLog::Write(AsyncLog::Severity::Error, "AkAutobahn", log);
 		}
 
 		// This assumes "message" is present, which should be a valid assumption
@@ -75,6 +81,7 @@ namespace AK
 
 		void Client::Disconnect()
 		{
+			EventDispatcher::CloseAll(m_ws);
 			m_ws->stop("connection closed by destruction of session");
 		}
 
@@ -82,9 +89,28 @@ namespace AK
 		{
 			session::createErrorMessageJson("Failed to receive WAAPI message in time.", out_jsonError);
 		}
+
+		// Frees the request's slot in the session either way, its response is dropped whenever it arrives
+		void CreateErrorMessageAbandonedWait(const session* in_session, CallWait in_wait, uint64_t in_requestId, AkJson& out_jsonError)
+		{
+			PendingRequests::Abandon(in_session, in_requestId);
+
+			if (in_wait == CallWait::Cancelled)
+			{
+				WampMetrics::OnAborted(in_requestId);
+				session::createErrorMessageJson("WAAPI call cancelled.", out_jsonError);
+			}
+			else
+			{
+				WampMetrics::OnTimedOut(in_requestId);
+				CreateErrorMessageFailedFuture(out_jsonError);
+			}
+		}
 		
 		bool Client::Call(const char* in_uri, const char* in_args, const char* in_options, std::string& out_result, int in_timeoutMs)
 		{
+			WAAPI_TRACE_SCOPE_DETAIL("waapi", "Client::Call", in_uri);
+
 			AkJson jsonArgs;
 			rapidjson::Document docArgs;
 
@@ -119,11 +145,14 @@ namespace AK
 				LogErrorMessageFromJson(jsonError);
 				return false;
 			}
+
+			const uint64_t requestId = WampMetrics::GetLastRequestId();
 			
-			if (!GetFuture<result_t>(future, in_timeoutMs, result))
+			const CallWait wait = WaitForFuture<result_t>(future, in_timeoutMs, result);
+			if (wait != CallWait::Ready)
 			{
 				AkJson jsonError;
-				CreateErrorMessageFailedFuture(jsonError);
+				CreateErrorMessageAbandonedWait(m_ws, wait, requestId, jsonError);
 				out_result = JSONHelpers::GetAkJsonString(jsonError);
 				LogErrorMessageFromJson(jsonError);
 				return false;
@@ -141,6 +170,8 @@ namespace AK
 		
 		bool Client::Call(const char* in_uri, const AkJson& in_args, const AkJson& in_options, AkJson& out_result, int in_timeoutMs)
 		{
+			WAAPI_TRACE_SCOPE_DETAIL("waapi", "Client::Call", in_uri);
+
 			std::future<result_t> future;
 
 			if (!m_ws->call_options(in_uri, std::vector<AkVariant>{}, in_args, in_options, future, out_result))
@@ -148,11 +179,14 @@ namespace AK
 				LogErrorMessageFromJson(out_result);
 				return false;
 			}
+
+			const uint64_t requestId = WampMetrics::GetLastRequestId();
 			
 			result_t result;
-			if (!GetFuture<result_t>(future, in_timeoutMs, result))
+			const CallWait wait = WaitForFuture<result_t>(future, in_timeoutMs, result);
+			if (wait != CallWait::Ready)
 			{
-				CreateErrorMessageFailedFuture(out_result);
+				CreateErrorMessageAbandonedWait(m_ws, wait, requestId, out_result);
 				LogErrorMessageFromJson(out_result);
 				return false;
 			}
@@ -171,21 +205,33 @@ namespace AK
 		{
 			std::future<subscription> future;
 
-			if (!m_ws->subscribe(in_uri, in_callback, in_options, future, out_result))
+			// the session calls handlers on its receive thread, the wrapped one just queues the event
+			std::shared_ptr<EventDispatcher::Strand> strand;
+			handler_t handler = EventDispatcher::Wrap(in_uri, in_callback, strand);
+
+			if (!m_ws->subscribe(in_uri, handler, in_options, future, out_result))
 			{
 				return false;
 			}
 
+			const uint64_t requestId = WampMetrics::GetLastRequestId();
+
 			subscription resultObject;
-			if (!GetFuture<subscription>(future, in_timeoutMs, resultObject))
+			const CallWait wait = WaitForFuture<subscription>(future, in_timeoutMs, resultObject);
+			if (wait != CallWait::Ready)
 			{
-				CreateErrorMessageFailedFuture(out_result);
+				CreateErrorMessageAbandonedWait(m_ws, wait, requestId, out_result);
 				return false;
 			}
 
 			out_subscriptionId = resultObject.id;
 			out_result = resultObject.errorJson;
 
+			if (resultObject.success)
+			{
+				EventDispatcher::Attach(m_ws, out_subscriptionId, std::move(strand));
+			}
+
 			return resultObject.success;
 		}
 		
@@ -233,15 +279,20 @@ namespace AK
 		{
 			std::future<result_t> future;
 
+			// the session keeps calling the handler for an unsubscribed id, the closed strand drops the events
+			EventDispatcher::Close(m_ws, in_subscriptionId);
+
 			if (!m_ws->unsubscribe(in_subscriptionId, future, out_result))
 			{
 				return false;
 			}
 
+			const uint64_t requestId = WampMetrics::GetLastRequestId();
+
 			result_t result;
 			if (!GetFuture<result_t>(future, in_timeoutMs, result))
 			{
-				CreateErrorMessageFailedFuture(out_result);
+				CreateErrorMessageAbandonedWait(m_ws, CallWait::TimedOut, requestId, out_result);
 				return false;
 			}
 
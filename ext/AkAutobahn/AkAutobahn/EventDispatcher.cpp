@@ -0,0 +1,423 @@
+#include "EventDispatcher.h"
+
+#include <algorithm>
+#include <condition_variable>
+#include <deque>
+#include <map>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "AsyncLog.h"
+#include "Tracing.h"
+
+namespace AK
+{
+	namespace WwiseAuthoringAPI
+	{
+		namespace EventDispatcher
+		{
+			namespace
+			{
+				// events a worker runs from one strand before giving the others a turn
+				const size_t STRAND_BATCH_SIZE = 16;
+
+				struct Event
+				{
+					uint64_t subscriptionId = 0;
+					AkJson kwargs;
+
+					// empty unless the strand coalesces
+					std::string key;
+				};
+
+				const char* GetMemberString(const AkJson& in_json, const char* in_key)
+				{
+					if (!in_json.IsMap() || !in_json.HasKey(in_key))
+					{
+						return nullptr;
+					}
+
+					const AkJson& member = in_json[in_key];
+					if (!member.IsVariant() || !member.GetVariant().IsString())
+					{
+						return nullptr;
+					}
+					return member.GetVariant().GetString().c_str();
+				}
+
+				// object id, plus the property for propertyChanged. Empty if the event doesn't name an object.
+				std::string MakeCoalesceKey(const AkJson& in_kwargs)
+				{
+					if (!in_kwargs.IsMap() || !in_kwargs.HasKey("object"))
+					{
+						return std::string();
+					}
+
+					const char* id = GetMemberString(in_kwargs["object"], "id");
+					if (!id)
+					{
+						return std::string();
+					}
+
+					std::string key(id);
+					if (const char* property = GetMemberString(in_kwargs, "property"))
+					{
+						key += '/';
+						key += property;
+					}
+					return key;
+				}
+			}
+
+			class Strand : public std::enable_shared_from_this<Strand>
+			{
+			public:
+				Strand(Handler in_handler, Policy in_policy) : m_handler(std::move(in_handler)), m_policy(in_policy) {}
+
+				// Receive thread
+				void Post(uint64_t in_subscriptionId, const AkJson& in_kwargs);
+
+				// Worker thread, runs up to STRAND_BATCH_SIZE events
+				void Run();
+
+				void Close();
+
+				bool IsClosed()
+				{
+					std::lock_guard<std::mutex> lock(m_mutex);
+					return m_closed;
+				}
+
+			private:
+				const Handler m_handler;
+				const Policy m_policy;
+
+				std::mutex m_mutex;
+				std::condition_variable m_idle;
+				std::deque<Event> m_events;
+
+				// scheduled: sitting in the pool's ready queue, running: a worker is in Run
+				bool m_scheduled = false;
+				bool m_running = false;
+				bool m_closed = false;
+				size_t m_numDropped = 0;
+			};
+
+			namespace
+			{
+				thread_local const Strand* t_currentStrand = nullptr;
+
+				// Workers only exist while there are subscriptions, so none are left running when the plugin
+				// is unloaded: the last CloseAll (Client::Disconnect/~Client) joins them.
+				class Pool
+				{
+				public:
+					// only reached with workers left if a Client was never disconnected, don't terminate over it
+					~Pool()
+					{
+						std::lock_guard<std::mutex> lock(m_mutex);
+						for (std::thread& worker : m_workers)
+						{
+							worker.detach();
+						}
+					}
+
+					void Schedule(std::shared_ptr<Strand> in_strand)
+					{
+						std::lock_guard<std::mutex> lock(m_mutex);
+						StartWorkers();
+						m_ready.push_back(std::move(in_strand));
+						m_wake.notify_one();
+					}
+
+					// Workers of the current generation exit, strands scheduled meanwhile get fresh ones
+					void Stop()
+					{
+						std::vector<std::thread> workers;
+						{
+							std::lock_guard<std::mutex> lock(m_mutex);
+							++m_generation;
+							workers.swap(m_workers);
+
+							m_ready.erase(std::remove_if(m_ready.begin(), m_ready.end(),
+								[](const std::shared_ptr<Strand>& strand) { return strand->IsClosed(); }), m_ready.end());
+							if (!m_ready.empty())
+							{
+								StartWorkers();
+							}
+						}
+						m_wake.notify_all();
+
+						for (std::thread& worker : workers)
+						{
+							// a handler closing its own subscription stops the pool from a worker
+							if (worker.get_id() == std::this_thread::get_id())
+								worker.detach();
+							else
+								worker.join();
+						}
+					}
+
+				private:
+					void StartWorkers()
+					{
+						if (m_workers.empty())
+						{
+							for (size_t i = 0; i < NUM_WORKERS; ++i)
+							{
+								m_workers.emplace_back(&Pool::WorkerLoop, this, m_generation);
+							}
+						}
+					}
+
+					void WorkerLoop(uint64_t in_generation)
+					{
+						WAAPI_TRACE_THREAD_NAME("WAAPI events");
+
+						for (;;)
+						{
+							std::shared_ptr<Strand> strand;
+							{
+								std::unique_lock<std::mutex> lock(m_mutex);
+								m_wake.wait(lock, [this, in_generation] { return m_generation != in_generation || !m_ready.empty(); });
+								if (m_generation != in_generation)
+								{
+									return;
+								}
+
+								strand = std::move(m_ready.front());
+								m_ready.pop_front();
+							}
+
+							strand->Run();
+						}
+					}
+
+					std::mutex m_mutex;
+					std::condition_variable m_wake;
+					std::deque<std::shared_ptr<Strand>> m_ready;
+					std::vector<std::thread> m_workers;
+					uint64_t m_generation = 0;
+				};
+
+				Pool s_pool;
+
+				typedef std::pair<const void*, uint64_t> StrandKey;
+
+				std::mutex s_registryMutex;
+				std::map<StrandKey, std::shared_ptr<Strand>> s_strands;
+				std::map<std::string, Policy> s_policies =
+				{
+					{ "ak.wwise.core.object.nameChanged", Policy::CoalesceByObject },
+					{ "ak.wwise.core.object.notesChanged", Policy::CoalesceByObject },
+					{ "ak.wwise.core.object.propertyChanged", Policy::CoalesceByObject },
+					{ "ak.wwise.core.object.attenuationCurveChanged", Policy::CoalesceByObject },
+					{ "ak.wwise.core.object.attenuationCurveLinkChanged", Policy::CoalesceByObject },
+				};
+
+				void StopPoolIfUnused()
+				{
+					bool unused;
+					{
+						std::lock_guard<std::mutex> lock(s_registryMutex);
+						unused = s_strands.empty();
+					}
+
+					if (unused)
+					{
+						s_pool.Stop();
+					}
+				}
+			}
+
+			void Strand::Post(uint64_t in_subscriptionId, const AkJson& in_kwargs)
+			{
+				std::string key;
+				if (m_policy == Policy::CoalesceByObject)
+				{
+					key = MakeCoalesceKey(in_kwargs);
+				}
+
+				bool dropped = false;
+				bool schedule = false;
+				{
+					std::lock_guard<std::mutex> lock(m_mutex);
+					if (m_closed)
+					{
+						return;
+					}
+
+					if (!key.empty())
+					{
+						for (Event& queued : m_events)
+						{
+							if (queued.key == key)
+							{
+								queued.kwargs = in_kwargs;
+								return;
+							}
+						}
+					}
+
+					if (m_events.size() >= MAX_QUEUED_EVENTS)
+					{
+						m_events.pop_front();
+						dropped = m_numDropped++ == 0;
+					}
+
+					Event event;
+					event.subscriptionId = in_subscriptionId;
+					event.kwargs = in_kwargs;
+					event.key = std::move(key);
+					m_events.push_back(std::move(event));
+
+					schedule = !m_scheduled && !m_running;
+					m_scheduled = m_scheduled || schedule;
+				}
+
+				if (dropped)
+				{
+					AsyncLog::Write(AsyncLog::Severity::Warning, "AkAutobahn", "Subscription handler is falling behind, dropping its oldest events");
+				}
+
+				if (schedule)
+				{
+					s_pool.Schedule(shared_from_this());
+				}
+			}
+
+			void Strand::Run()
+			{
+				std::unique_lock<std::mutex> lock(m_mutex);
+				m_scheduled = false;
+				if (m_closed)
+				{
+					return;
+				}
+				m_running = true;
+
+				t_currentStrand = this;
+				for (size_t i = 0; i < STRAND_BATCH_SIZE && !m_events.empty() && !m_closed; ++i)
+				{
+					Event event = std::move(m_events.front());
+					m_events.pop_front();
+					lock.unlock();
+
+					{
+						WAAPI_TRACE_SCOPE("waapi", "SubscriptionHandler");
+						m_handler(event.subscriptionId, JsonProvider(event.kwargs));
+					}
+
+					lock.lock();
+				}
+				t_currentStrand = nullptr;
+
+				m_running = false;
+				m_numDropped = 0;
+
+				const bool reschedule = !m_events.empty() && !m_closed;
+				m_scheduled = reschedule;
+				lock.unlock();
+				m_idle.notify_all();
+
+				// back of the line, so a busy subscription doesn't starve the others
+				if (reschedule)
+				{
+					s_pool.Schedule(shared_from_this());
+				}
+			}
+
+			void Strand::Close()
+			{
+				std::unique_lock<std::mutex> lock(m_mutex);
+				m_closed = true;
+				m_events.clear();
+
+				if (t_currentStrand != this)
+				{
+					m_idle.wait(lock, [this] { return !m_running; });
+				}
+			}
+
+			void SetPolicy(const std::string& in_topic, Policy in_policy)
+			{
+				std::lock_guard<std::mutex> lock(s_registryMutex);
+				s_policies[in_topic] = in_policy;
+			}
+
+			Policy GetPolicy(const std::string& in_topic)
+			{
+				std::lock_guard<std::mutex> lock(s_registryMutex);
+				auto policy = s_policies.find(in_topic);
+				return policy != s_policies.end() ? policy->second : Policy::KeepAll;
+			}
+
+			Handler Wrap(const std::string& in_topic, Handler in_handler, std::shared_ptr<Strand>& out_strand)
+			{
+				out_strand = std::make_shared<Strand>(std::move(in_handler), GetPolicy(in_topic));
+
+				// weak, the registry owns the strand once it's attached
+				std::weak_ptr<Strand> weakStrand = out_strand;
+				return [weakStrand](uint64_t in_subscriptionId, const JsonProvider& in_event)
+				{
+					if (std::shared_ptr<Strand> strand = weakStrand.lock())
+					{
+						strand->Post(in_subscriptionId, in_event.GetAkJson());
+					}
+				};
+			}
+
+			void Attach(const void* in_session, uint64_t in_subscriptionId, std::shared_ptr<Strand> in_strand)
+			{
+				std::lock_guard<std::mutex> lock(s_registryMutex);
+				s_strands[StrandKey(in_session, in_subscriptionId)] = std::move(in_strand);
+			}
+
+			void Close(const void* in_session, uint64_t in_subscriptionId)
+			{
+				std::shared_ptr<Strand> strand;
+				{
+					std::lock_guard<std::mutex> lock(s_registryMutex);
+					auto found = s_strands.find(StrandKey(in_session, in_subscriptionId));
+					if (found == s_strands.end())
+					{
+						return;
+					}
+					strand = std::move(found->second);
+					s_strands.erase(found);
+				}
+
+				strand->Close();
+				StopPoolIfUnused();
+			}
+
+			void CloseAll(const void* in_session)
+			{
+				std::vector<std::shared_ptr<Strand>> strands;
+				{
+					std::lock_guard<std::mutex> lock(s_registryMutex);
+					for (auto it = s_strands.begin(); it != s_strands.end();)
+					{
+						if (it->first.first == in_session)
+						{
+							strands.push_back(std::move(it->second));
+							it = s_strands.erase(it);
+						}
+						else
+						{
+							++it;
+						}
+					}
+				}
+
+				for (const std::shared_ptr<Strand>& strand : strands)
+				{
+					strand->Close();
+				}
+				StopPoolIfUnused();
+			}
+		}
+	}
+}
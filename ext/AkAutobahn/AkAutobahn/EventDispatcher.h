@@ -0,0 +1,59 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+
+#include "AK/WwiseAuthoringAPI/AkAutobahn/AkJson.h"
+#include "AK/WwiseAuthoringAPI/AkAutobahn/JsonProvider.h"
+
+// Runs subscription handlers on a small worker pool instead of the socket's receive thread. The session
+// calls handlers while it reads messages, so a slow one (a UI refresh, an index rebuild) used to hold up
+// every RESULT behind it. Now the handler Client::Subscribe registers only copies the event into the
+// subscription's strand and returns.
+//
+// A strand runs its events one at a time in arrival order, on whichever worker is free. Its queue is
+// bounded: object notifications that only report the latest state (nameChanged, propertyChanged...)
+// replace an event still queued for the same object, anything else drops its oldest event when full.
+
+namespace AK
+{
+	namespace WwiseAuthoringAPI
+	{
+		namespace EventDispatcher
+		{
+			typedef std::function<void(uint64_t, const JsonProvider&)> Handler;
+
+			enum class Policy
+			{
+				// every event is delivered, unless the queue overflows
+				KeepAll,
+
+				// a queued event for the same object (and property) is replaced by the newer one
+				CoalesceByObject
+			};
+
+			static const size_t MAX_QUEUED_EVENTS = 1024;
+			static const size_t NUM_WORKERS = 2;
+
+			class Strand;
+
+			// Overrides the policy of a topic, the object.*Changed topics coalesce by default
+			void SetPolicy(const std::string& in_topic, Policy in_policy);
+			Policy GetPolicy(const std::string& in_topic);
+
+			// A handler for session::subscribe that queues each event on a new strand running in_handler.
+			// Pass out_strand to Attach once the subscription id is known.
+			Handler Wrap(const std::string& in_topic, Handler in_handler, std::shared_ptr<Strand>& out_strand);
+
+			void Attach(const void* in_session, uint64_t in_subscriptionId, std::shared_ptr<Strand> in_strand);
+
+			// Drops the queued events of a subscription and waits for its running handler to return, unless
+			// called from that handler. No handler of the subscription runs once this returns.
+			void Close(const void* in_session, uint64_t in_subscriptionId);
+			void CloseAll(const void* in_session);
+		}
+	}
+}
@@ -61,11 +61,80 @@ namespace AK
 				return buffer.GetString();
 			}
 
+			// rapidjson output stream appending to a std::string or std::vector<char>
+			template <typename Container>
+			class ContainerOutputStream
+			{
+			public:
+				typedef char Ch;
+
+				explicit ContainerOutputStream(Container& in_container) : m_container(in_container) {}
+
+				void Put(char in_c) { m_container.push_back(in_c); }
+				void Flush() {}
+
+			private:
+				Container& m_container;
+			};
+
+			// Streams the AkJson straight into a rapidjson writer. Maps and arrays are walked here, only the
+			// variant leaves go through a rapidjson::Value, and the allocator is cleared after each one so it
+			// never holds more than a single leaf string.
+			template <typename Writer>
+			bool WriteAkJson(const AkJson& in_node, Writer& in_writer, rapidjson::MemoryPoolAllocator<>& in_allocator)
+			{
+				switch (in_node.GetType())
+				{
+				case AkJson::Type::Map:
+					in_writer.StartObject();
+					for (const auto& member : in_node.GetMap())
+					{
+						in_writer.Key(member.first.c_str(), static_cast<rapidjson::SizeType>(member.first.size()));
+						if (!WriteAkJson(member.second, in_writer, in_allocator))
+							return false;
+					}
+					return in_writer.EndObject();
+
+				case AkJson::Type::Array:
+					in_writer.StartArray();
+					for (const auto& element : in_node.GetArray())
+					{
+						if (!WriteAkJson(element, in_writer, in_allocator))
+							return false;
+					}
+					return in_writer.EndArray();
+
+				default:
+				{
+					rapidjson::Value leaf;
+					if (!ToRapidJson(in_node, leaf, in_allocator))
+						return false;
+
+					const bool written = leaf.Accept(in_writer);
+					in_allocator.Clear();
+					return written;
+				}
+				}
+			}
+
+			// Appends the JSON text of in_json to out_text, a std::string or std::vector<char>
+			template <typename Container>
+			bool AppendAkJsonText(const AkJson& in_json, Container& out_text)
+			{
+				ContainerOutputStream<Container> stream(out_text);
+				rapidjson::Writer<ContainerOutputStream<Container>> writer(stream);
+
+				// leaf strings are copied here one at a time, longer ones spill to the heap
+				size_t leafBuffer[128];
+				rapidjson::MemoryPoolAllocator<> allocator(leafBuffer, sizeof(leafBuffer));
+				return WriteAkJson(in_json, writer, allocator);
+			}
+
 			inline std::string GetAkJsonString(const AkJson& json)
 			{
-				rapidjson::Document doc;
-				ToRapidJson(json, doc, doc.GetAllocator());
-				return GetJsonText(doc);
+				std::string text;
+				AppendAkJsonText(json, text);
+				return text;
 			}
 		}
 	}
@@ -14,6 +14,8 @@ Copyright (c) 2020 Audiokinetic Inc.
 
 #include "AK/WwiseAuthoringAPI/AkAutobahn/Logger.h"
 
+#include "AsyncLog.h"
+
 #include <string>
 #include <stdarg.h>
 #include <stdio.h>
@@ -33,7 +35,7 @@ namespace AK
 			vsnprintf(buffer, MAX_BUFFER - 1, message, args);
 			va_end(args);
 
-			WwiseAuthoringAPI::Logger::Get()->LogMessage("AkAutobahn", buffer);
+			AsyncLog::Write(AsyncLog::Severity::Info, "AkAutobahn", buffer);
 		}
 	}
 }
@@ -0,0 +1,168 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+// Fixed capacity, open addressed table of requests waiting for their RESULT/ERROR, keyed by request id.
+// Callers insert and the receive thread completes without taking a lock: each slot's key is claimed with
+// a compare and swap, so an entry is only ever touched by the thread that claimed it. A slot is only claimed
+// after its owner was checked, so sessions sharing the table never hold each other's slots.
+//
+// Request ids come from one process wide counter (see nextRequestId in autobahn.cpp), so consecutive
+// requests land in consecutive slots and a lookup normally succeeds on its first probe. The slot array is
+// allocated once, a full table fails the insert instead of growing.
+
+namespace AK
+{
+	namespace WwiseAuthoringAPI
+	{
+		template <typename Entry>
+		class PendingTable
+		{
+		public:
+			// in_capacity is rounded up to a power of two
+			explicit PendingTable(size_t in_capacity)
+			{
+				size_t capacity = 1;
+				while (capacity < in_capacity)
+					capacity <<= 1;
+
+				m_slots.reset(new Slot[capacity]);
+				m_mask = capacity - 1;
+			}
+
+			PendingTable(const PendingTable&) = delete;
+			PendingTable& operator=(const PendingTable&) = delete;
+
+			// Claims a slot for in_id. in_setup(Entry&) runs before the entry is visible to Complete, so the
+			// caller can take its future there. False if every slot is in use.
+			template <typename Setup>
+			bool Insert(uint64_t in_id, const void* in_owner, Setup in_setup)
+			{
+				for (size_t probe = 0; probe <= m_mask; ++probe)
+				{
+					Slot& slot = m_slots[(in_id + probe) & m_mask];
+
+					uint64_t expected = EMPTY_KEY;
+					if (slot.key.compare_exchange_strong(expected, BUSY_KEY, std::memory_order_acquire))
+					{
+						slot.owner.store(in_owner, std::memory_order_relaxed);
+						slot.entry = Entry();
+						in_setup(slot.entry);
+						slot.key.store(in_id, std::memory_order_release);
+						m_numPending.fetch_add(1, std::memory_order_relaxed);
+						return true;
+					}
+				}
+				return false;
+			}
+
+			// Removes in_id if in_owner is waiting on it and runs in_complete(Entry&) on it. False if the
+			// request isn't pending (already completed or aborted, or a bogus id).
+			template <typename OnComplete>
+			bool Complete(uint64_t in_id, const void* in_owner, OnComplete in_complete)
+			{
+				for (size_t probe = 0; probe <= m_mask; ++probe)
+				{
+					Slot& slot = m_slots[(in_id + probe) & m_mask];
+
+					if (slot.key.load(std::memory_order_acquire) != in_id)
+					{
+						continue;
+					}
+
+					// ids are never reused, so the owner published with in_id is still the slot's if the claim works
+					if (slot.owner.load(std::memory_order_relaxed) != in_owner)
+					{
+						return false;
+					}
+
+					uint64_t expected = in_id;
+					if (slot.key.compare_exchange_strong(expected, BUSY_KEY, std::memory_order_acquire))
+					{
+						Release(slot, in_complete);
+						return true;
+					}
+					return false;
+				}
+				return false;
+			}
+
+			// Frees in_id's slot without completing it, for a request nobody waits on anymore (timed out or
+			// cancelled). A response that still comes finds nothing and is dropped. False if it wasn't pending.
+			bool Abandon(uint64_t in_id, const void* in_owner)
+			{
+				return Complete(in_id, in_owner, [](Entry&) {});
+			}
+
+			// Completes every request in_owner is waiting on, for when its session stops. Runs
+			// in_complete(uint64_t id, Entry&) on each.
+			template <typename OnComplete>
+			void CompleteAll(const void* in_owner, OnComplete in_complete)
+			{
+				for (size_t i = 0; i <= m_mask; ++i)
+				{
+					Slot& slot = m_slots[i];
+
+					uint64_t key = slot.key.load(std::memory_order_acquire);
+					if (key == EMPTY_KEY || key == BUSY_KEY || slot.owner.load(std::memory_order_relaxed) != in_owner)
+					{
+						continue;
+					}
+
+					// fails if the request completed in between, then it's not pending anymore
+					if (slot.key.compare_exchange_strong(key, BUSY_KEY, std::memory_order_acquire))
+					{
+						Release(slot, [&in_complete, key](Entry& entry) { in_complete(key, entry); });
+					}
+				}
+			}
+
+			size_t GetNumPending() const
+			{
+				return m_numPending.load(std::memory_order_relaxed);
+			}
+
+		private:
+			// request ids start at 1 and never reach UINT64_MAX
+			static const uint64_t EMPTY_KEY = 0;
+			static const uint64_t BUSY_KEY = UINT64_MAX;
+
+			struct Slot
+			{
+				std::atomic<uint64_t> key{ EMPTY_KEY };
+
+				// written before key is published, read before a slot is claimed
+				std::atomic<const void*> owner{ nullptr };
+				Entry entry;
+			};
+
+			template <typename OnComplete>
+			void Release(Slot& in_slot, OnComplete&& in_complete)
+			{
+				in_complete(in_slot.entry);
+
+				// drop the promise (and anything else the entry holds) before the slot can be reused
+				in_slot.entry = Entry();
+				in_slot.owner.store(nullptr, std::memory_order_relaxed);
+				in_slot.key.store(EMPTY_KEY, std::memory_order_release);
+				m_numPending.fetch_sub(1, std::memory_order_relaxed);
+			}
+
+			std::unique_ptr<Slot[]> m_slots;
+			size_t m_mask = 0;
+			std::atomic<size_t> m_numPending{ 0 };
+		};
+
+		// The session class comes from the SDK headers and its request types are private, so callers reach
+		// its tables (see pendingRequests in autobahn.cpp) through here.
+		namespace PendingRequests
+		{
+			// Any thread. Frees the slot of a call, subscribe or unsubscribe in_session sent, once the caller
+			// stopped waiting on it. Its late response is dropped.
+			void Abandon(const void* in_session, uint64_t in_requestId);
+		}
+	}
+}
@@ -0,0 +1,110 @@
+#include "ReceivePool.h"
+
+#include <algorithm>
+#include <memory>
+#include <vector>
+
+namespace AK
+{
+	namespace WwiseAuthoringAPI
+	{
+		namespace ReceivePool
+		{
+			namespace
+			{
+				// enough for the usual small RESULT/EVENT frames, larger ones grow the arena
+				const size_t INITIAL_VALUE_BYTES = 64 * 1024;
+				const size_t INITIAL_STACK_BYTES = 8 * 1024;
+				const size_t PARSE_STACK_CAPACITY = 1024;
+
+				thread_local std::string t_frame;
+			}
+
+			struct ParseScope::Arena
+			{
+				std::vector<char> valueBuffer;
+				std::vector<char> stackBuffer;
+				std::unique_ptr<Allocator> values;
+				std::unique_ptr<Allocator> stack;
+				bool busy = false;
+
+				Arena()
+				{
+					Reserve(valueBuffer, values, INITIAL_VALUE_BYTES);
+					Reserve(stackBuffer, stack, INITIAL_STACK_BYTES);
+				}
+
+				// Called once the document is gone: drops the overflow chunks, and if the buffer was too small
+				// for this message grows it (up to the retention limit) so the next one fits without chunks
+				void Reset()
+				{
+					Recycle(valueBuffer, values);
+					Recycle(stackBuffer, stack);
+					busy = false;
+				}
+
+			private:
+				static void Reserve(std::vector<char>& io_buffer, std::unique_ptr<Allocator>& out_allocator, size_t in_size)
+				{
+					// the old allocator still points at the old buffer
+					out_allocator.reset();
+					io_buffer.assign(in_size, 0);
+					out_allocator.reset(new Allocator(io_buffer.data(), io_buffer.size()));
+				}
+
+				static void Recycle(std::vector<char>& io_buffer, std::unique_ptr<Allocator>& io_allocator)
+				{
+					const size_t used = io_allocator->Capacity();
+					if (used > io_buffer.size() && io_buffer.size() < MAX_RETAINED_ARENA_BYTES)
+					{
+						Reserve(io_buffer, io_allocator, (std::min)(used, MAX_RETAINED_ARENA_BYTES));
+					}
+					else
+					{
+						io_allocator->Clear();
+					}
+				}
+			};
+
+			std::string& AcquireFrame(const char* in_data, size_t in_size)
+			{
+				t_frame.assign(in_data, in_size);
+				return t_frame;
+			}
+
+			void ReleaseFrame(std::string& in_frame)
+			{
+				if (in_frame.capacity() > MAX_RETAINED_FRAME_BYTES)
+				{
+					std::string().swap(in_frame);
+				}
+			}
+
+			ParseScope::ParseScope()
+				: m_arena(ClaimArena())
+				, m_document(m_arena ? m_arena->values.get() : &m_privateValues, PARSE_STACK_CAPACITY, m_arena ? m_arena->stack.get() : &m_privateStack)
+			{
+			}
+
+			ParseScope::~ParseScope()
+			{
+				// the document is destroyed after this body, which is fine: with pool allocators it frees nothing
+				if (m_arena)
+				{
+					m_arena->Reset();
+				}
+			}
+
+			ParseScope::Arena* ParseScope::ClaimArena()
+			{
+				thread_local Arena t_arena;
+				if (t_arena.busy)
+				{
+					return nullptr;
+				}
+				t_arena.busy = true;
+				return &t_arena;
+			}
+		}
+	}
+}
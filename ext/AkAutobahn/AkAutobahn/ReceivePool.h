@@ -0,0 +1,60 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+
+#include <rapidjson/document.h>
+
+// Per thread buffers for the receive path. Every frame used to be copied into a new std::string and parsed
+// into a new rapidjson::Document, whose pool allocator and parse stack were allocated and freed again for
+// each message. The civetweb thread now keeps one frame string and one parser arena and reuses them.
+//
+// Both keep the capacity the traffic needed, up to a limit: a single huge object.get result doesn't pin
+// megabytes on the thread for the rest of the session, anything above the limit is given back after use.
+
+namespace AK
+{
+	namespace WwiseAuthoringAPI
+	{
+		namespace ReceivePool
+		{
+			static const size_t MAX_RETAINED_FRAME_BYTES = 1024 * 1024;
+			static const size_t MAX_RETAINED_ARENA_BYTES = 4 * 1024 * 1024;
+
+			typedef rapidjson::MemoryPoolAllocator<> Allocator;
+
+			// Values and parse stack both come out of the arena, nothing is freed until the parse is released
+			typedef rapidjson::GenericDocument<rapidjson::UTF8<>, Allocator, Allocator> Document;
+
+			// The calling thread's frame buffer holding a copy of in_data. Hand it back with ReleaseFrame.
+			std::string& AcquireFrame(const char* in_data, size_t in_size);
+			void ReleaseFrame(std::string& in_frame);
+
+			// A document parsed out of the calling thread's arena, valid until the scope ends. Scopes may nest
+			// (an event handler can end up parsing again), the inner ones then use a private allocator.
+			class ParseScope
+			{
+			public:
+				ParseScope();
+				~ParseScope();
+
+				ParseScope(const ParseScope&) = delete;
+				ParseScope& operator=(const ParseScope&) = delete;
+
+				Document& GetDocument() { return m_document; }
+
+			private:
+				struct Arena;
+
+				// The calling thread's arena, null if a scope already holds it
+				static Arena* ClaimArena();
+
+				// null when nested
+				Arena* m_arena;
+				Allocator m_privateValues;
+				Allocator m_privateStack;
+				Document m_document;
+			};
+		}
+	}
+}
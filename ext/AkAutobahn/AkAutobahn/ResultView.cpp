@@ -0,0 +1,239 @@
+#include "ResultView.h"
+
+#include <cctype>
+#include <map>
+#include <mutex>
+#include <utility>
+
+#include "AK/WwiseAuthoringAPI/AkAutobahn/Client.h"
+
+#include "JSONHelpers.h"
+
+namespace AK
+{
+	namespace WwiseAuthoringAPI
+	{
+		namespace
+		{
+			using Key = std::pair<const void*, uint64_t>;
+
+			std::mutex s_mutex;
+
+			// registered calls, the message is null until the RESULT arrives
+			std::map<Key, std::shared_ptr<const ResultView::Message>> s_pending;
+
+			thread_local bool t_wantView = false;
+			thread_local Key t_lastRegistered(nullptr, 0);
+
+			const rapidjson::Value s_emptyObject(rapidjson::kObjectType);
+			const rapidjson::Value s_emptyArray(rapidjson::kArrayType);
+
+			std::shared_ptr<ResultView::Message> ParseMessage(std::string in_text)
+			{
+				auto message = std::make_shared<ResultView::Message>();
+				message->text = std::move(in_text);
+				if (message->document.ParseInsitu(&message->text[0]).HasParseError() || !message->document.IsArray())
+				{
+					return nullptr;
+				}
+				return message;
+			}
+		}
+
+		const rapidjson::Value& ResultView::GetKwargs() const
+		{
+			if (!m_message)
+			{
+				return s_emptyObject;
+			}
+
+			// [RESULT, CALL.Request|id, Details|dict, YIELD.Arguments|list, YIELD.ArgumentsKw|dict]
+			const rapidjson::Value& message = m_message->document;
+			if (message.Size() > 4 && message[4].IsObject())
+			{
+				return message[4];
+			}
+			return s_emptyObject;
+		}
+
+		const rapidjson::Value& ResultView::GetObjects() const
+		{
+			const rapidjson::Value& kwargs = GetKwargs();
+
+			for (const char* key : { "return", "objects" })
+			{
+				auto member = kwargs.FindMember(key);
+				if (member != kwargs.MemberEnd() && member->value.IsArray())
+				{
+					return member->value;
+				}
+			}
+			return s_emptyArray;
+		}
+
+		bool ResultView::Materialize(const rapidjson::Value& in_value, AkJson& out_json)
+		{
+			return JSONHelpers::FromRapidJson(in_value, out_json);
+		}
+
+		const char* ResultView::GetString(const rapidjson::Value& in_object, const char* in_key, const char* in_fallback)
+		{
+			if (!in_object.IsObject())
+			{
+				return in_fallback;
+			}
+
+			auto member = in_object.FindMember(in_key);
+			return member != in_object.MemberEnd() && member->value.IsString() ? member->value.GetString() : in_fallback;
+		}
+
+		int64_t ResultView::GetInt(const rapidjson::Value& in_object, const char* in_key, int64_t in_fallback)
+		{
+			if (!in_object.IsObject())
+			{
+				return in_fallback;
+			}
+
+			auto member = in_object.FindMember(in_key);
+			if (member == in_object.MemberEnd())
+			{
+				return in_fallback;
+			}
+
+			const rapidjson::Value& value = member->value;
+			if (value.IsInt64())
+				return value.GetInt64();
+			if (value.IsUint64())
+				return static_cast<int64_t>(value.GetUint64());
+			if (value.IsDouble())
+				return static_cast<int64_t>(value.GetDouble());
+			return in_fallback;
+		}
+
+		namespace ResultViews
+		{
+			bool Call(Client& in_client, const char* in_uri, const AkJson& in_args, const AkJson& in_options,
+				ResultView& out_result, AkJson& out_error, int in_timeoutMs)
+			{
+				t_wantView = true;
+				t_lastRegistered = Key(nullptr, 0);
+
+				AkJson result;
+				const bool succeeded = in_client.Call(in_uri, in_args, in_options, result, in_timeoutMs);
+
+				// still set if the call failed before reaching the session
+				t_wantView = false;
+
+				std::shared_ptr<const ResultView::Message> message;
+				if (t_lastRegistered.first)
+				{
+					// a timed out call is forgotten too, its RESULT is then decoded (and dropped) normally
+					std::lock_guard<std::mutex> lock(s_mutex);
+					auto pending = s_pending.find(t_lastRegistered);
+					if (pending != s_pending.end())
+					{
+						message = std::move(pending->second);
+						s_pending.erase(pending);
+					}
+				}
+
+				if (!succeeded)
+				{
+					out_error = std::move(result);
+					return false;
+				}
+
+				if (!message)
+				{
+					// the session decoded it the usual way, wrap the AkJson so callers only deal with views
+					message = ParseMessage("[50,0,{},[]," + JSONHelpers::GetAkJsonString(result) + "]");
+				}
+
+				out_result = ResultView(std::move(message));
+				return true;
+			}
+
+			bool ClaimNextCall()
+			{
+				const bool wantView = t_wantView;
+				t_wantView = false;
+				return wantView;
+			}
+
+			void Register(const void* in_session, uint64_t in_requestId)
+			{
+				t_lastRegistered = Key(in_session, in_requestId);
+
+				std::lock_guard<std::mutex> lock(s_mutex);
+				s_pending[t_lastRegistered] = nullptr;
+			}
+
+			bool Deliver(const void* in_session, uint64_t in_requestId, const std::string& in_text)
+			{
+				const Key key(in_session, in_requestId);
+				{
+					std::lock_guard<std::mutex> lock(s_mutex);
+					if (s_pending.find(key) == s_pending.end())
+					{
+						return false;
+					}
+				}
+
+				std::shared_ptr<const ResultView::Message> message = ParseMessage(in_text);
+				if (!message)
+				{
+					return false;
+				}
+
+				std::lock_guard<std::mutex> lock(s_mutex);
+				auto pending = s_pending.find(key);
+				if (pending == s_pending.end())
+				{
+					return false;
+				}
+				pending->second = std::move(message);
+				return true;
+			}
+
+			bool PeekHeader(const std::string& in_text, int64_t& out_code, uint64_t& out_id)
+			{
+				const char* it = in_text.c_str();
+
+				auto SkipSpace = [&it]()
+				{
+					while (*it && std::isspace(static_cast<unsigned char>(*it)))
+						++it;
+				};
+
+				auto ReadNumber = [&it](uint64_t& out_value)
+				{
+					if (!std::isdigit(static_cast<unsigned char>(*it)))
+						return false;
+
+					out_value = 0;
+					while (std::isdigit(static_cast<unsigned char>(*it)))
+						out_value = out_value * 10 + static_cast<uint64_t>(*it++ - '0');
+					return true;
+				};
+
+				uint64_t code = 0;
+
+				SkipSpace();
+				if (*it++ != '[')
+					return false;
+				SkipSpace();
+				if (!ReadNumber(code))
+					return false;
+				SkipSpace();
+				if (*it++ != ',')
+					return false;
+				SkipSpace();
+				if (!ReadNumber(out_id))
+					return false;
+
+				out_code = static_cast<int64_t>(code);
+				return true;
+			}
+		}
+	}
+}
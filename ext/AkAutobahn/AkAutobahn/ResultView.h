@@ -0,0 +1,75 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <string>
+
+#include <rapidjson/document.h>
+
+#include "AK/WwiseAuthoringAPI/AkAutobahn/AkJson.h"
+
+// Lazily decoded call results. A normal call converts the whole RESULT message to an AkJson tree before
+// the caller sees it, one std::map or std::string per value, which for an object.get over a large project
+// is millions of allocations. A call made through ResultViews::Call instead keeps the RESULT text, parses
+// it in place (strings point into the text) and hands the caller a ResultView over it. The session only
+// reads the message header to route it, nothing is converted to AkJson unless the caller asks for it.
+
+namespace AK
+{
+	namespace WwiseAuthoringAPI
+	{
+		class Client;
+
+		class ResultView
+		{
+		public:
+			// The RESULT text and the document parsed over it, never moved once parsed
+			struct Message
+			{
+				std::string text;
+				rapidjson::Document document;
+			};
+
+			ResultView() = default;
+			explicit ResultView(std::shared_ptr<const Message> in_message) : m_message(std::move(in_message)) {}
+
+			bool IsEmpty() const { return !m_message; }
+
+			// ArgumentsKw of the RESULT, an empty object if there were none
+			const rapidjson::Value& GetKwargs() const;
+
+			// The "return" or "objects" array of an object.get style result, empty if there is neither
+			const rapidjson::Value& GetObjects() const;
+
+			// Converts part of the view to AkJson, for code that still wants one
+			static bool Materialize(const rapidjson::Value& in_value, AkJson& out_json);
+
+			// Member accessors that tolerate missing members and mismatched types, returning the fallback
+			static const char* GetString(const rapidjson::Value& in_object, const char* in_key, const char* in_fallback = "");
+			static int64_t GetInt(const rapidjson::Value& in_object, const char* in_key, int64_t in_fallback = 0);
+
+		private:
+			std::shared_ptr<const Message> m_message;
+		};
+
+		namespace ResultViews
+		{
+			// Client::Call returning the result as a ResultView. On failure out_error holds the error (or
+			// timeout) message like Client::Call's out_result does.
+			bool Call(Client& in_client, const char* in_uri, const AkJson& in_args, const AkJson& in_options,
+				ResultView& out_result, AkJson& out_error, int in_timeoutMs = -1);
+
+			// Session side. session::call_options claims the flag ResultViews::Call sets on its thread and
+			// registers the request id, got_msg delivers matching RESULT text instead of converting it.
+			bool ClaimNextCall();
+			void Register(const void* in_session, uint64_t in_requestId);
+
+			// Parses the RESULT for a registered call and keeps it for the caller. False if the call isn't
+			// registered (or the caller stopped waiting) or the text doesn't parse, decode it normally then.
+			bool Deliver(const void* in_session, uint64_t in_requestId, const std::string& in_text);
+
+			// Reads [code, id, ... from the start of a WAMP message without parsing the rest of it
+			bool PeekHeader(const std::string& in_text, int64_t& out_code, uint64_t& out_id);
+		}
+	}
+}
@@ -0,0 +1,163 @@
+#include "SendQueue.h"
+
+#include <cstdint>
+#include <thread>
+
+namespace AK
+{
+	namespace WwiseAuthoringAPI
+	{
+		SendQueue::SendQueue()
+		{
+			Node* stub = new Node();
+			m_head.store(stub);
+			m_tail = stub;
+		}
+
+		SendQueue::~SendQueue()
+		{
+			Clear();
+			delete m_tail;
+		}
+
+		void SendQueue::Push(Buffer in_buffer)
+		{
+			Node* node = new Node();
+			node->buffer = std::move(in_buffer);
+
+			// seq_cst pairs with Wait: either the consumer sees this node before sleeping, or we see it waiting
+			Node* previous = m_head.exchange(node);
+			previous->next.store(node);
+
+			if (m_consumerWaiting.load())
+			{
+				std::lock_guard<std::mutex> lock(m_wakeMutex);
+				m_wakeEvent.notify_one();
+			}
+		}
+
+		void SendQueue::Wake()
+		{
+			std::lock_guard<std::mutex> lock(m_wakeMutex);
+			m_wakeEvent.notify_one();
+		}
+
+		bool SendQueue::Pop(Buffer& out_buffer)
+		{
+			Node* next = m_tail->next.load(std::memory_order_acquire);
+			if (!next)
+			{
+				return false;
+			}
+
+			out_buffer = std::move(next->buffer);
+			delete m_tail;
+			m_tail = next;
+			return true;
+		}
+
+		void SendQueue::Clear()
+		{
+			Buffer buffer;
+			while (Pop(buffer))
+			{
+			}
+		}
+
+		namespace SendQueues
+		{
+			namespace
+			{
+				struct Slot
+				{
+					std::atomic<const void*> owner{ nullptr };
+
+					// producers between checking the owner and finishing their push
+					std::atomic<uint32_t> pushing{ 0 };
+
+					SendQueue queue;
+				};
+
+				Slot s_slots[MAX_SESSIONS];
+
+				// owner of a slot being released: no producer matches it and Acquire can't claim it yet
+				const char s_releasing = 0;
+			}
+
+			SendQueue* Acquire(const void* in_session)
+			{
+				if (SendQueue* queue = Find(in_session))
+				{
+					return queue;
+				}
+
+				for (Slot& slot : s_slots)
+				{
+					const void* expected = nullptr;
+					if (slot.owner.compare_exchange_strong(expected, in_session))
+					{
+						// Release emptied it with no producer left
+						return &slot.queue;
+					}
+				}
+				return nullptr;
+			}
+
+			SendQueue* Find(const void* in_session)
+			{
+				for (Slot& slot : s_slots)
+				{
+					if (slot.owner.load(std::memory_order_acquire) == in_session)
+					{
+						return &slot.queue;
+					}
+				}
+				return nullptr;
+			}
+
+			bool Push(const void* in_session, SendQueue::Buffer in_buffer)
+			{
+				for (Slot& slot : s_slots)
+				{
+					if (slot.owner.load(std::memory_order_acquire) != in_session)
+					{
+						continue;
+					}
+
+					// seq_cst pairs with Release: either it sees us pinned and waits, or we see the owner gone
+					slot.pushing.fetch_add(1);
+					const bool stillOwned = slot.owner.load() == in_session;
+					if (stillOwned)
+					{
+						slot.queue.Push(std::move(in_buffer));
+					}
+					slot.pushing.fetch_sub(1);
+					return stillOwned;
+				}
+				return false;
+			}
+
+			void Release(const void* in_session)
+			{
+				for (Slot& slot : s_slots)
+				{
+					if (slot.owner.load(std::memory_order_acquire) != in_session)
+					{
+						continue;
+					}
+
+					// new producers now fail their check, wait out the ones that already passed it
+					slot.owner.store(&s_releasing);
+					while (slot.pushing.load() != 0)
+					{
+						std::this_thread::yield();
+					}
+
+					slot.queue.Clear();
+					slot.owner.store(nullptr, std::memory_order_release);
+					return;
+				}
+			}
+		}
+	}
+}
@@ -0,0 +1,94 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+// Outgoing message queue of a WAMP session. Any thread pushes without taking a lock, the session's send
+// thread is the only consumer. The consumer only sleeps on the condition variable once the queue is empty,
+// so producers just do an atomic exchange unless the send thread has actually gone to sleep.
+
+namespace AK
+{
+	namespace WwiseAuthoringAPI
+	{
+		class SendQueue
+		{
+		public:
+			typedef std::shared_ptr<std::vector<char>> Buffer;
+
+			SendQueue();
+			~SendQueue();
+
+			SendQueue(const SendQueue&) = delete;
+			SendQueue& operator=(const SendQueue&) = delete;
+
+			// Any thread
+			void Push(Buffer in_buffer);
+
+			// Wakes the consumer so it can check its stop condition
+			void Wake();
+
+			// Consumer only. False if the queue is empty, or the next push hasn't finished linking in yet
+			// (it will be there after the producer's wake up).
+			bool Pop(Buffer& out_buffer);
+
+			// Consumer only, blocks until there's something to pop or in_stop() returns true
+			template <typename StopPredicate>
+			void Wait(StopPredicate in_stop)
+			{
+				std::unique_lock<std::mutex> lock(m_wakeMutex);
+				m_consumerWaiting.store(true);
+				m_wakeEvent.wait(lock, [this, &in_stop] { return HasItems() || in_stop(); });
+				m_consumerWaiting.store(false);
+			}
+
+			// Drops everything queued, only while no consumer is running
+			void Clear();
+
+		private:
+			struct Node
+			{
+				std::atomic<Node*> next{ nullptr };
+				Buffer buffer;
+			};
+
+			bool HasItems() const { return m_tail->next.load() != nullptr; }
+
+			// producers link in at the head, the consumer pops after the tail. The tail is always a node
+			// whose buffer was already taken (initially an empty one).
+			std::atomic<Node*> m_head;
+			Node* m_tail;
+
+			std::atomic<bool> m_consumerWaiting{ false };
+			std::mutex m_wakeMutex;
+			std::condition_variable m_wakeEvent;
+		};
+
+		// The session class comes from the SDK headers, so each running session's queue lives in a fixed
+		// table keyed by the session's address. Lookups are a scan of atomic loads, no lock. Producers pin
+		// the slot while they push and check it's still the session's, Release waits for pinned producers
+		// before it drops the queue, so a stale push never lands in the next session's queue.
+		namespace SendQueues
+		{
+			static const size_t MAX_SESSIONS = 64;
+
+			// Claims a queue for a session that's starting, null if every slot is taken
+			SendQueue* Acquire(const void* in_session);
+
+			// The session's queue, null if it isn't running. Only for the session itself (start, stop and its
+			// send thread), the queue can be released and reused under anyone else.
+			SendQueue* Find(const void* in_session);
+
+			// Any thread. False (and the buffer is dropped) if the session isn't running.
+			bool Push(const void* in_session, SendQueue::Buffer in_buffer);
+
+			// Frees the slot of a stopped session, after its send thread has finished. Waits for producers
+			// still pushing to it, then drops what they queued.
+			void Release(const void* in_session);
+		}
+	}
+}
@@ -0,0 +1,301 @@
+#include "Tracing.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <deque>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace AK
+{
+	namespace WwiseAuthoringAPI
+	{
+		namespace Tracing
+		{
+			std::atomic<bool> g_enabled{ false };
+
+			namespace
+			{
+				const size_t RING_CAPACITY = 8192;
+				const size_t DETAIL_LENGTH = 48;
+
+				struct Event
+				{
+					const char* category;
+					const char* name;
+					uint64_t timestamp;
+
+					// duration for complete events, id for async events
+					uint64_t durationOrId;
+
+					EventType type;
+					char detail[DETAIL_LENGTH];
+				};
+
+				struct ThreadRing
+				{
+					// only contended while a trace is being written
+					std::mutex mutex;
+
+					uint32_t threadId = 0;
+					std::string threadName;
+
+					std::vector<Event> events;
+					uint64_t written = 0;
+				};
+
+				std::mutex s_ringsMutex;
+				std::vector<std::shared_ptr<ThreadRing>> s_rings;
+				uint32_t s_nextThreadId = 1;
+
+				// rings of exited threads, oldest first, still in s_rings so late traces show them
+				std::deque<std::shared_ptr<ThreadRing>> s_exitedRings;
+
+				void OnThreadExit(std::shared_ptr<ThreadRing> in_ring)
+				{
+					std::lock_guard<std::mutex> lock(s_ringsMutex);
+					s_exitedRings.push_back(std::move(in_ring));
+					if (s_exitedRings.size() > MAX_EXITED_RINGS)
+					{
+						// a trace being written may still hold it, it's freed once that's done
+						s_rings.erase(std::find(s_rings.begin(), s_rings.end(), s_exitedRings.front()));
+						s_exitedRings.pop_front();
+					}
+				}
+
+				struct ThreadRingHolder
+				{
+					std::shared_ptr<ThreadRing> ring;
+
+					~ThreadRingHolder()
+					{
+						if (ring)
+						{
+							OnThreadExit(std::move(ring));
+						}
+					}
+				};
+				thread_local ThreadRingHolder t_ringHolder;
+
+				// naming a thread doesn't allocate its ring, threads that never record cost nothing
+				thread_local const char* t_threadName = nullptr;
+
+				const std::chrono::steady_clock::time_point s_epoch = std::chrono::steady_clock::now();
+
+				ThreadRing& GetThreadRing()
+				{
+					std::shared_ptr<ThreadRing>& threadRing = t_ringHolder.ring;
+					if (!threadRing)
+					{
+						std::lock_guard<std::mutex> lock(s_ringsMutex);
+						if (!s_exitedRings.empty())
+						{
+							// the oldest exited thread's events go, its buffer is reused as is
+							threadRing = std::move(s_exitedRings.front());
+							s_exitedRings.pop_front();
+						}
+						else
+						{
+							threadRing = std::make_shared<ThreadRing>();
+							threadRing->events.resize(RING_CAPACITY);
+							s_rings.push_back(threadRing);
+						}
+
+						std::lock_guard<std::mutex> ringLock(threadRing->mutex);
+						threadRing->threadId = s_nextThreadId++;
+						threadRing->threadName = t_threadName ? t_threadName : "";
+						threadRing->written = 0;
+					}
+					return *threadRing;
+				}
+
+				void Record(EventType in_type, const char* in_category, const char* in_name, uint64_t in_timestamp, uint64_t in_durationOrId, const char* in_detail)
+				{
+					ThreadRing& ring = GetThreadRing();
+					std::lock_guard<std::mutex> lock(ring.mutex);
+
+					Event& event = ring.events[ring.written % RING_CAPACITY];
+					event.category = in_category;
+					event.name = in_name;
+					event.timestamp = in_timestamp;
+					event.durationOrId = in_durationOrId;
+					event.type = in_type;
+
+					if (in_detail)
+					{
+						strncpy(event.detail, in_detail, DETAIL_LENGTH - 1);
+						event.detail[DETAIL_LENGTH - 1] = '\0';
+					}
+					else
+					{
+						event.detail[0] = '\0';
+					}
+
+					++ring.written;
+				}
+
+				void WriteEscaped(std::ofstream& out, const char* in_str)
+				{
+					for (const char* c = in_str; *c; ++c)
+					{
+						switch (*c)
+						{
+						case '"': out << "\\\""; break;
+						case '\\': out << "\\\\"; break;
+						case '\n': out << "\\n"; break;
+						case '\r': out << "\\r"; break;
+						case '\t': out << "\\t"; break;
+						default:
+							if (static_cast<unsigned char>(*c) < 0x20)
+							{
+								char buffer[8];
+								snprintf(buffer, sizeof(buffer), "\\u%04x", *c);
+								out << buffer;
+							}
+							else
+							{
+								out << *c;
+							}
+						}
+					}
+				}
+
+				void WriteEvent(std::ofstream& out, const Event& in_event, uint32_t in_threadId)
+				{
+					static const char* phases[] = { "X", "b", "e", "i" };
+
+					out << "{\"cat\":\"";
+					WriteEscaped(out, in_event.category);
+					out << "\",\"name\":\"";
+					WriteEscaped(out, in_event.name);
+					out << "\",\"ph\":\"" << phases[static_cast<int>(in_event.type)]
+						<< "\",\"pid\":1,\"tid\":" << in_threadId
+						<< ",\"ts\":" << in_event.timestamp;
+
+					switch (in_event.type)
+					{
+					case EventType::Complete:
+						out << ",\"dur\":" << in_event.durationOrId;
+						break;
+					case EventType::AsyncBegin:
+					case EventType::AsyncEnd:
+						out << ",\"id\":\"0x" << std::hex << in_event.durationOrId << std::dec << '"';
+						break;
+					case EventType::Instant:
+						out << ",\"s\":\"t\"";
+						break;
+					}
+
+					if (in_event.detail[0])
+					{
+						out << ",\"args\":{\"detail\":\"";
+						WriteEscaped(out, in_event.detail);
+						out << "\"}";
+					}
+
+					out << '}';
+				}
+			}
+
+			void SetEnabled(bool in_enabled)
+			{
+				g_enabled.store(in_enabled, std::memory_order_relaxed);
+			}
+
+			uint64_t NowMicroseconds()
+			{
+				return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(
+					std::chrono::steady_clock::now() - s_epoch).count());
+			}
+
+			void RecordComplete(const char* in_category, const char* in_name, uint64_t in_startUs, uint64_t in_durationUs, const char* in_detail)
+			{
+				Record(EventType::Complete, in_category, in_name, in_startUs, in_durationUs, in_detail);
+			}
+
+			void RecordAsync(EventType in_type, const char* in_category, const char* in_name, uint64_t in_id, const char* in_detail)
+			{
+				Record(in_type, in_category, in_name, NowMicroseconds(), in_id, in_detail);
+			}
+
+			void RecordInstant(const char* in_category, const char* in_name, const char* in_detail)
+			{
+				Record(EventType::Instant, in_category, in_name, NowMicroseconds(), 0, in_detail);
+			}
+
+			void SetThreadName(const char* in_name)
+			{
+				t_threadName = in_name;
+
+				if (const std::shared_ptr<ThreadRing>& ring = t_ringHolder.ring)
+				{
+					std::lock_guard<std::mutex> lock(ring->mutex);
+					ring->threadName = in_name;
+				}
+			}
+
+			bool WriteChromeTrace(const std::string& in_path)
+			{
+				std::ofstream out(in_path, std::ios::trunc);
+				if (!out.is_open())
+				{
+					return false;
+				}
+
+				std::vector<std::shared_ptr<ThreadRing>> rings;
+				{
+					std::lock_guard<std::mutex> lock(s_ringsMutex);
+					rings = s_rings;
+				}
+
+				out << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+				bool first = true;
+
+				for (const auto& ring : rings)
+				{
+					std::lock_guard<std::mutex> lock(ring->mutex);
+
+					if (!ring->threadName.empty())
+					{
+						out << (first ? "" : ",") << "\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << ring->threadId
+							<< ",\"args\":{\"name\":\"";
+						WriteEscaped(out, ring->threadName.c_str());
+						out << "\"}}";
+						first = false;
+					}
+
+					const uint64_t count = ring->written < RING_CAPACITY ? ring->written : RING_CAPACITY;
+					for (uint64_t i = ring->written - count; i < ring->written; ++i)
+					{
+						out << (first ? "" : ",") << '\n';
+						WriteEvent(out, ring->events[i % RING_CAPACITY], ring->threadId);
+						first = false;
+					}
+				}
+
+				out << "\n]}\n";
+				return out.good();
+			}
+
+			void Clear()
+			{
+				std::lock_guard<std::mutex> lock(s_ringsMutex);
+				for (const auto& ring : s_rings)
+				{
+					std::lock_guard<std::mutex> ringLock(ring->mutex);
+					ring->written = 0;
+				}
+			}
+
+			size_t GetNumThreadRings()
+			{
+				std::lock_guard<std::mutex> lock(s_ringsMutex);
+				return s_rings.size();
+			}
+		}
+	}
+}
@@ -0,0 +1,142 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+
+// Chrome/Perfetto trace event recorder.
+// Every thread appends to its own fixed size ring buffer, oldest events are overwritten once it wraps.
+// A ring outlives its thread so the next trace still shows it, up to MAX_EXITED_RINGS of them, after that
+// the oldest exited thread's ring is reused by the next thread that records (or freed).
+// Recording is off until SetEnabled(true), while off a span costs one relaxed atomic load.
+// Build with WAAPI_TRACING=0 to remove the macros entirely.
+
+#ifndef WAAPI_TRACING
+#define WAAPI_TRACING 1
+#endif
+
+namespace AK
+{
+	namespace WwiseAuthoringAPI
+	{
+		namespace Tracing
+		{
+			enum class EventType : uint8_t
+			{
+				Complete,
+				AsyncBegin,
+				AsyncEnd,
+				Instant
+			};
+
+			extern std::atomic<bool> g_enabled;
+
+			inline bool IsEnabled()
+			{
+				return g_enabled.load(std::memory_order_relaxed);
+			}
+
+			void SetEnabled(bool in_enabled);
+
+			// Microseconds since the module was loaded, trace timestamps use this clock.
+			uint64_t NowMicroseconds();
+
+			// in_category and in_name are stored by pointer and must be string literals, in_detail is copied (and truncated).
+			void RecordComplete(const char* in_category, const char* in_name, uint64_t in_startUs, uint64_t in_durationUs, const char* in_detail = nullptr);
+			void RecordAsync(EventType in_type, const char* in_category, const char* in_name, uint64_t in_id, const char* in_detail = nullptr);
+			void RecordInstant(const char* in_category, const char* in_name, const char* in_detail = nullptr);
+
+			// Name shown for the calling thread's track, stored by pointer until the thread first records.
+			void SetThreadName(const char* in_name);
+
+			// Writes every thread's ring as a Chrome trace JSON file, recording carries on while writing.
+			bool WriteChromeTrace(const std::string& in_path);
+
+			void Clear();
+
+			static const size_t MAX_EXITED_RINGS = 8;
+
+			// Rings held, one per live thread that recorded plus the exited ones kept
+			size_t GetNumThreadRings();
+
+			class ScopedSpan
+			{
+			public:
+				ScopedSpan(const char* in_category, const char* in_name, const char* in_detail = nullptr)
+					: m_category(in_category)
+					, m_name(IsEnabled() ? in_name : nullptr)
+					, m_detail(in_detail)
+					, m_start(m_name ? NowMicroseconds() : 0)
+				{
+				}
+
+				~ScopedSpan()
+				{
+					if (m_name)
+					{
+						RecordComplete(m_category, m_name, m_start, NowMicroseconds() - m_start, m_detail);
+					}
+				}
+
+				ScopedSpan(const ScopedSpan&) = delete;
+				ScopedSpan& operator=(const ScopedSpan&) = delete;
+
+			private:
+				const char* m_category;
+				const char* m_name;
+				const char* m_detail;
+				uint64_t m_start;
+			};
+		}
+	}
+}
+
+#if WAAPI_TRACING
+
+#define WAAPI_TRACE_CONCAT_INNER(a, b) a##b
+#define WAAPI_TRACE_CONCAT(a, b) WAAPI_TRACE_CONCAT_INNER(a, b)
+
+#define WAAPI_TRACE_SCOPE(category, name) \
+	::AK::WwiseAuthoringAPI::Tracing::ScopedSpan WAAPI_TRACE_CONCAT(waapiTraceSpan, __LINE__)(category, name)
+
+#define WAAPI_TRACE_SCOPE_DETAIL(category, name, detail) \
+	::AK::WwiseAuthoringAPI::Tracing::ScopedSpan WAAPI_TRACE_CONCAT(waapiTraceSpan, __LINE__)(category, name, detail)
+
+// span that finished now and lasted durationSeconds, for work timed by other means
+#define WAAPI_TRACE_ELAPSED(category, name, durationSeconds, detail) \
+	do { if (::AK::WwiseAuthoringAPI::Tracing::IsEnabled()) { \
+		const uint64_t waapiTraceDuration = static_cast<uint64_t>((durationSeconds) * 1000000.0); \
+		const uint64_t waapiTraceNow = ::AK::WwiseAuthoringAPI::Tracing::NowMicroseconds(); \
+		::AK::WwiseAuthoringAPI::Tracing::RecordComplete(category, name, \
+			waapiTraceNow > waapiTraceDuration ? waapiTraceNow - waapiTraceDuration : 0, waapiTraceDuration, detail); \
+	} } while (0)
+
+// begin/end pairs may happen on different threads, they are matched by category and id
+#define WAAPI_TRACE_ASYNC_BEGIN(category, name, id, detail) \
+	do { if (::AK::WwiseAuthoringAPI::Tracing::IsEnabled()) { \
+		::AK::WwiseAuthoringAPI::Tracing::RecordAsync(::AK::WwiseAuthoringAPI::Tracing::EventType::AsyncBegin, category, name, id, detail); \
+	} } while (0)
+
+#define WAAPI_TRACE_ASYNC_END(category, name, id) \
+	do { if (::AK::WwiseAuthoringAPI::Tracing::IsEnabled()) { \
+		::AK::WwiseAuthoringAPI::Tracing::RecordAsync(::AK::WwiseAuthoringAPI::Tracing::EventType::AsyncEnd, category, name, id); \
+	} } while (0)
+
+#define WAAPI_TRACE_INSTANT(category, name, detail) \
+	do { if (::AK::WwiseAuthoringAPI::Tracing::IsEnabled()) { \
+		::AK::WwiseAuthoringAPI::Tracing::RecordInstant(category, name, detail); \
+	} } while (0)
+
+#define WAAPI_TRACE_THREAD_NAME(name) ::AK::WwiseAuthoringAPI::Tracing::SetThreadName(name)
+
+#else
+
+#define WAAPI_TRACE_SCOPE(category, name) do { } while (0)
+#define WAAPI_TRACE_SCOPE_DETAIL(category, name, detail) do { } while (0)
+#define WAAPI_TRACE_ELAPSED(category, name, durationSeconds, detail) do { } while (0)
+#define WAAPI_TRACE_ASYNC_BEGIN(category, name, id, detail) do { } while (0)
+#define WAAPI_TRACE_ASYNC_END(category, name, id) do { } while (0)
+#define WAAPI_TRACE_INSTANT(category, name, detail) do { } while (0)
+#define WAAPI_TRACE_THREAD_NAME(name) do { } while (0)
+
+#endif
@@ -0,0 +1,239 @@
+#include "WampCapture.h"
+
+#include <chrono>
+#include <cstring>
+#include <mutex>
+#include <unordered_map>
+
+namespace AK
+{
+	namespace WwiseAuthoringAPI
+	{
+		namespace WampCapture
+		{
+			std::atomic<bool> g_capturing(false);
+
+			namespace
+			{
+				using Clock = std::chrono::steady_clock;
+
+				const char k_magic[8] = { 'W', 'A', 'M', 'P', 'C', 'A', 'P', 0x01 };
+				const size_t k_fileBufferSize = 1 << 20;
+
+				std::mutex s_mutex;
+				FILE* s_file = nullptr;
+				std::string s_path;
+				Clock::time_point s_lastFrame;
+
+				// session pointers to stream numbers, numbered in order of their first frame
+				std::unordered_map<const void*, uint32_t> s_streams;
+
+				// one byte per 7 bits, at most 10 for a uint64
+				size_t EncodeVarint(uint64_t in_value, unsigned char* out_bytes)
+				{
+					size_t size = 0;
+					do
+					{
+						unsigned char byte = static_cast<unsigned char>(in_value & 0x7F);
+						in_value >>= 7;
+						out_bytes[size++] = byte | (in_value ? 0x80 : 0);
+					} while (in_value);
+					return size;
+				}
+
+				bool DecodeVarint(FILE* in_file, uint64_t& out_value)
+				{
+					out_value = 0;
+					for (int shift = 0; shift < 64; shift += 7)
+					{
+						const int byte = fgetc(in_file);
+						if (byte == EOF)
+						{
+							return false;
+						}
+						out_value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+						if (!(byte & 0x80))
+						{
+							return true;
+						}
+					}
+					return false;
+				}
+
+				void CloseFile()
+				{
+					if (s_file)
+					{
+						fclose(s_file);
+						s_file = nullptr;
+					}
+					s_path.clear();
+					s_streams.clear();
+				}
+			}
+
+			bool Start(const std::string& in_path)
+			{
+				std::lock_guard<std::mutex> lock(s_mutex);
+
+				g_capturing = false;
+				CloseFile();
+
+				s_file = fopen(in_path.c_str(), "wb");
+				if (!s_file)
+				{
+					return false;
+				}
+				setvbuf(s_file, nullptr, _IOFBF, k_fileBufferSize);
+
+				const uint64_t startEpochUs = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(
+					std::chrono::system_clock::now().time_since_epoch()).count());
+
+				unsigned char header[16];
+				memcpy(header, k_magic, sizeof(k_magic));
+				for (int i = 0; i < 8; ++i)
+				{
+					header[8 + i] = static_cast<unsigned char>(startEpochUs >> (8 * i));
+				}
+
+				if (fwrite(header, sizeof(header), 1, s_file) != 1)
+				{
+					CloseFile();
+					return false;
+				}
+
+				s_path = in_path;
+				s_lastFrame = Clock::now();
+				g_capturing = true;
+				return true;
+			}
+
+			void Stop()
+			{
+				std::lock_guard<std::mutex> lock(s_mutex);
+				g_capturing = false;
+				CloseFile();
+			}
+
+			std::string GetPath()
+			{
+				std::lock_guard<std::mutex> lock(s_mutex);
+				return s_path;
+			}
+
+			void RecordFrame(const void* in_stream, Direction in_direction, const char* in_data, size_t in_size)
+			{
+				if (!IsCapturing())
+				{
+					return;
+				}
+
+				std::lock_guard<std::mutex> lock(s_mutex);
+				if (!s_file)
+				{
+					return;
+				}
+
+				// stamped under the lock so deltas never go negative between threads
+				const Clock::time_point now = Clock::now();
+				const uint64_t deltaUs = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(now - s_lastFrame).count());
+				s_lastFrame = now;
+
+				const uint32_t stream = s_streams.emplace(in_stream, static_cast<uint32_t>(s_streams.size())).first->second;
+
+				unsigned char prefix[1 + 10 + 10 + 10];
+				size_t prefixSize = 0;
+				prefix[prefixSize++] = static_cast<unsigned char>(in_direction);
+				prefixSize += EncodeVarint(stream, prefix + prefixSize);
+				prefixSize += EncodeVarint(deltaUs, prefix + prefixSize);
+				prefixSize += EncodeVarint(in_size, prefix + prefixSize);
+
+				if (fwrite(prefix, 1, prefixSize, s_file) != prefixSize ||
+					fwrite(in_data, 1, in_size, s_file) != in_size)
+				{
+					// disk full or similar, keep what was written
+					g_capturing = false;
+					CloseFile();
+				}
+			}
+
+			Reader::Reader()
+				: m_file(nullptr)
+				, m_startEpochUs(0)
+				, m_timeUs(0)
+			{
+			}
+
+			Reader::~Reader()
+			{
+				Close();
+			}
+
+			bool Reader::Open(const std::string& in_path, std::string& out_error)
+			{
+				Close();
+
+				m_file = fopen(in_path.c_str(), "rb");
+				if (!m_file)
+				{
+					out_error = "couldn't open " + in_path;
+					return false;
+				}
+
+				unsigned char header[16];
+				if (fread(header, sizeof(header), 1, m_file) != 1 || memcmp(header, k_magic, sizeof(k_magic)) != 0)
+				{
+					out_error = in_path + " isn't a WAMP capture";
+					Close();
+					return false;
+				}
+
+				m_startEpochUs = 0;
+				for (int i = 0; i < 8; ++i)
+				{
+					m_startEpochUs |= static_cast<uint64_t>(header[8 + i]) << (8 * i);
+				}
+				m_timeUs = 0;
+				return true;
+			}
+
+			void Reader::Close()
+			{
+				if (m_file)
+				{
+					fclose(m_file);
+					m_file = nullptr;
+				}
+			}
+
+			bool Reader::Next(Frame& out_frame)
+			{
+				if (!m_file)
+				{
+					return false;
+				}
+
+				const int direction = fgetc(m_file);
+				uint64_t stream = 0;
+				uint64_t deltaUs = 0;
+				uint64_t size = 0;
+				if (direction == EOF || !DecodeVarint(m_file, stream) || !DecodeVarint(m_file, deltaUs) || !DecodeVarint(m_file, size))
+				{
+					return false;
+				}
+
+				out_frame.payload.resize(static_cast<size_t>(size));
+				if (size && fread(&out_frame.payload[0], 1, static_cast<size_t>(size), m_file) != size)
+				{
+					return false;
+				}
+
+				m_timeUs += deltaUs;
+				out_frame.direction = static_cast<Direction>(direction);
+				out_frame.stream = static_cast<uint32_t>(stream);
+				out_frame.timeUs = m_timeUs;
+				return true;
+			}
+		}
+	}
+}
@@ -0,0 +1,81 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+
+// Records every WAMP frame a session sends and receives to a compact binary log, for replaying real
+// Wwise sessions against new client builds (tools/waapi_replay_server).
+//
+// File layout, integers are little endian:
+//   header  "WAMPCAP" 0x01 | uint64 capture start, microseconds since the unix epoch
+//   frame   uint8 direction | varint stream | varint microseconds since the previous frame | varint size | payload
+// Varints are unsigned LEB128. Each session object gets its own stream number, so concurrent clients
+// (the transfer and recall windows) can be told apart. Sent frames are stamped when the session queues
+// them, received frames when the session starts handling them.
+
+namespace AK
+{
+	namespace WwiseAuthoringAPI
+	{
+		namespace WampCapture
+		{
+			enum class Direction : uint8_t
+			{
+				Sent = 0,
+				Received = 1
+			};
+
+			extern std::atomic<bool> g_capturing;
+
+			inline bool IsCapturing()
+			{
+				return g_capturing.load(std::memory_order_relaxed);
+			}
+
+			// Starts a new capture file, replacing any capture in progress.
+			bool Start(const std::string& in_path);
+			void Stop();
+
+			// Path of the capture in progress, empty when not capturing.
+			std::string GetPath();
+
+			// Thread safe, does nothing unless capturing. in_stream identifies the session.
+			void RecordFrame(const void* in_stream, Direction in_direction, const char* in_data, size_t in_size);
+
+			struct Frame
+			{
+				Direction direction = Direction::Sent;
+				uint32_t stream = 0;
+
+				// microseconds since the capture started
+				uint64_t timeUs = 0;
+				std::string payload;
+			};
+
+			class Reader
+			{
+			public:
+				Reader();
+				~Reader();
+
+				Reader(const Reader&) = delete;
+				Reader& operator=(const Reader&) = delete;
+
+				bool Open(const std::string& in_path, std::string& out_error);
+				void Close();
+
+				// false at the end of the file or on a truncated frame (a capture cut off mid write)
+				bool Next(Frame& out_frame);
+
+				uint64_t GetStartEpochUs() const { return m_startEpochUs; }
+
+			private:
+				FILE* m_file;
+				uint64_t m_startEpochUs;
+				uint64_t m_timeUs;
+			};
+		}
+	}
+}
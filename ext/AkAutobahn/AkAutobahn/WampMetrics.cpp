@@ -0,0 +1,493 @@
+#include "WampMetrics.h"
+#include "PendingTable.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <ctime>
+#include <fstream>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+
+#include <rapidjson/prettywriter.h>
+#include <rapidjson/stringbuffer.h>
+
+namespace AK
+{
+	namespace WwiseAuthoringAPI
+	{
+		namespace WampMetrics
+		{
+			namespace
+			{
+				using Clock = std::chrono::steady_clock;
+
+				// UriMetrics any thread can add to
+				struct UriCounters
+				{
+					std::atomic<uint64_t> requests{ 0 };
+					std::atomic<uint64_t> errors{ 0 };
+					std::atomic<uint64_t> timeouts{ 0 };
+					std::atomic<uint64_t> lateResponses{ 0 };
+					std::atomic<uint64_t> bytesSent{ 0 };
+					std::atomic<uint64_t> bytesReceived{ 0 };
+
+					std::atomic<uint64_t> latencyBuckets[LatencyHistogram::NUM_BUCKETS] = {};
+					std::atomic<uint64_t> latencyCount{ 0 };
+					std::atomic<uint64_t> latencySum{ 0 };
+					std::atomic<uint64_t> latencyMin{ UINT64_MAX };
+					std::atomic<uint64_t> latencyMax{ 0 };
+
+					void RecordLatency(uint64_t in_valueUs)
+					{
+						latencyBuckets[LatencyHistogram::GetBucketIndex(in_valueUs)].fetch_add(1, std::memory_order_relaxed);
+						latencyCount.fetch_add(1, std::memory_order_relaxed);
+						latencySum.fetch_add(in_valueUs, std::memory_order_relaxed);
+
+						uint64_t min = latencyMin.load(std::memory_order_relaxed);
+						while (in_valueUs < min && !latencyMin.compare_exchange_weak(min, in_valueUs, std::memory_order_relaxed))
+						{
+						}
+
+						uint64_t max = latencyMax.load(std::memory_order_relaxed);
+						while (in_valueUs > max && !latencyMax.compare_exchange_weak(max, in_valueUs, std::memory_order_relaxed))
+						{
+						}
+					}
+
+					UriMetrics Snapshot() const
+					{
+						UriMetrics metrics;
+						metrics.requests = requests.load(std::memory_order_relaxed);
+						metrics.errors = errors.load(std::memory_order_relaxed);
+						metrics.timeouts = timeouts.load(std::memory_order_relaxed);
+						metrics.lateResponses = lateResponses.load(std::memory_order_relaxed);
+						metrics.bytesSent = bytesSent.load(std::memory_order_relaxed);
+						metrics.bytesReceived = bytesReceived.load(std::memory_order_relaxed);
+
+						std::vector<uint64_t> buckets(LatencyHistogram::NUM_BUCKETS);
+						for (uint32_t i = 0; i < LatencyHistogram::NUM_BUCKETS; ++i)
+						{
+							buckets[i] = latencyBuckets[i].load(std::memory_order_relaxed);
+						}
+						metrics.latency = LatencyHistogram(std::move(buckets),
+							latencyCount.load(std::memory_order_relaxed), latencySum.load(std::memory_order_relaxed),
+							latencyMin.load(std::memory_order_relaxed), latencyMax.load(std::memory_order_relaxed));
+						return metrics;
+					}
+
+					void Reset()
+					{
+						for (std::atomic<uint64_t>* counter : { &requests, &errors, &timeouts, &lateResponses, &bytesSent,
+							&bytesReceived, &latencyCount, &latencySum, &latencyMax })
+						{
+							counter->store(0, std::memory_order_relaxed);
+						}
+						for (std::atomic<uint64_t>& bucket : latencyBuckets)
+						{
+							bucket.store(0, std::memory_order_relaxed);
+						}
+						latencyMin.store(UINT64_MAX, std::memory_order_relaxed);
+					}
+				};
+
+				struct PendingRequest
+				{
+					UriCounters* uri = nullptr;
+					Clock::time_point sent;
+				};
+
+				// twice the sessions' own table, a request that doesn't fit is counted but not timed
+				const size_t MAX_PENDING_REQUESTS = 2048;
+
+				// guards s_uris' layout and s_timedOut. Counters are never freed, Reset zeroes them
+				std::mutex s_mutex;
+				std::map<std::string, std::unique_ptr<UriCounters>> s_uris;
+
+				PendingTable<PendingRequest> s_pending(MAX_PENDING_REQUESTS);
+
+				// request ids the caller stopped waiting on, so late responses are still attributed. Ids only grow,
+				// so when it's full the first one is the oldest and is forgotten: its response is likely never coming
+				const size_t MAX_TIMED_OUT_REQUESTS = MAX_PENDING_REQUESTS;
+				std::map<uint64_t, UriCounters*> s_timedOut;
+				std::atomic<size_t> s_numTimedOut{ 0 };
+
+				thread_local size_t t_inboundBytes = 0;
+				thread_local uint64_t t_lastRequestId = 0;
+
+				// the URIs this thread has sent to, so only the first request to a URI takes the mutex
+				thread_local std::unordered_map<std::string, UriCounters*> t_uris;
+
+				UriCounters& FindCounters(const std::string& in_key)
+				{
+					auto cached = t_uris.find(in_key);
+					if (cached != t_uris.end())
+					{
+						return *cached->second;
+					}
+
+					std::lock_guard<std::mutex> lock(s_mutex);
+					std::unique_ptr<UriCounters>& counters = s_uris[in_key];
+					if (!counters)
+					{
+						counters.reset(new UriCounters());
+					}
+					t_uris.insert({ in_key, counters.get() });
+					return *counters;
+				}
+
+				// the caller gave up on in_requestId, so its response is late. Null if it wasn't timed out
+				UriCounters* TakeTimedOut(uint64_t in_requestId)
+				{
+					if (!s_numTimedOut.load(std::memory_order_acquire))
+					{
+						return nullptr;
+					}
+
+					std::lock_guard<std::mutex> lock(s_mutex);
+					auto timedOut = s_timedOut.find(in_requestId);
+					if (timedOut == s_timedOut.end())
+					{
+						return nullptr;
+					}
+
+					UriCounters* counters = timedOut->second;
+					s_timedOut.erase(timedOut);
+					s_numTimedOut.fetch_sub(1, std::memory_order_release);
+					return counters;
+				}
+
+				std::string MakeKey(RequestKind in_kind, const std::string& in_uri)
+				{
+					switch (in_kind)
+					{
+					case RequestKind::Subscribe: return "subscribe:" + in_uri;
+					case RequestKind::Unsubscribe: return "unsubscribe";
+					default: return in_uri;
+					}
+				}
+			}
+
+			LatencyHistogram::LatencyHistogram()
+				: m_buckets(NUM_BUCKETS, 0)
+				, m_count(0)
+				, m_sum(0)
+				, m_min(UINT64_MAX)
+				, m_max(0)
+			{
+			}
+
+			LatencyHistogram::LatencyHistogram(std::vector<uint64_t> in_buckets, uint64_t in_count, uint64_t in_sum, uint64_t in_min, uint64_t in_max)
+				: m_buckets(std::move(in_buckets))
+				, m_count(in_count)
+				, m_sum(in_sum)
+				, m_min(in_min)
+				, m_max(in_max)
+			{
+			}
+
+			uint32_t LatencyHistogram::GetBucketIndex(uint64_t in_valueUs)
+			{
+				const uint64_t maxValue = (uint64_t(1) << (MAX_EXPONENT + 1)) - 1;
+				const uint64_t value = in_valueUs < maxValue ? in_valueUs : maxValue;
+
+				if (value < LINEAR_BUCKETS)
+				{
+					return static_cast<uint32_t>(value);
+				}
+
+				// shift the value down until only its top SUB_BUCKET_BITS - 1 bits are left
+				uint32_t shift = 1;
+				while ((value >> shift) >= LINEAR_BUCKETS)
+				{
+					++shift;
+				}
+
+				const uint32_t top = static_cast<uint32_t>(value >> shift);
+				return LINEAR_BUCKETS + (shift - 1) * HALF_LINEAR_BUCKETS + (top - HALF_LINEAR_BUCKETS);
+			}
+
+			uint64_t LatencyHistogram::GetBucketLowerBound(uint32_t in_index)
+			{
+				if (in_index < LINEAR_BUCKETS)
+				{
+					return in_index;
+				}
+
+				const uint32_t offset = in_index - LINEAR_BUCKETS;
+				const uint32_t shift = offset / HALF_LINEAR_BUCKETS + 1;
+				const uint64_t top = HALF_LINEAR_BUCKETS + offset % HALF_LINEAR_BUCKETS;
+				return top << shift;
+			}
+
+			uint64_t LatencyHistogram::GetBucketUpperBound(uint32_t in_index)
+			{
+				if (in_index < LINEAR_BUCKETS)
+				{
+					return in_index;
+				}
+
+				const uint32_t offset = in_index - LINEAR_BUCKETS;
+				const uint32_t shift = offset / HALF_LINEAR_BUCKETS + 1;
+				const uint64_t top = HALF_LINEAR_BUCKETS + offset % HALF_LINEAR_BUCKETS;
+				return ((top + 1) << shift) - 1;
+			}
+
+			void LatencyHistogram::Record(uint64_t in_valueUs)
+			{
+				++m_buckets[GetBucketIndex(in_valueUs)];
+				++m_count;
+				m_sum += in_valueUs;
+				m_min = in_valueUs < m_min ? in_valueUs : m_min;
+				m_max = in_valueUs > m_max ? in_valueUs : m_max;
+			}
+
+			uint64_t LatencyHistogram::GetPercentile(double in_percentile) const
+			{
+				if (!m_count)
+				{
+					return 0;
+				}
+
+				uint64_t target = static_cast<uint64_t>((in_percentile / 100.0) * m_count + 0.5);
+				target = target < 1 ? 1 : target;
+
+				uint64_t cumulative = 0;
+				for (uint32_t i = 0; i < NUM_BUCKETS; ++i)
+				{
+					cumulative += m_buckets[i];
+					if (cumulative >= target)
+					{
+						const uint64_t upper = GetBucketUpperBound(i);
+						return upper < m_max ? upper : m_max;
+					}
+				}
+
+				return m_max;
+			}
+
+			void OnRequestSent(uint64_t in_requestId, RequestKind in_kind, const std::string& in_uri, size_t in_bytesSent)
+			{
+				t_lastRequestId = in_requestId;
+
+				// calls are keyed by the bare URI, no key to build
+				UriCounters& counters = in_kind == RequestKind::Call ? FindCounters(in_uri) : FindCounters(MakeKey(in_kind, in_uri));
+				counters.requests.fetch_add(1, std::memory_order_relaxed);
+				counters.bytesSent.fetch_add(in_bytesSent, std::memory_order_relaxed);
+
+				const Clock::time_point now = Clock::now();
+				s_pending.Insert(in_requestId, nullptr, [&counters, now](PendingRequest& request)
+				{
+					request.uri = &counters;
+					request.sent = now;
+				});
+			}
+
+			void OnResponse(uint64_t in_requestId, bool in_success)
+			{
+				const Clock::time_point now = Clock::now();
+
+				const bool pending = s_pending.Complete(in_requestId, nullptr, [&](PendingRequest& request)
+				{
+					UriCounters& counters = *request.uri;
+					counters.bytesReceived.fetch_add(t_inboundBytes, std::memory_order_relaxed);
+					if (!in_success)
+					{
+						counters.errors.fetch_add(1, std::memory_order_relaxed);
+					}
+					counters.RecordLatency(static_cast<uint64_t>(
+						std::chrono::duration_cast<std::chrono::microseconds>(now - request.sent).count()));
+				});
+
+				if (!pending)
+				{
+					if (UriCounters* counters = TakeTimedOut(in_requestId))
+					{
+						counters->bytesReceived.fetch_add(t_inboundBytes, std::memory_order_relaxed);
+						counters->lateResponses.fetch_add(1, std::memory_order_relaxed);
+					}
+				}
+			}
+
+			void OnAborted(uint64_t in_requestId)
+			{
+				const bool pending = s_pending.Complete(in_requestId, nullptr, [](PendingRequest& request)
+				{
+					request.uri->errors.fetch_add(1, std::memory_order_relaxed);
+				});
+
+				if (!pending)
+				{
+					TakeTimedOut(in_requestId);
+				}
+			}
+
+			void SetInboundMessageBytes(size_t in_bytes)
+			{
+				t_inboundBytes = in_bytes;
+			}
+
+			uint64_t GetLastRequestId()
+			{
+				return t_lastRequestId;
+			}
+
+			void OnTimedOut(uint64_t in_requestId)
+			{
+				UriCounters* timedOut = nullptr;
+				s_pending.Complete(in_requestId, nullptr, [&timedOut](PendingRequest& request)
+				{
+					request.uri->timeouts.fetch_add(1, std::memory_order_relaxed);
+					timedOut = request.uri;
+				});
+
+				if (timedOut)
+				{
+					std::lock_guard<std::mutex> lock(s_mutex);
+					if (s_timedOut.size() >= MAX_TIMED_OUT_REQUESTS)
+					{
+						s_timedOut.erase(s_timedOut.begin());
+						s_numTimedOut.fetch_sub(1, std::memory_order_release);
+					}
+					s_timedOut[in_requestId] = timedOut;
+					s_numTimedOut.fetch_add(1, std::memory_order_release);
+				}
+			}
+
+			std::vector<std::pair<std::string, UriMetrics>> GetSnapshot()
+			{
+				std::lock_guard<std::mutex> lock(s_mutex);
+
+				std::vector<std::pair<std::string, UriMetrics>> snapshot;
+				snapshot.reserve(s_uris.size());
+				for (const auto& uri : s_uris)
+				{
+					// URIs Reset emptied stay registered, they aren't reported until they're used again
+					UriMetrics metrics = uri.second->Snapshot();
+					if (metrics.requests || metrics.lateResponses)
+					{
+						snapshot.emplace_back(uri.first, std::move(metrics));
+					}
+				}
+				return snapshot;
+			}
+
+			std::string FormatReport()
+			{
+				const auto snapshot = GetSnapshot();
+
+				std::string report;
+				char line[512];
+
+				snprintf(line, sizeof(line), "%-48s %8s %7s %8s %6s %10s %10s %9s %9s %9s %9s\n",
+					"uri", "requests", "errors", "timeouts", "late", "sent KB", "recv KB", "p50 ms", "p90 ms", "p99 ms", "max ms");
+				report += line;
+
+				for (const auto& uri : snapshot)
+				{
+					const UriMetrics& metrics = uri.second;
+					snprintf(line, sizeof(line), "%-48s %8llu %7llu %8llu %6llu %10.1f %10.1f %9.2f %9.2f %9.2f %9.2f\n",
+						uri.first.c_str(),
+						static_cast<unsigned long long>(metrics.requests),
+						static_cast<unsigned long long>(metrics.errors),
+						static_cast<unsigned long long>(metrics.timeouts),
+						static_cast<unsigned long long>(metrics.lateResponses),
+						metrics.bytesSent / 1024.0,
+						metrics.bytesReceived / 1024.0,
+						metrics.latency.GetPercentile(50.0) / 1000.0,
+						metrics.latency.GetPercentile(90.0) / 1000.0,
+						metrics.latency.GetPercentile(99.0) / 1000.0,
+						metrics.latency.GetMax() / 1000.0);
+					report += line;
+				}
+
+				return report;
+			}
+
+			bool WriteJson(const std::string& in_path)
+			{
+				const auto snapshot = GetSnapshot();
+
+				rapidjson::StringBuffer buffer;
+				rapidjson::PrettyWriter<rapidjson::StringBuffer> writer(buffer);
+
+				writer.StartObject();
+				writer.Key("timestamp");
+				writer.Int64(static_cast<int64_t>(std::time(nullptr)));
+				writer.Key("uris");
+				writer.StartObject();
+
+				for (const auto& uri : snapshot)
+				{
+					const UriMetrics& metrics = uri.second;
+					const LatencyHistogram& latency = metrics.latency;
+
+					writer.Key(uri.first.c_str());
+					writer.StartObject();
+					writer.Key("requests"); writer.Uint64(metrics.requests);
+					writer.Key("errors"); writer.Uint64(metrics.errors);
+					writer.Key("timeouts"); writer.Uint64(metrics.timeouts);
+					writer.Key("lateResponses"); writer.Uint64(metrics.lateResponses);
+					writer.Key("bytesSent"); writer.Uint64(metrics.bytesSent);
+					writer.Key("bytesReceived"); writer.Uint64(metrics.bytesReceived);
+
+					writer.Key("latencyUs");
+					writer.StartObject();
+					writer.Key("count"); writer.Uint64(latency.GetCount());
+					writer.Key("min"); writer.Uint64(latency.GetMin());
+					writer.Key("mean"); writer.Double(latency.GetMean());
+					writer.Key("p50"); writer.Uint64(latency.GetPercentile(50.0));
+					writer.Key("p90"); writer.Uint64(latency.GetPercentile(90.0));
+					writer.Key("p99"); writer.Uint64(latency.GetPercentile(99.0));
+					writer.Key("p999"); writer.Uint64(latency.GetPercentile(99.9));
+					writer.Key("max"); writer.Uint64(latency.GetMax());
+
+					// non-empty buckets only, [lower bound, upper bound, count]
+					writer.Key("buckets");
+					writer.StartArray();
+					const std::vector<uint64_t>& buckets = latency.GetBuckets();
+					for (uint32_t i = 0; i < LatencyHistogram::NUM_BUCKETS; ++i)
+					{
+						if (buckets[i])
+						{
+							writer.StartArray();
+							writer.Uint64(LatencyHistogram::GetBucketLowerBound(i));
+							writer.Uint64(LatencyHistogram::GetBucketUpperBound(i));
+							writer.Uint64(buckets[i]);
+							writer.EndArray();
+						}
+					}
+					writer.EndArray();
+
+					writer.EndObject();
+					writer.EndObject();
+				}
+
+				writer.EndObject();
+				writer.EndObject();
+
+				std::ofstream file(in_path, std::ios::trunc);
+				if (!file.is_open())
+				{
+					return false;
+				}
+
+				file << buffer.GetString() << '\n';
+				return file.good();
+			}
+
+			void Reset()
+			{
+				std::lock_guard<std::mutex> lock(s_mutex);
+				for (auto& uri : s_uris)
+				{
+					uri.second->Reset();
+				}
+				s_timedOut.clear();
+				s_numTimedOut.store(0, std::memory_order_release);
+			}
+		}
+	}
+}
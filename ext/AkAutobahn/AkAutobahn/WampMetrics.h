@@ -0,0 +1,113 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <string>
+#include <vector>
+
+// Per-URI counters and latency histograms for WAMP requests.
+// Latency is measured in the session, from the request being queued for send to its RESULT/ERROR arriving.
+// Recording is lock free: counters are atomics and requests in flight sit in a PendingTable. The mutex is only
+// taken the first time a thread sees a URI, for timed out requests and for reports.
+
+namespace AK
+{
+	namespace WwiseAuthoringAPI
+	{
+		namespace WampMetrics
+		{
+			enum class RequestKind : uint8_t
+			{
+				Call,
+				Subscribe,
+				Unsubscribe
+			};
+
+			// Log-linear histogram in the style of HdrHistogram, values are microseconds.
+			// Values below LINEAR_BUCKETS are exact, above that each power of two is split into
+			// HALF_LINEAR_BUCKETS buckets (~6% precision). Values past 2^MAX_EXPONENT are clamped.
+			class LatencyHistogram
+			{
+			public:
+				static const uint32_t SUB_BUCKET_BITS = 5;
+				static const uint32_t LINEAR_BUCKETS = 1u << SUB_BUCKET_BITS;
+				static const uint32_t HALF_LINEAR_BUCKETS = LINEAR_BUCKETS / 2;
+				static const uint32_t MAX_EXPONENT = 40;
+				static const uint32_t NUM_BUCKETS = LINEAR_BUCKETS + (MAX_EXPONENT - SUB_BUCKET_BITS + 1) * HALF_LINEAR_BUCKETS;
+
+				LatencyHistogram();
+
+				// snapshot of counts recorded elsewhere, in_buckets has NUM_BUCKETS entries
+				LatencyHistogram(std::vector<uint64_t> in_buckets, uint64_t in_count, uint64_t in_sum, uint64_t in_min, uint64_t in_max);
+
+				void Record(uint64_t in_valueUs);
+
+				uint64_t GetCount() const { return m_count; }
+				uint64_t GetMin() const { return m_count ? m_min : 0; }
+				uint64_t GetMax() const { return m_max; }
+				double GetMean() const { return m_count ? static_cast<double>(m_sum) / m_count : 0.0; }
+
+				// upper bound of the bucket holding the percentile (0-100), never above the recorded max
+				uint64_t GetPercentile(double in_percentile) const;
+
+				static uint32_t GetBucketIndex(uint64_t in_valueUs);
+				static uint64_t GetBucketLowerBound(uint32_t in_index);
+				static uint64_t GetBucketUpperBound(uint32_t in_index);
+
+				const std::vector<uint64_t>& GetBuckets() const { return m_buckets; }
+
+			private:
+				std::vector<uint64_t> m_buckets;
+				uint64_t m_count;
+				uint64_t m_sum;
+				uint64_t m_min;
+				uint64_t m_max;
+			};
+
+			struct UriMetrics
+			{
+				uint64_t requests = 0;
+				uint64_t errors = 0;
+				uint64_t timeouts = 0;
+
+				// responses arriving after the caller stopped waiting
+				uint64_t lateResponses = 0;
+
+				uint64_t bytesSent = 0;
+				uint64_t bytesReceived = 0;
+
+				LatencyHistogram latency;
+			};
+
+			// Session side, called with the serialized request size once it is queued.
+			void OnRequestSent(uint64_t in_requestId, RequestKind in_kind, const std::string& in_uri, size_t in_bytesSent);
+
+			// Session side, called from the receive thread while handling a RESULT/ERROR/SUBSCRIBED/UNSUBSCRIBED.
+			// Uses the size set by SetInboundMessageBytes.
+			void OnResponse(uint64_t in_requestId, bool in_success);
+
+			// Session side, request dropped without a response (session stopped).
+			void OnAborted(uint64_t in_requestId);
+
+			// Size of the message the calling (receive) thread is handling.
+			void SetInboundMessageBytes(size_t in_bytes);
+
+			// Request id of the last request sent from the calling thread, so callers can report timeouts.
+			uint64_t GetLastRequestId();
+
+			// Client side, the caller gave up waiting. Only the latest timed out requests are kept to count late responses.
+			void OnTimedOut(uint64_t in_requestId);
+
+			// Snapshot of every URI, keys are the URI prefixed with the request kind for non-calls.
+			std::vector<std::pair<std::string, UriMetrics>> GetSnapshot();
+
+			// Human readable table, one line per URI.
+			std::string FormatReport();
+
+			// Machine readable report for monitoring.
+			bool WriteJson(const std::string& in_path);
+
+			void Reset();
+		}
+	}
+}
@@ -23,6 +23,8 @@ Copyright (c) 2020 Audiokinetic Inc.
 
 #include "AK/WwiseAuthoringAPI/AkAutobahn/IWebSocketClientHandler.h"
 
+#include "ReceivePool.h"
+
 namespace AK
 {
 	namespace WwiseAuthoringAPI
@@ -50,7 +52,11 @@ namespace AK
 			mg_context* ctx = mg_get_context(conn);
 			WebSocketClient* that = reinterpret_cast<WebSocketClient*>(mg_get_user_data(ctx));
 			AKASSERT(that != nullptr);
-			that->m_handler->OnMessage(std::string(data, data_len));
+
+			// the handler only reads the frame, so the thread's buffer (and its capacity) survives the call
+			std::string& frame = ReceivePool::AcquireFrame(data, data_len);
+			that->m_handler->OnMessage(std::move(frame));
+			ReceivePool::ReleaseFrame(frame);
 
 			return 1;
 		}
@@ -22,10 +22,13 @@
 
 #include "AK/WwiseAuthoringAPI/AkAutobahn/autobahn.h"
 
+#include <atomic>
 #include <cstdint>
 #include <cstdlib>
 #include <iostream>
 #include <map>
+#include <memory>
+#include <mutex>
 #include <sstream>
 #include <string>
 #include <vector>
@@ -34,8 +37,15 @@
 #include <rapidjson/writer.h>
 #include <rapidjson/stringbuffer.h>
 
+#include "AsyncLog.h"
 #include "JSONHelpers.h"
-#include "AK/WwiseAuthoringAPI/AkAutobahn/Logger.h"
+#include "PendingTable.h"
+#include "ReceivePool.h"
+#include "ResultView.h"
+#include "SendQueue.h"
+#include "Tracing.h"
+#include "WampCapture.h"
+#include "WampMetrics.h"
 
 #ifdef VALIDATE_WAMP
 #define WAMP_ASSERT(x, y) WampAssert((x), (y))
@@ -47,6 +57,87 @@ namespace AK
 {
 	namespace WwiseAuthoringAPI
 	{
+		// Serializes an outgoing message straight into the buffer the send thread takes ownership of,
+		// null terminated like the ones session::send(std::string) queues. Reserved for the size of the
+		// last message this thread sent, consecutive import batches are usually alike.
+		static std::shared_ptr<std::vector<char>> makeSendBuffer(const AkJson& in_jsonPayload)
+		{
+			thread_local size_t s_lastMessageSize = 0;
+
+			auto sendBuffer = std::make_shared<std::vector<char>>();
+			sendBuffer->reserve(s_lastMessageSize + 1);
+			JSONHelpers::AppendAkJsonText(in_jsonPayload, *sendBuffer);
+
+			s_lastMessageSize = sendBuffer->size();
+			sendBuffer->push_back('\0');
+			return sendBuffer;
+		}
+
+		static void pushSendBuffer(const void* in_session, SendQueue::Buffer in_sendBuffer)
+		{
+			WampCapture::RecordFrame(in_session, WampCapture::Direction::Sent, in_sendBuffer->data(), in_sendBuffer->size() - 1);
+
+			// no queue when the session isn't running, the message is dropped like stop() drops queued ones
+			SendQueues::Push(in_session, std::move(in_sendBuffer));
+		}
+
+		// Ids are unique across every session in the process, so pending tables and WampMetrics can be shared
+		static uint64_t nextRequestId()
+		{
+			static std::atomic<uint64_t> s_lastRequestId(0);
+			return ++s_lastRequestId;
+		}
+
+		static const size_t MAX_PENDING_REQUESTS = 1024;
+
+		typedef bool (*AbandonRequest)(uint64_t in_requestId, const void* in_owner);
+		static const size_t NUM_REQUEST_KINDS = 3;
+
+		// PendingTable<Entry>::Abandon of each table made so far, for PendingRequests::Abandon
+		static std::atomic<AbandonRequest> s_abandonRequest[NUM_REQUEST_KINDS];
+		static std::atomic<size_t> s_numRequestKinds(0);
+
+		static bool addRequestKind(AbandonRequest in_abandon)
+		{
+			s_abandonRequest[s_numRequestKinds.fetch_add(1)].store(in_abandon);
+			return true;
+		}
+
+		// One table per kind of request (call, subscribe, unsubscribe), shared by all sessions. Entry is
+		// the session's own request type, which only its member functions can name.
+		template <typename Entry>
+		static PendingTable<Entry>& pendingRequests()
+		{
+			static PendingTable<Entry> s_table(MAX_PENDING_REQUESTS);
+
+			// a request is always inserted through here first, so its table is known before it can be abandoned
+			static const bool s_added = addRequestKind([](uint64_t in_requestId, const void* in_owner)
+			{
+				return pendingRequests<Entry>().Abandon(in_requestId, in_owner);
+			});
+			(void)s_added;
+
+			return s_table;
+		}
+
+		void PendingRequests::Abandon(const void* in_session, uint64_t in_requestId)
+		{
+			// ids are unique across kinds, at most one table has it
+			for (const std::atomic<AbandonRequest>& abandon : s_abandonRequest)
+			{
+				const AbandonRequest function = abandon.load();
+				if (function && function(in_requestId, in_session))
+				{
+					return;
+				}
+			}
+		}
+
+		static void createTooManyRequestsErrorJson(AkJson& out_jsonError)
+		{
+			session::createErrorMessageJson("Too many WAMP requests waiting for a response.", out_jsonError);
+		}
+
 #ifdef VALIDATE_WAMP
 		void session::WampAssert(bool value, const char* message)
 		{
@@ -95,6 +186,14 @@ namespace AK
 			m_websocket = std::make_shared<WebSocketClient>(this);
 			connectResult = m_websocket->Connect(in_uri, in_port);
 
+			if (connectResult && !SendQueues::Acquire(this))
+			{
+				logMessage("Too many WAMP sessions running at once, could not start a send queue.");
+				m_websocket->Close();
+				m_websocket = nullptr;
+				connectResult = false;
+			}
+
 			if (connectResult)
 			{
 				m_running = true;
@@ -112,11 +211,11 @@ namespace AK
 			bool expected = true;
 			if (m_running.compare_exchange_strong(expected, false))
 			{
+				// Wake the send thread up, so it terminates.
+				SendQueue* sendQueue = SendQueues::Find(this);
+				if (sendQueue)
 				{
-					std::lock_guard<std::mutex> lock(m_sendQueueMutex);
-					m_sendQueue = decltype(m_sendQueue)();
-					// Wake the send thread up, so it terminates.
-					m_sendEvent.notify_one();
+					sendQueue->Wake();
 				}
 
 				// Stop the threads.
@@ -125,38 +224,37 @@ namespace AK
 				else if (m_sendThread.joinable())
 					m_sendThread.join();
 
+				// anything still queued is dropped
+				SendQueues::Release(this);
+
 				if (m_websocket != nullptr)
 				{
 					m_websocket->Close();
 					m_websocket = nullptr;
 				}
 
-				std::lock_guard<std::mutex> lockCalls(m_callsMutex);
-				std::lock_guard<std::mutex> lockSubs(m_subreqMutex);
-				std::lock_guard<std::mutex> lockUnsubs(m_unsubreqMutex);
-
 				AkJson jsonError;
 				createErrorMessageJson(errorMessage, jsonError);
 
 				// Abort all pending requests.
-				for (auto& call : m_calls)
+				pendingRequests<call_t>().CompleteAll(this, [&jsonError](uint64_t request_id, call_t& call)
 				{
-					call.second.m_res.set_value(result_t(false, jsonError));
-				}
+					WAAPI_TRACE_ASYNC_END("waapi", "call", request_id);
+					WampMetrics::OnAborted(request_id);
+					call.m_res.set_value(result_t(false, jsonError));
+				});
 
-				for (auto& sub_req : m_subscribe_requests)
+				pendingRequests<subscribe_request_t>().CompleteAll(this, [&jsonError](uint64_t request_id, subscribe_request_t& sub_req)
 				{
-					sub_req.second.m_res.set_value(subscription(jsonError));
-				}
+					WampMetrics::OnAborted(request_id);
+					sub_req.m_res.set_value(subscription(jsonError));
+				});
 
-				for (auto& unsub_req : m_unsubscribe_requests)
+				pendingRequests<unsubscribe_request_t>().CompleteAll(this, [&jsonError](uint64_t request_id, unsubscribe_request_t& unsub_req)
 				{
-					unsub_req.second.m_res.set_value(result_t(false, jsonError));
-				}
-
-				m_calls.clear();
-				m_subscribe_requests.clear();
-				m_unsubscribe_requests.clear();
+					WampMetrics::OnAborted(request_id);
+					unsub_req.m_res.set_value(result_t(false, jsonError));
+				});
 
 				m_session_id = 0;
 			}
@@ -233,22 +331,30 @@ namespace AK
 				return false;
 			}
 
-			std::lock_guard<std::mutex> lock(m_subreqMutex);
-
-			m_request_id += 1;
-			m_subscribe_requests.insert(std::make_pair(m_request_id, subscribe_request_t(handler)));
+			const uint64_t request_id = nextRequestId();
 
 			AkJson jsonPayload(AkJson::Array
 			{
 				AkJson(AkVariant(static_cast<int>(msg_code::SUBSCRIBE))),
-				AkJson(AkVariant(m_request_id)),
+				AkJson(AkVariant(request_id)),
 				AkJson(options),
 				AkJson(AkVariant(topic))
 			});
 
-			send(jsonPayload);
+			auto sendBuffer = makeSendBuffer(jsonPayload);
+
+			if (!pendingRequests<subscribe_request_t>().Insert(request_id, this, [&](subscribe_request_t& sub_req)
+				{
+					sub_req = subscribe_request_t(handler);
+					out_future = sub_req.m_res.get_future();
+				}))
+			{
+				createTooManyRequestsErrorJson(out_jsonError);
+				return false;
+			}
 
-			out_future = m_subscribe_requests[m_request_id].m_res.get_future();
+			WampMetrics::OnRequestSent(request_id, WampMetrics::RequestKind::Subscribe, topic, sendBuffer->size() - 1);
+			pushSendBuffer(this, std::move(sendBuffer));
 			return true;
 		}
 		
@@ -262,21 +368,28 @@ namespace AK
 				return false;
 			}
 
-			std::lock_guard<std::mutex> lock(m_unsubreqMutex);
-
-			++m_request_id;
-			m_unsubscribe_requests.insert(std::make_pair(m_request_id, unsubscribe_request_t()));
+			const uint64_t request_id = nextRequestId();
 
 			AkJson jsonPayload(AkJson::Array
 			{
 				AkVariant(static_cast<int>(msg_code::UNSUBSCRIBE)),
-				AkVariant(m_request_id),
+				AkVariant(request_id),
 				AkVariant(subscription_id)
 			});
 
-			send(jsonPayload);
+			auto sendBuffer = makeSendBuffer(jsonPayload);
 
-			out_future = m_unsubscribe_requests[m_request_id].m_res.get_future();
+			if (!pendingRequests<unsubscribe_request_t>().Insert(request_id, this, [&](unsubscribe_request_t& unsub_req)
+				{
+					out_future = unsub_req.m_res.get_future();
+				}))
+			{
+				createTooManyRequestsErrorJson(out_jsonError);
+				return false;
+			}
+
+			WampMetrics::OnRequestSent(request_id, WampMetrics::RequestKind::Unsubscribe, std::string(), sendBuffer->size() - 1);
+			pushSendBuffer(this, std::move(sendBuffer));
 			return true;
 		}
 
@@ -305,10 +418,7 @@ namespace AK
 				return false;
 			}
 
-			std::lock_guard<std::mutex> lock(m_callsMutex);
-
-			m_request_id += 1;
-			m_calls.insert(std::make_pair(m_request_id, call_t()));
+			const uint64_t request_id = nextRequestId();
 
 			// [CALL, Request|id, Options|dict, Procedure|uri, Arguments|list, ArgumentsKw|dict]
 
@@ -322,16 +432,36 @@ namespace AK
 			AkJson jsonPayload(AkJson::Array
 			{
 				AkVariant(static_cast<int>(msg_code::CALL)),
-				AkVariant(m_request_id),
+				AkVariant(request_id),
 				options,
 				AkVariant(procedure),
 				jsonArgs,
 				kwargs
 			});
 
-			send(jsonPayload);
+			auto sendBuffer = makeSendBuffer(jsonPayload);
 
-			out_future = m_calls[m_request_id].m_res.get_future();
+			if (!pendingRequests<call_t>().Insert(request_id, this, [&out_future](call_t& call)
+				{
+					out_future = call.m_res.get_future();
+				}))
+			{
+				ResultViews::ClaimNextCall();
+				createTooManyRequestsErrorJson(out_jsonError);
+				return false;
+			}
+
+			// registered before sending so got_msg can't see the RESULT first
+			if (ResultViews::ClaimNextCall())
+			{
+				ResultViews::Register(this, request_id);
+			}
+
+			// round trip ends in process_call_result or process_error
+			WAAPI_TRACE_ASYNC_BEGIN("waapi", "call", request_id, procedure.c_str());
+
+			WampMetrics::OnRequestSent(request_id, WampMetrics::RequestKind::Call, procedure, sendBuffer->size() - 1);
+			pushSendBuffer(this, std::move(sendBuffer));
 			return true;
 		}
 
@@ -408,45 +538,50 @@ namespace AK
 
 			errorJson.GetMap()["uri"] = msg[4].GetVariant();
 
-			switch (static_cast<msg_code>(static_cast<int64_t>(msg[1].GetVariant())))
+			const uint64_t request_id = msg[2].GetVariant();
+
+			const msg_code requestKind = static_cast<msg_code>(static_cast<int64_t>(msg[1].GetVariant()));
+			bool pending = true;
+
+			switch (requestKind)
 			{
 			case msg_code::SUBSCRIBE:
-			{
-				std::lock_guard<std::mutex> lock(m_subreqMutex);
-				auto subscribe_request = m_subscribe_requests.find(msg[2].GetVariant());
-				if (subscribe_request != m_subscribe_requests.end())
+				pending = pendingRequests<subscribe_request_t>().Complete(request_id, this, [&](subscribe_request_t& sub_req)
 				{
-					subscribe_request->second.m_res.set_value(subscription(errorJson));
-					m_subscribe_requests.erase(subscribe_request);
-				}
-			}
-			break;
+					WampMetrics::OnResponse(request_id, false);
+					sub_req.m_res.set_value(subscription(errorJson));
+				});
+				break;
+
 			case msg_code::UNSUBSCRIBE:
-			{
-				std::lock_guard<std::mutex> lock(m_unsubreqMutex);
-				auto unsubscribe_request = m_unsubscribe_requests.find(msg[2].GetVariant());
-				if (unsubscribe_request != m_unsubscribe_requests.end())
+				pending = pendingRequests<unsubscribe_request_t>().Complete(request_id, this, [&](unsubscribe_request_t& unsub_req)
 				{
-					unsubscribe_request->second.m_res.set_value(result_t(false, errorJson));
-					m_unsubscribe_requests.erase(unsubscribe_request);
-				}
-			}
-			break;
+					WampMetrics::OnResponse(request_id, false);
+					unsub_req.m_res.set_value(result_t(false, errorJson));
+				});
+				break;
+
 			case msg_code::CALL:
-			{
-				std::lock_guard<std::mutex> lock(m_callsMutex);
-				auto call_req = m_calls.find(msg[2].GetVariant());
-				if (call_req != m_calls.end())
+				pending = pendingRequests<call_t>().Complete(request_id, this, [&](call_t& call)
 				{
-					call_req->second.m_res.set_value(result_t(false, errorJson));
-					m_calls.erase(call_req);
-				}
-			}
-			break;
+					WAAPI_TRACE_ASYNC_END("waapi", "call", request_id);
+					WampMetrics::OnResponse(request_id, false);
+					call.m_res.set_value(result_t(false, errorJson));
+				});
+				break;
 
 			default:
 				WAMP_ASSERT(false, "ERROR not handled");
 			}
+
+			if (!pending)
+			{
+				if (requestKind == msg_code::CALL)
+				{
+					WAAPI_TRACE_ASYNC_END("waapi", "call", request_id);
+				}
+				WampMetrics::OnResponse(request_id, false);
+			}
 		}
 
 		void session::process_goodbye(const wamp_msg_t& msg)
@@ -502,29 +637,29 @@ namespace AK
 
 			uint64_t request_id = msg[1].GetVariant();
 
-			std::lock_guard<std::mutex> lock(m_callsMutex);
-
-			calls_t::iterator call = m_calls.find(request_id);
-			
-			if (call != m_calls.end())
+			const bool pending = pendingRequests<call_t>().Complete(request_id, this, [&](call_t& call)
 			{
+				WAAPI_TRACE_ASYNC_END("waapi", "call", request_id);
+				WampMetrics::OnResponse(request_id, true);
+
 				if (msg.GetArray().size() > 4)
 				{
 					auto args = msg[4];
 					WAMP_ASSERT(args.IsMap(), "RESULT wamp message is invalid - ArgumentsKw");
-					call->second.m_res.set_value(result_t(true, args));
+					call.m_res.set_value(result_t(true, args));
 				}
 				else
 				{
 					// empty result
-					call->second.m_res.set_value(result_t(true, AkJson(AkJson::Type::Map)));
+					call.m_res.set_value(result_t(true, AkJson(AkJson::Type::Map)));
 				}
+			});
 
-				m_calls.erase(call);
-			}
-			else
+			if (!pending)
 			{
-				WAMP_ASSERT(false, "bogus RESULT message for non-pending request ID");
+				// the caller abandoned it (or the id is bogus), only the trace and the metrics still see it
+				WAAPI_TRACE_ASYNC_END("waapi", "call", request_id);
+				WampMetrics::OnResponse(request_id, true);
 			}
 		}
 
@@ -541,26 +676,23 @@ namespace AK
 
 			uint64_t request_id = msg[1].GetVariant();
 
-			std::lock_guard<std::mutex> lock(m_subreqMutex);
-
-			subscribe_requests_t::iterator subscribe_request = m_subscribe_requests.find(request_id);
-
-			if (subscribe_request != m_subscribe_requests.end())
+			const bool pending = pendingRequests<subscribe_request_t>().Complete(request_id, this, [&](subscribe_request_t& sub_req)
 			{
 				uint64_t subscription_id = msg[2].GetVariant();
 
+				WampMetrics::OnResponse(request_id, true);
+
 				{
 					std::lock_guard<std::mutex> lock(m_handlersMutex);
-					m_handlers[subscription_id] = subscribe_request->second.m_handler;
+					m_handlers[subscription_id] = sub_req.m_handler;
 				}
 
-				subscribe_request->second.m_res.set_value(subscription(subscription_id));
+				sub_req.m_res.set_value(subscription(subscription_id));
+			});
 
-				m_subscribe_requests.erase(subscribe_request);
-			}
-			else
+			if (!pending)
 			{
-				WAMP_ASSERT(false, "bogus SUBSCRIBED message for non-pending request ID");
+				WampMetrics::OnResponse(request_id, true);
 			}
 		}
 
@@ -576,18 +708,15 @@ namespace AK
 
 			uint64_t request_id = msg[1].GetVariant();
 
-			std::lock_guard<std::mutex> lock(m_unsubreqMutex);
-
-			auto unsubscribe_request = m_unsubscribe_requests.find(request_id);
-
-			if (unsubscribe_request != m_unsubscribe_requests.end())
+			const bool pending = pendingRequests<unsubscribe_request_t>().Complete(request_id, this, [&](unsubscribe_request_t& unsub_req)
 			{
-				unsubscribe_request->second.m_res.set_value(result_t(true, AkJson(AkJson::Type::Map)));
-				m_unsubscribe_requests.erase(unsubscribe_request);
-			}
-			else
+				WampMetrics::OnResponse(request_id, true);
+				unsub_req.m_res.set_value(result_t(true, AkJson(AkJson::Type::Map)));
+			});
+
+			if (!pending)
 			{
-				WAMP_ASSERT(false, "bogus UNSUBSCRIBED message for non-pending request ID");
+				WampMetrics::OnResponse(request_id, true);
 			}
 		}
 		
@@ -641,21 +770,46 @@ namespace AK
 
 		void session::got_msg(const std::string& jsonPayload)
 		{
+			WAAPI_TRACE_SCOPE("waapi", "got_msg");
+			WampMetrics::SetInboundMessageBytes(jsonPayload.size());
+			WampCapture::RecordFrame(this, WampCapture::Direction::Received, jsonPayload.data(), jsonPayload.size());
+
+			// Results for ResultViews::Call are routed on the header alone, the caller reads them from the
+			// view and the call completes with an empty result. Everything else is decoded to AkJson.
+			int64_t headerCode = 0;
+			uint64_t headerRequestId = 0;
+			if (ResultViews::PeekHeader(jsonPayload, headerCode, headerRequestId) &&
+				headerCode == static_cast<int64_t>(msg_code::RESULT) &&
+				ResultViews::Deliver(this, headerRequestId, jsonPayload))
+			{
+				process_call_result(wamp_msg_t(AkJson::Array
+				{
+					AkVariant(static_cast<int>(msg_code::RESULT)),
+					AkVariant(headerRequestId),
+					AkJson(AkJson::Type::Map)
+				}));
+				return;
+			}
+
 			wamp_msg_t msg;
-			rapidjson::Document doc;
+			{
+				// the parse arena is handed back before dispatching, handlers may end up parsing themselves
+				ReceivePool::ParseScope parse;
+				ReceivePool::Document& doc = parse.GetDocument();
 
-			// Disregard ParseResult other content and directly cast, we just want to know if it worked at all.
-			bool hasErrors = doc.Parse(jsonPayload.c_str()).HasParseError();
+				// Disregard ParseResult other content and directly cast, we just want to know if it worked at all.
+				bool hasErrors = doc.Parse(jsonPayload.c_str()).HasParseError();
 
-			WAMP_ASSERT((
-				!hasErrors
-				), "WebSocket received payload is not a valid JSON");
+				WAMP_ASSERT((
+					!hasErrors
+					), "WebSocket received payload is not a valid JSON");
 
-			bool fromRapidJsonResult = JSONHelpers::FromRapidJson(doc, msg);
+				bool fromRapidJsonResult = JSONHelpers::FromRapidJson(doc, msg);
 
-			WAMP_ASSERT((
-				fromRapidJsonResult
-				), "WebSocket received JSON payload contains invalid data");
+				WAMP_ASSERT((
+					fromRapidJsonResult
+					), "WebSocket received JSON payload contains invalid data");
+			}
 
 			WAMP_ASSERT((
 				msg.IsArray() &&
@@ -764,16 +918,12 @@ namespace AK
 
 		void session::send(const AkJson& jsonPayload)
 		{
-			send(JSONHelpers::GetAkJsonString(jsonPayload).c_str());
+			pushSendBuffer(this, makeSendBuffer(jsonPayload));
 		}
 
 		void session::send(std::string s)
 		{
-			auto sendBuffer = std::make_shared<std::vector<char>>(s.c_str(), s.c_str() + s.length() + 1);
-
-			std::lock_guard<std::mutex> lock(m_sendQueueMutex);
-			m_sendQueue.push(sendBuffer);
-			m_sendEvent.notify_one();
+			pushSendBuffer(this, std::make_shared<std::vector<char>>(s.c_str(), s.c_str() + s.length() + 1));
 		}
 		
 		void session::OnMessage(std::string&& message)
@@ -799,50 +949,73 @@ namespace AK
 
 		void session::logMessage(const char* logContent)
 		{
-			Logger::Get()->LogMessage("AkAutobahn", logContent);
+			AsyncLog::Write(AsyncLog::Severity::Warning, "AkAutobahn", logContent);
 		}
 
 		void session::sendThread()
 		{
-			bool started = false;
+			WAAPI_TRACE_THREAD_NAME("WAMP send");
+
+			// acquired by start() before this thread was created
+			SendQueue* sendQueue = SendQueues::Find(this);
+			m_send_thread_started.set_value(true);
+
+			if (!sendQueue)
+			{
+				return;
+			}
+
+			// SendUTF8 takes a std::string, reuse one so each message is a copy but not an allocation
+			std::string message;
+
+			// everything ready at wake up is written under one websocket lock. civetweb has no vectored
+			// write for client frames (each one is masked separately), so it is still a write per frame.
+			static const size_t MAX_BATCH = 64;
+			std::vector<SendQueue::Buffer> batch;
+			batch.reserve(MAX_BATCH);
+
 			while (m_running && m_websocket)
 			{
-				std::unique_lock<std::mutex> lock(m_sendQueueMutex);
-				if (!started)
+				sendQueue->Wait([this] { return !m_running; });
+
+				SendQueue::Buffer sendBuffer;
+				while (batch.size() < MAX_BATCH && sendQueue->Pop(sendBuffer))
+				{
+					batch.push_back(std::move(sendBuffer));
+				}
+
+				if (batch.empty())
 				{
-					m_send_thread_started.set_value(true);
-					started = true;
+					continue;
 				}
-				m_sendEvent.wait(lock);
 
-				while (m_running && m_websocket && m_sendQueue.size())
+				std::string errorMessage;
 				{
-					auto sendBuffer = m_sendQueue.front();
-					lock.unlock();
+					WAAPI_TRACE_SCOPE("waapi", "SendUTF8");
+					std::lock_guard<std::recursive_mutex> websocketLock(m_websocketMutex);
 
-					std::string errorMessage;
-					bool result = false;
+					if (!m_websocket)
 					{
-						std::lock_guard<std::recursive_mutex> websocketLock(m_websocketMutex);
-						
-						if (!m_websocket)
+						return;
+					}
+
+					for (const SendQueue::Buffer& buffer : batch)
+					{
+						if (!m_running)
 						{
 							return;
 						}
-						if (!m_websocket->SendUTF8(std::string(sendBuffer->data()), errorMessage))
+
+						message.assign(buffer->data(), buffer->size() - 1);
+						if (!m_websocket->SendUTF8(message, errorMessage))
 						{
 							stop(errorMessage);
 							return;
 						}
 					}
-
-					lock.lock();
-					// Queue could have been cleared by another thread.
-					if (m_sendQueue.size())
-					{
-						m_sendQueue.pop();
-					}
 				}
+
+				batch.clear();
 			}
 		}
 	}
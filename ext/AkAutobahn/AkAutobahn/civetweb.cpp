@@ -12613,6 +12613,16 @@ mg_connect_client_impl(const struct mg_client_options *client_options,
 		conn->client.sock = sock;
 		conn->client.lsa = sa;
 
+		/* WAAPI: websocket frames are written as a header and then the
+		 * payload. With Nagle's algorithm the payload waits for the server's
+		 * delayed ACK of the header, which adds up to 40ms to every call. */
+		if (set_tcp_nodelay(sock, 1) != 0) {
+			mg_cry(conn,
+			       "%s: setsockopt(IPPROTO_TCP TCP_NODELAY) failed: %s",
+			       __func__,
+			       strerror(ERRNO));
+		}
+
 		if (getsockname(sock, psa, &len) != 0) {
 			mg_cry(conn,
 			       "%s: getsockname() failed: %s",
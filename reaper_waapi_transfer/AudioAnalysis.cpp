@@ -0,0 +1,899 @@
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <Windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <thread>
+
+#include <rapidjson/document.h>
+#include <rapidjson/prettywriter.h>
+#include <rapidjson/stringbuffer.h>
+
+#include "AudioAnalysis.h"
+#include "Tracing.h"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define WT_ANALYSIS_SSE2 1
+#include <emmintrin.h>
+#endif
+
+//frames converted and analysed at a time
+static const size_t ANALYSIS_BLOCK_FRAMES = 4096;
+
+//true peak interpolator, 4 phases of 12 taps. Each output needs the 11 samples before it
+static const size_t TRUE_PEAK_PHASES = 4;
+static const size_t TRUE_PEAK_TAPS = 12;
+static const size_t TRUE_PEAK_HISTORY = TRUE_PEAK_TAPS - 1;
+
+//read only view of a whole file, the os pages it in as it's read
+class MappedFile
+{
+public:
+    explicit MappedFile(const fs::path &path)
+    {
+#ifdef _WIN32
+        m_file = CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                             FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+        LARGE_INTEGER fileSize;
+        if (m_file == INVALID_HANDLE_VALUE || !GetFileSizeEx(m_file, &fileSize) || !fileSize.QuadPart)
+        {
+            return;
+        }
+
+        m_mapping = CreateFileMappingW(m_file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (m_mapping)
+        {
+            m_data = static_cast<const uint8_t*>(MapViewOfFile(m_mapping, FILE_MAP_READ, 0, 0, 0));
+            m_size = m_data ? static_cast<size_t>(fileSize.QuadPart) : 0;
+        }
+#else
+        m_file = open(path.c_str(), O_RDONLY);
+        struct stat fileStat;
+        if (m_file < 0 || fstat(m_file, &fileStat) || !fileStat.st_size)
+        {
+            return;
+        }
+
+        void *data = mmap(nullptr, static_cast<size_t>(fileStat.st_size), PROT_READ, MAP_PRIVATE, m_file, 0);
+        if (data != MAP_FAILED)
+        {
+            madvise(data, static_cast<size_t>(fileStat.st_size), MADV_SEQUENTIAL);
+            m_data = static_cast<const uint8_t*>(data);
+            m_size = static_cast<size_t>(fileStat.st_size);
+        }
+#endif
+    }
+
+    ~MappedFile()
+    {
+#ifdef _WIN32
+        if (m_data)
+        {
+            UnmapViewOfFile(m_data);
+        }
+        if (m_mapping)
+        {
+            CloseHandle(m_mapping);
+        }
+        if (m_file != INVALID_HANDLE_VALUE)
+        {
+            CloseHandle(m_file);
+        }
+#else
+        if (m_data)
+        {
+            munmap(const_cast<uint8_t*>(m_data), m_size);
+        }
+        if (m_file >= 0)
+        {
+            close(m_file);
+        }
+#endif
+    }
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile &operator=(const MappedFile&) = delete;
+
+    //nullptr if the file couldn't be mapped or is empty
+    const uint8_t *GetData() const { return m_data; }
+    size_t GetSize() const { return m_size; }
+
+private:
+#ifdef _WIN32
+    HANDLE m_file = INVALID_HANDLE_VALUE;
+    HANDLE m_mapping = nullptr;
+#else
+    int m_file = -1;
+#endif
+    const uint8_t *m_data = nullptr;
+    size_t m_size = 0;
+};
+
+enum class SampleFormat
+{
+    Int16,
+    Int24,
+    Int32,
+    Float32
+};
+
+struct WavData
+{
+    SampleFormat format = SampleFormat::Int16;
+    uint32 numChannels = 0;
+    uint32 sampleRate = 0;
+    const uint8_t *samples = nullptr;
+    uint64_t numFrames = 0;
+};
+
+template <typename T>
+static T ReadLittleEndian(const uint8_t *data)
+{
+    //wavs and every platform the plugin runs on are little endian
+    T value;
+    memcpy(&value, data, sizeof(value));
+    return value;
+}
+
+static bool ParseWav(const uint8_t *file, size_t size, WavData &wavOut, std::string &errorOut)
+{
+    if (size < 12 || (memcmp(file, "RIFF", 4) && memcmp(file, "RF64", 4)) || memcmp(file + 8, "WAVE", 4))
+    {
+        errorOut = "not a wav file";
+        return false;
+    }
+
+    bool hasFmt = false;
+    uint16 formatTag = 0;
+    uint16 bitsPerSample = 0;
+
+    size_t offset = 12;
+    while (offset + 8 <= size)
+    {
+        const uint8_t *chunk = file + offset;
+        const uint64_t chunkSize = ReadLittleEndian<uint32>(chunk + 4);
+
+        if (!memcmp(chunk, "fmt ", 4) && chunkSize >= 16 && offset + 8 + 16 <= size)
+        {
+            hasFmt = true;
+            formatTag = ReadLittleEndian<uint16>(chunk + 8);
+            wavOut.numChannels = ReadLittleEndian<uint16>(chunk + 10);
+            wavOut.sampleRate = ReadLittleEndian<uint32>(chunk + 12);
+            bitsPerSample = ReadLittleEndian<uint16>(chunk + 22);
+
+            //WAVE_FORMAT_EXTENSIBLE, the sub format starts with the format tag
+            if (formatTag == 0xFFFE && chunkSize >= 40 && offset + 8 + 40 <= size)
+            {
+                formatTag = ReadLittleEndian<uint16>(chunk + 32);
+            }
+        }
+        else if (!memcmp(chunk, "data", 4))
+        {
+            //RF64 and unfinished files don't have the real size here, the data goes to the end of the file then
+            const uint64_t available = size - offset - 8;
+            const uint64_t dataSize = chunkSize == 0xFFFFFFFF ? available : std::min(chunkSize, available);
+
+            if (!hasFmt)
+            {
+                errorOut = "no fmt chunk before the data";
+                return false;
+            }
+
+            if (!wavOut.numChannels)
+            {
+                errorOut = "no channels";
+                return false;
+            }
+
+            if (formatTag == 1 && bitsPerSample == 16)      wavOut.format = SampleFormat::Int16;
+            else if (formatTag == 1 && bitsPerSample == 24) wavOut.format = SampleFormat::Int24;
+            else if (formatTag == 1 && bitsPerSample == 32) wavOut.format = SampleFormat::Int32;
+            else if (formatTag == 3 && bitsPerSample == 32) wavOut.format = SampleFormat::Float32;
+            else
+            {
+                errorOut = "unsupported sample format (" + std::to_string(formatTag) + ", "
+                           + std::to_string(bitsPerSample) + " bit)";
+                return false;
+            }
+
+            if (!wavOut.sampleRate)
+            {
+                errorOut = "sample rate is 0";
+                return false;
+            }
+
+            wavOut.samples = chunk + 8;
+            wavOut.numFrames = dataSize / (wavOut.numChannels * (bitsPerSample / 8));
+            return true;
+        }
+
+        //chunks are padded to an even size
+        offset += 8 + static_cast<size_t>(chunkSize) + (chunkSize & 1);
+    }
+
+    errorOut = "no data chunk";
+    return false;
+}
+
+static void ConvertInt16(const uint8_t *source, float *destination, size_t numSamples)
+{
+    const float scale = 1.0f / 32768.0f;
+    size_t i = 0;
+#ifdef WT_ANALYSIS_SSE2
+    const __m128 scaleVector = _mm_set1_ps(scale);
+    for (; i + 8 <= numSamples; i += 8)
+    {
+        const __m128i samples = _mm_loadu_si128(reinterpret_cast<const __m128i*>(source + i * 2));
+
+        //each sample into the top half of a 32 bit lane and shifted back down to sign extend it
+        const __m128i low = _mm_srai_epi32(_mm_unpacklo_epi16(samples, samples), 16);
+        const __m128i high = _mm_srai_epi32(_mm_unpackhi_epi16(samples, samples), 16);
+        _mm_storeu_ps(destination + i, _mm_mul_ps(_mm_cvtepi32_ps(low), scaleVector));
+        _mm_storeu_ps(destination + i + 4, _mm_mul_ps(_mm_cvtepi32_ps(high), scaleVector));
+    }
+#endif
+    for (; i < numSamples; ++i)
+    {
+        destination[i] = ReadLittleEndian<int16_t>(source + i * 2) * scale;
+    }
+}
+
+static void ConvertInt24(const uint8_t *source, float *destination, size_t numSamples)
+{
+    const float scale = 1.0f / 8388608.0f;
+    for (size_t i = 0; i < numSamples; ++i)
+    {
+        const uint8_t *sample = source + i * 3;
+        const int32_t value = static_cast<int32_t>(static_cast<uint32>(sample[0]) << 8
+                                                   | static_cast<uint32>(sample[1]) << 16
+                                                   | static_cast<uint32>(sample[2]) << 24) >> 8;
+        destination[i] = value * scale;
+    }
+}
+
+static void ConvertInt32(const uint8_t *source, float *destination, size_t numSamples)
+{
+    const float scale = 1.0f / 2147483648.0f;
+    size_t i = 0;
+#ifdef WT_ANALYSIS_SSE2
+    const __m128 scaleVector = _mm_set1_ps(scale);
+    for (; i + 4 <= numSamples; i += 4)
+    {
+        const __m128i samples = _mm_loadu_si128(reinterpret_cast<const __m128i*>(source + i * 4));
+        _mm_storeu_ps(destination + i, _mm_mul_ps(_mm_cvtepi32_ps(samples), scaleVector));
+    }
+#endif
+    for (; i < numSamples; ++i)
+    {
+        destination[i] = ReadLittleEndian<int32_t>(source + i * 4) * scale;
+    }
+}
+
+//largest magnitude and sum of squares of samples
+static void AccumulateLevels(const float *samples, size_t numSamples, float &peakInOut, double &sumSquaresInOut)
+{
+    size_t i = 0;
+    float peak = peakInOut;
+    double sumSquares = 0.0;
+#ifdef WT_ANALYSIS_SSE2
+    const __m128 absMask = _mm_castsi128_ps(_mm_set1_epi32(0x7FFFFFFF));
+    __m128 peakVector = _mm_set1_ps(peak);
+    __m128 squaresVector = _mm_setzero_ps();
+    for (; i + 4 <= numSamples; i += 4)
+    {
+        const __m128 x = _mm_loadu_ps(samples + i);
+        peakVector = _mm_max_ps(peakVector, _mm_and_ps(x, absMask));
+        squaresVector = _mm_add_ps(squaresVector, _mm_mul_ps(x, x));
+    }
+
+    float lanes[4];
+    _mm_storeu_ps(lanes, peakVector);
+    peak = std::max(std::max(lanes[0], lanes[1]), std::max(lanes[2], lanes[3]));
+    _mm_storeu_ps(lanes, squaresVector);
+    sumSquares = static_cast<double>(lanes[0]) + lanes[1] + lanes[2] + lanes[3];
+#endif
+    for (; i < numSamples; ++i)
+    {
+        peak = std::max(peak, std::fabs(samples[i]));
+        sumSquares += static_cast<double>(samples[i]) * samples[i];
+    }
+
+    peakInOut = peak;
+    sumSquaresInOut += sumSquares;
+}
+
+//polyphase 4x interpolator from a 48 tap windowed sinc, every phase scaled to unity gain at DC.
+//Stored newest sample first so output n of a phase is the dot product with samples n..n+11
+struct TruePeakFilter
+{
+    float taps[TRUE_PEAK_PHASES][TRUE_PEAK_TAPS];
+#ifdef WT_ANALYSIS_SSE2
+    //every tap in all four lanes
+    __m128 broadcastTaps[TRUE_PEAK_PHASES][TRUE_PEAK_TAPS];
+#endif
+
+    TruePeakFilter()
+    {
+        const double pi = 3.14159265358979323846;
+        const size_t length = TRUE_PEAK_PHASES * TRUE_PEAK_TAPS;
+        const double center = (length - 1) / 2.0;
+
+        for (size_t phase = 0; phase < TRUE_PEAK_PHASES; ++phase)
+        {
+            double coefficients[TRUE_PEAK_TAPS];
+            double sum = 0.0;
+            for (size_t tap = 0; tap < TRUE_PEAK_TAPS; ++tap)
+            {
+                const size_t n = tap * TRUE_PEAK_PHASES + phase;
+                const double t = (n - center) / TRUE_PEAK_PHASES;
+                const double sinc = std::sin(pi * t) / (pi * t);
+                const double window = 0.5 - 0.5 * std::cos(2.0 * pi * (n + 0.5) / length);
+                coefficients[tap] = sinc * window;
+                sum += coefficients[tap];
+            }
+
+            for (size_t tap = 0; tap < TRUE_PEAK_TAPS; ++tap)
+            {
+                taps[phase][TRUE_PEAK_TAPS - 1 - tap] = static_cast<float>(coefficients[tap] / sum);
+            }
+#ifdef WT_ANALYSIS_SSE2
+            for (size_t tap = 0; tap < TRUE_PEAK_TAPS; ++tap)
+            {
+                broadcastTaps[phase][tap] = _mm_set1_ps(taps[phase][tap]);
+            }
+#endif
+        }
+    }
+};
+
+//largest magnitude of the interpolated signal, samples has TRUE_PEAK_HISTORY samples before the numSamples new ones
+static float TruePeak(const TruePeakFilter &filter, const float *samples, size_t numSamples)
+{
+    float peak = 0.0f;
+    size_t i = 0;
+#ifdef WT_ANALYSIS_SSE2
+    //four outputs of every phase at a time, each load of samples feeds all four phases. No horizontal sums
+    static_assert(TRUE_PEAK_PHASES == 4, "one accumulator per phase");
+    const __m128 absMask = _mm_castsi128_ps(_mm_set1_epi32(0x7FFFFFFF));
+    __m128 peakVector = _mm_setzero_ps();
+    for (; i + 4 <= numSamples; i += 4)
+    {
+        __m128 sum0 = _mm_setzero_ps();
+        __m128 sum1 = _mm_setzero_ps();
+        __m128 sum2 = _mm_setzero_ps();
+        __m128 sum3 = _mm_setzero_ps();
+        for (size_t tap = 0; tap < TRUE_PEAK_TAPS; ++tap)
+        {
+            const __m128 x = _mm_loadu_ps(samples + i + tap);
+            sum0 = _mm_add_ps(sum0, _mm_mul_ps(filter.broadcastTaps[0][tap], x));
+            sum1 = _mm_add_ps(sum1, _mm_mul_ps(filter.broadcastTaps[1][tap], x));
+            sum2 = _mm_add_ps(sum2, _mm_mul_ps(filter.broadcastTaps[2][tap], x));
+            sum3 = _mm_add_ps(sum3, _mm_mul_ps(filter.broadcastTaps[3][tap], x));
+        }
+
+        const __m128 peak01 = _mm_max_ps(_mm_and_ps(sum0, absMask), _mm_and_ps(sum1, absMask));
+        const __m128 peak23 = _mm_max_ps(_mm_and_ps(sum2, absMask), _mm_and_ps(sum3, absMask));
+        peakVector = _mm_max_ps(peakVector, _mm_max_ps(peak01, peak23));
+    }
+
+    float lanes[4];
+    _mm_storeu_ps(lanes, peakVector);
+    peak = std::max(std::max(lanes[0], lanes[1]), std::max(lanes[2], lanes[3]));
+#endif
+    for (; i < numSamples; ++i)
+    {
+        for (size_t phase = 0; phase < TRUE_PEAK_PHASES; ++phase)
+        {
+            float sum = 0.0f;
+            for (size_t tap = 0; tap < TRUE_PEAK_TAPS; ++tap)
+            {
+                sum += filter.taps[phase][tap] * samples[i + tap];
+            }
+            peak = std::max(peak, std::fabs(sum));
+        }
+    }
+    return peak;
+}
+
+struct Biquad
+{
+    double b0, b1, b2, a1, a2;
+};
+
+//state of one channel's K-weighting filters (z1, z2 of each, transposed direct form II) and the sum of its samples
+struct KWeightingState
+{
+    double shelf[2] = {};
+    double highPass[2] = {};
+    double sum = 0.0;
+};
+
+//K-weights numFrames samples stride apart, returns the sum of their squares
+static double KWeight(const Biquad &shelf, const Biquad &highPass, KWeightingState &state, const float *samples,
+                      size_t stride, size_t numFrames)
+{
+    double s1 = state.shelf[0], s2 = state.shelf[1];
+    double h1 = state.highPass[0], h2 = state.highPass[1];
+    double sum = 0.0;
+    double energy = 0.0;
+    for (size_t i = 0; i < numFrames; ++i)
+    {
+        const double x = samples[i * stride];
+        const double y = shelf.b0 * x + s1;
+        s1 = shelf.b1 * x - shelf.a1 * y + s2;
+        s2 = shelf.b2 * x - shelf.a2 * y;
+
+        const double z = highPass.b0 * y + h1;
+        h1 = highPass.b1 * y - highPass.a1 * z + h2;
+        h2 = highPass.b2 * y - highPass.a2 * z;
+
+        sum += x;
+        energy += z * z;
+    }
+
+    state.shelf[0] = s1;
+    state.shelf[1] = s2;
+    state.highPass[0] = h1;
+    state.highPass[1] = h2;
+    state.sum += sum;
+    return energy;
+}
+
+#ifdef WT_ANALYSIS_SSE2
+//KWeight of two channels next to each other in one pass, a lane each. The filters are recursive so the channels are
+//all there is to run side by side
+static void KWeightPair(const Biquad &shelf, const Biquad &highPass, KWeightingState &first, KWeightingState &second,
+                        const float *samples, size_t stride, size_t numFrames, double energiesOut[2])
+{
+    const __m128d sb0 = _mm_set1_pd(shelf.b0), sb1 = _mm_set1_pd(shelf.b1), sb2 = _mm_set1_pd(shelf.b2);
+    const __m128d sa1 = _mm_set1_pd(shelf.a1), sa2 = _mm_set1_pd(shelf.a2);
+    const __m128d hb0 = _mm_set1_pd(highPass.b0), hb1 = _mm_set1_pd(highPass.b1), hb2 = _mm_set1_pd(highPass.b2);
+    const __m128d ha1 = _mm_set1_pd(highPass.a1), ha2 = _mm_set1_pd(highPass.a2);
+
+    __m128d s1 = _mm_set_pd(second.shelf[0], first.shelf[0]), s2 = _mm_set_pd(second.shelf[1], first.shelf[1]);
+    __m128d h1 = _mm_set_pd(second.highPass[0], first.highPass[0]), h2 = _mm_set_pd(second.highPass[1], first.highPass[1]);
+    __m128d sum = _mm_setzero_pd();
+    __m128d energy = _mm_setzero_pd();
+    for (size_t i = 0; i < numFrames; ++i)
+    {
+        const __m128d x = _mm_cvtps_pd(_mm_castsi128_ps(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(samples + i * stride))));
+        const __m128d y = _mm_add_pd(_mm_mul_pd(sb0, x), s1);
+        s1 = _mm_add_pd(_mm_sub_pd(_mm_mul_pd(sb1, x), _mm_mul_pd(sa1, y)), s2);
+        s2 = _mm_sub_pd(_mm_mul_pd(sb2, x), _mm_mul_pd(sa2, y));
+
+        const __m128d z = _mm_add_pd(_mm_mul_pd(hb0, y), h1);
+        h1 = _mm_add_pd(_mm_sub_pd(_mm_mul_pd(hb1, y), _mm_mul_pd(ha1, z)), h2);
+        h2 = _mm_sub_pd(_mm_mul_pd(hb2, y), _mm_mul_pd(ha2, z));
+
+        sum = _mm_add_pd(sum, x);
+        energy = _mm_add_pd(energy, _mm_mul_pd(z, z));
+    }
+
+    _mm_storel_pd(&first.shelf[0], s1);
+    _mm_storeh_pd(&second.shelf[0], s1);
+    _mm_storel_pd(&first.shelf[1], s2);
+    _mm_storeh_pd(&second.shelf[1], s2);
+    _mm_storel_pd(&first.highPass[0], h1);
+    _mm_storeh_pd(&second.highPass[0], h1);
+    _mm_storel_pd(&first.highPass[1], h2);
+    _mm_storeh_pd(&second.highPass[1], h2);
+
+    double sums[2];
+    _mm_storeu_pd(sums, sum);
+    first.sum += sums[0];
+    second.sum += sums[1];
+    _mm_storeu_pd(energiesOut, energy);
+}
+#endif
+
+//BS.1770 K-weighting, a high shelf then a high pass, from their analog prototypes at any sample rate
+static void GetKWeighting(uint32 sampleRate, Biquad &shelfOut, Biquad &highPassOut)
+{
+    const double pi = 3.14159265358979323846;
+
+    double f0 = 1681.974450955533;
+    const double gainDb = 3.999843853973347;
+    double q = 0.7071752369554196;
+    double k = std::tan(pi * f0 / sampleRate);
+    const double vh = std::pow(10.0, gainDb / 20.0);
+    const double vb = std::pow(vh, 0.4996667741545416);
+    double a0 = 1.0 + k / q + k * k;
+    shelfOut.b0 = (vh + vb * k / q + k * k) / a0;
+    shelfOut.b1 = 2.0 * (k * k - vh) / a0;
+    shelfOut.b2 = (vh - vb * k / q + k * k) / a0;
+    shelfOut.a1 = 2.0 * (k * k - 1.0) / a0;
+    shelfOut.a2 = (1.0 - k / q + k * k) / a0;
+
+    f0 = 38.13547087602444;
+    q = 0.5003270373238773;
+    k = std::tan(pi * f0 / sampleRate);
+    a0 = 1.0 + k / q + k * k;
+    highPassOut.b0 = 1.0;
+    highPassOut.b1 = -2.0;
+    highPassOut.b2 = 1.0;
+    highPassOut.a1 = 2.0 * (k * k - 1.0) / a0;
+    highPassOut.a2 = (1.0 - k / q + k * k) / a0;
+}
+
+//BS.1770 channel weights for 5.0 and 5.1 in wav order, the LFE doesn't count and surrounds count more
+static double GetChannelWeight(uint32 channel, uint32 numChannels)
+{
+    if (numChannels == 6)
+    {
+        static const double s_weights[] = { 1.0, 1.0, 1.0, 0.0, 1.41, 1.41 };
+        return s_weights[channel];
+    }
+    if (numChannels == 5)
+    {
+        static const double s_weights[] = { 1.0, 1.0, 1.0, 1.41, 1.41 };
+        return s_weights[channel];
+    }
+    return 1.0;
+}
+
+static double ToDb(double linear)
+{
+    return 20.0 * std::log10(linear);
+}
+
+//400ms blocks overlapping by 75%, gated at -70 LUFS then 10 LU under the loudness of what's left
+static double GetIntegratedLoudness(const std::vector<double> &subBlockEnergies, uint64_t subBlockFrames)
+{
+    const double negativeInfinity = -std::numeric_limits<double>::infinity();
+    if (subBlockEnergies.size() < 4)
+    {
+        return negativeInfinity;
+    }
+
+    std::vector<double> blockPowers;
+    blockPowers.reserve(subBlockEnergies.size() - 3);
+    for (size_t i = 3; i < subBlockEnergies.size(); ++i)
+    {
+        const double energy = subBlockEnergies[i - 3] + subBlockEnergies[i - 2] + subBlockEnergies[i - 1] + subBlockEnergies[i];
+        blockPowers.push_back(energy / (4.0 * subBlockFrames));
+    }
+
+    auto Loudness = [](double power) { return -0.691 + 10.0 * std::log10(power); };
+    auto GatedMean = [&blockPowers, &Loudness](double threshold)
+    {
+        double sum = 0.0;
+        size_t count = 0;
+        for (double power : blockPowers)
+        {
+            if (Loudness(power) > threshold)
+            {
+                sum += power;
+                ++count;
+            }
+        }
+        return count ? sum / count : 0.0;
+    };
+
+    const double absoluteGated = GatedMean(-70.0);
+    if (absoluteGated <= 0.0)
+    {
+        return negativeInfinity;
+    }
+
+    const double relativeGated = GatedMean(std::max(-70.0, Loudness(absoluteGated) - 10.0));
+    return relativeGated > 0.0 ? Loudness(relativeGated) : negativeInfinity;
+}
+
+AudioAnalysis AnalyzeWav(const fs::path &path)
+{
+    WAAPI_TRACE_SCOPE("analysis", "AnalyzeWav");
+
+    static const TruePeakFilter s_truePeakFilter;
+
+    AudioAnalysis analysis;
+    analysis.path = path;
+
+    MappedFile file(path);
+    if (!file.GetData())
+    {
+        analysis.error = "couldn't open the file";
+        return analysis;
+    }
+
+    WavData wav;
+    if (!ParseWav(file.GetData(), file.GetSize(), wav, analysis.error))
+    {
+        return analysis;
+    }
+
+    analysis.sampleRate = wav.sampleRate;
+    analysis.numChannels = wav.numChannels;
+    analysis.numFrames = wav.numFrames;
+
+    const uint32 numChannels = wav.numChannels;
+    const size_t bytesPerSample = wav.format == SampleFormat::Int16 ? 2 : wav.format == SampleFormat::Int24 ? 3 : 4;
+
+    Biquad shelf, highPass;
+    GetKWeighting(wav.sampleRate, shelf, highPass);
+
+    //the last samples of each channel, the true peak of the next block's first ones needs them
+    std::vector<std::array<float, TRUE_PEAK_HISTORY>> histories(numChannels);
+    std::vector<KWeightingState> kWeighting(numChannels);
+
+    std::vector<float> interleaved(ANALYSIS_BLOCK_FRAMES * numChannels);
+    std::vector<float> channelSamples(TRUE_PEAK_HISTORY + ANALYSIS_BLOCK_FRAMES);
+
+    //100ms of K-weighted energy summed over the weighted channels, four make a gating block
+    const uint64_t subBlockFrames = std::max<uint64_t>(1, wav.sampleRate / 10);
+    std::vector<double> subBlockEnergies;
+    subBlockEnergies.reserve(static_cast<size_t>(wav.numFrames / subBlockFrames + 1));
+
+    float samplePeak = 0.0f;
+    float truePeak = 0.0f;
+    double sumSquares = 0.0;
+
+    for (uint64_t frameStart = 0; frameStart < wav.numFrames; frameStart += ANALYSIS_BLOCK_FRAMES)
+    {
+        const size_t numFrames = static_cast<size_t>(std::min<uint64_t>(ANALYSIS_BLOCK_FRAMES, wav.numFrames - frameStart));
+        const size_t numSamples = numFrames * numChannels;
+        const uint8_t *source = wav.samples + frameStart * numChannels * bytesPerSample;
+
+        switch (wav.format)
+        {
+        case SampleFormat::Int16:   ConvertInt16(source, interleaved.data(), numSamples); break;
+        case SampleFormat::Int24:   ConvertInt24(source, interleaved.data(), numSamples); break;
+        case SampleFormat::Int32:   ConvertInt32(source, interleaved.data(), numSamples); break;
+        case SampleFormat::Float32: memcpy(interleaved.data(), source, numSamples * sizeof(float)); break;
+        }
+
+        AccumulateLevels(interleaved.data(), numSamples, samplePeak, sumSquares);
+
+        const size_t numSubBlocks = static_cast<size_t>((frameStart + numFrames + subBlockFrames - 1) / subBlockFrames);
+        subBlockEnergies.resize(numSubBlocks, 0.0);
+
+        for (uint32 channelIdx = 0; channelIdx < numChannels; ++channelIdx)
+        {
+            std::array<float, TRUE_PEAK_HISTORY> &history = histories[channelIdx];
+
+            float *samples = channelSamples.data() + TRUE_PEAK_HISTORY;
+            std::copy(history.begin(), history.end(), channelSamples.begin());
+            for (size_t i = 0; i < numFrames; ++i)
+            {
+                samples[i] = interleaved[i * numChannels + channelIdx];
+            }
+            truePeak = std::max(truePeak, TruePeak(s_truePeakFilter, channelSamples.data(), numFrames));
+            std::copy_n(channelSamples.begin() + numFrames, TRUE_PEAK_HISTORY, history.begin());
+        }
+
+        //split where the sub blocks end
+        size_t i = 0;
+        while (i < numFrames)
+        {
+            const size_t subBlock = static_cast<size_t>((frameStart + i) / subBlockFrames);
+            const size_t segmentEnd = static_cast<size_t>(std::min<uint64_t>(numFrames, (subBlock + 1) * subBlockFrames - frameStart));
+            const float *segment = interleaved.data() + i * numChannels;
+            const size_t segmentFrames = segmentEnd - i;
+
+            double energy = 0.0;
+            uint32 channelIdx = 0;
+#ifdef WT_ANALYSIS_SSE2
+            for (; channelIdx + 2 <= numChannels; channelIdx += 2)
+            {
+                double energies[2];
+                KWeightPair(shelf, highPass, kWeighting[channelIdx], kWeighting[channelIdx + 1], segment + channelIdx,
+                            numChannels, segmentFrames, energies);
+                energy += GetChannelWeight(channelIdx, numChannels) * energies[0]
+                          + GetChannelWeight(channelIdx + 1, numChannels) * energies[1];
+            }
+#endif
+            for (; channelIdx < numChannels; ++channelIdx)
+            {
+                energy += GetChannelWeight(channelIdx, numChannels)
+                          * KWeight(shelf, highPass, kWeighting[channelIdx], segment + channelIdx, numChannels, segmentFrames);
+            }
+
+            subBlockEnergies[subBlock] += energy;
+            i = segmentEnd;
+        }
+    }
+
+    //a last sub block that isn't whole doesn't make a gating block
+    subBlockEnergies.resize(static_cast<size_t>(wav.numFrames / subBlockFrames));
+
+    for (const KWeightingState &channel : kWeighting)
+    {
+        if (wav.numFrames)
+        {
+            analysis.dcOffset = std::max(analysis.dcOffset, std::fabs(channel.sum / wav.numFrames));
+        }
+    }
+
+    const uint64_t numSamples = wav.numFrames * numChannels;
+    analysis.samplePeakDb = ToDb(samplePeak);
+    analysis.truePeakDb = ToDb(std::max(truePeak, samplePeak));
+    analysis.rmsDb = numSamples ? 10.0 * std::log10(sumSquares / numSamples) : -std::numeric_limits<double>::infinity();
+    analysis.integratedLufs = GetIntegratedLoudness(subBlockEnergies, subBlockFrames);
+    return analysis;
+}
+
+std::vector<AudioAnalysis> AnalyzeWavs(const std::vector<fs::path> &paths, uint32 numThreads)
+{
+    std::vector<AudioAnalysis> analyses(paths.size());
+    std::atomic<size_t> nextFile{ 0 };
+
+    auto AnalyzeWorker = [&]()
+    {
+        for (size_t i = nextFile++; i < paths.size(); i = nextFile++)
+        {
+            analyses[i] = AnalyzeWav(paths[i]);
+        }
+    };
+
+    const size_t numWorkers = std::min<size_t>(std::max(1u, numThreads), paths.size());
+    std::vector<std::thread> threads;
+    for (size_t i = 1; i < numWorkers; ++i)
+    {
+        threads.emplace_back(AnalyzeWorker);
+    }
+    AnalyzeWorker();
+
+    for (std::thread &thread : threads)
+    {
+        thread.join();
+    }
+    return analyses;
+}
+
+bool LoudnessSpec::Load(const fs::path &path, std::string &errorOut)
+{
+    *this = LoudnessSpec();
+
+    std::ifstream file(path);
+    if (!file.is_open())
+    {
+        errorOut = "couldn't open " + path.generic_string();
+        return false;
+    }
+
+    std::stringstream contents;
+    contents << file.rdbuf();
+
+    rapidjson::Document doc;
+    if (doc.Parse(contents.str().c_str()).HasParseError() || !doc.IsObject())
+    {
+        errorOut = path.generic_string() + " is not a valid JSON object";
+        return false;
+    }
+
+    const std::pair<const char*, double*> limits[] =
+    {
+        { "maxSamplePeakDb",   &m_maxSamplePeakDb },
+        { "maxTruePeakDb",     &m_maxTruePeakDb },
+        { "minIntegratedLufs", &m_minIntegratedLufs },
+        { "maxIntegratedLufs", &m_maxIntegratedLufs },
+        { "maxDcOffset",       &m_maxDcOffset }
+    };
+
+    for (const auto &member : doc.GetObject())
+    {
+        const std::string key = member.name.GetString();
+        auto limit = std::find_if(std::begin(limits), std::end(limits),
+                                  [&key](const std::pair<const char*, double*> &known) { return key == known.first; });
+        if (limit == std::end(limits))
+        {
+            errorOut = "unknown limit " + key;
+            return false;
+        }
+        if (!member.value.IsNumber())
+        {
+            errorOut = key + " should be a number";
+            return false;
+        }
+        *limit->second = member.value.GetDouble();
+    }
+    return true;
+}
+
+std::string LoudnessSpec::Check(const AudioAnalysis &analysis) const
+{
+    if (!analysis.error.empty())
+    {
+        return analysis.error;
+    }
+
+    std::string outOfSpec;
+    char text[128];
+    auto Add = [&outOfSpec, &text](const char *name, double value, const char *unit, const char *limitName, double limit)
+    {
+        snprintf(text, sizeof(text), "%s %.2f %s %s %.2f", name, value, unit, limitName, limit);
+        outOfSpec += outOfSpec.empty() ? text : std::string(", ") + text;
+    };
+
+    if (analysis.samplePeakDb > m_maxSamplePeakDb)
+    {
+        Add("sample peak", analysis.samplePeakDb, "dB", "over", m_maxSamplePeakDb);
+    }
+    if (analysis.truePeakDb > m_maxTruePeakDb)
+    {
+        Add("true peak", analysis.truePeakDb, "dBTP", "over", m_maxTruePeakDb);
+    }
+
+    //too short to gate isn't too quiet, short sounds are checked by their peaks
+    if (std::isfinite(analysis.integratedLufs) && analysis.integratedLufs < m_minIntegratedLufs)
+    {
+        Add("loudness", analysis.integratedLufs, "LUFS", "under", m_minIntegratedLufs);
+    }
+    if (analysis.integratedLufs > m_maxIntegratedLufs)
+    {
+        Add("loudness", analysis.integratedLufs, "LUFS", "over", m_maxIntegratedLufs);
+    }
+    if (analysis.dcOffset > m_maxDcOffset)
+    {
+        Add("dc offset", analysis.dcOffset, "", "over", m_maxDcOffset);
+    }
+    return outOfSpec;
+}
+
+bool WriteAnalysisReport(const fs::path &path, const std::vector<AudioAnalysis> &analyses, const LoudnessSpec &spec)
+{
+    rapidjson::StringBuffer buffer;
+    rapidjson::PrettyWriter<rapidjson::StringBuffer> writer(buffer);
+
+    auto WriteLevel = [&writer](const char *key, double value)
+    {
+        writer.Key(key);
+        if (std::isfinite(value))
+        {
+            writer.Double(value);
+        }
+        else
+        {
+            writer.Null();
+        }
+    };
+
+    writer.StartArray();
+    for (const AudioAnalysis &analysis : analyses)
+    {
+        writer.StartObject();
+        writer.Key("file");
+        writer.String(analysis.path.generic_string().c_str());
+        if (analysis.error.empty())
+        {
+            writer.Key("sampleRate");
+            writer.Uint(analysis.sampleRate);
+            writer.Key("channels");
+            writer.Uint(analysis.numChannels);
+            writer.Key("seconds");
+            writer.Double(static_cast<double>(analysis.numFrames) / analysis.sampleRate);
+            WriteLevel("samplePeakDb", analysis.samplePeakDb);
+            WriteLevel("truePeakDb", analysis.truePeakDb);
+            WriteLevel("rmsDb", analysis.rmsDb);
+            WriteLevel("integratedLufs", analysis.integratedLufs);
+            WriteLevel("dcOffset", analysis.dcOffset);
+        }
+
+        const std::string outOfSpec = spec.Check(analysis);
+        if (!outOfSpec.empty())
+        {
+            writer.Key("outOfSpec");
+            writer.String(outOfSpec.c_str());
+        }
+        writer.EndObject();
+    }
+    writer.EndArray();
+
+    std::ofstream file(path, std::ios::trunc);
+    file << buffer.GetString() << '\n';
+    return file.good();
+}
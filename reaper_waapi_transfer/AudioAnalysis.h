@@ -0,0 +1,64 @@
+#pragma once
+#include <limits>
+#include <string>
+#include <vector>
+
+#include "types.h"
+
+//Levels of a rendered wav, dB are relative to full scale. No reaper api in here so tools outside of reaper can use it
+struct AudioAnalysis
+{
+    fs::path path;
+
+    //empty if the file was analysed, why it couldn't be otherwise
+    std::string error;
+
+    uint32 sampleRate = 0;
+    uint32 numChannels = 0;
+    uint64_t numFrames = 0;
+
+    //largest sample of any channel
+    double samplePeakDb = 0.0;
+
+    //dBTP, the largest sample of the signal oversampled 4x (ITU-R BS.1770-4 annex 2), never below the sample peak
+    double truePeakDb = 0.0;
+
+    //every sample of every channel
+    double rmsDb = 0.0;
+
+    //ITU-R BS.1770-4 gated loudness, -inf if the file is shorter than a 400ms block or gated out completely
+    double integratedLufs = 0.0;
+
+    //mean of the channel furthest from 0, linear
+    double dcOffset = 0.0;
+};
+
+//Limits an analysed file has to stay in to be imported, read from a JSON object with any of maxSamplePeakDb,
+//maxTruePeakDb, minIntegratedLufs, maxIntegratedLufs and maxDcOffset. Limits that aren't there aren't checked
+class LoudnessSpec
+{
+public:
+    bool Load(const fs::path &path, std::string &errorOut);
+
+    //empty if the analysis is within the limits, the limits it breaks otherwise. Files that couldn't be analysed
+    //are out of spec
+    std::string Check(const AudioAnalysis &analysis) const;
+
+private:
+    static constexpr double s_infinity = std::numeric_limits<double>::infinity();
+
+    double m_maxSamplePeakDb = s_infinity;
+    double m_maxTruePeakDb = s_infinity;
+    double m_minIntegratedLufs = -s_infinity;
+    double m_maxIntegratedLufs = s_infinity;
+    double m_maxDcOffset = s_infinity;
+};
+
+//reads the wav through a memory mapping, 16, 24 and 32 bit PCM and 32 bit float, RF64 with the data chunk last
+AudioAnalysis AnalyzeWav(const fs::path &path);
+
+//AnalyzeWav on up to numThreads threads, one file per thread at a time, in the order of paths
+std::vector<AudioAnalysis> AnalyzeWavs(const std::vector<fs::path> &paths, uint32 numThreads);
+
+//JSON array of the analyses with what each breaks in spec, levels that are -inf are null
+bool WriteAnalysisReport(const fs::path &path, const std::vector<AudioAnalysis> &analyses, const LoudnessSpec &spec);
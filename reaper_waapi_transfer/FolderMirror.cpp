@@ -0,0 +1,207 @@
+#include <algorithm>
+#include <cctype>
+#include <cstring>
+#include <unordered_set>
+
+#include "FolderMirror.h"
+
+static std::string ToLower(std::string text)
+{
+    std::transform(text.begin(), text.end(), text.begin(), [](char c) { return static_cast<char>(tolower(c)); });
+    return text;
+}
+
+std::string MakeWwiseObjectName(const std::string &name)
+{
+    std::string wwiseName = name;
+    for (char &c : wwiseName)
+    {
+        if (strchr("\\/:*?\"<>|", c))
+        {
+            c = '_';
+        }
+    }
+    return wwiseName;
+}
+
+std::string GetTrackFolderPath(const RenderItem &renderItem)
+{
+    std::string path;
+    for (const std::string &folder : renderItem.trackFolders)
+    {
+        if (!path.empty())
+        {
+            path += '\\';
+        }
+        path += MakeWwiseObjectName(folder);
+    }
+    return path;
+}
+
+std::vector<std::string> CollectTrackFolderPaths(const std::vector<const RenderItem*> &renderItems)
+{
+    std::vector<std::string> folderPaths;
+
+    //wwise names aren't case sensitive, the first spelling seen wins
+    std::unordered_set<std::string> seen;
+
+    for (const RenderItem *renderItem : renderItems)
+    {
+        std::string path;
+        for (const std::string &folder : renderItem->trackFolders)
+        {
+            if (!path.empty())
+            {
+                path += '\\';
+            }
+            path += MakeWwiseObjectName(folder);
+
+            //the first item in a folder adds the folders above it first
+            if (seen.insert(ToLower(path)).second)
+            {
+                folderPaths.push_back(path);
+            }
+        }
+    }
+
+    return folderPaths;
+}
+
+static FolderNode &FindOrAddChild(std::vector<FolderNode> &nodes, const std::string &name)
+{
+    auto found = std::find_if(nodes.begin(), nodes.end(), [&name](const FolderNode &node)
+    {
+        return node.name.size() == name.size() && ToLower(node.name) == ToLower(name);
+    });
+
+    if (found != nodes.end())
+    {
+        return *found;
+    }
+
+    nodes.push_back(FolderNode{ name, {} });
+    return nodes.back();
+}
+
+//drops nodes that exist with nothing missing below them, true if node itself has to stay
+static bool PruneExisting(FolderNode &node, const std::string &path, const std::function<bool(const std::string&)> &exists)
+{
+    bool keepChildren = false;
+    for (auto child = node.children.begin(); child != node.children.end(); /* */)
+    {
+        if (PruneExisting(*child, path + '\\' + child->name, exists))
+        {
+            keepChildren = true;
+            ++child;
+        }
+        else
+        {
+            child = node.children.erase(child);
+        }
+    }
+
+    return keepChildren || !exists(path);
+}
+
+std::vector<FolderNode> BuildFolderTree(const std::vector<std::string> &folderPaths,
+                                        const std::function<bool(const std::string&)> &exists)
+{
+    std::vector<FolderNode> roots;
+
+    for (const std::string &path : folderPaths)
+    {
+        std::vector<FolderNode> *level = &roots;
+        size_t segmentStart = 0;
+        while (segmentStart <= path.size())
+        {
+            size_t segmentEnd = path.find('\\', segmentStart);
+            if (segmentEnd == std::string::npos)
+            {
+                segmentEnd = path.size();
+            }
+
+            FolderNode &node = FindOrAddChild(*level, path.substr(segmentStart, segmentEnd - segmentStart));
+            level = &node.children;
+            segmentStart = segmentEnd + 1;
+        }
+    }
+
+    for (auto root = roots.begin(); root != roots.end(); /* */)
+    {
+        if (PruneExisting(*root, root->name, exists))
+        {
+            ++root;
+        }
+        else
+        {
+            root = roots.erase(root);
+        }
+    }
+
+    return roots;
+}
+
+size_t CountFolderNodes(const std::vector<FolderNode> &nodes)
+{
+    size_t count = nodes.size();
+    for (const FolderNode &node : nodes)
+    {
+        count += CountFolderNodes(node.children);
+    }
+    return count;
+}
+
+static AK::WwiseAuthoringAPI::AkJson::Array MakeChildren(const std::vector<FolderNode> &nodes, const std::string &containerType)
+{
+    using namespace AK::WwiseAuthoringAPI;
+
+    AkJson::Array children;
+    children.reserve(nodes.size());
+    for (const FolderNode &node : nodes)
+    {
+        AkJson child(AkJson::Map{
+            { "type", AkVariant(containerType) },
+            { "name", AkVariant(node.name) }
+        });
+
+        if (!node.children.empty())
+        {
+            child.GetMap().insert({ "children", MakeChildren(node.children, containerType) });
+        }
+        children.push_back(std::move(child));
+    }
+    return children;
+}
+
+AK::WwiseAuthoringAPI::AkJson MakeFolderSetArgs(const std::string &root, const std::vector<FolderNode> &nodes,
+                                                const std::string &containerType)
+{
+    using namespace AK::WwiseAuthoringAPI;
+
+    return AkJson(AkJson::Map{
+        { "objects", AkJson::Array{ AkJson::Map{
+            { "object", AkVariant(root) },
+            { "children", MakeChildren(nodes, containerType) }
+        } } },
+        { "onNameConflict", AkVariant("merge") }
+    });
+}
+
+AK::WwiseAuthoringAPI::AkJson MakeFolderCreateArgs(const std::string &parent, const FolderNode &node,
+                                                   const std::string &containerType)
+{
+    using namespace AK::WwiseAuthoringAPI;
+
+    AkJson args(AkJson::Map{
+        { "parent", AkVariant(parent) },
+        { "type", AkVariant(containerType) },
+        { "name", AkVariant(node.name) },
+        { "onNameConflict", AkVariant("merge") }
+    });
+
+    if (!node.children.empty())
+    {
+        args.GetMap().insert({ "children", MakeChildren(node.children, containerType) });
+    }
+    return args;
+}
@@ -0,0 +1,45 @@
+#pragma once
+#include <functional>
+#include <string>
+#include <vector>
+
+#include <AK/WwiseAuthoringAPI/AkAutobahn/AkJson.h>
+
+#include "types.h"
+
+//Reaper track folders mirrored into wwise as containers under a chosen root, so stems land in a structure
+//matching the reaper project instead of being parented one by one (see RenderItem::trackFolders).
+//No reaper api or waapi calls in here, the command line transfer uses it too.
+
+//One container to create or merge, children nested like the object.set/object.create "children" argument
+struct FolderNode
+{
+    std::string name;
+    std::vector<FolderNode> children;
+};
+
+//"Folder\Sub" from the item's track folders, relative to the mirror root
+//empty for items outside any folder (master, media and top level tracks), they go straight under the root
+std::string GetTrackFolderPath(const RenderItem &renderItem);
+
+//track names as wwise names, characters wwise doesn't allow in names become '_'
+std::string MakeWwiseObjectName(const std::string &name);
+
+//every folder path the items need, including the folders above them, parents before children
+std::vector<std::string> CollectTrackFolderPaths(const std::vector<const RenderItem*> &renderItems);
+
+//the folder paths as a tree, exists is given each relative path and subtrees that exist completely are left out
+//folders that exist but have missing folders below them stay in, they are merged by name
+std::vector<FolderNode> BuildFolderTree(const std::vector<std::string> &folderPaths,
+                                        const std::function<bool(const std::string&)> &exists);
+
+size_t CountFolderNodes(const std::vector<FolderNode> &nodes);
+
+//arguments for one ak.wwise.core.object.set making the whole tree under root (guid or path), merged by name
+AK::WwiseAuthoringAPI::AkJson MakeFolderSetArgs(const std::string &root, const std::vector<FolderNode> &nodes,
+                                                const std::string &containerType);
+
+//arguments for one ak.wwise.core.object.create making node and everything below it under parent, merged by name
+//for wwise versions without object.set, one call per top level folder
+AK::WwiseAuthoringAPI::AkJson MakeFolderCreateArgs(const std::string &parent, const FolderNode &node,
+                                                   const std::string &containerType);
@@ -0,0 +1,169 @@
+#include <algorithm>
+#include <cctype>
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+
+#include "ImportIdIndex.h"
+#include "config.h"
+
+//written in place of an empty source guid
+static const char *NO_GUID = "-";
+
+fs::path ImportIdIndex::GetIndexPath(const fs::path &dir, const std::string &reaperProject)
+{
+    //FNV-1a of the project path, windows paths aren't case sensitive
+    uint64_t hash = 14695981039346656037ull;
+    for (char c : reaperProject)
+    {
+        hash ^= static_cast<unsigned char>(tolower(c));
+        hash *= 1099511628211ull;
+    }
+
+    char fileName[32];
+    snprintf(fileName, sizeof(fileName), "%016llx", static_cast<unsigned long long>(hash));
+    return dir / (fileName + IMPORT_ID_INDEX_EXTENSION);
+}
+
+bool ImportIdIndex::Load(const fs::path &path)
+{
+    m_reaperProject.clear();
+    m_entries.clear();
+    m_objects.clear();
+
+    std::ifstream file(path);
+    if (!file.is_open())
+    {
+        return false;
+    }
+
+    //first line is the reaper project, then one item per line: parent guid, sound guid, source guid, output name
+    if (!std::getline(file, m_reaperProject))
+    {
+        return false;
+    }
+
+    std::string line;
+    while (std::getline(file, line))
+    {
+        std::stringstream lineStream(line);
+        Entry entry;
+        if (!(lineStream >> entry.parentGuid >> entry.soundGuid >> entry.sourceGuid))
+        {
+            continue;
+        }
+
+        std::getline(lineStream >> std::ws, entry.outputName);
+        if (entry.outputName.empty())
+        {
+            continue;
+        }
+
+        if (entry.sourceGuid == NO_GUID)
+        {
+            entry.sourceGuid.clear();
+        }
+        Set(entry);
+    }
+
+    return true;
+}
+
+bool ImportIdIndex::Save(const fs::path &path) const
+{
+    fs::path tempPath = path;
+    tempPath += ".tmp";
+
+    {
+        std::ofstream file(tempPath, std::ios::trunc);
+        if (!file.is_open())
+        {
+            return false;
+        }
+
+        file << m_reaperProject << '\n';
+        for (const auto &entry : m_entries)
+        {
+            const Entry &item = entry.second;
+            file << item.parentGuid << ' ' << item.soundGuid << ' '
+                 << (item.sourceGuid.empty() ? NO_GUID : item.sourceGuid.c_str()) << ' '
+                 << item.outputName << '\n';
+        }
+
+        if (!file.good())
+        {
+            return false;
+        }
+    }
+
+    std::error_code error;
+    fs::rename(tempPath, path, error);
+    return !error;
+}
+
+void ImportIdIndex::Set(const Entry &entry)
+{
+    auto existing = m_entries.find(MakeKey(entry.parentGuid, entry.outputName));
+    if (existing != m_entries.end())
+    {
+        m_objects.erase(existing->second.soundGuid);
+        m_objects.erase(existing->second.sourceGuid);
+        existing->second = entry;
+    }
+    else
+    {
+        m_entries.insert({ MakeKey(entry.parentGuid, entry.outputName), entry });
+    }
+
+    m_objects.insert(entry.soundGuid);
+    if (!entry.sourceGuid.empty())
+    {
+        m_objects.insert(entry.sourceGuid);
+    }
+}
+
+const ImportIdIndex::Entry *ImportIdIndex::Find(const std::string &parentGuid, const std::string &outputName) const
+{
+    auto found = m_entries.find(MakeKey(parentGuid, outputName));
+    return found != m_entries.end() ? &found->second : nullptr;
+}
+
+bool ImportIdIndex::ContainsObject(const std::string &guid) const
+{
+    return m_objects.find(guid) != m_objects.end();
+}
+
+std::string ImportIdIndex::MakeKey(const std::string &parentGuid, const std::string &outputName)
+{
+    //wwise names aren't case sensitive
+    std::string key = parentGuid + '\\' + outputName;
+    std::transform(key.begin(), key.end(), key.begin(), [](char c) { return static_cast<char>(tolower(c)); });
+    return key;
+}
+
+void LoadImportIdIndexes(const fs::path &dir, std::unordered_map<std::string, std::string> &objectProjectsOut)
+{
+    std::error_code error;
+    for (fs::directory_iterator it(dir, error), end; !error && it != end; it.increment(error))
+    {
+        if (it->path().extension() != IMPORT_ID_INDEX_EXTENSION)
+        {
+            continue;
+        }
+
+        ImportIdIndex index;
+        if (!index.Load(it->path()))
+        {
+            continue;
+        }
+
+        for (const auto &entry : index.GetEntries())
+        {
+            objectProjectsOut[entry.second.soundGuid] = index.GetReaperProject();
+            if (!entry.second.sourceGuid.empty())
+            {
+                objectProjectsOut[entry.second.sourceGuid] = index.GetReaperProject();
+            }
+        }
+    }
+}
@@ -0,0 +1,57 @@
+#pragma once
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+
+#include "types.h"
+
+//Wwise object ids of the render items imported from one reaper project, read from the audio.import results
+//Keyed on the wwise parent guid and output name an item was imported with, so a later transfer of the same item
+//finds its sound by id even if it was renamed or moved in wwise, and recall finds the reaper project of a selected
+//sound or source without reading notes.
+//One small text file per reaper project in the transfer data dir, see GetIndexPath.
+class ImportIdIndex
+{
+public:
+    struct Entry
+    {
+        std::string parentGuid;
+        std::string outputName;
+        std::string soundGuid;
+
+        //empty if the import result didn't list the source
+        std::string sourceGuid;
+    };
+
+    //file of a reaper project's index inside dir
+    static fs::path GetIndexPath(const fs::path &dir, const std::string &reaperProject);
+
+    //returns false if the file couldn't be opened, the index is left empty in that case
+    bool Load(const fs::path &path);
+
+    //written to a temporary file and renamed over path
+    bool Save(const fs::path &path) const;
+
+    const std::string &GetReaperProject() const { return m_reaperProject; }
+    void SetReaperProject(const std::string &reaperProject) { m_reaperProject = reaperProject; }
+
+    void Set(const Entry &entry);
+    const Entry *Find(const std::string &parentGuid, const std::string &outputName) const;
+
+    //if guid is an indexed sound or source
+    bool ContainsObject(const std::string &guid) const;
+
+    //keyed on the lowercase parent guid and output name
+    typedef std::unordered_map<std::string, Entry> EntryMap;
+    const EntryMap &GetEntries() const { return m_entries; }
+
+private:
+    static std::string MakeKey(const std::string &parentGuid, const std::string &outputName);
+
+    std::string m_reaperProject;
+    EntryMap m_entries;
+    std::unordered_set<std::string> m_objects;
+};
+
+//every index in dir, indexed sound and source guids to the reaper project they were imported from
+void LoadImportIdIndexes(const fs::path &dir, std::unordered_map<std::string, std::string> &objectProjectsOut);
@@ -0,0 +1,294 @@
+#include <algorithm>
+#include <cctype>
+#include <fstream>
+
+#include "ImportPlan.h"
+#include "config.h"
+
+AK::WwiseAuthoringAPI::AkJson MakeImportItem(const RenderItem &renderItem, const std::string &recallNote)
+{
+    using namespace AK::WwiseAuthoringAPI;
+
+    AkJson importItem = AkJson(AkJson::Map{
+        { "audioFile", AkVariant(renderItem.audioFilePath.generic_string()) },
+        { "importLocation", AkVariant(renderItem.wwiseGuid) },
+        { "objectType", AkVariant("Sound") }
+    });
+
+    auto &importMap = importItem.GetMap();
+
+    switch (renderItem.importObjectType)
+    {
+
+    case ImportObjectType::SFX:
+    {
+        importMap.insert({ "objectPath", AkVariant("<Sound SFX>" + renderItem.outputFileName) });
+        if (!recallNote.empty())
+        {
+            importMap.insert({ "audioSourceNotes", AkVariant(recallNote) });
+        }
+    } break;
+
+    case ImportObjectType::Voice:
+    {
+        importMap.insert({ "importLanguage", AkVariant(WwiseLanguages[renderItem.wwiseLanguageIndex]) });
+        importMap.insert({ "objectPath", AkVariant("<Sound Voice>" + renderItem.outputFileName) });
+        if (!recallNote.empty())
+        {
+            importMap.insert({ "audioSourceNotes", AkVariant(recallNote) });
+        }
+    } break;
+
+    case ImportObjectType::Music:
+    {
+        importMap.insert({ "objectPath", AkVariant("<Music Track>" + renderItem.outputFileName) });
+    } break;
+
+    }
+
+    if (!renderItem.wwiseOriginalsSubpath.empty())
+    {
+        //TODO: Check for path correctness
+        importMap.insert({ "originalsSubFolder", AkVariant(renderItem.wwiseOriginalsSubpath) });
+    }
+
+    return importItem;
+}
+
+AK::WwiseAuthoringAPI::AkJson MakeImportArgs(const AK::WwiseAuthoringAPI::AkJson::Array &items, WAAPIImportOperation importOperation)
+{
+    using namespace AK::WwiseAuthoringAPI;
+
+    return AkJson(AkJson::Map{
+        { "importOperation", AkVariant(GetImportOperationString(importOperation)) },
+        { "default", AkJson::Map{
+            { "importLanguage", AkVariant("SFX") }
+        } },
+        { "imports", items }
+    });
+}
+
+std::vector<ImportBatch> BuildImportPlan(const std::vector<const RenderItem*> &renderItems, const std::string &recallNote)
+{
+    //order the calls are made in for each chunk
+    static const WAAPIImportOperation operationOrder[] = {
+        WAAPIImportOperation::createNew,
+        WAAPIImportOperation::replaceExisting,
+        WAAPIImportOperation::useExisting
+    };
+
+    std::vector<ImportBatch> plan;
+
+    for (size_t chunkStart = 0; chunkStart < renderItems.size(); chunkStart += WAAPI_IMPORT_BATCH_SIZE)
+    {
+        const size_t chunkEnd = std::min(renderItems.size(), chunkStart + WAAPI_IMPORT_BATCH_SIZE);
+
+        ImportBatch chunkBatches[3];
+        for (int op = 0; op < 3; ++op)
+        {
+            chunkBatches[op].importOperation = operationOrder[op];
+        }
+
+        for (size_t i = chunkStart; i < chunkEnd; ++i)
+        {
+            const RenderItem &renderItem = *renderItems[i];
+
+            //check if object has wwise GUID attached
+            if (renderItem.wwiseGuid.empty())
+            {
+                continue;
+            }
+
+            for (ImportBatch &batch : chunkBatches)
+            {
+                if (batch.importOperation == renderItem.importOperation)
+                {
+                    batch.items.push_back(MakeImportItem(renderItem, recallNote));
+                    batch.renderItems.push_back(&renderItem);
+                    break;
+                }
+            }
+        }
+
+        for (ImportBatch &batch : chunkBatches)
+        {
+            if (!batch.items.empty())
+            {
+                plan.push_back(std::move(batch));
+            }
+        }
+    }
+
+    return plan;
+}
+
+static std::string ToLower(std::string text)
+{
+    std::transform(text.begin(), text.end(), text.begin(), [](char c) { return static_cast<char>(tolower(c)); });
+    return text;
+}
+
+//wwise names aren't case sensitive
+static std::string MakeChildKey(const std::string &parentGuid, const std::string &name)
+{
+    return parentGuid + '\\' + ToLower(name);
+}
+
+size_t CountImportCalls(const std::vector<const RenderItem*> &renderItems)
+{
+    size_t numCalls = 0;
+    for (size_t chunkStart = 0; chunkStart < renderItems.size(); chunkStart += WAAPI_IMPORT_BATCH_SIZE)
+    {
+        const size_t chunkEnd = std::min(renderItems.size(), chunkStart + WAAPI_IMPORT_BATCH_SIZE);
+
+        bool hasOperation[3] = {};
+        for (size_t i = chunkStart; i < chunkEnd; ++i)
+        {
+            if (!renderItems[i]->wwiseGuid.empty())
+            {
+                hasOperation[static_cast<int>(renderItems[i]->importOperation)] = true;
+            }
+        }
+        numCalls += std::count(std::begin(hasOperation), std::end(hasOperation), true);
+    }
+    return numCalls;
+}
+
+const PreflightItem *PreflightPlan::Find(const RenderItem &renderItem) const
+{
+    auto found = items.find(renderItem.audioFilePath.generic_string());
+    return found != items.end() ? &found->second : nullptr;
+}
+
+PreflightPlan BuildPreflightPlan(const std::vector<const RenderItem*> &renderItems, const std::vector<ExistingObject> &existingObjects)
+{
+    std::unordered_map<std::string, const ExistingObject*> existingByChild;
+    existingByChild.reserve(existingObjects.size());
+    for (const ExistingObject &existing : existingObjects)
+    {
+        existingByChild.insert({ MakeChildKey(existing.parentGuid, existing.name), &existing });
+    }
+
+    PreflightPlan plan;
+
+    //import calls are planned per render queue project, count them the same way
+    std::vector<std::string> projectOrder;
+    std::unordered_map<std::string, std::pair<std::vector<const RenderItem*>, std::vector<const RenderItem*>>> projects;
+
+    for (const RenderItem *renderItem : renderItems)
+    {
+        const std::string projectPath = renderItem->projectPath.generic_string();
+        auto project = projects.find(projectPath);
+        if (project == projects.end())
+        {
+            projectOrder.push_back(projectPath);
+            project = projects.insert({ projectPath, {} }).first;
+        }
+        project->second.first.push_back(renderItem);
+
+        if (renderItem->wwiseGuid.empty())
+        {
+            continue;
+        }
+
+        PreflightItem item;
+        auto existing = existingByChild.find(MakeChildKey(renderItem->wwiseGuid, renderItem->outputFileName));
+        if (existing == existingByChild.end())
+        {
+            item.action = PreflightAction::Create;
+            ++plan.numCreate;
+        }
+        else
+        {
+            const ExistingObject &existingObject = *existing->second;
+            item.existingGuid = existingObject.guid;
+
+            const bool sameFileName = existingObject.type == "Sound" && !existingObject.originalWavFilePath.empty() &&
+                ToLower(fs::path(existingObject.originalWavFilePath).filename().generic_string()) ==
+                ToLower(renderItem->audioFilePath.filename().generic_string());
+
+            if (renderItem->importOperation == WAAPIImportOperation::createNew)
+            {
+                item.action = PreflightAction::Create;
+                item.renamed = true;
+                ++plan.numCreate;
+                ++plan.numRenamed;
+            }
+            else if (sameFileName)
+            {
+                item.action = PreflightAction::Unchanged;
+                item.existingOriginal = existingObject.originalWavFilePath;
+                ++plan.numUnchanged;
+            }
+            else
+            {
+                item.action = PreflightAction::Replace;
+                ++plan.numReplace;
+            }
+        }
+
+        if (item.action != PreflightAction::Unchanged)
+        {
+            project->second.second.push_back(renderItem);
+        }
+        plan.items.insert({ renderItem->audioFilePath.generic_string(), std::move(item) });
+    }
+
+    for (const std::string &projectPath : projectOrder)
+    {
+        const auto &project = projects[projectPath];
+        plan.numImportCalls += CountImportCalls(project.first);
+        plan.numImportCallsWithoutUnchanged += CountImportCalls(project.second);
+    }
+
+    return plan;
+}
+
+bool IsUnchangedImport(const RenderItem &renderItem, const PreflightItem &preflightItem)
+{
+    if (preflightItem.action != PreflightAction::Unchanged)
+    {
+        return false;
+    }
+
+    std::error_code error;
+    const uintmax_t renderSize = fs::file_size(renderItem.audioFilePath, error);
+    if (error || renderSize != fs::file_size(fs::u8path(preflightItem.existingOriginal), error) || error)
+    {
+        return false;
+    }
+
+    std::ifstream renderFile(renderItem.audioFilePath, std::ios::binary);
+    std::ifstream originalFile(fs::u8path(preflightItem.existingOriginal), std::ios::binary);
+    if (!renderFile || !originalFile)
+    {
+        return false;
+    }
+
+    std::vector<char> renderBuffer(64 * 1024);
+    std::vector<char> originalBuffer(renderBuffer.size());
+    while (renderFile && originalFile)
+    {
+        renderFile.read(renderBuffer.data(), renderBuffer.size());
+        originalFile.read(originalBuffer.data(), originalBuffer.size());
+
+        if (renderFile.gcount() != originalFile.gcount() ||
+            !std::equal(renderBuffer.begin(), renderBuffer.begin() + renderFile.gcount(), originalBuffer.begin()))
+        {
+            return false;
+        }
+    }
+    return renderFile.eof() && originalFile.eof();
+}
+
+std::string FormatPreflightPlan(const PreflightPlan &plan)
+{
+    std::string text = std::to_string(plan.numCreate) + " create";
+    if (plan.numRenamed)
+    {
+        text += " (" + std::to_string(plan.numRenamed) + " renamed)";
+    }
+    return text + ", "
+        + std::to_string(plan.numReplace) + " replace, "
+        + std::to_string(plan.numUnchanged) + " unchanged";
+}
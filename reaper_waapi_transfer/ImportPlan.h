@@ -0,0 +1,115 @@
+#pragma once
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <AK/WwiseAuthoringAPI/AkAutobahn/AkJson.h>
+
+#include "types.h"
+
+//A single ak.wwise.core.audio.import call
+struct ImportBatch
+{
+    WAAPIImportOperation importOperation;
+    AK::WwiseAuthoringAPI::AkJson::Array items;
+
+    //render items imported by this call, same order as items
+    std::vector<const RenderItem*> renderItems;
+};
+
+//Splits render items into import calls, items without a wwise parent are skipped.
+//Wwise struggles with large imports so render items are chunked by WAAPI_IMPORT_BATCH_SIZE,
+//each chunk makes up to one call per import operation (createNew, replaceExisting, useExisting).
+//recallNote is set as the audio source notes for sfx and voice items, pass empty to leave notes alone
+std::vector<ImportBatch> BuildImportPlan(const std::vector<const RenderItem*> &renderItems, const std::string &recallNote);
+
+//the number of calls BuildImportPlan would make, without building them
+size_t CountImportCalls(const std::vector<const RenderItem*> &renderItems);
+
+//What importing a render item will do to the project, decided before rendering from the objects already under the
+//render items' parents (one object.get for the whole queue, see WAAPIHelpers GetChildrenOfObjects)
+enum class PreflightAction
+{
+    //nothing named like the item under its parent, or createNew where an object with the same name exists, which
+    //wwise imports as a new object with a numbered name (see PreflightItem::renamed)
+    Create,
+
+    //replaceExisting/useExisting onto an existing object
+    Replace,
+
+    //replaceExisting/useExisting onto a sound whose original has the same file name as the render, dropped
+    //after rendering if the contents match too (see IsUnchangedImport)
+    Unchanged
+};
+
+//child of a render item parent, as returned by object.get
+struct ExistingObject
+{
+    std::string guid;
+    std::string name;
+    std::string type;
+    std::string parentGuid;
+    std::string originalWavFilePath;
+};
+
+struct PreflightItem
+{
+    PreflightAction action = PreflightAction::Create;
+
+    //Create next to an object of the same name, the new object gets a numbered name
+    bool renamed = false;
+
+    std::string existingGuid;
+    std::string existingOriginal;
+};
+
+struct PreflightPlan
+{
+    //key is the render item audio file path
+    std::unordered_map<std::string, PreflightItem> items;
+
+    uint32 numCreate = 0;
+    uint32 numRenamed = 0;
+    uint32 numReplace = 0;
+    uint32 numUnchanged = 0;
+
+    //import calls made for the render items as they are, and with every Unchanged item dropped
+    size_t numImportCalls = 0;
+    size_t numImportCallsWithoutUnchanged = 0;
+
+    const PreflightItem *Find(const RenderItem &renderItem) const;
+};
+
+//items without a wwise parent are left out
+PreflightPlan BuildPreflightPlan(const std::vector<const RenderItem*> &renderItems, const std::vector<ExistingObject> &existingObjects);
+
+//after rendering, true if the rendered file is byte for byte the existing sound's original
+bool IsUnchangedImport(const RenderItem &renderItem, const PreflightItem &preflightItem);
+
+//"12 create (1 renamed), 3 replace, 40 unchanged"
+std::string FormatPreflightPlan(const PreflightPlan &plan);
+
+//one entry of the "imports" array
+AK::WwiseAuthoringAPI::AkJson MakeImportItem(const RenderItem &renderItem, const std::string &recallNote);
+
+//arguments for ak.wwise.core.audio.import
+AK::WwiseAuthoringAPI::AkJson MakeImportArgs(const AK::WwiseAuthoringAPI::AkJson::Array &items, WAAPIImportOperation importOperation);
+
+inline std::string GetImportOperationString(WAAPIImportOperation operation)
+{
+    switch (operation)
+    {
+    case WAAPIImportOperation::createNew:
+        return std::string("createNew");
+        break;
+    case WAAPIImportOperation::useExisting:
+        return std::string("useExisting");
+        break;
+    case WAAPIImportOperation::replaceExisting:
+        return std::string("replaceExisting");
+        break;
+    default:
+        return std::string();
+        break;
+    }
+}
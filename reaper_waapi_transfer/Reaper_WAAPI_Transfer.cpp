@@ -6,6 +6,8 @@
 #else
 #endif
 
+#include <ctime>
+
 #include "reaper_plugin.h"
 
 #define REAPERAPI_IMPLEMENT
@@ -18,6 +20,12 @@
 #include "resource.h"
 #include "WAAPIHelpers.h"
 #include "WwiseSettingsReader.h"
+#include "RenderQueueReader.h"
+#include "Tracing.h"
+#include "WampMetrics.h"
+#include "WampCapture.h"
+#include "AsyncLog.h"
+#include "config.h"
 
 #define GET_FUNC_AND_CHKERROR(x) if (!((*((void **)&(x)) = (void *)rec->GetFunc(#x)))) ++funcerrcnt
 #define REGISTER_AND_CHKERROR(variable, name, info) if(!(variable = rec->Register(name, (void*)info))) ++regerrcnt
@@ -32,6 +40,69 @@ int g_Waapi_Port;
 //actions
 gaccel_register_t actionOpenTransferWindow = { { 0, 0, 0 }, "Open WAAPI transfer window." };
 gaccel_register_t actionOpenRecallWindow = { { 0, 0, 0 }, "Open WAAPI recall window." };
+gaccel_register_t actionToggleTracing = { { 0, 0, 0 }, "Toggle WAAPI transfer trace recording." };
+gaccel_register_t actionWriteTrace = { { 0, 0, 0 }, "Write WAAPI transfer trace file." };
+gaccel_register_t actionWaapiMetricsReport = { { 0, 0, 0 }, "Show WAAPI call metrics report." };
+gaccel_register_t actionToggleWaapiCapture = { { 0, 0, 0 }, "Toggle WAAPI session capture." };
+gaccel_register_t actionToggleChangedRegionsOnly = { { 0, 0, 0 }, "Toggle WAAPI transfer rendering only changed regions." };
+
+//writes the recorded trace events to the transfer data dir, open with chrome://tracing or ui.perfetto.dev
+static void WriteTraceFile()
+{
+    char timeBuff[32];
+    std::time_t now = std::time(nullptr);
+    std::strftime(timeBuff, sizeof(timeBuff), "%Y%m%d_%H%M%S", std::localtime(&now));
+
+    const fs::path tracePath = GetTransferDataDir() / (TRACE_FILENAME_PREFIX + timeBuff + ".json");
+    if (AK::WwiseAuthoringAPI::Tracing::WriteChromeTrace(tracePath.string()))
+    {
+        ShowConsoleMsg(("WAAPI Transfer: wrote trace to " + tracePath.string() + "\n").c_str());
+    }
+    else
+    {
+        ShowConsoleMsg(("WAAPI Transfer: failed to write trace to " + tracePath.string() + "\n").c_str());
+    }
+}
+
+//starts recording every wamp frame to a new file in the transfer data dir, or stops the current recording
+static void ToggleWaapiCapture()
+{
+    using namespace AK::WwiseAuthoringAPI;
+
+    if (WampCapture::IsCapturing())
+    {
+        const std::string capturePath = WampCapture::GetPath();
+        WampCapture::Stop();
+        ShowConsoleMsg(("WAAPI Transfer: session capture written to " + capturePath + "\n").c_str());
+        return;
+    }
+
+    char timeBuff[32];
+    std::time_t now = std::time(nullptr);
+    std::strftime(timeBuff, sizeof(timeBuff), "%Y%m%d_%H%M%S", std::localtime(&now));
+
+    const fs::path capturePath = GetTransferDataDir() / (WAAPI_CAPTURE_FILENAME_PREFIX + timeBuff + ".wampcap");
+    if (WampCapture::Start(capturePath.string()))
+    {
+        ShowConsoleMsg(("WAAPI Transfer: capturing session to " + capturePath.string() + "\n").c_str());
+    }
+    else
+    {
+        ShowConsoleMsg(("WAAPI Transfer: failed to open " + capturePath.string() + " for capture\n").c_str());
+    }
+}
+
+//prints the per uri call metrics to the console and writes them next to the transfer history
+static void ShowWaapiMetricsReport()
+{
+    using namespace AK::WwiseAuthoringAPI;
+
+    const fs::path metricsPath = GetTransferDataDir() / WAAPI_METRICS_FILENAME;
+    WampMetrics::WriteJson(metricsPath.string());
+
+    ShowConsoleMsg(("WAAPI call metrics (" + metricsPath.string() + ")\n").c_str());
+    ShowConsoleMsg(WampMetrics::FormatReport().c_str());
+}
 
 //produces an error message during reaper startup
 //similar to SWS function ErrMsg in sws_extension.cpp
@@ -54,12 +125,16 @@ extern "C"
         if (!rec)
         {
 			UnhookWindowsHookEx(g_winHook);
+            AK::WwiseAuthoringAPI::AsyncLog::Shutdown();
+            AK::WwiseAuthoringAPI::AsyncLog::CloseFile();
             return 0;
         }
         //set globals
         g_parentWindow = rec->hwnd_main;
         g_hInst = hInstance;
 
+        WAAPI_TRACE_THREAD_NAME("Reaper main");
+
         //get func pointers that we need
         int funcerrcnt = 0;
         GET_FUNC_AND_CHKERROR(Main_OnCommand);
@@ -82,6 +157,9 @@ extern "C"
         GET_FUNC_AND_CHKERROR(GetSetMediaTrackInfo_String);
         GET_FUNC_AND_CHKERROR(CountTracks);
         GET_FUNC_AND_CHKERROR(CountProjectMarkers);
+        GET_FUNC_AND_CHKERROR(CountSelectedTracks);
+        GET_FUNC_AND_CHKERROR(GetSelectedTrack);
+        GET_FUNC_AND_CHKERROR(IsProjectDirty);
         GET_FUNC_AND_CHKERROR(ShowConsoleMsg);
 
 		g_winHook = SetWindowsHookExA(WH_KEYBOARD_LL, TransferWindow_ReaperKeyboardHook, g_hInst, 0);
@@ -98,6 +176,11 @@ extern "C"
         int regerrcnt = 0;
         REGISTER_AND_CHKERROR(actionOpenTransferWindow.accel.cmd, "command_id", "actionOpenTransferWindow");
         REGISTER_AND_CHKERROR(actionOpenRecallWindow.accel.cmd, "command_id", "actionOpenRecallWindow");
+        REGISTER_AND_CHKERROR(actionToggleTracing.accel.cmd, "command_id", "actionToggleWaapiTransferTracing");
+        REGISTER_AND_CHKERROR(actionWriteTrace.accel.cmd, "command_id", "actionWriteWaapiTransferTrace");
+        REGISTER_AND_CHKERROR(actionWaapiMetricsReport.accel.cmd, "command_id", "actionWaapiMetricsReport");
+        REGISTER_AND_CHKERROR(actionToggleWaapiCapture.accel.cmd, "command_id", "actionToggleWaapiCapture");
+        REGISTER_AND_CHKERROR(actionToggleChangedRegionsOnly.accel.cmd, "command_id", "actionToggleWaapiTransferChangedRegionsOnly");
         if (regerrcnt)
         {
             StartupError("An error occured whilst initializing the WAAPI Transfer actions.\n"
@@ -108,6 +191,11 @@ extern "C"
         //register actions
         plugin_register("gaccel", &actionOpenRecallWindow.accel);
         plugin_register("gaccel", &actionOpenTransferWindow.accel);
+        plugin_register("gaccel", &actionToggleTracing.accel);
+        plugin_register("gaccel", &actionWriteTrace.accel);
+        plugin_register("gaccel", &actionWaapiMetricsReport.accel);
+        plugin_register("gaccel", &actionToggleWaapiCapture.accel);
+        plugin_register("gaccel", &actionToggleChangedRegionsOnly.accel);
 
         rec->Register("hookcommand", (void*)HookCommandProc);
 
@@ -131,6 +219,10 @@ extern "C"
             InsertMenuItem(hMenu, 1, true, &mi);
         }
 
+        //the wamp client logs from its own threads, the log file is written in the background
+        const fs::path waapiLogPath = GetTransferDataDir() / WAAPI_LOG_FILENAME;
+        AK::WwiseAuthoringAPI::AsyncLog::OpenFile(waapiLogPath.string(), WAAPI_LOG_MAX_BYTES, WAAPI_LOG_NUM_BACKUPS);
+
         //setup images
         WwiseImageList::LoadIcons({
             { "WorkUnit", IDI_WORKUNIT },
@@ -186,5 +278,35 @@ bool HookCommandProc(int command, int flag)
         OpenRecallWindow();
         return true;
     }
+    if (command == actionToggleTracing.accel.cmd)
+    {
+        using namespace AK::WwiseAuthoringAPI;
+        Tracing::SetEnabled(!Tracing::IsEnabled());
+        ShowConsoleMsg(Tracing::IsEnabled() ? "WAAPI Transfer: trace recording on\n" : "WAAPI Transfer: trace recording off\n");
+        return true;
+    }
+    if (command == actionWriteTrace.accel.cmd)
+    {
+        WriteTraceFile();
+        return true;
+    }
+    if (command == actionWaapiMetricsReport.accel.cmd)
+    {
+        ShowWaapiMetricsReport();
+        return true;
+    }
+    if (command == actionToggleWaapiCapture.accel.cmd)
+    {
+        ToggleWaapiCapture();
+        return true;
+    }
+    if (command == actionToggleChangedRegionsOnly.accel.cmd)
+    {
+        WAAPITransfer::SetRenderChangedRegionsOnly(!WAAPITransfer::ShouldRenderChangedRegionsOnly());
+        ShowConsoleMsg(WAAPITransfer::ShouldRenderChangedRegionsOnly()
+                       ? "WAAPI Transfer: rendering only changed regions\n"
+                       : "WAAPI Transfer: rendering all regions\n");
+        return true;
+    }
     return false;
 }
\ No newline at end of file
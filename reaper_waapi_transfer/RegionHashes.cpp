@@ -0,0 +1,716 @@
+#include <algorithm>
+#include <cctype>
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+
+#include "RegionHashes.h"
+#include "RenderQueueParser.h"
+#include "config.h"
+
+//FNV-1a, 64 bit
+static const uint64_t HASH_SEED = 14695981039346656037ull;
+
+static uint64_t HashBytes(uint64_t hash, const void *data, size_t size)
+{
+    const unsigned char *bytes = static_cast<const unsigned char*>(data);
+    for (size_t i = 0; i < size; ++i)
+    {
+        hash ^= bytes[i];
+        hash *= 1099511628211ull;
+    }
+    return hash;
+}
+
+static uint64_t HashString(uint64_t hash, const std::string &text)
+{
+    //the length keeps "ab" "c" and "a" "bc" apart
+    const uint64_t length = text.size();
+    hash = HashBytes(hash, &length, sizeof(length));
+    return HashBytes(hash, text.data(), text.size());
+}
+
+template <typename T>
+static uint64_t HashValue(uint64_t hash, T value)
+{
+    return HashBytes(hash, &value, sizeof(value));
+}
+
+static std::string ToLower(std::string text)
+{
+    std::transform(text.begin(), text.end(), text.begin(), [](char c) { return static_cast<char>(tolower(c)); });
+    return text;
+}
+
+//the line without its indentation
+static std::string TrimLine(const std::string &line)
+{
+    const size_t start = line.find_first_not_of(" \t");
+    if (start == std::string::npos)
+    {
+        return std::string();
+    }
+
+    size_t end = line.size();
+    while (end > start && (line[end - 1] == '\r' || line[end - 1] == '\n'))
+    {
+        --end;
+    }
+    return line.substr(start, end - start);
+}
+
+static std::string FirstToken(const std::string &text)
+{
+    return text.substr(0, text.find(' '));
+}
+
+//lines that only hold selection, window or lane state, changing them doesn't change what renders
+static bool IsUiStateLine(const std::string &token)
+{
+    static const char *s_uiTokens[] =
+    {
+        "SEL", "TRACKHEIGHT", "MASTERTRACKHEIGHT", "PEAKCOL", "MASTERPEAKCOL", "FLOATPOS", "WNDRECT", "SHOW",
+        "LASTSEL", "DOCKED", "VIS", "LANEHEIGHT"
+    };
+
+    for (const char *uiToken : s_uiTokens)
+    {
+        if (token == uiToken)
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+//project lines that change every render: tempo, sample rate, render format and tail, the master track
+//RENDER_FILE and RENDER_PATTERN only change where outputs go, the output paths are hashed per item
+static bool IsProjectAudioLine(const std::string &token)
+{
+    if (token == "RENDER_FILE" || token == "RENDER_PATTERN")
+    {
+        return false;
+    }
+
+    return token == "TEMPO" || token == "SAMPLERATE" || token == "PLAYRATE"
+        || token.compare(0, 7, "RENDER_") == 0 || token.compare(0, 6, "MASTER") == 0
+        || token.compare(0, 8, "<RENDER_") == 0 || token.compare(0, 7, "<MASTER") == 0 || token == "<TEMPOENVEX";
+}
+
+//hashes the rest of a block whose opening line was just read, nested blocks included
+static uint64_t HashBlock(std::istream &stream, uint64_t hash)
+{
+    std::string line;
+    int depth = 0;
+    while (std::getline(stream, line))
+    {
+        const std::string text = TrimLine(line);
+        if (text.empty())
+        {
+            continue;
+        }
+
+        if (text[0] == '>')
+        {
+            if (!depth)
+            {
+                break;
+            }
+            --depth;
+        }
+        else if (text[0] == '<')
+        {
+            ++depth;
+        }
+
+        if (!IsUiStateLine(FirstToken(text)))
+        {
+            hash = HashString(hash, text);
+        }
+    }
+    return hash;
+}
+
+static void SkipBlock(std::istream &stream)
+{
+    std::string line;
+    int depth = 0;
+    while (std::getline(stream, line))
+    {
+        const std::string text = TrimLine(line);
+        if (text.empty())
+        {
+            continue;
+        }
+
+        if (text[0] == '>')
+        {
+            if (!depth)
+            {
+                break;
+            }
+            --depth;
+        }
+        else if (text[0] == '<')
+        {
+            ++depth;
+        }
+    }
+}
+
+struct HashedItem
+{
+    double start;
+    double end;
+    uint64_t hash;
+
+    //FILE lines of the item's sources, hashed by size and time once the project directory is known
+    std::vector<std::string> mediaFiles;
+};
+
+struct HashedTrack
+{
+    std::string guid;
+    uint64_t stateHash = HASH_SEED;
+
+    //second ISBUS field, see ReaperTrack in RenderQueueParser.cpp
+    int folderDepthChange = 0;
+
+    //track indices of AUXRECV sends into this track
+    std::vector<int> auxSources;
+
+    //sorted by start
+    std::vector<HashedItem> items;
+    double maxItemLength = 0.0;
+};
+
+static HashedItem ParseItem(std::istream &stream)
+{
+    HashedItem item{};
+    item.hash = HASH_SEED;
+
+    double position = 0.0;
+    double length = 0.0;
+    std::string line;
+    int depth = 0;
+    while (std::getline(stream, line))
+    {
+        const std::string text = TrimLine(line);
+        if (text.empty())
+        {
+            continue;
+        }
+
+        if (text[0] == '>')
+        {
+            if (!depth)
+            {
+                break;
+            }
+            --depth;
+            continue;
+        }
+        if (text[0] == '<')
+        {
+            ++depth;
+        }
+
+        const std::string token = FirstToken(text);
+        if (IsUiStateLine(token))
+        {
+            continue;
+        }
+
+        std::stringstream lineStream(text);
+        std::string skipToken;
+        lineStream >> skipToken;
+        if (!depth && token == "POSITION")
+        {
+            lineStream >> position;
+        }
+        else if (!depth && token == "LENGTH")
+        {
+            lineStream >> length;
+        }
+        else if (token == "FILE")
+        {
+            item.mediaFiles.push_back(GetStringToken(lineStream));
+        }
+
+        item.hash = HashString(item.hash, text);
+    }
+
+    item.start = position;
+    item.end = position + length;
+    return item;
+}
+
+static void ParseTrack(std::istream &stream, HashedTrack &track)
+{
+    std::string line;
+    while (std::getline(stream, line))
+    {
+        const std::string text = TrimLine(line);
+        if (text.empty())
+        {
+            continue;
+        }
+        if (text[0] == '>')
+        {
+            break;
+        }
+
+        const std::string token = FirstToken(text);
+        if (token == "<ITEM")
+        {
+            track.items.push_back(ParseItem(stream));
+            continue;
+        }
+        if (text[0] == '<')
+        {
+            //fx chains, envelopes and the like, all of it counts
+            track.stateHash = HashBlock(stream, HashString(track.stateHash, text));
+            continue;
+        }
+        if (IsUiStateLine(token))
+        {
+            continue;
+        }
+
+        std::stringstream lineStream(text);
+        std::string skipToken;
+        lineStream >> skipToken;
+        if (token == "ISBUS")
+        {
+            int busState;
+            lineStream >> busState >> track.folderDepthChange;
+        }
+        else if (token == "AUXRECV")
+        {
+            int sourceTrack;
+            if (lineStream >> sourceTrack)
+            {
+                track.auxSources.push_back(sourceTrack);
+            }
+        }
+
+        track.stateHash = HashString(track.stateHash, text);
+    }
+}
+
+std::string RegionHashes::GetRegionKey(const RenderItem &renderItem)
+{
+    if (renderItem.regionRenderFlags & RenderBoundsRegion)
+    {
+        return std::to_string(renderItem.reaperRegionId) + ' ' + renderItem.regionName;
+    }
+    return "range";
+}
+
+bool RegionHashes::Compute(const fs::path &rppPath, const std::vector<const RenderItem*> &renderItems)
+{
+    m_hashes.clear();
+    m_reaperProject = rppPath.generic_string();
+
+    std::ifstream file(rppPath);
+    if (!file.is_open())
+    {
+        return false;
+    }
+
+    uint64_t projectHash = HASH_SEED;
+    double tailSeconds = 0.0;
+    std::vector<HashedTrack> tracks;
+
+    //first line is <REAPER_PROJECT with the version and save time, the time changes every save
+    std::string line;
+    std::getline(file, line);
+
+    while (std::getline(file, line))
+    {
+        const std::string text = TrimLine(line);
+        if (text.empty() || text[0] == '>')
+        {
+            continue;
+        }
+
+        const std::string token = FirstToken(text);
+        std::stringstream lineStream(text);
+        std::string skipToken;
+        lineStream >> skipToken;
+
+        if (token == "<TRACK")
+        {
+            tracks.emplace_back();
+            lineStream >> tracks.back().guid;
+            ParseTrack(file, tracks.back());
+            continue;
+        }
+
+        if (text[0] == '<')
+        {
+            if (IsProjectAudioLine(token))
+            {
+                projectHash = HashBlock(file, HashString(projectHash, text));
+            }
+            else
+            {
+                SkipBlock(file);
+            }
+            continue;
+        }
+
+        if (token == "QUEUED_RENDER_ORIGINAL_FILENAME")
+        {
+            m_reaperProject = GetStringToken(lineStream);
+            continue;
+        }
+
+        if (token == "RENDER_RANGE")
+        {
+            //mode, start, end, tail flags, tail length in ms
+            int rangeMode, tailFlags, tailMs = 0;
+            double rangeStart, rangeEnd;
+            lineStream >> rangeMode >> rangeStart >> rangeEnd >> tailFlags >> tailMs;
+            tailSeconds = tailMs / 1000.0;
+        }
+
+        if (IsProjectAudioLine(token))
+        {
+            projectHash = HashString(projectHash, text);
+        }
+    }
+
+    //relative media paths are relative to the project the queued render was made from
+    std::string projectDir = m_reaperProject;
+    std::replace(projectDir.begin(), projectDir.end(), '\\', '/');
+    const fs::path mediaDir = fs::path(projectDir).parent_path();
+
+    std::unordered_map<std::string, int> trackIndices;
+    std::vector<std::vector<int>> feeders(tracks.size());
+    std::vector<int> openFolders;
+    for (size_t i = 0; i < tracks.size(); ++i)
+    {
+        HashedTrack &track = tracks[i];
+        trackIndices.insert({ track.guid, static_cast<int>(i) });
+
+        for (HashedItem &item : track.items)
+        {
+            for (const std::string &mediaFile : item.mediaFiles)
+            {
+                std::string mediaPath = mediaFile;
+                std::replace(mediaPath.begin(), mediaPath.end(), '\\', '/');
+                fs::path path(mediaPath);
+                if (path.is_relative())
+                {
+                    path = mediaDir / path;
+                }
+
+                std::error_code error;
+                const uintmax_t size = fs::file_size(path, error);
+                const auto writeTime = fs::last_write_time(path, error).time_since_epoch().count();
+                item.hash = HashValue(HashValue(item.hash, error ? 0 : size), error ? 0 : writeTime);
+            }
+            track.maxItemLength = std::max(track.maxItemLength, item.end - item.start);
+        }
+        std::sort(track.items.begin(), track.items.end(), [](const HashedItem &a, const HashedItem &b)
+        {
+            return a.start < b.start;
+        });
+
+        //a folder track renders its children, a track with receives renders what is sent to it
+        if (!openFolders.empty())
+        {
+            feeders[openFolders.back()].push_back(static_cast<int>(i));
+        }
+        if (track.folderDepthChange > 0)
+        {
+            openFolders.push_back(static_cast<int>(i));
+        }
+        else if (track.folderDepthChange < 0)
+        {
+            const size_t numClosed = std::min<size_t>(-track.folderDepthChange, openFolders.size());
+            openFolders.resize(openFolders.size() - numClosed);
+        }
+
+        for (int source : track.auxSources)
+        {
+            if (source >= 0 && source < static_cast<int>(tracks.size()))
+            {
+                feeders[i].push_back(source);
+            }
+        }
+    }
+
+    std::vector<char> isDependency(tracks.size());
+    std::vector<int> pending;
+    for (const RenderItem *renderItem : renderItems)
+    {
+        //the item was never matched to what rendered it
+        if (!renderItem->regionRenderFlags)
+        {
+            m_hashes.clear();
+            return false;
+        }
+
+        //every track for the master mix, otherwise the stem's track and whatever feeds it
+        std::fill(isDependency.begin(), isDependency.end(), 0);
+        if (renderItem->regionRenderFlags & RenderSourceMaster)
+        {
+            std::fill(isDependency.begin(), isDependency.end(), 1);
+        }
+        else
+        {
+            auto found = trackIndices.find(renderItem->trackStemGuid);
+            if (found == trackIndices.end())
+            {
+                m_hashes.clear();
+                return false;
+            }
+
+            pending.assign(1, found->second);
+            while (!pending.empty())
+            {
+                const int track = pending.back();
+                pending.pop_back();
+                if (!isDependency[track])
+                {
+                    isDependency[track] = 1;
+                    pending.insert(pending.end(), feeders[track].begin(), feeders[track].end());
+                }
+            }
+        }
+
+        uint64_t &hash = m_hashes.insert({ GetRegionKey(*renderItem), projectHash }).first->second;
+        hash = HashString(hash, ToLower(renderItem->audioFilePath.generic_string()));
+        hash = HashString(hash, renderItem->wwiseGuid);
+        hash = HashString(hash, renderItem->wwiseOriginalsSubpath);
+        hash = HashValue(hash, static_cast<int>(renderItem->importOperation));
+        hash = HashValue(hash, static_cast<int>(renderItem->importObjectType));
+        hash = HashValue(hash, renderItem->wwiseLanguageIndex);
+        hash = HashValue(hash, renderItem->inTime);
+        hash = HashValue(hash, renderItem->outTime);
+
+        const double start = renderItem->inTime;
+        const double end = renderItem->outTime + tailSeconds;
+        for (size_t i = 0; i < tracks.size(); ++i)
+        {
+            if (!isDependency[i])
+            {
+                continue;
+            }
+
+            const HashedTrack &track = tracks[i];
+            hash = HashValue(hash, track.stateHash);
+
+            //nothing starting before start - maxItemLength can reach start
+            auto item = std::lower_bound(track.items.begin(), track.items.end(), start - track.maxItemLength,
+                                         [](const HashedItem &item, double time) { return item.start < time; });
+            for (; item != track.items.end() && item->start < end; ++item)
+            {
+                if (item->end > start)
+                {
+                    hash = HashValue(hash, item->hash);
+                }
+            }
+        }
+    }
+
+    return true;
+}
+
+std::unordered_set<std::string> RegionHashes::FindUnchanged(const RegionHashes &previous) const
+{
+    std::unordered_set<std::string> unchanged;
+    for (const auto &region : m_hashes)
+    {
+        auto found = previous.m_hashes.find(region.first);
+        if (found != previous.m_hashes.end() && found->second == region.second)
+        {
+            unchanged.insert(region.first);
+        }
+    }
+    return unchanged;
+}
+
+void RegionHashes::Merge(const RegionHashes &newer)
+{
+    m_reaperProject = newer.m_reaperProject;
+    for (const auto &region : newer.m_hashes)
+    {
+        m_hashes[region.first] = region.second;
+    }
+}
+
+void RegionHashes::Forget(const std::string &regionKey)
+{
+    m_hashes.erase(regionKey);
+}
+
+fs::path RegionHashes::GetStorePath(const fs::path &dir, const std::string &reaperProject)
+{
+    //windows paths aren't case sensitive
+    const uint64_t hash = HashString(HASH_SEED, ToLower(reaperProject));
+
+    char fileName[32];
+    snprintf(fileName, sizeof(fileName), "%016llx", static_cast<unsigned long long>(hash));
+    return dir / (fileName + REGION_HASH_EXTENSION);
+}
+
+bool RegionHashes::Load(const fs::path &path)
+{
+    m_reaperProject.clear();
+    m_hashes.clear();
+
+    std::ifstream file(path);
+    if (!file.is_open())
+    {
+        return false;
+    }
+
+    //first line is the reaper project, then one region per line: hash in hex, region key
+    if (!std::getline(file, m_reaperProject))
+    {
+        return false;
+    }
+
+    std::string line;
+    while (std::getline(file, line))
+    {
+        std::stringstream lineStream(line);
+        std::string hashText;
+        std::string key;
+        if (!(lineStream >> hashText))
+        {
+            continue;
+        }
+
+        std::getline(lineStream >> std::ws, key);
+        if (!key.empty())
+        {
+            m_hashes[key] = std::strtoull(hashText.c_str(), nullptr, 16);
+        }
+    }
+
+    return true;
+}
+
+bool RegionHashes::Save(const fs::path &path) const
+{
+    fs::path tempPath = path;
+    tempPath += ".tmp";
+
+    {
+        std::ofstream file(tempPath, std::ios::trunc);
+        if (!file.is_open())
+        {
+            return false;
+        }
+
+        file << m_reaperProject << '\n';
+        char hashText[32];
+        for (const auto &region : m_hashes)
+        {
+            snprintf(hashText, sizeof(hashText), "%016llx", static_cast<unsigned long long>(region.second));
+            file << hashText << ' ' << region.first << '\n';
+        }
+
+        if (!file.good())
+        {
+            return false;
+        }
+    }
+
+    std::error_code error;
+    fs::rename(tempPath, path, error);
+    return !error;
+}
+
+bool WriteReducedRenderQueue(const fs::path &rppPath, const std::vector<const RenderItem*> &skippedItems)
+{
+    std::unordered_set<int> skippedRegions;
+    std::unordered_set<std::string> skippedFiles;
+    for (const RenderItem *renderItem : skippedItems)
+    {
+        if (renderItem->regionRenderFlags & RenderBoundsRegion)
+        {
+            skippedRegions.insert(renderItem->reaperRegionId);
+        }
+        skippedFiles.insert(ToLower(renderItem->audioFilePath.generic_string()));
+    }
+
+    std::ifstream file(rppPath);
+    if (!file.is_open())
+    {
+        return false;
+    }
+
+    fs::path tempPath = rppPath;
+    tempPath += ".tmp";
+
+    {
+        std::ofstream reduced(tempPath, std::ios::trunc);
+        if (!reduced.is_open())
+        {
+            return false;
+        }
+
+        //a region's REGIONRENDER block follows its first MARKER line
+        bool afterSkippedRegion = false;
+
+        std::string line;
+        while (std::getline(file, line))
+        {
+            std::stringstream lineStream(line);
+            std::string token;
+            lineStream >> token;
+
+            if (token == "QUEUED_RENDER_OUTFILE")
+            {
+                const fs::path outputPath(GetStringToken(lineStream));
+                if (skippedFiles.count(ToLower(outputPath.generic_string())))
+                {
+                    continue;
+                }
+            }
+            else if (token == "MARKER")
+            {
+                //id, time, name, render flags, markers have none and share ids with regions
+                int markerId = 0;
+                double markerTime;
+                lineStream >> markerId >> markerTime;
+                GetStringToken(lineStream);
+                int markerFlags = 0;
+                lineStream >> markerFlags;
+                if (markerFlags && skippedRegions.count(markerId))
+                {
+                    afterSkippedRegion = true;
+                    continue;
+                }
+            }
+            else if (token == "<REGIONRENDER" && afterSkippedRegion)
+            {
+                SkipBlock(file);
+                continue;
+            }
+
+            afterSkippedRegion = false;
+            reduced << line << '\n';
+        }
+
+        if (!reduced.good())
+        {
+            return false;
+        }
+    }
+
+    file.close();
+    std::error_code error;
+    fs::rename(tempPath, rppPath, error);
+    if (error)
+    {
+        fs::remove(tempPath, error);
+        return false;
+    }
+    return true;
+}
@@ -0,0 +1,58 @@
+#pragma once
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "types.h"
+
+//Content hash of every region a queued render renders, so regions that haven't changed since the last successful
+//transfer can be left out of the render and keep what wwise already has.
+//A region's hash covers everything in the RPP that can change its outputs: the items overlapping it (render tail
+//included) on the tracks it renders, the state of those tracks (fx, envelopes, routing) and of the tracks feeding them
+//through folders and sends, every track for master mix outputs, the master track, tempo, sample rate and render
+//format. The output paths and wwise settings of its render items are in it too, so a region is rendered again
+//when it would be imported somewhere else. Media files are hashed by size and modification time, not contents.
+//Renders with custom bounds count as one region. No reaper api in here, see WAAPITransfer::ReduceRenderQueues.
+class RegionHashes
+{
+public:
+    //hashes the regions of renderItems, as ParseRenderQueue gave them for the same file
+    //false if the file can't be read or an item wasn't matched to its region and track, nothing can be skipped then
+    bool Compute(const fs::path &rppPath, const std::vector<const RenderItem*> &renderItems);
+
+    //the project a queued render was made from (QUEUED_RENDER_ORIGINAL_FILENAME), the file itself otherwise
+    const std::string &GetReaperProject() const { return m_reaperProject; }
+
+    //"<region id> <region name>", or "range" for custom bounds
+    static std::string GetRegionKey(const RenderItem &renderItem);
+
+    typedef std::unordered_map<std::string, uint64_t> HashMap;
+    const HashMap &GetHashes() const { return m_hashes; }
+
+    //regions hashed the same here and in previous
+    std::unordered_set<std::string> FindUnchanged(const RegionHashes &previous) const;
+
+    //takes the hashes of newer, regions only this has keep theirs
+    void Merge(const RegionHashes &newer);
+
+    //the region counts as changed next time, for regions whose outputs weren't imported
+    void Forget(const std::string &regionKey);
+
+    //file of a reaper project's region hashes inside dir
+    static fs::path GetStorePath(const fs::path &dir, const std::string &reaperProject);
+
+    //returns false if the file couldn't be opened, nothing is loaded in that case
+    bool Load(const fs::path &path);
+
+    //written to a temporary file and renamed over path
+    bool Save(const fs::path &path) const;
+
+private:
+    std::string m_reaperProject;
+    HashMap m_hashes;
+};
+
+//rewrites a queued render without the regions of skippedItems and their QUEUED_RENDER_OUTFILE lines, reaper then
+//only renders the rest. Returns false if the file couldn't be rewritten, it is left as it was then
+bool WriteReducedRenderQueue(const fs::path &rppPath, const std::vector<const RenderItem*> &skippedItems);
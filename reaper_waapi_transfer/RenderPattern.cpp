@@ -0,0 +1,149 @@
+#include <cctype>
+#include <cstring>
+
+#include "RenderPattern.h"
+
+void RenderPattern::Compile(const std::string &pattern)
+{
+    //longest names first so $regionnumber isn't read as $region followed by "number"
+    static const std::pair<const char*, Wildcard> s_wildcards[] =
+    {
+        { "regionnumber", Wildcard::RegionNumber },
+        { "tracknumber",  Wildcard::TrackNumber },
+        { "parenttrack",  Wildcard::ParentTrack },
+        { "project",      Wildcard::Project },
+        { "folders",      Wildcard::Folders },
+        { "region",       Wildcard::Region },
+        { "track",        Wildcard::Track }
+    };
+
+    m_tokens.clear();
+    m_literals.clear();
+    m_isPredictable = true;
+    m_usesTrack = false;
+
+    auto AddLiteral = [this](const char *text, size_t length)
+    {
+        if (!m_tokens.empty() && m_tokens.back().wildcard == Wildcard::Literal)
+        {
+            m_tokens.back().literalLength += length;
+        }
+        else
+        {
+            m_tokens.push_back(Token{ Wildcard::Literal, m_literals.size(), length });
+        }
+        m_literals.append(text, length);
+    };
+
+    const char *text = pattern.c_str();
+    while (*text)
+    {
+        if (*text != '$' || !isalpha(static_cast<unsigned char>(text[1])))
+        {
+            //reaper patterns use either slash for sub directories
+            AddLiteral(*text == '\\' ? "/" : text, 1);
+            ++text;
+            continue;
+        }
+
+        ++text;
+        Wildcard wildcard = Wildcard::Unknown;
+        size_t nameLength = 0;
+        for (const auto &known : s_wildcards)
+        {
+            const size_t length = strlen(known.first);
+            if (strncmp(text, known.first, length) == 0)
+            {
+                wildcard = known.second;
+                nameLength = length;
+                break;
+            }
+        }
+
+        if (wildcard == Wildcard::Unknown)
+        {
+            //$date, $filenumber and the like, skip the name
+            while (isalnum(static_cast<unsigned char>(text[nameLength])))
+            {
+                ++nameLength;
+            }
+            m_isPredictable = false;
+        }
+
+        m_usesTrack |= wildcard == Wildcard::Track || wildcard == Wildcard::TrackNumber;
+        m_tokens.push_back(Token{ wildcard, 0, 0 });
+        text += nameLength;
+    }
+}
+
+static void AppendFileNamePart(const std::string &value, std::string &nameOut)
+{
+    for (char c : value)
+    {
+        nameOut.push_back(strchr("\\/:*?\"<>|", c) ? '_' : c);
+    }
+}
+
+void RenderPattern::Evaluate(const RenderPatternValues &values, std::string &nameOut) const
+{
+    nameOut.clear();
+    for (const Token &token : m_tokens)
+    {
+        switch (token.wildcard)
+        {
+        case Wildcard::Literal:
+            nameOut.append(m_literals, token.literalStart, token.literalLength);
+            break;
+
+        case Wildcard::Project:
+            AppendFileNamePart(values.project, nameOut);
+            break;
+
+        case Wildcard::Region:
+            AppendFileNamePart(values.region, nameOut);
+            break;
+
+        case Wildcard::RegionNumber:
+            if (values.hasRegion)
+            {
+                nameOut += std::to_string(values.regionNumber);
+            }
+            break;
+
+        case Wildcard::Track:
+            AppendFileNamePart(values.track, nameOut);
+            break;
+
+        case Wildcard::TrackNumber:
+            if (values.trackNumber)
+            {
+                nameOut += std::to_string(values.trackNumber);
+            }
+            break;
+
+        case Wildcard::ParentTrack:
+            if (values.folders && !values.folders->empty())
+            {
+                AppendFileNamePart(values.folders->back(), nameOut);
+            }
+            break;
+
+        case Wildcard::Folders:
+            if (values.folders)
+            {
+                for (size_t i = 0; i < values.folders->size(); ++i)
+                {
+                    if (i)
+                    {
+                        nameOut += '/';
+                    }
+                    AppendFileNamePart((*values.folders)[i], nameOut);
+                }
+            }
+            break;
+
+        default:
+            break;
+        }
+    }
+}
@@ -0,0 +1,72 @@
+#pragma once
+#include <string>
+#include <vector>
+
+#include "types.h"
+
+//What a render output's wildcards stand for
+struct RenderPatternValues
+{
+    std::string project;
+
+    //empty with hasRegion false for custom bounds
+    bool hasRegion = false;
+    std::string region;
+    uint32 regionNumber = 0;
+
+    //empty with trackNumber 0 for the master mix
+    std::string track;
+    uint32 trackNumber = 0;
+
+    //folder tracks above the track, outermost first
+    const std::vector<std::string> *folders = nullptr;
+};
+
+//A reaper render pattern (RENDER_PATTERN, "$region-$track") compiled once into literals and wildcards so the
+//output name of every region and track can be worked out before rendering.
+//Only wildcards that come from the project's regions and tracks are understood: $project, $region,
+//$regionnumber, $track, $tracknumber, $parenttrack and $folders. Anything else ($date, $filenumber, ...)
+//makes the pattern unpredictable, outputs have to be matched up some other way then.
+class RenderPattern
+{
+public:
+    void Compile(const std::string &pattern);
+
+    //false if the pattern has wildcards Evaluate doesn't know
+    bool IsPredictable() const { return m_isPredictable; }
+
+    //true if the output name changes with the track, stems can't be told apart by name otherwise
+    bool UsesTrack() const { return m_usesTrack; }
+
+    //the output path relative to the render directory, without extension, '/' between directories
+    //reaper replaces characters file names can't have in wildcard values, so does this
+    void Evaluate(const RenderPatternValues &values, std::string &nameOut) const;
+
+private:
+    enum class Wildcard
+    {
+        Literal,
+        Project,
+        Region,
+        RegionNumber,
+        Track,
+        TrackNumber,
+        ParentTrack,
+        Folders,
+        Unknown
+    };
+
+    struct Token
+    {
+        Wildcard wildcard;
+
+        //literal text in m_literals
+        size_t literalStart;
+        size_t literalLength;
+    };
+
+    std::vector<Token> m_tokens;
+    std::string m_literals;
+    bool m_isPredictable = true;
+    bool m_usesTrack = false;
+};
@@ -0,0 +1,949 @@
+#include <algorithm>
+#include <cctype>
+#include <fstream>
+#include <sstream>
+#include <unordered_map>
+
+#include "RenderPattern.h"
+#include "RenderQueueParser.h"
+#include "Tracing.h"
+
+/*
+ Info for parsing render queue item infomation from RPP files
+
+ - RENDER_RANGE
+    - first number indicates 0 based index of the selected render bounds option
+    - 0 = Custom Time Range
+    - 1 = Entire Project
+    - 2 = Time Selection
+    - 3 = Project Regions
+
+
+ - RENDER_STEMS
+    - Based off whats selected in 'Source' render option
+    - 0 = Master Mix
+    - 1 = Master Mix + Stems
+    - 3 = Stems: Selected Tracks
+    - 8 = Render Region Matrix
+    - 32 = Selected Media Items
+
+
+ - Regions:
+             region id    time (dont care for now)     name    RenderSettingsId     Not sure what the rest of this is, doesn't seem relevant ATM.
+      MARKER     2        6.67291127704084            "NAME"       5               0          1       R
+
+
+
+      RenderSettingsID:
+        - 0 = normal markers (dont care for now)
+        - 1 = Tracks listed below under <REGIONRENDER
+        - 4 = all tracks 
+        - 5 = Master mix + tracks below
+        - 7 = Master mix + all tracks
+*/
+
+//NOTE: This is not a fully featured RPP parser, just implements enough to get needed infomation 
+//for searching render items by region and track 
+
+//This parser isn't implemented yet --
+
+enum ReaperRegionRenderFlags
+{
+    RegionSelectedTracks    = 1 << 0,
+    RegionAllTracks         = 1 << 1,
+    RegionMasterMix         = 1 << 2
+};
+
+enum class ReaperRenderRangeMode
+{
+    CustomTimeRange = 0,
+    EntireProject   = 1,
+    TimeSelection   = 2,
+    ProjectRegions  = 3
+};
+
+
+
+struct ReaperRegion
+{
+    std::string note;
+    std::vector<std::string> regionRenderTracks;
+    uint32 id;
+    uint32 regionRenderFlags{};
+
+    //region bounds in project time (seconds)
+    double startTime{};
+    double endTime{};
+};
+
+struct ReaperTrack
+{
+    std::string name;
+    std::string guid;
+    bool isSelected{};
+
+    //second ISBUS field: 1 opens a folder with this track as its parent, -n is the last track of n folders
+    int folderDepthChange{};
+};
+
+//render settings and what they render from, read from a project or the copy of it a queued render keeps
+struct ReaperRenderInfo
+{
+    ReaperRenderRangeMode rangeMode{};
+    uint32 stemFlags{};
+
+    //custom render bounds, entire project renders leave these at 0 as the project length isn't stored
+    double rangeStart{}, rangeEnd{};
+
+    //RENDER_FILE is the output directory when there is a RENDER_PATTERN, the output file without one
+    std::string renderFile;
+    std::string renderPattern;
+
+    //QUEUED_RENDER_ORIGINAL_FILENAME, the project a queued render was made from
+    std::string originalProjectPath;
+
+    std::vector<ReaperTrack> tracks;
+    std::vector<ReaperRegion> regions;
+
+    //QUEUED_RENDER_OUTFILE paths in the order reaper wrote them
+    std::vector<std::string> queuedOutputs;
+};
+
+//one file the render settings make
+struct RenderOutput
+{
+    uint32 regionRenderFlags;
+
+    //nullptr for custom bounds
+    const ReaperRegion *region;
+    int regionMatrixOffset;
+
+    //index in ReaperRenderInfo::tracks, -1 for the master mix and region matrix tracks missing from the project
+    int trackIndex;
+    std::string trackGuid;
+};
+
+//what a track is shown as in reaper and the folders it is in, outermost first
+struct TrackNaming
+{
+    std::string name;
+    std::vector<std::string> folders;
+};
+
+std::string GetStringToken(std::stringstream &line)
+{
+    std::string text;
+    std::ios_base::fmtflags prevSkipWs = line.flags() & std::ios_base::skipws;
+    
+    std::skipws(line);
+
+    //work out if its a quoted string
+    char endchar{};
+    char c;
+    line >> c;
+    if (c == '\"')
+    {
+        endchar = '\"';
+    }
+    else
+    {
+        endchar = ' ';
+        text.push_back(c);
+    }
+
+    std::noskipws(line);
+    //add rest of chars
+    while (line >> c)
+    {
+        if (c != endchar)
+        {
+            text.push_back(c);
+        }
+        else
+        {
+            break;
+        }
+    }
+    prevSkipWs ? std::skipws(line) : std::noskipws(line);
+    return text;
+}
+
+//the closing MARKER line of a region holds the region end time
+void ParseRegionEnd(const std::string &line, ReaperRegion &region)
+{
+    std::stringstream markerStream(line);
+    std::skipws(markerStream);
+
+    std::string markerToken;
+    int markerId;
+    double endTime;
+    if (markerStream >> markerToken >> markerId >> endTime && markerToken == "MARKER")
+    {
+        region.endTime = endTime;
+    }
+}
+
+ReaperRegion &ParseRegion(std::istream &ifstream, ReaperRegion &region)
+{
+    std::string line;
+    std::getline(ifstream, line);
+    std::stringstream markerStream(line);
+    std::skipws(markerStream);
+
+    std::string markerToken;
+    markerStream >> markerToken;
+    if (markerToken == "MARKER")
+    {
+        //marker finishes here 
+        ParseRegionEnd(line, region);
+    }
+    else if (markerToken == "<REGIONRENDER")
+    {
+        //get region render tracks
+        while (std::getline(ifstream, line))
+        {
+            std::stringstream trackStream(line);
+            std::skipws(trackStream);
+            trackStream >> markerToken;
+            if (markerToken[0] == '>')
+            {
+                //we are done - eat next "MARKER" line (signifies end of region)
+                std::getline(ifstream, line);
+                ParseRegionEnd(line, region);
+                break;
+            }
+            if (markerToken == "TRACK")
+            {
+                //get track GUID
+                trackStream >> markerToken;
+                region.regionRenderTracks.push_back(markerToken);
+            }
+        }
+    } 
+    return region;
+}
+
+ReaperTrack &ParseTrack(std::istream &fstream, ReaperTrack &track)
+{
+    std::string line;
+    std::ios_base::fmtflags prevSkipWs = fstream.flags() & std::ios_base::skipws;
+    std::skipws(fstream);
+    int subElementDepth = 0;
+    while (std::getline(fstream, line))
+    {
+        std::stringstream lineStream(line);
+        std::skipws(lineStream);
+        std::string firstToken;
+        lineStream >> firstToken;
+
+        if (firstToken[0] == '<')
+        {
+            ++subElementDepth;
+        }
+
+        if (firstToken[0] == '>')
+        {
+            if (subElementDepth)
+            {
+                --subElementDepth;
+            }
+            else
+            {
+                //we are done
+                break;
+            }
+        }
+
+        if (!subElementDepth)
+        {
+            if (firstToken == "SEL")
+            {
+                int selected;
+                lineStream >> selected;
+                track.isSelected = selected;
+                continue;
+            }
+
+            if (firstToken == "NAME")
+            {
+                track.name = GetStringToken(lineStream);
+                continue;
+            }
+
+            if (firstToken == "ISBUS")
+            {
+                int busState;
+                lineStream >> busState >> track.folderDepthChange;
+                continue;
+            }
+        }
+    }
+    prevSkipWs ? std::skipws(fstream) : std::noskipws(fstream);
+    return track;
+}
+
+void SetRenderItemBounds(RenderItem &item, const ReaperRegion &region)
+{
+    item.inTime = region.startTime;
+    item.outTime = region.endTime;
+    item.regionName = region.note;
+}
+
+//walks the tracks in project order keeping the stack of open folders
+std::vector<TrackNaming> GetTrackNaming(const std::vector<ReaperTrack> &tracks)
+{
+    std::vector<TrackNaming> naming(tracks.size());
+    std::vector<std::string> openFolders;
+
+    for (size_t i = 0; i < tracks.size(); ++i)
+    {
+        const ReaperTrack &track = tracks[i];
+
+        //reaper shows unnamed tracks by number
+        naming[i].name = track.name.empty() ? "Track " + std::to_string(i + 1) : track.name;
+        naming[i].folders = openFolders;
+
+        if (track.folderDepthChange > 0)
+        {
+            openFolders.push_back(naming[i].name);
+        }
+        else if (track.folderDepthChange < 0)
+        {
+            const size_t numClosed = std::min<size_t>(-track.folderDepthChange, openFolders.size());
+            openFolders.resize(openFolders.size() - numClosed);
+        }
+    }
+
+    return naming;
+}
+
+//every file the render settings make, in the order reaper renders them
+//stems are the selected tracks, region matrix tracks the ones ticked for the region
+std::vector<RenderOutput> CollectRenderOutputs(const ReaperRenderInfo &info)
+{
+    std::vector<RenderOutput> outputs;
+
+    auto AddMaster = [&outputs](uint32 flags, const ReaperRegion *region, int matrixOffset)
+    {
+        outputs.push_back(RenderOutput{ flags, region, matrixOffset, -1, std::string() });
+    };
+    auto AddTrack = [&outputs, &info](uint32 flags, const ReaperRegion *region, int matrixOffset, int trackIndex)
+    {
+        outputs.push_back(RenderOutput{ flags, region, matrixOffset, trackIndex, info.tracks[trackIndex].guid });
+    };
+
+    if (info.stemFlags & RenderSourceRegionMatrix)
+    {
+        std::unordered_map<std::string, int> trackIndices;
+        for (size_t i = 0; i < info.tracks.size(); ++i)
+        {
+            trackIndices.insert({ info.tracks[i].guid, static_cast<int>(i) });
+        }
+
+        for (const ReaperRegion &region : info.regions)
+        {
+            //per region render master flag
+            int matrixOffsetCounter = 0;
+            if (region.regionRenderFlags & RenderSourceMaster)
+            {
+                AddMaster(RenderSourceMaster | RenderBoundsRegion, &region, matrixOffsetCounter++);
+            }
+            if (region.regionRenderFlags & RenderMatrixSourceAllTracks)
+            {
+                for (size_t i = 0; i < info.tracks.size(); ++i)
+                {
+                    AddTrack(RenderSourceSelectedStems | RenderBoundsRegion, &region, matrixOffsetCounter++, static_cast<int>(i));
+                }
+            }
+            else
+            {
+                for (const std::string &matrixTrack : region.regionRenderTracks)
+                {
+                    auto found = trackIndices.find(matrixTrack);
+                    const int trackIndex = found != trackIndices.end() ? found->second : -1;
+                    outputs.push_back(RenderOutput{ RenderSourceRegionMatrix | RenderBoundsRegion, &region,
+                                                    matrixOffsetCounter++, trackIndex, matrixTrack });
+                }
+            }
+        }
+    }
+    else if (info.stemFlags & (RenderSourceSelectedStems | RenderSourceMaster))
+    {
+        switch (info.rangeMode)
+        {
+        case ReaperRenderRangeMode::CustomTimeRange:
+        case ReaperRenderRangeMode::EntireProject:
+        case ReaperRenderRangeMode::TimeSelection:
+        {
+            if (info.stemFlags & RenderSourceMaster)
+            {
+                AddMaster(RenderSourceMaster | RenderBoundsCustom, nullptr, 0);
+            }
+
+            for (size_t i = 0; (info.stemFlags & RenderSourceSelectedStems) && i < info.tracks.size(); ++i)
+            {
+                if (info.tracks[i].isSelected)
+                {
+                    AddTrack(RenderSourceSelectedStems | RenderBoundsCustom, nullptr, 0, static_cast<int>(i));
+                }
+            }
+        } break;
+        case ReaperRenderRangeMode::ProjectRegions:
+        {
+            for (const ReaperRegion &region : info.regions)
+            {
+                if (info.stemFlags & RenderSourceMaster)
+                {
+                    AddMaster(RenderSourceMaster | RenderBoundsRegion, &region, 0);
+                }
+
+                for (size_t i = 0; (info.stemFlags & RenderSourceSelectedStems) && i < info.tracks.size(); ++i)
+                {
+                    if (info.tracks[i].isSelected)
+                    {
+                        AddTrack(RenderSourceSelectedStems | RenderBoundsRegion, &region, 0, static_cast<int>(i));
+                    }
+                }
+            }
+        } break;
+        default:
+        {
+            assert(!"Unidentified project render range.");
+        } break;
+        }
+    }
+
+    return outputs;
+}
+
+//sets the region, track and bounds the output was rendered from
+void ApplyRenderOutput(RenderItem &item, const RenderOutput &output, const ReaperRenderInfo &info,
+                       const std::vector<TrackNaming> &naming)
+{
+    item.regionRenderFlags = output.regionRenderFlags;
+    item.regionMatrixOffset = output.regionMatrixOffset;
+    if (output.region)
+    {
+        item.reaperRegionId = output.region->id;
+        SetRenderItemBounds(item, *output.region);
+    }
+    else
+    {
+        item.inTime = info.rangeStart;
+        item.outTime = info.rangeEnd;
+    }
+
+    item.trackStemGuid = output.trackGuid;
+    if (output.trackIndex >= 0)
+    {
+        item.trackName = naming[output.trackIndex].name;
+        item.trackFolders = naming[output.trackIndex].folders;
+    }
+}
+
+static std::string ToLower(std::string text)
+{
+    std::transform(text.begin(), text.end(), text.begin(), [](char c) { return static_cast<char>(tolower(c)); });
+    return text;
+}
+
+//the project name $project stands for, a queued render is named after the project it was made from
+static std::string GetProjectName(const fs::path &path, const ReaperRenderInfo &info)
+{
+    std::string projectPath = info.originalProjectPath.empty() ? path.generic_string() : info.originalProjectPath;
+    std::replace(projectPath.begin(), projectPath.end(), '\\', '/');
+    return fs::path(projectPath).stem().generic_string();
+}
+
+//the output file name itself stands in for a missing pattern, or the project name if there isn't one either
+static std::string GetRenderPattern(const ReaperRenderInfo &info)
+{
+    if (!info.renderPattern.empty())
+    {
+        return info.renderPattern;
+    }
+
+    std::string renderFile = info.renderFile;
+    std::replace(renderFile.begin(), renderFile.end(), '\\', '/');
+    const std::string fileName = fs::path(renderFile).stem().generic_string();
+    return fileName.empty() ? "$project" : fileName;
+}
+
+static void SetPatternValues(const RenderOutput &output, const std::vector<TrackNaming> &naming, RenderPatternValues &values)
+{
+    values.hasRegion = output.region != nullptr;
+    values.region = output.region ? output.region->note : std::string();
+    values.regionNumber = output.region ? output.region->id : 0;
+    values.track = output.trackIndex >= 0 ? naming[output.trackIndex].name : std::string();
+    values.trackNumber = static_cast<uint32>(output.trackIndex + 1);
+    values.folders = output.trackIndex >= 0 ? &naming[output.trackIndex].folders : nullptr;
+}
+
+//the path lower case with '/' separators and no extension, windows file names aren't case sensitive
+static std::string GetOutputKey(const std::string &path)
+{
+    std::string key = ToLower(path);
+    std::replace(key.begin(), key.end(), '\\', '/');
+
+    const size_t extension = key.find_last_of('.');
+    if (extension != std::string::npos && extension > key.find_last_of('/') + 1)
+    {
+        key.resize(extension);
+    }
+    return key;
+}
+
+//finds each queued output by the name the render pattern gives every output, an index into outputs or -1
+//outputs the pattern can't tell apart (no $track with stems) and files that aren't found by name fall back
+//to their position in the queue, which only holds if reaper rendered exactly what the settings say
+std::vector<int> MatchQueuedOutputs(const ReaperRenderInfo &info, const std::vector<RenderOutput> &outputs,
+                                    const std::vector<TrackNaming> &naming, const std::string &projectName,
+                                    RenderQueueMatchStats &statsOut)
+{
+    std::vector<int> outputIndices(info.queuedOutputs.size(), -1);
+    std::vector<bool> claimed(outputs.size());
+
+    RenderPattern pattern;
+    pattern.Compile(GetRenderPattern(info));
+    statsOut.patternPredictable = pattern.IsPredictable();
+
+    if (pattern.IsPredictable())
+    {
+        //predicted name -> output, -1 where several outputs get the same name
+        std::unordered_map<std::string, int> outputsByName;
+        outputsByName.reserve(outputs.size());
+
+        RenderPatternValues values;
+        values.project = projectName;
+        std::string name;
+        for (size_t i = 0; i < outputs.size(); ++i)
+        {
+            SetPatternValues(outputs[i], naming, values);
+            pattern.Evaluate(values, name);
+            auto inserted = outputsByName.insert({ ToLower(name), static_cast<int>(i) });
+            if (!inserted.second)
+            {
+                inserted.first->second = -1;
+            }
+        }
+
+        for (size_t i = 0; i < info.queuedOutputs.size(); ++i)
+        {
+            //the render directory isn't part of the predicted name, try the path from its longest tail down
+            const std::string key = GetOutputKey(info.queuedOutputs[i]);
+            for (size_t tailStart = 0; tailStart < key.size(); tailStart = key.find('/', tailStart) + 1)
+            {
+                auto found = outputsByName.find(key.substr(tailStart));
+                if (found != outputsByName.end() && found->second >= 0 && !claimed[found->second])
+                {
+                    outputIndices[i] = found->second;
+                    claimed[found->second] = true;
+                    ++statsOut.numMatchedByName;
+                    break;
+                }
+
+                if (key.find('/', tailStart) == std::string::npos)
+                {
+                    break;
+                }
+            }
+        }
+    }
+
+    for (size_t i = 0; i < info.queuedOutputs.size(); ++i)
+    {
+        if (outputIndices[i] >= 0)
+        {
+            continue;
+        }
+
+        if (i < outputs.size() && !claimed[i])
+        {
+            outputIndices[i] = static_cast<int>(i);
+            claimed[i] = true;
+            ++statsOut.numMatchedByPosition;
+        }
+        else
+        {
+            ++statsOut.numUnmatched;
+        }
+    }
+
+    return outputIndices;
+}
+
+std::string GetQueuedRenderProject(const fs::path &path)
+{
+    std::string project = path.generic_string();
+
+    //reaper writes it with the render settings, before the first track
+    std::ifstream fileReader(path);
+    std::string line;
+    while (std::getline(fileReader, line))
+    {
+        std::stringstream lineStream(line);
+        std::string tokenName;
+        lineStream >> tokenName;
+
+        if (tokenName == "<TRACK")
+        {
+            break;
+        }
+
+        if (tokenName == "QUEUED_RENDER_ORIGINAL_FILENAME")
+        {
+            project = GetStringToken(lineStream);
+            break;
+        }
+    }
+
+    std::replace(project.begin(), project.end(), '\\', '/');
+    return project;
+}
+
+//reads the render settings, tracks, regions and queued outputs
+void ParseRenderInfo(std::istream &fileReader, ReaperRenderInfo &info)
+{
+    double timeSelectionStart{}, timeSelectionEnd{};
+    std::string line;
+
+    while (std::getline(fileReader, line))
+    {
+        std::stringstream lineStream(line);
+        std::skipws(lineStream);
+        std::string tokenName;
+        lineStream >> tokenName;
+
+        if (tokenName == "QUEUED_RENDER_OUTFILE")
+        {
+            info.queuedOutputs.push_back(GetStringToken(lineStream));
+            continue;
+        }
+
+        if (tokenName == "QUEUED_RENDER_ORIGINAL_FILENAME")
+        {
+            info.originalProjectPath = GetStringToken(lineStream);
+            continue;
+        }
+
+        if (tokenName == "RENDER_FILE")
+        {
+            info.renderFile = GetStringToken(lineStream);
+            continue;
+        }
+
+        if (tokenName == "RENDER_PATTERN")
+        {
+            info.renderPattern = GetStringToken(lineStream);
+            continue;
+        }
+
+        if (tokenName == "RENDER_RANGE")
+        {
+            int rangeId;
+            lineStream >> rangeId >> info.rangeStart >> info.rangeEnd;
+            info.rangeMode = static_cast<ReaperRenderRangeMode>(rangeId);
+        }
+
+        if (tokenName == "SELECTION")
+        {
+            lineStream >> timeSelectionStart >> timeSelectionEnd;
+            continue;
+        }
+
+        if (tokenName == "RENDER_STEMS")
+        {
+            int stemsId;
+            lineStream >> stemsId;
+            switch (stemsId)
+            {
+            case 0:
+                //master mix
+                info.stemFlags = RenderSourceMaster;
+                break;
+
+            case 1:
+                //master mix and stems
+                info.stemFlags = RenderSourceMaster | RenderSourceSelectedStems;
+                break;
+
+            case 3:
+                //selected tracks
+                info.stemFlags = RenderSourceSelectedStems;
+                break;
+
+            case 8:
+                //region matrix
+                info.stemFlags = RenderSourceRegionMatrix;
+                break;
+
+            case 32:
+                //selected media items
+                info.stemFlags = RenderSourceSelectedMedia;
+                break;
+
+            default:
+                assert(!"Unidentified stem render mode");
+                break;
+            }
+            continue;
+        }
+
+        if (tokenName == "<TRACK")
+        {
+            //get track guid
+            ReaperTrack track;
+            lineStream >> track.guid;
+            ParseTrack(fileReader, track);
+            info.tracks.push_back(std::move(track));
+        }
+
+        if (tokenName == "MARKER")
+        {
+            int markerId;
+            lineStream >> markerId;
+            std::string name;
+
+            double markerTime;
+            lineStream >> markerTime;
+            name = GetStringToken(lineStream);
+
+            int markerRenderMode;
+            lineStream >> markerRenderMode;
+            if (!markerRenderMode)
+            {
+                //marker not a region
+                continue;
+            }
+            ReaperRegion region;
+            if      (markerRenderMode == 1) region.regionRenderFlags = RenderItemFlags::RenderSourceSelectedStems;
+            else if (markerRenderMode == 4) region.regionRenderFlags = RenderItemFlags::RenderMatrixSourceAllTracks;
+            else if (markerRenderMode == 5) region.regionRenderFlags = RenderItemFlags::RenderSourceSelectedStems   | RenderItemFlags::RenderSourceMaster;
+            else if (markerRenderMode == 7) region.regionRenderFlags = RenderItemFlags::RenderMatrixSourceAllTracks | RenderItemFlags::RenderSourceMaster;
+
+            region.id = markerId;
+            region.note = name;
+            region.startTime = markerTime;
+            ParseRegion(fileReader, region);
+            info.regions.push_back(std::move(region));
+        }
+    }
+
+    if (info.rangeMode == ReaperRenderRangeMode::TimeSelection)
+    {
+        info.rangeStart = timeSelectionStart;
+        info.rangeEnd = timeSelectionEnd;
+    }
+}
+
+//false if the file can't be opened
+bool ParseRenderInfo(const fs::path &path, ReaperRenderInfo &info)
+{
+    std::ifstream fileReader(path);
+
+    if (!fileReader.is_open())
+    {
+        return false;
+    }
+
+    ParseRenderInfo(fileReader, info);
+    return true;
+}
+
+RenderItem MakeRenderItem(const fs::path &audioFilePath, const std::string &projectPath)
+{
+    RenderItem item;
+    item.audioFilePath = audioFilePath;
+    item.wwiseParentName = "Not set.";
+    item.projectPath = projectPath;
+    item.outputFileName = item.audioFilePath.filename().replace_extension("").generic_string();
+    item.importOperation = WAAPIImportOperation::createNew;
+    item.importObjectType = ImportObjectType::SFX;
+    item.wwiseLanguageIndex = 0;
+    item.regionRenderFlags = 0;
+    item.reaperRegionId = -1;
+    item.regionMatrixOffset = 0;
+    item.inTime = 0.0;
+    item.outTime = 0.0;
+    return item;
+}
+
+std::vector<RenderItem> ParseRenderQueue(const fs::path &path, RenderQueueMatchStats *statsOut)
+{
+    WAAPI_TRACE_SCOPE("reaper", "ParseRenderQueue");
+
+    std::vector<RenderItem> renderItems;
+    ReaperRenderInfo info;
+    if (!ParseRenderInfo(path, info))
+    {
+        return renderItems;
+    }
+
+    const std::vector<RenderOutput> outputs = CollectRenderOutputs(info);
+    const std::vector<TrackNaming> naming = GetTrackNaming(info.tracks);
+
+    RenderQueueMatchStats stats;
+    const std::vector<int> outputIndices = MatchQueuedOutputs(info, outputs, naming, GetProjectName(path, info), stats);
+
+    const std::string projectPath = path.generic_string();
+    renderItems.reserve(info.queuedOutputs.size());
+    for (size_t i = 0; i < info.queuedOutputs.size(); ++i)
+    {
+        renderItems.push_back(MakeRenderItem(info.queuedOutputs[i], projectPath));
+        if (outputIndices[i] >= 0)
+        {
+            ApplyRenderOutput(renderItems.back(), outputs[outputIndices[i]], info, naming);
+        }
+    }
+
+    if (statsOut)
+    {
+        *statsOut = stats;
+    }
+    return renderItems;
+}
+
+std::vector<RenderItem> PredictRenderOutputs(const fs::path &projectPath, std::string &errorOut)
+{
+    std::ifstream fileReader(projectPath);
+    if (!fileReader.is_open())
+    {
+        errorOut = "couldn't open " + projectPath.generic_string();
+        return std::vector<RenderItem>();
+    }
+
+    return PredictRenderOutputs(fileReader, projectPath, errorOut);
+}
+
+std::vector<RenderItem> PredictRenderOutputs(std::istream &project, const fs::path &projectPath, std::string &errorOut)
+{
+    WAAPI_TRACE_SCOPE("reaper", "PredictRenderOutputs");
+
+    std::vector<RenderItem> renderItems;
+    ReaperRenderInfo info;
+    ParseRenderInfo(project, info);
+
+    RenderPattern pattern;
+    pattern.Compile(GetRenderPattern(info));
+    if (!pattern.IsPredictable())
+    {
+        errorOut = "render pattern \"" + info.renderPattern + "\" has wildcards that can't be predicted";
+        return renderItems;
+    }
+
+    //with a pattern RENDER_FILE is the directory, relative ones are under the project's
+    std::string renderFile = info.renderFile;
+    std::replace(renderFile.begin(), renderFile.end(), '\\', '/');
+    fs::path renderDirectory = info.renderPattern.empty() ? fs::path(renderFile).parent_path() : fs::path(renderFile);
+    if (renderDirectory.is_relative())
+    {
+        renderDirectory = projectPath.parent_path() / renderDirectory;
+    }
+
+    const std::vector<RenderOutput> outputs = CollectRenderOutputs(info);
+    const std::vector<TrackNaming> naming = GetTrackNaming(info.tracks);
+
+    RenderPatternValues values;
+    values.project = GetProjectName(projectPath, info);
+    std::string name;
+    std::unordered_map<std::string, size_t> seenNames;
+
+    const std::string projectPathText = projectPath.generic_string();
+    renderItems.reserve(outputs.size());
+    for (const RenderOutput &output : outputs)
+    {
+        SetPatternValues(output, naming, values);
+        pattern.Evaluate(values, name);
+
+        //reaper numbers clashing names, which of them is which isn't knowable up front
+        auto inserted = seenNames.insert({ ToLower(name), renderItems.size() });
+        if (!inserted.second)
+        {
+            errorOut = "render pattern gives more than one output the name \"" + name + "\"";
+            renderItems.clear();
+            return renderItems;
+        }
+
+        //wwise only imports wav
+        renderItems.push_back(MakeRenderItem(renderDirectory / (name + ".wav"), projectPathText));
+        ApplyRenderOutput(renderItems.back(), output, info, naming);
+    }
+
+    return renderItems;
+}
+
+
+#if 0
+//simple parser just for render item path before we implement searching
+std::vector<RenderItem> ParseRenderQueueFile(const fs::path &path)
+{
+    std::vector<RenderItem> items;
+    const std::string projectPath = path.generic_string();
+    std::ifstream fileReader(path);
+
+    if (!fileReader.is_open())
+    {
+        return items;
+    }
+
+    std::string line;
+    //eat first line
+    std::getline(fileReader, line);
+
+    while (std::getline(fileReader, line))
+    {
+        if (std::size_t strPos = line.find(QueuedRenderPrjText) != line.npos)
+        {
+            RenderItem item;
+            //Find start of the file path in the line
+            std::size_t pathStart = line.find_first_of('\"');
+            line = line.substr(pathStart + 1, line.find_last_of('"') - pathStart - 1);
+            item.audioFilePath = line;
+            item.wwiseParentName = "Not set.";
+            item.projectPath = projectPath;
+            item.audioFilePath.filename();
+            item.outputFileName = item.audioFilePath.filename().replace_extension("").generic_string();
+            item.importOperation = WAAPIImportOperation::createNew;
+            item.importObjectType = ImportObjectType::SFX;
+            item.wwiseLanguageIndex = 0;
+
+            items.push_back(item);
+        }
+        else
+        {
+            //there aren't any more files after this
+            break;
+        }
+    }
+
+    return items;
+}
+#endif
+
+std::string GetTextForImportObject(ImportObjectType importObject)
+{
+    switch (importObject)
+    {
+
+    case ImportObjectType::SFX:
+    {
+        return std::string("SFX");
+    } break;
+
+    case ImportObjectType::Music:
+    {
+        return std::string("Music");
+    } break;
+
+    case ImportObjectType::Voice:
+    {
+        return std::string("Dialog");
+    } break;
+
+    default:
+    {
+        return std::string();
+    } break;
+
+    }
+}
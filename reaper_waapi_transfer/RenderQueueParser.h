@@ -0,0 +1,67 @@
+#pragma once
+#include <istream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "types.h"
+
+//RPP render queue parsing, no reaper api in here so tools outside of reaper can use it
+
+const std::string QueuedRenderPrjText("QUEUED_RENDER_OUTFILE");
+
+
+std::string GetTextForImportObject(ImportObjectType importObject);
+
+//next RPP token from line, quoted strings without their quotes
+std::string GetStringToken(std::stringstream &line);
+
+
+enum RenderItemFlags
+{
+    //bounds
+    RenderBoundsRegion = 1 << 0,
+    RenderBoundsCustom = 1 << 1,
+     
+    //source
+    RenderSourceSelectedStems   = 1 << 2,
+    RenderSourceRegionMatrix    = 1 << 3,
+    RenderSourceMaster          = 1 << 4,
+    RenderSourceSelectedMedia   = 1 << 5,
+    
+    RenderMatrixSourceAllTracks         = 1 << 6,
+    RenderMatrixSourceSelectedTrack     = 1 << 7
+};
+
+
+//how ParseRenderQueue matched the queued output files to the regions and tracks they were rendered from
+struct RenderQueueMatchStats
+{
+    //the render pattern only has wildcards RenderPattern can evaluate
+    bool patternPredictable = false;
+
+    //outputs found by the name the render pattern gives them
+    uint32 numMatchedByName = 0;
+
+    //outputs given the region and track at their position in reaper's render order
+    uint32 numMatchedByPosition = 0;
+
+    //outputs found neither way, they have no region or track
+    uint32 numUnmatched = 0;
+};
+
+//render items for the QUEUED_RENDER_OUTFILE files of a queued render, each matched to its region and track by the
+//name RENDER_PATTERN gives it where the pattern allows, by position otherwise
+std::vector<RenderItem> ParseRenderQueue(const fs::path &path, RenderQueueMatchStats *statsOut = nullptr);
+
+//the project a queued render was made from (QUEUED_RENDER_ORIGINAL_FILENAME) with '/' separators, path itself if it
+//doesn't say. Reaper names every queued render anew, this stays the same from one render of a project to the next
+std::string GetQueuedRenderProject(const fs::path &path);
+
+//the render items rendering the project as it is set up now would make, from its RENDER_FILE and RENDER_PATTERN
+//so they can be mapped and planned before rendering. Empty with errorOut if the pattern has wildcards that can't be
+//evaluated or gives two outputs the same name
+std::vector<RenderItem> PredictRenderOutputs(const fs::path &projectPath, std::string &errorOut);
+
+//the same for project text that isn't saved at projectPath (yet), relative render directories are under projectPath's
+std::vector<RenderItem> PredictRenderOutputs(std::istream &project, const fs::path &projectPath, std::string &errorOut);
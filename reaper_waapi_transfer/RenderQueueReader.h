@@ -5,32 +5,18 @@
 #include "config.h"
 #include "types.h"
 #include "WAAPIHelpers.h"
+#include "RenderQueueParser.h"
 
-const std::string QueuedRenderPrjText("QUEUED_RENDER_OUTFILE");
-
-
-std::string GetTextForImportObject(ImportObjectType importObject);
-
+fs::path GetRenderQueueDir();
 
-enum RenderItemFlags
-{
-    //bounds
-    RenderBoundsRegion = 1 << 0,
-    RenderBoundsCustom = 1 << 1,
-     
-    //source
-    RenderSourceSelectedStems   = 1 << 2,
-    RenderSourceRegionMatrix    = 1 << 3,
-    RenderSourceMaster          = 1 << 4,
-    RenderSourceSelectedMedia   = 1 << 5,
-    
-    RenderMatrixSourceAllTracks         = 1 << 6,
-    RenderMatrixSourceSelectedTrack     = 1 << 7
-};
+//directory in the reaper resource path where transfer history, logs and indexes are kept
+fs::path GetTransferDataDir();
 
-fs::path GetRenderQueueDir();
+//import id indexes, inside the transfer data dir
+fs::path GetImportIdIndexDir();
 
+//region hashes of the last successful transfers, inside the transfer data dir
+fs::path GetRegionHashDir();
 
-std::vector<RenderItem> ParseRenderQueue(const fs::path &path);
 
 std::vector<fs::path> GetRenderQueueProjectFiles();
\ No newline at end of file
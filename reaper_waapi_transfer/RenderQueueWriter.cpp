@@ -0,0 +1,268 @@
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+#include <unordered_map>
+#include <unordered_set>
+
+#include "RenderQueueParser.h"
+#include "RenderQueueWriter.h"
+#include "Tracing.h"
+
+//start and length of the index'th token of line, RPP strings can be quoted with " ' or `
+static bool FindToken(const std::string &line, size_t index, size_t &startOut, size_t &lengthOut)
+{
+    size_t position = 0;
+    for (size_t i = 0; ; ++i)
+    {
+        position = line.find_first_not_of(" \t", position);
+        if (position == std::string::npos)
+        {
+            return false;
+        }
+
+        size_t end;
+        const char quote = line[position];
+        if (quote == '"' || quote == '\'' || quote == '`')
+        {
+            end = line.find(quote, position + 1);
+            end = end == std::string::npos ? line.size() : end + 1;
+        }
+        else
+        {
+            end = line.find_first_of(" \t", position);
+            end = end == std::string::npos ? line.size() : end;
+        }
+
+        if (i == index)
+        {
+            startOut = position;
+            lengthOut = end - position;
+            return true;
+        }
+        position = end;
+    }
+}
+
+//quoted with whichever quote the text doesn't have, the way reaper writes strings
+static std::string QuoteToken(const std::string &text)
+{
+    const char quote = text.find('"') == std::string::npos ? '"'
+                       : text.find('\'') == std::string::npos ? '\'' : '`';
+    return quote + text + quote;
+}
+
+bool WriteQueuedRender(const fs::path &projectPath, const RenderQueueSelection &selection, const fs::path &queuePath,
+                       std::vector<RenderItem> &outputsOut, std::string &errorOut)
+{
+    WAAPI_TRACE_SCOPE("reaper", "WriteQueuedRender");
+
+    outputsOut.clear();
+
+    std::unordered_map<uint32, const RenderQueueSelection::Region*> selectedRegions;
+    selectedRegions.reserve(selection.regions.size());
+    for (const RenderQueueSelection::Region &region : selection.regions)
+    {
+        selectedRegions.insert({ region.id, &region });
+    }
+
+    std::ifstream project(projectPath);
+    std::string firstLine;
+    if (!project.is_open() || !std::getline(project, firstLine))
+    {
+        errorOut = "couldn't read " + projectPath.generic_string();
+        return false;
+    }
+
+    //everything after the first line, the QUEUED_RENDER_OUTFILE lines go in front of it once the outputs are known
+    std::string body;
+    std::error_code error;
+    const uintmax_t projectSize = fs::file_size(projectPath, error);
+    body.reserve(static_cast<size_t>(error ? 0 : projectSize) + selection.regions.size() * 64);
+
+    std::unordered_set<std::string> projectTracks;
+    std::unordered_set<uint32> foundRegions;
+    bool hasRange = false;
+    bool hasStems = false;
+    bool hasPattern = false;
+
+    //the MARKER line after a region's first one, or after its <REGIONRENDER block, is where it ends
+    bool expectRegionEnd = false;
+
+    std::string line;
+    size_t tokenStart, tokenLength;
+    while (std::getline(project, line))
+    {
+        if (!line.empty() && line.back() == '\r')
+        {
+            line.pop_back();
+        }
+
+        const bool closesRegion = expectRegionEnd;
+        expectRegionEnd = false;
+
+        if (!FindToken(line, 0, tokenStart, tokenLength))
+        {
+            body += line;
+            body += '\n';
+            continue;
+        }
+        const std::string indent = line.substr(0, tokenStart);
+        const std::string token = line.substr(tokenStart, tokenLength);
+
+        if (token == "QUEUED_RENDER_OUTFILE" || token == "QUEUED_RENDER_ORIGINAL_FILENAME")
+        {
+            //the project was a queued render itself
+            continue;
+        }
+
+        if (token == "RENDER_RANGE")
+        {
+            //project regions, the rest of the line is the tail
+            if (FindToken(line, 1, tokenStart, tokenLength))
+            {
+                line.replace(tokenStart, tokenLength, "3");
+            }
+            else
+            {
+                line += " 3";
+            }
+            hasRange = true;
+        }
+        else if (token == "RENDER_STEMS")
+        {
+            line = indent + "RENDER_STEMS 8";
+            hasStems = true;
+        }
+        else if (token == "RENDER_PATTERN" && !selection.renderPattern.empty())
+        {
+            line = indent + "RENDER_PATTERN " + QuoteToken(selection.renderPattern);
+            hasPattern = true;
+        }
+        else if (token == "<TRACK")
+        {
+            if (FindToken(line, 1, tokenStart, tokenLength))
+            {
+                projectTracks.insert(line.substr(tokenStart, tokenLength));
+            }
+        }
+        else if (token == "<REGIONRENDER")
+        {
+            //the matrix is written from the selection, the project's is dropped
+            while (std::getline(project, line))
+            {
+                if (FindToken(line, 0, tokenStart, tokenLength) && line[tokenStart] == '>')
+                {
+                    break;
+                }
+            }
+            expectRegionEnd = closesRegion;
+            continue;
+        }
+        else if (token == "MARKER" && !closesRegion)
+        {
+            //id, time, name, render flags, plain markers have none
+            size_t idStart, idLength;
+            if (FindToken(line, 1, idStart, idLength) && FindToken(line, 4, tokenStart, tokenLength)
+                && strtol(line.c_str() + tokenStart, nullptr, 10))
+            {
+                const uint32 regionId = static_cast<uint32>(strtoul(line.c_str() + idStart, nullptr, 10));
+                auto selected = selectedRegions.find(regionId);
+
+                //regions without a <REGIONRENDER block render nothing from the matrix
+                const bool includeMaster = selected != selectedRegions.end() && selected->second->includeMasterMix;
+                line.replace(tokenStart, tokenLength, includeMaster ? "5" : "1");
+                body += line;
+                body += '\n';
+
+                if (selected != selectedRegions.end())
+                {
+                    foundRegions.insert(regionId);
+                    body += indent + "<REGIONRENDER\n";
+                    for (const std::string &trackGuid : selected->second->trackGuids)
+                    {
+                        body += indent + "  TRACK " + trackGuid + '\n';
+                    }
+                    body += indent + ">\n";
+                }
+                expectRegionEnd = true;
+                continue;
+            }
+        }
+
+        body += line;
+        body += '\n';
+    }
+
+    for (const RenderQueueSelection::Region &region : selection.regions)
+    {
+        if (!foundRegions.count(region.id))
+        {
+            errorOut = "region " + std::to_string(region.id) + " isn't in " + projectPath.generic_string();
+            return false;
+        }
+        for (const std::string &trackGuid : region.trackGuids)
+        {
+            if (!projectTracks.count(trackGuid))
+            {
+                errorOut = "track " + trackGuid + " isn't in " + projectPath.generic_string();
+                return false;
+            }
+        }
+    }
+
+    //settings older projects don't have yet
+    std::string settings = "  QUEUED_RENDER_ORIGINAL_FILENAME " + QuoteToken(fs::absolute(projectPath).string()) + '\n';
+    if (!hasRange)
+    {
+        settings += "  RENDER_RANGE 3 0 0 0 1000\n";
+    }
+    if (!hasStems)
+    {
+        settings += "  RENDER_STEMS 8\n";
+    }
+    if (!hasPattern && !selection.renderPattern.empty())
+    {
+        settings += "  RENDER_PATTERN " + QuoteToken(selection.renderPattern) + '\n';
+    }
+    body.insert(0, settings);
+
+    {
+        std::istringstream queuedProject(body);
+        outputsOut = PredictRenderOutputs(queuedProject, projectPath, errorOut);
+    }
+    if (outputsOut.empty())
+    {
+        if (errorOut.empty())
+        {
+            errorOut = "the selection doesn't render anything";
+        }
+        return false;
+    }
+
+    std::ofstream queued(queuePath, std::ios::trunc);
+    if (!queued.is_open())
+    {
+        errorOut = "couldn't write " + queuePath.generic_string();
+        outputsOut.clear();
+        return false;
+    }
+
+    queued << firstLine << '\n';
+    const std::string queuePathText = queuePath.generic_string();
+    for (RenderItem &output : outputsOut)
+    {
+        queued << "  QUEUED_RENDER_OUTFILE " << QuoteToken(fs::path(output.audioFilePath).make_preferred().string()) << '\n';
+        output.projectPath = queuePathText;
+    }
+    queued << body;
+    queued.close();
+
+    if (!queued.good())
+    {
+        errorOut = "couldn't write " + queuePath.generic_string();
+        fs::remove(queuePath, error);
+        outputsOut.clear();
+        return false;
+    }
+    return true;
+}
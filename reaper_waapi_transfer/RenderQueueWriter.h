@@ -0,0 +1,35 @@
+#pragma once
+#include <string>
+#include <vector>
+
+#include "types.h"
+
+//What a generated queued render renders: regions of the project, each through its own tracks
+struct RenderQueueSelection
+{
+    struct Region
+    {
+        //MARKER id of the region
+        uint32 id;
+
+        //<TRACK guids as the RPP has them ("{...}"), in project order
+        std::vector<std::string> trackGuids;
+        bool includeMasterMix = false;
+    };
+
+    std::vector<Region> regions;
+
+    //replaces RENDER_PATTERN, empty keeps the project's. The pattern has to give every region and track its own
+    //name, "$region-$track" does
+    std::string renderPattern;
+};
+
+//Writes a queued render of the project saved at projectPath to queuePath, the way reaper's "Add to render queue"
+//would with the region render matrix set to the selection: RENDER_STEMS renders the matrix, RENDER_RANGE the project
+//regions, the selected regions get a <REGIONRENDER block with their tracks and every other region renders nothing.
+//The QUEUED_RENDER_OUTFILE lines are the outputs PredictRenderOutputs gives the result, returned in outputsOut.
+//One pass over the project however many regions and tracks are selected. No reaper api in here.
+//False with errorOut if the project can't be read, a selected region or track isn't in it or the outputs can't be
+//predicted, nothing is written then
+bool WriteQueuedRender(const fs::path &projectPath, const RenderQueueSelection &selection, const fs::path &queuePath,
+                       std::vector<RenderItem> &outputsOut, std::string &errorOut);
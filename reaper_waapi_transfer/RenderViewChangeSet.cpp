@@ -0,0 +1,101 @@
+#include <algorithm>
+
+#include "RenderViewChangeSet.h"
+
+void RenderViewChangeSet::SetCell(MappedListViewID row, int column, const std::string &text)
+{
+    const CellKey key = MakeCellKey(row, column);
+    ++m_frame.cellsRecorded;
+
+    auto pendingIt = m_pending.find(key);
+    if (pendingIt != m_pending.end())
+    {
+        //same cell edited twice this frame, only the last edit is pushed
+        ++m_frame.cellsCoalesced;
+        pendingIt->second = text;
+        return;
+    }
+
+    m_pending.insert({ key, text });
+    m_pendingOrder.push_back(key);
+    m_pendingColumns[row].push_back(column);
+}
+
+void RenderViewChangeSet::RemoveRow(MappedListViewID row)
+{
+    auto columnsIt = m_shadowColumns.find(row);
+    if (columnsIt != m_shadowColumns.end())
+    {
+        for (int column : columnsIt->second)
+        {
+            m_shadow.erase(MakeCellKey(row, column));
+        }
+        m_shadowColumns.erase(columnsIt);
+    }
+
+    //pending edits for the row are dropped, from the flush order too
+    auto pendingColumnsIt = m_pendingColumns.find(row);
+    if (pendingColumnsIt == m_pendingColumns.end())
+    {
+        return;
+    }
+
+    for (int column : pendingColumnsIt->second)
+    {
+        m_pending.erase(MakeCellKey(row, column));
+    }
+    m_pendingColumns.erase(pendingColumnsIt);
+
+    m_pendingOrder.erase(std::remove_if(m_pendingOrder.begin(), m_pendingOrder.end(),
+                                        [row](CellKey key) { return GetRow(key) == row; }),
+                         m_pendingOrder.end());
+}
+
+void RenderViewChangeSet::Clear()
+{
+    m_pending.clear();
+    m_pendingOrder.clear();
+    m_pendingColumns.clear();
+    m_shadow.clear();
+    m_shadowColumns.clear();
+    m_frame = Stats{};
+}
+
+RenderViewChangeSet::Stats RenderViewChangeSet::Flush(const ApplyCellFunc &applyCell)
+{
+    for (CellKey key : m_pendingOrder)
+    {
+        auto pendingIt = m_pending.find(key);
+        auto shadowIt = m_shadow.find(key);
+        if (shadowIt != m_shadow.end())
+        {
+            if (shadowIt->second == pendingIt->second)
+            {
+                ++m_frame.cellsUnchanged;
+                continue;
+            }
+            shadowIt->second = std::move(pendingIt->second);
+        }
+        else
+        {
+            shadowIt = m_shadow.insert({ key, std::move(pendingIt->second) }).first;
+            m_shadowColumns[GetRow(key)].push_back(GetColumn(key));
+        }
+
+        applyCell(GetRow(key), GetColumn(key), shadowIt->second);
+        ++m_frame.cellsPushed;
+    }
+
+    m_pending.clear();
+    m_pendingOrder.clear();
+    m_pendingColumns.clear();
+
+    m_total.cellsRecorded += m_frame.cellsRecorded;
+    m_total.cellsCoalesced += m_frame.cellsCoalesced;
+    m_total.cellsUnchanged += m_frame.cellsUnchanged;
+    m_total.cellsPushed += m_frame.cellsPushed;
+
+    m_lastFrame = m_frame;
+    m_frame = Stats{};
+    return m_lastFrame;
+}
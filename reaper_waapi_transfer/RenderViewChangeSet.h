@@ -0,0 +1,83 @@
+#pragma once
+#include <string>
+#include <vector>
+#include <functional>
+#include <unordered_map>
+
+#include "types.h"
+
+//Records edits to the render item list view cells and pushes them in one batch per frame.
+//A shadow copy of what the view currently shows is kept, so only cells whose text actually
+//changed reach the control. No win32 in here so it can be driven without a window.
+class RenderViewChangeSet
+{
+public:
+    RenderViewChangeSet() = default;
+
+    RenderViewChangeSet(const RenderViewChangeSet&) = delete;
+    RenderViewChangeSet &operator=(const RenderViewChangeSet&) = delete;
+
+    struct Stats
+    {
+        //edits recorded since the last flush
+        uint32 cellsRecorded;
+
+        //edits overwritten by a later edit to the same cell in the same frame
+        uint32 cellsCoalesced;
+
+        //edits that matched what the view already shows
+        uint32 cellsUnchanged;
+
+        //cells actually pushed to the view
+        uint32 cellsPushed;
+    };
+
+    using ApplyCellFunc = std::function<void(MappedListViewID, int, const std::string&)>;
+
+    //record a cell edit, it isn't pushed to the view until Flush
+    void SetCell(MappedListViewID row, int column, const std::string &text);
+
+    //row was removed from the view, drop its shadow and any pending edits
+    void RemoveRow(MappedListViewID row);
+
+    //view was cleared
+    void Clear();
+
+    bool HasPending() const { return !m_pendingOrder.empty(); }
+
+    //calls applyCell for every pending cell that differs from the shadow, returns this frames counters
+    Stats Flush(const ApplyCellFunc &applyCell);
+
+    const Stats &GetLastFrameStats() const { return m_lastFrame; }
+    const Stats &GetTotalStats() const { return m_total; }
+
+private:
+    using CellKey = uint64_t;
+
+    static CellKey MakeCellKey(MappedListViewID row, int column)
+    {
+        return (static_cast<uint64_t>(static_cast<uint32>(row)) << 32) | static_cast<uint32>(column);
+    }
+
+    static MappedListViewID GetRow(CellKey key) { return static_cast<MappedListViewID>(key >> 32); }
+    static int GetColumn(CellKey key) { return static_cast<int>(key & 0xFFFFFFFF); }
+
+    //last text recorded for a cell this frame
+    std::unordered_map<CellKey, std::string> m_pending;
+
+    //first edit order, so cells are pushed in the order they were touched
+    std::vector<CellKey> m_pendingOrder;
+
+    //columns with a pending edit per row, so RemoveRow can skip rows without any
+    std::unordered_map<MappedListViewID, std::vector<int>> m_pendingColumns;
+
+    //text currently displayed per cell
+    std::unordered_map<CellKey, std::string> m_shadow;
+
+    //columns with a shadow entry per row, so RemoveRow doesn't have to scan the shadow
+    std::unordered_map<MappedListViewID, std::vector<int>> m_shadowColumns;
+
+    Stats m_frame{};
+    Stats m_lastFrame{};
+    Stats m_total{};
+};
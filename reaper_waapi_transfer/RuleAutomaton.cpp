@@ -0,0 +1,738 @@
+#include <algorithm>
+#include <cctype>
+#include <set>
+
+#include "RuleAutomaton.h"
+#include "config.h"
+
+bool RuleAutomaton::AddRule(const std::vector<Pattern> &patterns, std::string &errorOut)
+{
+    //states of a rule that fails part way are cut off again
+    const size_t numNfaStates = m_nfa.size();
+    const size_t numPatterns = m_patternStarts.size();
+
+    std::vector<int> patternIds;
+    for (const Pattern &pattern : patterns)
+    {
+        const int patternId = static_cast<int>(m_patternStarts.size());
+        if (!CompilePattern(pattern, patternId, errorOut))
+        {
+            m_nfa.resize(numNfaStates);
+            m_patternStarts.resize(numPatterns);
+            return false;
+        }
+        patternIds.push_back(patternId);
+    }
+
+    m_rules.push_back(std::move(patternIds));
+    m_compiled = false;
+    return true;
+}
+
+void RuleAutomaton::Clear()
+{
+    m_nfa.clear();
+    m_charSets.clear();
+    m_charSetIndex.clear();
+    m_patternStarts.clear();
+    m_rules.clear();
+    m_classBytes.clear();
+    m_dfaStates.clear();
+    m_dfaIndex.clear();
+    m_transitions.clear();
+    m_visited.clear();
+    m_compiled = false;
+}
+
+int RuleAutomaton::Match(const std::string &subject)
+{
+    if (!m_compiled)
+    {
+        Compile();
+    }
+
+    const size_t numClasses = m_classBytes.size();
+    int state = 0;
+    for (char c : subject)
+    {
+        const int byteClass = m_byteClasses[static_cast<uint8_t>(c)];
+        const int next = m_transitions[state * numClasses + byteClass];
+        state = next >= 0 ? next : Step(state, byteClass, true);
+    }
+
+    return m_dfaStates[state].rule;
+}
+
+RuleAutomaton::ConflictReport RuleAutomaton::FindConflicts(size_t maxStates)
+{
+    if (!m_compiled)
+    {
+        Compile();
+    }
+
+    ConflictReport report;
+    const size_t numClasses = m_classBytes.size();
+
+    //breadth first from the start, each state remembers the state and class it was first reached from
+    //so the shortest subject reaching it can be spelled out
+    std::vector<std::pair<int, int>> reachedFrom(m_dfaStates.size(), { -1, -1 });
+    std::vector<bool> discovered(m_dfaStates.size(), false);
+    std::vector<int> queue{ 0 };
+    discovered[0] = true;
+
+    auto GetExample = [this, &reachedFrom](int state)
+    {
+        std::string example;
+        for (; reachedFrom[state].first >= 0; state = reachedFrom[state].first)
+        {
+            example.push_back(static_cast<char>(m_classBytes[reachedFrom[state].second]));
+        }
+        std::reverse(example.begin(), example.end());
+        return example;
+    };
+
+    std::vector<bool> picked(m_rules.size(), false);
+    std::vector<bool> matched(m_rules.size(), false);
+    std::set<std::pair<size_t, size_t>> reported;
+    std::vector<size_t> rules;
+
+    for (size_t head = 0; head < queue.size(); ++head)
+    {
+        const int state = queue[head];
+
+        GetMatchingRules(*m_dfaStates[state].nfaStates, rules);
+        if (!rules.empty())
+        {
+            picked[rules.front()] = true;
+            for (size_t i = 0; i < rules.size(); ++i)
+            {
+                matched[rules[i]] = true;
+                if (i && reported.insert({ rules.front(), rules[i] }).second)
+                {
+                    report.conflicts.push_back(Conflict{ rules.front(), rules[i], GetExample(state) });
+                }
+            }
+        }
+
+        for (size_t byteClass = 0; byteClass < numClasses; ++byteClass)
+        {
+            int next = m_transitions[state * numClasses + byteClass];
+            if (next < 0)
+            {
+                if (m_dfaStates.size() >= maxStates)
+                {
+                    report.complete = false;
+                    continue;
+                }
+
+                int from = state;
+                next = Step(from, static_cast<int>(byteClass), false);
+            }
+
+            if (static_cast<size_t>(next) >= discovered.size())
+            {
+                discovered.resize(m_dfaStates.size(), false);
+                reachedFrom.resize(m_dfaStates.size(), { -1, -1 });
+            }
+            if (!discovered[next])
+            {
+                discovered[next] = true;
+                reachedFrom[next] = { state, static_cast<int>(byteClass) };
+                queue.push_back(next);
+            }
+        }
+    }
+
+    for (size_t rule = 0; rule < m_rules.size(); ++rule)
+    {
+        if (!picked[rule])
+        {
+            (matched[rule] ? report.shadowedRules : report.unmatchableRules).push_back(rule);
+        }
+    }
+
+    report.numStates = queue.size();
+    return report;
+}
+
+int RuleAutomaton::AddNfaState(NfaState::Type type, int charSet)
+{
+    m_nfa.push_back(NfaState{ type, charSet, -1, -1, -1 });
+    return static_cast<int>(m_nfa.size() - 1);
+}
+
+int RuleAutomaton::AddCharSet(CharSet set)
+{
+    auto found = m_charSetIndex.find(set);
+    if (found != m_charSetIndex.end())
+    {
+        return found->second;
+    }
+
+    m_charSets.push_back(set);
+    m_charSetIndex.insert({ set, static_cast<int>(m_charSets.size() - 1) });
+    return static_cast<int>(m_charSets.size() - 1);
+}
+
+void RuleAutomaton::Patch(const Fragment &fragment, int target)
+{
+    for (const auto &exit : fragment.exits)
+    {
+        (exit.second ? m_nfa[exit.first].out1 : m_nfa[exit.first].out) = target;
+    }
+}
+
+RuleAutomaton::Fragment RuleAutomaton::MakeEmpty()
+{
+    const int state = AddNfaState(NfaState::Split);
+    return Fragment{ state, { { state, 0 } } };
+}
+
+RuleAutomaton::Fragment RuleAutomaton::MakeChars(const CharSet &set)
+{
+    const int state = AddNfaState(NfaState::Char, AddCharSet(set));
+    return Fragment{ state, { { state, 0 } } };
+}
+
+RuleAutomaton::Fragment RuleAutomaton::MakeConcat(Fragment first, const Fragment &second)
+{
+    Patch(first, second.start);
+    first.exits = second.exits;
+    return first;
+}
+
+RuleAutomaton::Fragment RuleAutomaton::MakeAlternate(Fragment first, const Fragment &second)
+{
+    const int state = AddNfaState(NfaState::Split);
+    m_nfa[state].out = first.start;
+    m_nfa[state].out1 = second.start;
+
+    first.start = state;
+    first.exits.insert(first.exits.end(), second.exits.begin(), second.exits.end());
+    return first;
+}
+
+RuleAutomaton::Fragment RuleAutomaton::MakeStar(const Fragment &repeated)
+{
+    const int state = AddNfaState(NfaState::Split);
+    m_nfa[state].out = repeated.start;
+    Patch(repeated, state);
+    return Fragment{ state, { { state, 1 } } };
+}
+
+RuleAutomaton::Fragment RuleAutomaton::MakePlus(const Fragment &repeated)
+{
+    const int state = AddNfaState(NfaState::Split);
+    m_nfa[state].out = repeated.start;
+    Patch(repeated, state);
+    return Fragment{ repeated.start, { { state, 1 } } };
+}
+
+RuleAutomaton::Fragment RuleAutomaton::MakeOptional(Fragment optional)
+{
+    const int state = AddNfaState(NfaState::Split);
+    m_nfa[state].out = optional.start;
+
+    optional.start = state;
+    optional.exits.push_back({ state, 1 });
+    return optional;
+}
+
+RuleAutomaton::CharSet RuleAutomaton::GetFieldChars()
+{
+    //anything but the separator, wildcards and classes never run into the next field
+    CharSet set;
+    set.set();
+    set.reset(static_cast<uint8_t>(FIELD_SEPARATOR));
+    return set;
+}
+
+bool RuleAutomaton::CompilePattern(const Pattern &pattern, int patternId, std::string &errorOut)
+{
+    Fragment fragment;
+    if (pattern.syntax == Syntax::Glob)
+    {
+        fragment = CompileGlob(pattern.text);
+    }
+    else
+    {
+        //patterns are anchored anyway
+        std::string regex = pattern.text;
+        if (!regex.empty() && regex.front() == '^')
+        {
+            regex.erase(0, 1);
+        }
+        if (!regex.empty() && regex.back() == '$')
+        {
+            //unless it's an escaped $
+            size_t numBackslashes = 0;
+            for (size_t i = regex.size() - 1; i > 0 && regex[i - 1] == '\\'; --i)
+            {
+                ++numBackslashes;
+            }
+            if (numBackslashes % 2 == 0)
+            {
+                regex.pop_back();
+            }
+        }
+
+        const char *text = regex.c_str();
+        bool parsed = ParseAlternation(text, fragment, errorOut);
+        if (parsed && *text)
+        {
+            errorOut = "unmatched )";
+            parsed = false;
+        }
+        if (!parsed)
+        {
+            errorOut = "regex \"" + pattern.text + "\": " + errorOut;
+            return false;
+        }
+    }
+
+    CharSet separator;
+    separator.set(static_cast<uint8_t>(FIELD_SEPARATOR));
+    CharSet anything;
+    anything.set();
+
+    //skips the fields before this one
+    Fragment anchored = MakeEmpty();
+    for (size_t i = 0; i < pattern.field; ++i)
+    {
+        anchored = MakeConcat(anchored, MakeStar(MakeChars(GetFieldChars())));
+        anchored = MakeConcat(anchored, MakeChars(separator));
+    }
+    anchored = MakeConcat(anchored, fragment);
+
+    //then the end of the subject or the fields after it
+    anchored = MakeConcat(anchored, MakeOptional(MakeConcat(MakeChars(separator), MakeStar(MakeChars(anything)))));
+
+    const int accept = AddNfaState(NfaState::Accept);
+    m_nfa[accept].pattern = patternId;
+    Patch(anchored, accept);
+
+    m_patternStarts.push_back(anchored.start);
+    return true;
+}
+
+RuleAutomaton::Fragment RuleAutomaton::CompileGlob(const std::string &glob)
+{
+    //the same wildcards as GlobMatch
+    Fragment fragment = MakeEmpty();
+    for (char c : glob)
+    {
+        if (c == '*')
+        {
+            fragment = MakeConcat(fragment, MakeStar(MakeChars(GetFieldChars())));
+        }
+        else if (c == '?')
+        {
+            fragment = MakeConcat(fragment, MakeChars(GetFieldChars()));
+        }
+        else
+        {
+            CharSet set;
+            set.set(static_cast<uint8_t>(c));
+            fragment = MakeConcat(fragment, MakeChars(set & GetFieldChars()));
+        }
+    }
+    return fragment;
+}
+
+bool RuleAutomaton::ParseAlternation(const char *&text, Fragment &fragmentOut, std::string &errorOut)
+{
+    if (!ParseSequence(text, fragmentOut, errorOut))
+    {
+        return false;
+    }
+
+    while (*text == '|')
+    {
+        ++text;
+        Fragment alternative;
+        if (!ParseSequence(text, alternative, errorOut))
+        {
+            return false;
+        }
+        fragmentOut = MakeAlternate(fragmentOut, alternative);
+    }
+    return true;
+}
+
+bool RuleAutomaton::ParseSequence(const char *&text, Fragment &fragmentOut, std::string &errorOut)
+{
+    fragmentOut = MakeEmpty();
+    while (*text && *text != '|' && *text != ')')
+    {
+        Fragment repeat;
+        if (!ParseRepeat(text, repeat, errorOut))
+        {
+            return false;
+        }
+        fragmentOut = MakeConcat(fragmentOut, repeat);
+    }
+    return true;
+}
+
+bool RuleAutomaton::ParseRepeat(const char *&text, Fragment &fragmentOut, std::string &errorOut)
+{
+    if (!ParseAtom(text, fragmentOut, errorOut))
+    {
+        return false;
+    }
+
+    for (;; ++text)
+    {
+        if (*text == '*') fragmentOut = MakeStar(fragmentOut);
+        else if (*text == '+') fragmentOut = MakePlus(fragmentOut);
+        else if (*text == '?') fragmentOut = MakeOptional(fragmentOut);
+        else if (*text == '{')
+        {
+            errorOut = "counted repetition isn't supported";
+            return false;
+        }
+        else return true;
+    }
+}
+
+bool RuleAutomaton::ParseAtom(const char *&text, Fragment &fragmentOut, std::string &errorOut)
+{
+    const char c = *text++;
+    switch (c)
+    {
+    case '(':
+    {
+        //nothing is captured, (?: groups are the same thing
+        if (text[0] == '?' && text[1] == ':')
+        {
+            text += 2;
+        }
+        if (!ParseAlternation(text, fragmentOut, errorOut))
+        {
+            return false;
+        }
+        if (*text != ')')
+        {
+            errorOut = "missing )";
+            return false;
+        }
+        ++text;
+        return true;
+    }
+    case '[':
+    {
+        return ParseClass(text, fragmentOut, errorOut);
+    }
+    case '.':
+    {
+        fragmentOut = MakeChars(GetFieldChars());
+        return true;
+    }
+    case '*':
+    case '+':
+    case '?':
+    {
+        errorOut = std::string("nothing to repeat before ") + c;
+        return false;
+    }
+    case '^':
+    case '$':
+    {
+        errorOut = "^ and $ are only allowed at the ends, patterns always match the whole field";
+        return false;
+    }
+    case '\\':
+    {
+        if (!*text)
+        {
+            errorOut = "trailing \\";
+            return false;
+        }
+        CharSet set;
+        ParseEscape(*text++, set);
+        fragmentOut = MakeChars(set & GetFieldChars());
+        return true;
+    }
+    default:
+    {
+        CharSet set;
+        set.set(static_cast<uint8_t>(c));
+        fragmentOut = MakeChars(set & GetFieldChars());
+        return true;
+    }
+    }
+}
+
+bool RuleAutomaton::ParseClass(const char *&text, Fragment &fragmentOut, std::string &errorOut)
+{
+    CharSet set;
+    const bool negate = *text == '^';
+    if (negate)
+    {
+        ++text;
+    }
+
+    //a ] straight after the [ or [^ is a literal
+    for (bool first = true; *text && (*text != ']' || first); first = false)
+    {
+        int low;
+        if (*text == '\\' && text[1])
+        {
+            low = ParseEscape(text[1], set);
+            text += 2;
+        }
+        else
+        {
+            low = static_cast<uint8_t>(*text++);
+            set.set(low);
+        }
+
+        if (low < 0 || text[0] != '-' || !text[1] || text[1] == ']')
+        {
+            continue;
+        }
+
+        int high;
+        if (text[1] == '\\' && text[2])
+        {
+            CharSet escaped;
+            high = ParseEscape(text[2], escaped);
+            text += 3;
+        }
+        else
+        {
+            high = static_cast<uint8_t>(text[1]);
+            text += 2;
+        }
+
+        if (high < low)
+        {
+            errorOut = "bad range in []";
+            return false;
+        }
+        for (int rangeChar = low; rangeChar <= high; ++rangeChar)
+        {
+            set.set(rangeChar);
+        }
+    }
+
+    if (*text != ']')
+    {
+        errorOut = "missing ]";
+        return false;
+    }
+    ++text;
+
+    if (negate)
+    {
+        set.flip();
+    }
+    fragmentOut = MakeChars(set & GetFieldChars());
+    return true;
+}
+
+int RuleAutomaton::ParseEscape(char escaped, CharSet &setOut)
+{
+    //adds the characters of \escaped to setOut, returns the character or -1 for classes like \d
+    CharSet set;
+    switch (escaped)
+    {
+    case 'd':
+    case 'D':
+    {
+        for (int c = '0'; c <= '9'; ++c) set.set(c);
+    } break;
+    case 'w':
+    case 'W':
+    {
+        for (int c = '0'; c <= '9'; ++c) set.set(c);
+        for (int c = 'a'; c <= 'z'; ++c) set.set(c);
+        for (int c = 'A'; c <= 'Z'; ++c) set.set(c);
+        set.set('_');
+    } break;
+    case 's':
+    case 'S':
+    {
+        for (char c : std::string(" \t\r\n\v\f")) set.set(static_cast<uint8_t>(c));
+    } break;
+    case 't':
+    {
+        setOut.set('\t');
+        return '\t';
+    }
+    default:
+    {
+        setOut.set(static_cast<uint8_t>(escaped));
+        return static_cast<uint8_t>(escaped);
+    }
+    }
+
+    setOut |= isupper(static_cast<uint8_t>(escaped)) ? ~set : set;
+    return -1;
+}
+
+void RuleAutomaton::Compile()
+{
+    //every set splits the classes into the bytes in it and the ones that aren't,
+    //bytes stay together only if no set tells them apart
+    uint16 classes[256] = {};
+    size_t numClasses = 1;
+    for (const CharSet &set : m_charSets)
+    {
+        int16 split[512];
+        std::fill(std::begin(split), std::end(split), static_cast<int16>(-1));
+
+        size_t numSplit = 0;
+        for (int c = 0; c < 256; ++c)
+        {
+            int16 &splitClass = split[classes[c] * 2 + (set[c] ? 1 : 0)];
+            if (splitClass < 0)
+            {
+                splitClass = static_cast<int16>(numSplit++);
+            }
+            classes[c] = static_cast<uint16>(splitClass);
+        }
+        numClasses = numSplit;
+    }
+
+    //any byte of a class stands for all of it, readable ones make readable conflict examples
+    m_classBytes.assign(numClasses, 0);
+    std::vector<bool> hasByte(numClasses, false);
+    auto PickByte = [this, &classes, &hasByte](uint8_t c)
+    {
+        if (!hasByte[classes[c]])
+        {
+            hasByte[classes[c]] = true;
+            m_classBytes[classes[c]] = c;
+        }
+    };
+    for (const char *c = "abcdefghijklmnopqrstuvwxyz0123456789_ABCDEFGHIJKLMNOPQRSTUVWXYZ-. "; *c; ++c)
+    {
+        PickByte(static_cast<uint8_t>(*c));
+    }
+    for (int c = 0; c < 256; ++c)
+    {
+        PickByte(static_cast<uint8_t>(c));
+        m_byteClasses[c] = static_cast<uint8_t>(classes[c]);
+    }
+
+    m_compiled = true;
+    ResetDfa();
+}
+
+void RuleAutomaton::ResetDfa()
+{
+    m_dfaStates.clear();
+    m_dfaIndex.clear();
+    m_transitions.clear();
+    m_visited.assign(m_nfa.size(), 0);
+    m_visitMark = 0;
+
+    //start is state 0
+    std::vector<int> start;
+    ++m_visitMark;
+    for (int patternStart : m_patternStarts)
+    {
+        AddClosure(patternStart, start);
+    }
+    std::sort(start.begin(), start.end());
+    FindOrAddDfaState(std::move(start));
+}
+
+int RuleAutomaton::FindOrAddDfaState(std::vector<int> &&nfaStates)
+{
+    auto found = m_dfaIndex.find(nfaStates);
+    if (found != m_dfaIndex.end())
+    {
+        return found->second;
+    }
+
+    std::vector<size_t> rules;
+    GetMatchingRules(nfaStates, rules);
+
+    const int index = static_cast<int>(m_dfaStates.size());
+    auto inserted = m_dfaIndex.emplace(std::move(nfaStates), index).first;
+    m_dfaStates.push_back(DfaState{ &inserted->first, rules.empty() ? -1 : static_cast<int>(rules.front()) });
+    m_transitions.resize(m_dfaStates.size() * m_classBytes.size(), -1);
+    return index;
+}
+
+int RuleAutomaton::Step(int &state, int byteClass, bool mayReset)
+{
+    const uint8_t c = m_classBytes[byteClass];
+
+    std::vector<int> next;
+    ++m_visitMark;
+    for (int nfaState : *m_dfaStates[state].nfaStates)
+    {
+        const NfaState &from = m_nfa[nfaState];
+        if (from.type == NfaState::Char && m_charSets[from.charSet][c])
+        {
+            AddClosure(from.out, next);
+        }
+    }
+    std::sort(next.begin(), next.end());
+
+    if (mayReset && m_dfaStates.size() >= RULE_AUTOMATON_MAX_STATES && m_dfaIndex.find(next) == m_dfaIndex.end())
+    {
+        //carries on from where the subject is, the rest is rebuilt when something reaches it again
+        std::vector<int> current = *m_dfaStates[state].nfaStates;
+        ResetDfa();
+        state = FindOrAddDfaState(std::move(current));
+    }
+
+    const int nextState = FindOrAddDfaState(std::move(next));
+    m_transitions[state * m_classBytes.size() + byteClass] = nextState;
+    return nextState;
+}
+
+void RuleAutomaton::AddClosure(int nfaState, std::vector<int> &statesOut)
+{
+    //the caller bumps m_visitMark once per state set being built
+    std::vector<int> stack{ nfaState };
+    while (!stack.empty())
+    {
+        const int index = stack.back();
+        stack.pop_back();
+
+        if (index < 0 || m_visited[index] == m_visitMark)
+        {
+            continue;
+        }
+        m_visited[index] = m_visitMark;
+
+        const NfaState &state = m_nfa[index];
+        if (state.type == NfaState::Split)
+        {
+            stack.push_back(state.out1);
+            stack.push_back(state.out);
+        }
+        else
+        {
+            statesOut.push_back(index);
+        }
+    }
+}
+
+void RuleAutomaton::GetMatchingRules(const std::vector<int> &nfaStates, std::vector<size_t> &rulesOut) const
+{
+    rulesOut.clear();
+
+    std::vector<bool> matched(m_patternStarts.size(), false);
+    for (int nfaState : nfaStates)
+    {
+        if (m_nfa[nfaState].type == NfaState::Accept)
+        {
+            matched[m_nfa[nfaState].pattern] = true;
+        }
+    }
+
+    for (size_t rule = 0; rule < m_rules.size(); ++rule)
+    {
+        const std::vector<int> &patterns = m_rules[rule];
+        if (std::all_of(patterns.begin(), patterns.end(), [&matched](int pattern) { return matched[pattern]; }))
+        {
+            rulesOut.push_back(rule);
+        }
+    }
+}
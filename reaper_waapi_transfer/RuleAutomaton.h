@@ -0,0 +1,172 @@
+#pragma once
+#include <bitset>
+#include <map>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "types.h"
+
+//Glob and regex patterns over a few text fields, all compiled into one automaton so picking the rule for a subject
+//is a single pass over its characters however many rules there are.
+//The patterns make one Thompson NFA and the DFA is built from it lazily: a state is made the first time a subject
+//reaches it and kept, so a batch of items only pays for the states their names visit. Past
+//RULE_AUTOMATON_MAX_STATES the built states are dropped and rebuilt as needed.
+//A subject is its fields joined with FIELD_SEPARATOR, a pattern always matches the whole of its field.
+//Matching builds states, so it isn't thread safe.
+class RuleAutomaton
+{
+public:
+    static const char FIELD_SEPARATOR = '\x1f';
+
+    enum class Syntax
+    {
+        //* any run of characters, ? any one character
+        Glob,
+
+        //literals, ., [] classes with ranges and ^, \d \w \s, \ escapes, () groups, |, *, + and ?
+        //^ and $ are allowed at the ends only
+        Regex
+    };
+
+    struct Pattern
+    {
+        size_t field;
+        std::string text;
+        Syntax syntax;
+    };
+
+    //a rule matches when all of its patterns do, one without patterns matches everything
+    //returns false with errorOut if a pattern doesn't parse, nothing is added then
+    bool AddRule(const std::vector<Pattern> &patterns, std::string &errorOut);
+
+    size_t GetNumRules() const { return m_rules.size(); }
+
+    //drops every rule
+    void Clear();
+
+    //the first rule matching subject, -1 if none do
+    int Match(const std::string &subject);
+
+    struct Conflict
+    {
+        //both rules match example, earlierRule is the one picked
+        size_t earlierRule;
+        size_t laterRule;
+        std::string example;
+    };
+
+    struct ConflictReport
+    {
+        std::vector<Conflict> conflicts;
+
+        //rules that match something but are never picked, earlier rules match all of it
+        std::vector<size_t> shadowedRules;
+
+        //rules whose patterns can't all match the same subject
+        std::vector<size_t> unmatchableRules;
+
+        //false if the search gave up at maxStates, any of the above may be missing entries then
+        bool complete = true;
+        size_t numStates = 0;
+    };
+
+    //visits every DFA state reachable from the start, which is every combination of rules some subject matches
+    ConflictReport FindConflicts(size_t maxStates);
+
+    //DFA states built so far
+    size_t GetNumStates() const { return m_dfaStates.size(); }
+
+private:
+    struct NfaState
+    {
+        enum Type
+        {
+            //consumes a byte in charSet and goes to out
+            Char,
+
+            //epsilon to out and out1 (unless -1)
+            Split,
+
+            //pattern matched, only reached at the end of the subject
+            Accept
+        };
+
+        Type type;
+        int charSet;
+        int out;
+        int out1;
+        int pattern;
+    };
+
+    //a piece of NFA with its start and the outs still to be connected, (state, 0 for out or 1 for out1)
+    struct Fragment
+    {
+        int start;
+        std::vector<std::pair<int, int>> exits;
+    };
+
+    struct DfaState
+    {
+        //key in m_dfaIndex, sorted Char and Accept states
+        const std::vector<int> *nfaStates;
+        int rule;
+    };
+
+    typedef std::bitset<256> CharSet;
+
+    //NFA building
+    int AddNfaState(NfaState::Type type, int charSet = -1);
+    int AddCharSet(CharSet set);
+    void Patch(const Fragment &fragment, int target);
+    Fragment MakeEmpty();
+    Fragment MakeChars(const CharSet &set);
+    Fragment MakeConcat(Fragment first, const Fragment &second);
+    Fragment MakeAlternate(Fragment first, const Fragment &second);
+    Fragment MakeStar(const Fragment &repeated);
+    Fragment MakePlus(const Fragment &repeated);
+    Fragment MakeOptional(Fragment optional);
+    static CharSet GetFieldChars();
+
+    bool CompilePattern(const Pattern &pattern, int patternId, std::string &errorOut);
+    Fragment CompileGlob(const std::string &glob);
+    bool ParseAlternation(const char *&text, Fragment &fragmentOut, std::string &errorOut);
+    bool ParseSequence(const char *&text, Fragment &fragmentOut, std::string &errorOut);
+    bool ParseRepeat(const char *&text, Fragment &fragmentOut, std::string &errorOut);
+    bool ParseAtom(const char *&text, Fragment &fragmentOut, std::string &errorOut);
+    bool ParseClass(const char *&text, Fragment &fragmentOut, std::string &errorOut);
+    static int ParseEscape(char escaped, CharSet &setOut);
+
+    //DFA building
+    void Compile();
+    void ResetDfa();
+    int FindOrAddDfaState(std::vector<int> &&nfaStates);
+    int Step(int &state, int byteClass, bool mayReset);
+    void AddClosure(int nfaState, std::vector<int> &statesOut);
+    void GetMatchingRules(const std::vector<int> &nfaStates, std::vector<size_t> &rulesOut) const;
+
+    std::vector<NfaState> m_nfa;
+    std::vector<CharSet> m_charSets;
+    std::unordered_map<CharSet, int> m_charSetIndex;
+
+    //start state of every pattern, by pattern id
+    std::vector<int> m_patternStarts;
+
+    //pattern ids of each rule
+    std::vector<std::vector<int>> m_rules;
+
+    //bytes no pattern tells apart share a class, DFA transitions are per class
+    bool m_compiled = false;
+    uint8_t m_byteClasses[256];
+    std::vector<uint8_t> m_classBytes;
+
+    std::vector<DfaState> m_dfaStates;
+    std::map<std::vector<int>, int> m_dfaIndex;
+
+    //m_dfaStates.size() * number of classes, -1 until followed
+    std::vector<int> m_transitions;
+
+    //closure bookkeeping
+    std::vector<uint32> m_visited;
+    uint32 m_visitMark = 0;
+};
@@ -24,6 +24,19 @@ INT_PTR WINAPI TransferSearchWindowProc(HWND hwndDlg, UINT uMsg, WPARAM wParam,
         ShowWindow(hwndDlg, SW_SHOW);
     } break;
 
+    case WM_COMMAND:
+    {
+        if (LOWORD(wParam) == IDC_QUEUE_SELECTED_REGIONS)
+        {
+            std::string error;
+            TransferSearch *searchPtr = reinterpret_cast<TransferSearch*>(GetWindowLongPtr(hwndDlg, GWLP_USERDATA));
+            if (!searchPtr->QueueSelectedRegions(error))
+            {
+                MessageBox(hwndDlg, error.c_str(), "Queue Render", MB_OK | MB_ICONERROR);
+            }
+        }
+    } break;
+
     case WM_CLOSE:
     {
         DestroyWindow(hwndDlg);
@@ -0,0 +1,357 @@
+#include <fstream>
+#include <sstream>
+#include <cstring>
+
+#include <rapidjson/document.h>
+
+#include "TransferMapping.h"
+#include "config.h"
+
+//mapping file keys of each MappingField
+static const char *s_fieldGlobKeys[MappingFieldCount] = { "match", "region", "track" };
+static const char *s_fieldRegexKeys[MappingFieldCount] = { "matchRegex", "regionRegex", "trackRegex" };
+static const char *s_fieldNames[MappingFieldCount] = { "output name", "region", "track" };
+
+static bool ParseOperation(const std::string &text, WAAPIImportOperation &operationOut)
+{
+    if (text == "createNew") operationOut = WAAPIImportOperation::createNew;
+    else if (text == "useExisting") operationOut = WAAPIImportOperation::useExisting;
+    else if (text == "replaceExisting") operationOut = WAAPIImportOperation::replaceExisting;
+    else return false;
+    return true;
+}
+
+static bool ParseObjectType(const std::string &text, ImportObjectType &typeOut)
+{
+    if (text == "SFX") typeOut = ImportObjectType::SFX;
+    else if (text == "Voice" || text == "Dialog") typeOut = ImportObjectType::Voice;
+    else if (text == "Music") typeOut = ImportObjectType::Music;
+    else return false;
+    return true;
+}
+
+static bool ParseLanguage(const std::string &text, int &languageIndexOut)
+{
+    const int numLanguages = static_cast<int>(sizeof(WwiseLanguages) / sizeof(WwiseLanguages[0]));
+    for (int i = 0; i < numLanguages; ++i)
+    {
+        if (text == WwiseLanguages[i])
+        {
+            languageIndexOut = i;
+            return true;
+        }
+    }
+    return false;
+}
+
+//reads the fields present in json over the top of rule
+static bool ParseRule(const rapidjson::Value &json, MappingRule &rule, std::string &errorOut)
+{
+    if (!json.IsObject())
+    {
+        errorOut = "rule is not an object";
+        return false;
+    }
+
+    auto GetString = [&json](const char *key, std::string &valueOut)
+    {
+        auto member = json.FindMember(key);
+        if (member == json.MemberEnd() || !member->value.IsString())
+        {
+            return false;
+        }
+        valueOut = member->value.GetString();
+        return true;
+    };
+
+    std::string value;
+    for (int field = 0; field < MappingFieldCount; ++field)
+    {
+        const bool hasGlob = GetString(s_fieldGlobKeys[field], rule.patterns[field]);
+        if (GetString(s_fieldRegexKeys[field], value))
+        {
+            if (hasGlob)
+            {
+                errorOut = std::string("has both ") + s_fieldGlobKeys[field] + " and " + s_fieldRegexKeys[field];
+                return false;
+            }
+            rule.patterns[field] = value;
+            rule.isRegex[field] = true;
+        }
+    }
+
+    GetString("importLocation", rule.importLocation);
+    GetString("originalsSubpath", rule.originalsSubpath);
+
+    if (GetString("operation", value) && !ParseOperation(value, rule.importOperation))
+    {
+        errorOut = "unknown import operation '" + value + "'";
+        return false;
+    }
+    if (GetString("objectType", value) && !ParseObjectType(value, rule.importObjectType))
+    {
+        errorOut = "unknown object type '" + value + "'";
+        return false;
+    }
+    if (GetString("language", value) && !ParseLanguage(value, rule.wwiseLanguageIndex))
+    {
+        errorOut = "unknown language '" + value + "'";
+        return false;
+    }
+
+    return true;
+}
+
+static void ClearPatterns(MappingRule &rule)
+{
+    for (int field = 0; field < MappingFieldCount; ++field)
+    {
+        rule.patterns[field].clear();
+        rule.isRegex[field] = false;
+    }
+}
+
+static bool HaveSameResult(const MappingRule &a, const MappingRule &b)
+{
+    return a.importLocation == b.importLocation
+        && a.importOperation == b.importOperation
+        && a.importObjectType == b.importObjectType
+        && a.wwiseLanguageIndex == b.wwiseLanguageIndex
+        && a.originalsSubpath == b.originalsSubpath;
+}
+
+//rule 3 (match "VO_*", track "Dialog*")
+static std::string DescribeRule(size_t index, const MappingRule &rule)
+{
+    std::string description = "rule " + std::to_string(index) + " (";
+    bool first = true;
+    for (int field = 0; field < MappingFieldCount; ++field)
+    {
+        if (rule.patterns[field].empty())
+        {
+            continue;
+        }
+        description += first ? "" : ", ";
+        description += rule.isRegex[field] ? s_fieldRegexKeys[field] : s_fieldGlobKeys[field];
+        description += " \"" + rule.patterns[field] + "\"";
+        first = false;
+    }
+    return description + ")";
+}
+
+//an automaton subject as the item names it stands for
+static std::string DescribeExample(const std::string &example)
+{
+    std::string description;
+    size_t fieldStart = 0;
+    for (int field = 0; field < MappingFieldCount && fieldStart <= example.size(); ++field)
+    {
+        size_t fieldEnd = example.find(RuleAutomaton::FIELD_SEPARATOR, fieldStart);
+        if (fieldEnd == std::string::npos)
+        {
+            fieldEnd = example.size();
+        }
+
+        if (fieldEnd > fieldStart)
+        {
+            description += description.empty() ? "" : ", ";
+            description += std::string(s_fieldNames[field]) + " \"" + example.substr(fieldStart, fieldEnd - fieldStart) + "\"";
+        }
+        fieldStart = fieldEnd + 1;
+    }
+    return description.empty() ? "items with empty names" : description;
+}
+
+bool TransferMapping::Load(const fs::path &path, std::string &errorOut)
+{
+    m_rules.clear();
+    m_automaton.Clear();
+    m_defaults = MappingRule();
+    m_hasDefaultLocation = false;
+
+    std::ifstream file(path);
+    if (!file.is_open())
+    {
+        errorOut = "couldn't open " + path.generic_string();
+        return false;
+    }
+
+    std::stringstream contents;
+    contents << file.rdbuf();
+
+    rapidjson::Document doc;
+    if (doc.Parse(contents.str().c_str()).HasParseError() || !doc.IsObject())
+    {
+        errorOut = path.generic_string() + " is not a valid JSON object";
+        return false;
+    }
+
+    MappingRule defaults;
+    auto defaultsMember = doc.FindMember("defaults");
+    if (defaultsMember != doc.MemberEnd() && !ParseRule(defaultsMember->value, defaults, errorOut))
+    {
+        errorOut = "defaults: " + errorOut;
+        return false;
+    }
+
+    auto rulesMember = doc.FindMember("rules");
+    if (rulesMember != doc.MemberEnd())
+    {
+        if (!rulesMember->value.IsArray())
+        {
+            errorOut = "rules should be an array";
+            return false;
+        }
+
+        for (const auto &ruleJson : rulesMember->value.GetArray())
+        {
+            MappingRule rule = defaults;
+            ClearPatterns(rule);
+
+            if (!ParseRule(ruleJson, rule, errorOut))
+            {
+                errorOut = "rule " + std::to_string(m_rules.size()) + ": " + errorOut;
+                return false;
+            }
+            std::vector<RuleAutomaton::Pattern> patterns;
+            for (int field = 0; field < MappingFieldCount; ++field)
+            {
+                if (!rule.patterns[field].empty())
+                {
+                    patterns.push_back(RuleAutomaton::Pattern{ static_cast<size_t>(field), rule.patterns[field],
+                        rule.isRegex[field] ? RuleAutomaton::Syntax::Regex : RuleAutomaton::Syntax::Glob });
+                }
+            }
+
+            if (patterns.empty() || rule.importLocation.empty())
+            {
+                errorOut = "rule " + std::to_string(m_rules.size()) + ": needs a match pattern and an importLocation";
+                return false;
+            }
+            if (!m_automaton.AddRule(patterns, errorOut))
+            {
+                errorOut = "rule " + std::to_string(m_rules.size()) + ": " + errorOut;
+                return false;
+            }
+            m_rules.push_back(std::move(rule));
+        }
+    }
+
+    //catch all, kept out of the automaton so it doesn't conflict with every rule
+    ClearPatterns(defaults);
+    m_hasDefaultLocation = !defaults.importLocation.empty();
+    m_defaults = std::move(defaults);
+
+    if (m_rules.empty() && !m_hasDefaultLocation)
+    {
+        errorOut = "mapping has no rules and no default importLocation";
+        return false;
+    }
+
+    return true;
+}
+
+const MappingRule *TransferMapping::Match(const RenderItem &item)
+{
+    m_subject.assign(item.outputFileName);
+    m_subject += RuleAutomaton::FIELD_SEPARATOR;
+    m_subject += item.regionName;
+    m_subject += RuleAutomaton::FIELD_SEPARATOR;
+    m_subject += item.trackName;
+
+    const int rule = m_automaton.Match(m_subject);
+    if (rule >= 0)
+    {
+        return &m_rules[rule];
+    }
+    return m_hasDefaultLocation ? &m_defaults : nullptr;
+}
+
+bool TransferMapping::Apply(RenderItem &item)
+{
+    const MappingRule *rule = Match(item);
+    if (!rule)
+    {
+        return false;
+    }
+
+    item.wwiseGuid = rule->importLocation;
+    item.wwiseParentName = rule->importLocation;
+    item.importOperation = rule->importOperation;
+    item.importObjectType = rule->importObjectType;
+    item.wwiseLanguageIndex = rule->wwiseLanguageIndex;
+    item.wwiseOriginalsSubpath = rule->originalsSubpath;
+    return true;
+}
+
+std::vector<std::string> TransferMapping::GetConflictReport()
+{
+    std::vector<std::string> lines;
+    const RuleAutomaton::ConflictReport report = m_automaton.FindConflicts(RULE_CONFLICT_SEARCH_MAX_STATES);
+
+    for (const RuleAutomaton::Conflict &conflict : report.conflicts)
+    {
+        //overlapping rules that import the same way don't matter
+        const MappingRule &earlier = m_rules[conflict.earlierRule];
+        const MappingRule &later = m_rules[conflict.laterRule];
+        if (HaveSameResult(earlier, later))
+        {
+            continue;
+        }
+
+        lines.push_back(DescribeRule(conflict.earlierRule, earlier) + " and " + DescribeRule(conflict.laterRule, later)
+                        + " both match " + DescribeExample(conflict.example) + ", the first is used");
+    }
+
+    for (size_t rule : report.shadowedRules)
+    {
+        lines.push_back(DescribeRule(rule, m_rules[rule]) + " never applies, earlier rules match everything it does");
+    }
+    for (size_t rule : report.unmatchableRules)
+    {
+        lines.push_back(DescribeRule(rule, m_rules[rule]) + " can't match anything, no names fit all of its patterns");
+    }
+
+    if (!report.complete)
+    {
+        lines.push_back("stopped checking after " + std::to_string(report.numStates)
+                        + " combinations of rules, there may be more conflicts than listed");
+    }
+    return lines;
+}
+
+bool GlobMatch(const char *pattern, const char *text)
+{
+    //iterative wildcard match, backtracks to the last * only
+    const char *starPattern = nullptr;
+    const char *starText = nullptr;
+
+    while (*text)
+    {
+        if (*pattern == '*')
+        {
+            starPattern = ++pattern;
+            starText = text;
+        }
+        else if (*pattern == '?' || *pattern == *text)
+        {
+            ++pattern;
+            ++text;
+        }
+        else if (starPattern)
+        {
+            pattern = starPattern;
+            text = ++starText;
+        }
+        else
+        {
+            return false;
+        }
+    }
+
+    while (*pattern == '*')
+    {
+        ++pattern;
+    }
+    return !*pattern;
+}
@@ -0,0 +1,85 @@
+#pragma once
+#include <string>
+#include <vector>
+
+#include "RuleAutomaton.h"
+#include "types.h"
+
+//render item fields a mapping rule can match on
+enum MappingField
+{
+    MappingFieldOutputName,
+    MappingFieldRegion,
+    MappingFieldTrack,
+    MappingFieldCount
+};
+
+//Where a render item goes in wwise and how it is imported
+struct MappingRule
+{
+    //globs matched against the render item output file name, reaper region name and track name, * and ? wildcards
+    //or regexes where isRegex is set (see RuleAutomaton::Syntax). Empty patterns aren't checked
+    std::string patterns[MappingFieldCount];
+    bool isRegex[MappingFieldCount] = {};
+
+    //wwise object guid or path
+    std::string importLocation;
+
+    WAAPIImportOperation importOperation = WAAPIImportOperation::createNew;
+    ImportObjectType importObjectType = ImportObjectType::SFX;
+    int wwiseLanguageIndex = 0;
+    std::string originalsSubpath;
+};
+
+//Mapping file for the command line transfer and the transfer window's "assign parents from mapping" action,
+//replaces the manual parenting.
+//
+//{
+//    "defaults": { "importLocation": "\\Actor-Mixer Hierarchy\\Default Work Unit", "operation": "createNew",
+//                  "objectType": "SFX", "language": "English(US)", "originalsSubpath": "" },
+//    "rules": [
+//        { "match": "VO_*", "importLocation": "{GUID}", "objectType": "Voice" },
+//        { "matchRegex": "SFX_(Door|Window)_\\d+", "track": "Foley*", "importLocation": "\\Actor-Mixer Hierarchy\\Foley" }
+//    ]
+//}
+//
+//"match", "region" and "track" are globs on the output file name, region name and track name, "matchRegex",
+//"regionRegex" and "trackRegex" the same as regexes. A rule needs one of them and matches when all it has do.
+//The first matching rule wins, fields missing from a rule come from "defaults".
+//If defaults has an importLocation it also catches every item no rule matched.
+//All the rules are compiled into one RuleAutomaton, an item is mapped in one pass over its names.
+class TransferMapping
+{
+public:
+    bool Load(const fs::path &path, std::string &errorOut);
+
+    //the first rule matching the item, the defaults if none did and they have an importLocation, otherwise nullptr
+    const MappingRule *Match(const RenderItem &item);
+
+    //sets the wwise fields of the item from Match, returns false if nothing matched
+    bool Apply(RenderItem &item);
+
+    size_t GetNumRules() const { return m_rules.size(); }
+    const MappingRule &GetRule(size_t index) const { return m_rules[index]; }
+
+    //rules matching the same items with different results, rules that never apply and rules that can't match
+    //anything, one line each. Empty if the rules don't conflict
+    std::vector<std::string> GetConflictReport();
+
+    //DFA states built by the items mapped so far
+    size_t GetNumAutomatonStates() const { return m_automaton.GetNumStates(); }
+
+private:
+    std::vector<MappingRule> m_rules;
+
+    MappingRule m_defaults;
+    bool m_hasDefaultLocation = false;
+
+    RuleAutomaton m_automaton;
+
+    //the item's fields joined for the automaton, kept to reuse its allocation
+    std::string m_subject;
+};
+
+//one glob on its own, without building an automaton
+bool GlobMatch(const char *pattern, const char *text);
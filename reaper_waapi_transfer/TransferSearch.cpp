@@ -1,9 +1,12 @@
 #include <algorithm>
 #include <cctype>
+#include <ctime>
 
 #include "reaper_plugin_functions.h"
 
 #include "TransferSearch.h"
+#include "RenderQueueReader.h"
+#include "RenderQueueWriter.h"
 #include "WAAPITransfer.h"
 
 
@@ -67,6 +70,63 @@ void TransferSearch::RefreshState()
     RefreshRenderItemIndexing();
 }
 
+bool TransferSearch::QueueSelectedRegions(std::string &errorOut)
+{
+    char projectPath[MAX_PATH];
+    EnumProjects(-1, projectPath, MAX_PATH);
+
+    //the queued render is made from the file, unsaved changes wouldn't be in it
+    if (!strcmp(projectPath, "") || IsProjectDirty(nullptr))
+    {
+        errorOut = "Save the project before queueing a render.";
+        return false;
+    }
+
+    //selected tracks come in project order
+    std::vector<std::string> trackGuids;
+    const int numSelectedTracks = CountSelectedTracks(nullptr);
+    for (int trackIdx = 0; trackIdx < numSelectedTracks; ++trackIdx)
+    {
+        char guidStr[64];
+        guidToString(GetTrackGUID(GetSelectedTrack(nullptr, trackIdx)), guidStr);
+        trackGuids.push_back(guidStr);
+    }
+
+    RenderQueueSelection selection;
+    HWND regionView = GetRegionListViewHWND();
+    for (int listIdx = ListView_GetNextItem(regionView, -1, LVNI_SELECTED);
+         listIdx != -1;
+         listIdx = ListView_GetNextItem(regionView, listIdx, LVNI_SELECTED))
+    {
+        LVITEM listViewItem{};
+        listViewItem.mask = LVIF_PARAM;
+        listViewItem.iItem = listIdx;
+        ListView_GetItem(regionView, &listViewItem);
+        selection.regions.push_back(RenderQueueSelection::Region{ static_cast<uint32>(listViewItem.lParam), trackGuids, trackGuids.empty() });
+    }
+
+    if (selection.regions.empty())
+    {
+        errorOut = "Select the regions to render first.";
+        return false;
+    }
+
+    //named like the ones reaper queues, GetRenderQueueProjectFiles looks for "qrender"
+    char timeStr[32];
+    const std::time_t now = std::time(nullptr);
+    std::strftime(timeStr, sizeof(timeStr), "%y%m%d_%H%M%S", std::localtime(&now));
+    const std::string queueName = "qrender_" + std::string(timeStr) + "_" + fs::path(projectPath).stem().string();
+
+    fs::path queuePath = GetRenderQueueDir() / (queueName + ".rpp");
+    for (int suffix = 2; fs::exists(queuePath); ++suffix)
+    {
+        queuePath = GetRenderQueueDir() / (queueName + "_" + std::to_string(suffix) + ".rpp");
+    }
+
+    std::vector<RenderItem> outputs;
+    return WriteQueuedRender(projectPath, selection, queuePath, outputs, errorOut);
+}
+
 void TransferSearch::RefreshReaperState()
 {
     m_trackGuidToRenderItems.clear();
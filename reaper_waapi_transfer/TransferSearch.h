@@ -1,4 +1,5 @@
 #pragma once
+#include <string>
 #include <vector>
 #include <unordered_map>
 #include <Windows.h>
@@ -18,6 +19,10 @@ public:
 
     void RefreshState();
 
+    //queues a render of the saved project for the selected regions, through the tracks selected in reaper or the
+    //master mix if none are. The transfer window picks it up with reaper's own queued renders
+    bool QueueSelectedRegions(std::string &errorOut);
+
     HWND GetRegionListViewHWND() { return GetDlgItem(m_hwnd, m_regionListViewId); }
     HWND GetRegionTracksToRenderHWND() { return GetDlgItem(m_hwnd, m_regionTracksToRenderListViewId); }
 
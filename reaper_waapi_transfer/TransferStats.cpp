@@ -0,0 +1,198 @@
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+#include <ctime>
+#include <cstdio>
+
+#include "TransferStats.h"
+#include "config.h"
+
+bool TransferHistory::Load(const fs::path &path)
+{
+    m_projects.clear();
+    m_allProjects = TransferProjectHistory{};
+
+    std::ifstream file(path);
+    if (!file.is_open())
+    {
+        return false;
+    }
+
+    //one project per line: render ratio, render samples, import per item, import samples, last used, project path.
+    //Lines from before last used was saved don't parse and are dropped, they were keyed by queued render anyway
+    std::string line;
+    while (std::getline(file, line))
+    {
+        std::stringstream lineStream(line);
+        TransferProjectHistory history;
+        std::string project;
+
+        if (!(lineStream >> history.renderSecondsPerAudioSecond >> history.renderSamples
+                         >> history.importSecondsPerItem >> history.importSamples >> history.lastUsed))
+        {
+            continue;
+        }
+
+        std::getline(lineStream >> std::ws, project);
+        if (project.empty())
+        {
+            continue;
+        }
+
+        if (history.renderSamples)
+        {
+            AddSample(m_allProjects.renderSecondsPerAudioSecond, m_allProjects.renderSamples, history.renderSecondsPerAudioSecond);
+        }
+        if (history.importSamples)
+        {
+            AddSample(m_allProjects.importSecondsPerItem, m_allProjects.importSamples, history.importSecondsPerItem);
+        }
+
+        m_projects[project] = history;
+    }
+
+    return true;
+}
+
+bool TransferHistory::Save(const fs::path &path) const
+{
+    std::ofstream file(path, std::ios::trunc);
+    if (!file.is_open())
+    {
+        return false;
+    }
+
+    //most recently used first, so the file only ever holds the newest TRANSFER_HISTORY_MAX_PROJECTS
+    std::vector<const ProjectMap::value_type*> projects;
+    projects.reserve(m_projects.size());
+    for (const auto &project : m_projects)
+    {
+        projects.push_back(&project);
+    }
+    std::sort(projects.begin(), projects.end(), [](const ProjectMap::value_type *a, const ProjectMap::value_type *b)
+    {
+        return a->second.lastUsed > b->second.lastUsed;
+    });
+    projects.resize(std::min(projects.size(), TRANSFER_HISTORY_MAX_PROJECTS));
+
+    for (const ProjectMap::value_type *project : projects)
+    {
+        const TransferProjectHistory &history = project->second;
+        file << history.renderSecondsPerAudioSecond << ' ' << history.renderSamples << ' '
+             << history.importSecondsPerItem << ' ' << history.importSamples << ' '
+             << history.lastUsed << ' ' << project->first << '\n';
+    }
+
+    return file.good();
+}
+
+void TransferHistory::AddSample(double &average, uint32 &numSamples, double sample)
+{
+    //exponential moving average so the history follows machine/project changes
+    if (numSamples == 0)
+    {
+        average = sample;
+    }
+    else
+    {
+        average += TRANSFER_HISTORY_SMOOTHING * (sample - average);
+    }
+    ++numSamples;
+}
+
+void TransferHistory::AddRenderSample(const std::string &project, double audioSeconds, double renderSeconds)
+{
+    //entire project renders don't know their length, nothing to learn from them
+    if (audioSeconds <= 0.0)
+    {
+        return;
+    }
+
+    const double ratio = renderSeconds / audioSeconds;
+    TransferProjectHistory &history = m_projects[project];
+    history.lastUsed = static_cast<int64_t>(std::time(nullptr));
+    AddSample(history.renderSecondsPerAudioSecond, history.renderSamples, ratio);
+    AddSample(m_allProjects.renderSecondsPerAudioSecond, m_allProjects.renderSamples, ratio);
+}
+
+void TransferHistory::AddImportSample(const std::string &project, uint32 numItems, double importSeconds)
+{
+    if (numItems == 0)
+    {
+        return;
+    }
+
+    const double perItem = importSeconds / numItems;
+    TransferProjectHistory &history = m_projects[project];
+    history.lastUsed = static_cast<int64_t>(std::time(nullptr));
+    AddSample(history.importSecondsPerItem, history.importSamples, perItem);
+    AddSample(m_allProjects.importSecondsPerItem, m_allProjects.importSamples, perItem);
+}
+
+double TransferHistory::PredictRenderSeconds(const std::string &project, double audioSeconds) const
+{
+    auto found = m_projects.find(project);
+    if (found != m_projects.end() && found->second.renderSamples)
+    {
+        return audioSeconds * found->second.renderSecondsPerAudioSecond;
+    }
+
+    if (m_allProjects.renderSamples)
+    {
+        return audioSeconds * m_allProjects.renderSecondsPerAudioSecond;
+    }
+
+    return audioSeconds * TRANSFER_DEFAULT_RENDER_RATIO;
+}
+
+double TransferHistory::PredictImportSeconds(const std::string &project, uint32 numItems) const
+{
+    auto found = m_projects.find(project);
+    if (found != m_projects.end() && found->second.importSamples)
+    {
+        return numItems * found->second.importSecondsPerItem;
+    }
+
+    if (m_allProjects.importSamples)
+    {
+        return numItems * m_allProjects.importSecondsPerItem;
+    }
+
+    return numItems * TRANSFER_DEFAULT_IMPORT_SECONDS_PER_ITEM;
+}
+
+std::string FormatTransferProgress(const TransferProgress &progress, const char *separator)
+{
+    char strbuff[256];
+    snprintf(strbuff, sizeof(strbuff),
+             "%u/%u projects, %u items%s%.1f items/s, %.2f MB/s%srender %.1fs, import %.1fs",
+             progress.projectsDone, progress.projectsTotal, progress.itemsImported, separator,
+             progress.GetItemsPerSecond(), progress.GetMegabytesPerSecond(), separator,
+             progress.renderSeconds, progress.importSeconds);
+
+    std::string text(strbuff);
+
+    if (progress.etaSeconds >= 0.0)
+    {
+        const uint32 eta = static_cast<uint32>(progress.etaSeconds + 0.5);
+        snprintf(strbuff, sizeof(strbuff), "%sETA %um %02us", separator, eta / 60, eta % 60);
+        text += strbuff;
+    }
+
+    return text;
+}
+
+void AppendTransferLog(const fs::path &logPath, const std::string &line)
+{
+    std::ofstream file(logPath, std::ios::app);
+    if (!file.is_open())
+    {
+        return;
+    }
+
+    char timeBuff[64];
+    std::time_t now = std::time(nullptr);
+    std::strftime(timeBuff, sizeof(timeBuff), "%Y-%m-%d %H:%M:%S", std::localtime(&now));
+
+    file << '[' << timeBuff << "] " << line << '\n';
+}
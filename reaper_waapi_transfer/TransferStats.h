@@ -0,0 +1,80 @@
+#pragma once
+#include <string>
+#include <vector>
+#include <unordered_map>
+
+#include "types.h"
+
+//Timing history for a single render queue project
+struct TransferProjectHistory
+{
+    //wall clock seconds spent rendering per second of rendered audio
+    double renderSecondsPerAudioSecond{};
+
+    //wall clock seconds spent in waapi imports per imported item
+    double importSecondsPerItem{};
+
+    uint32 renderSamples{};
+    uint32 importSamples{};
+
+    //time_t of the last sample, the oldest projects are dropped when saving
+    int64_t lastUsed{};
+};
+
+//Persistent render/import timing history keyed by reaper project path, the project the render queue was made from
+//(GetQueuedRenderProject) and not the queued render, which reaper names anew every time. One running average per
+//project, at most TRANSFER_HISTORY_MAX_PROJECTS of them are saved.
+//Used to predict the remaining time of a transfer
+class TransferHistory
+{
+public:
+    TransferHistory() = default;
+
+    //returns false if the file couldn't be opened, history is left empty in that case
+    bool Load(const fs::path &path);
+    bool Save(const fs::path &path) const;
+
+    void AddRenderSample(const std::string &project, double audioSeconds, double renderSeconds);
+    void AddImportSample(const std::string &project, uint32 numItems, double importSeconds);
+
+    //falls back to the average of every project, then to defaults from config.h
+    double PredictRenderSeconds(const std::string &project, double audioSeconds) const;
+    double PredictImportSeconds(const std::string &project, uint32 numItems) const;
+
+private:
+    static void AddSample(double &average, uint32 &numSamples, double sample);
+
+    typedef std::unordered_map<std::string, TransferProjectHistory> ProjectMap;
+    ProjectMap m_projects;
+
+    //running averages over every project
+    TransferProjectHistory m_allProjects;
+};
+
+//Snapshot of a running transfer, written by the transfer thread and read by the progress window
+struct TransferProgress
+{
+    uint32 projectsDone;
+    uint32 projectsTotal;
+
+    uint32 itemsImported;
+    uint64_t bytesImported;
+
+    //time spent waiting on reaper to render and time spent in waapi import calls
+    double renderSeconds;
+    double importSeconds;
+
+    double elapsedSeconds;
+
+    //negative if there isn't enough information yet
+    double etaSeconds;
+
+    double GetItemsPerSecond() const { return importSeconds > 0.0 ? itemsImported / importSeconds : 0.0; }
+    double GetMegabytesPerSecond() const { return importSeconds > 0.0 ? (bytesImported / (1024.0 * 1024.0)) / importSeconds : 0.0; }
+};
+
+//human readable summary, the log uses a single line, the progress window one line per group
+std::string FormatTransferProgress(const TransferProgress &progress, const char *separator = " | ");
+
+//appends a time stamped line to the transfer log file
+void AppendTransferLog(const fs::path &logPath, const std::string &line);
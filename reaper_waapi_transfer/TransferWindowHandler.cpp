@@ -48,6 +48,7 @@ INT_PTR WINAPI AboutWindowProc(HWND hwndDlg, UINT uMsg, WPARAM wParam, LPARAM lP
 //////////////////////////////////////////////////////////////////////////
 
 const uint32 IDT_REFRESH_VIEW_TIMER = 1002;
+const uint32 IDT_PROGRESS_STATS_TIMER = 1003;
 
 #define START_REFRESH_TIMER(hwnd) SetTimer(hwnd, IDT_REFRESH_VIEW_TIMER, 1500, static_cast<TIMERPROC>(nullptr))
 #define STOP_REFRESH_TIMER(hwnd) KillTimer(hwnd, IDT_REFRESH_VIEW_TIMER)
@@ -57,6 +58,9 @@ static uint32 const s_contextMenuReplaceExisting = 0xFE000000 | 0x1;
 static uint32 const s_contextMenuUseExistingId = 0xFE000000 | 0x2;
 static uint32 const s_contextMenuImportAsSFX = 0xFE000000 | 0x3;
 static uint32 const s_contextMenuImportAsDialog = 0xFE000000 | 0x4;
+static uint32 const s_contextMenuMirrorAsActorMixers = 0xFE000000 | 0x5;
+static uint32 const s_contextMenuMirrorAsFolders = 0xFE000000 | 0x6;
+static uint32 const s_contextMenuAssignFromMapping = 0xFE000000 | 0x7;
 
 
 LRESULT CALLBACK TransferWindow_ReaperKeyboardHook(int code, WPARAM wParam, LPARAM lParam)
@@ -125,6 +129,29 @@ INT_PTR WINAPI TransferWindowProc(HWND hwndDlg, UINT uMsg, WPARAM wParam, LPARAM
 		case WM_COMMAND:
 		{
 			WAAPITransfer *transfer = reinterpret_cast<WAAPITransfer*>(GetWindowLongPtr(hwndDlg, GWLP_USERDATA));
+
+			//combo box notifications carry the notification code in the high word
+			if (LOWORD(wParam) == IDC_WWISE_SEARCH)
+			{
+				switch (HIWORD(wParam))
+				{
+					case CBN_EDITCHANGE:
+					{
+						transfer->OnWwiseSearchEdited();
+					} break;
+
+					case CBN_SELENDOK:
+					{
+						transfer->AddWwiseSearchSelection();
+					} break;
+
+					default:
+					{
+					} break;
+				}
+				break;
+			}
+
 			switch (wParam)
 			{
 				case s_contextMenuReplaceExisting:
@@ -152,6 +179,24 @@ INT_PTR WINAPI TransferWindowProc(HWND hwndDlg, UINT uMsg, WPARAM wParam, LPARAM
 					transfer->SetSelectedImportObjectType(ImportObjectType::Voice);
 				} break;
 
+				case s_contextMenuMirrorAsActorMixers:
+				case s_contextMenuMirrorAsFolders:
+				{
+					auto selected = ListView_GetNextItem(transfer->GetWwiseObjectListHWND(), -1, LVNI_SELECTED);
+					if (selected == -1)
+					{
+						transfer->SetStatusText("Select a Wwise parent to mirror the track folders under.");
+						break;
+					}
+					transfer->MirrorSelectedTrackFolders(ListView_MapIndexToID(transfer->GetWwiseObjectListHWND(), selected),
+														 wParam == s_contextMenuMirrorAsActorMixers ? "ActorMixer" : "Folder");
+				} break;
+
+				case s_contextMenuAssignFromMapping:
+				{
+					transfer->AssignSelectedParentsFromMapping();
+				} break;
+
 
 				case IDC_WAAPI_RECONNECT:
 				{
@@ -275,6 +320,28 @@ INT_PTR WINAPI TransferWindowProc(HWND hwndDlg, UINT uMsg, WPARAM wParam, LPARAM
 			return true;
 		} break;
 
+		//posted from the parent search thread, wParam is if the query succeeded
+		case WM_WWISE_SEARCH_RESULTS:
+		{
+			WAAPITransfer *transfer = reinterpret_cast<WAAPITransfer*>(GetWindowLongPtr(hwndDlg, GWLP_USERDATA));
+			if (transfer)
+			{
+				transfer->OnWwiseSearchResults(wParam != FALSE);
+			}
+			return true;
+		} break;
+
+		//posted from the hierarchy mirror when something changed in Wwise
+		case WM_WWISE_HIERARCHY_CHANGED:
+		{
+			WAAPITransfer *transfer = reinterpret_cast<WAAPITransfer*>(GetWindowLongPtr(hwndDlg, GWLP_USERDATA));
+			if (transfer)
+			{
+				transfer->RefreshWwiseObjectsFromHierarchy();
+			}
+			return true;
+		} break;
+
 		case WM_CONTEXTMENU:
 		{
 			WAAPITransfer *transfer = reinterpret_cast<WAAPITransfer*>(GetWindowLongPtr(hwndDlg, GWLP_USERDATA));
@@ -295,6 +362,12 @@ INT_PTR WINAPI TransferWindowProc(HWND hwndDlg, UINT uMsg, WPARAM wParam, LPARAM
 				InsertMenuA(hPopupMenu, -1, MF_BYPOSITION | MF_GRAYED | MF_STRING, 0, "Import Type");
 				InsertMenuA(hPopupMenu, -1, MF_BYPOSITION | MF_STRING, s_contextMenuImportAsSFX, "SFX");
 				InsertMenuA(hPopupMenu, -1, MF_BYPOSITION | MF_STRING, s_contextMenuImportAsDialog, "Dialog");
+				InsertMenuA(hPopupMenu, -1, MF_BYPOSITION | MF_GRAYED | MF_SEPARATOR, 0, nullptr);
+				InsertMenuA(hPopupMenu, -1, MF_BYPOSITION | MF_GRAYED | MF_STRING, 0, "Mirror Track Folders Under Selected Wwise Parent");
+				InsertMenuA(hPopupMenu, -1, MF_BYPOSITION | MF_STRING, s_contextMenuMirrorAsActorMixers, "As Actor-Mixers");
+				InsertMenuA(hPopupMenu, -1, MF_BYPOSITION | MF_STRING, s_contextMenuMirrorAsFolders, "As Virtual Folders");
+				InsertMenuA(hPopupMenu, -1, MF_BYPOSITION | MF_GRAYED | MF_SEPARATOR, 0, nullptr);
+				InsertMenuA(hPopupMenu, -1, MF_BYPOSITION | MF_STRING, s_contextMenuAssignFromMapping, "Assign Parents From Mapping File");
 				SetForegroundWindow(hwndDlg);
 				TrackPopupMenu(hPopupMenu, TPM_TOPALIGN | TPM_LEFTALIGN, xPos, yPos, 0, hwndDlg, NULL);
 			}
@@ -400,9 +473,19 @@ INT_PTR WINAPI ProgressWindowProc(HWND hwndDlg, UINT uMsg, WPARAM wParam, LPARAM
 		{
 			SetWindowLongPtr(hwndDlg, GWLP_USERDATA, lParam);
 			reinterpret_cast<WAAPITransfer*>(lParam)->SetProgressWindowHWND(hwndDlg);
+			SetTimer(hwndDlg, IDT_PROGRESS_STATS_TIMER, 250, static_cast<TIMERPROC>(nullptr));
 			ShowWindow(hwndDlg, SW_SHOW);
 		} break;
 
+		case WM_TIMER:
+		{
+			if (wParam == IDT_PROGRESS_STATS_TIMER)
+			{
+				const WAAPITransfer *transfer = reinterpret_cast<WAAPITransfer*>(GetWindowLongPtr(hwndDlg, GWLP_USERDATA));
+				SetDlgItemText(hwndDlg, IDC_PROGRESS_STATS, FormatTransferProgress(transfer->GetTransferProgress(), "\n").c_str());
+			}
+		} break;
+
 		case WM_PROGRESS_WINDOW_MSG:
 		{
 			HWND progressBarHWND = GetDlgItem(hwndDlg, IDC_PROGRESS);
@@ -421,6 +504,7 @@ INT_PTR WINAPI ProgressWindowProc(HWND hwndDlg, UINT uMsg, WPARAM wParam, LPARAM
 
 				case PROGRESS_WINDOW_WPARAM::EXIT:
 				{
+					KillTimer(hwndDlg, IDT_PROGRESS_STATS_TIMER);
 					reinterpret_cast<WAAPITransfer*>(GetWindowLongPtr(hwndDlg, GWLP_USERDATA))->SetProgressWindowHWND(0);
 					EndDialog(hwndDlg, 0);
 				} break;
@@ -567,12 +651,7 @@ INT_PTR WINAPI ImportSettingsWindowProc(HWND hwndDlg, UINT uMsg, WPARAM wParam,
 							ComboBox_AddString(GetDlgItem(hwndDlg, IDC_ORIGINALS_TEXT), strBuff);
 						}
 
-						transferPtr->ForEachSelectedRenderItem([transferPtr, &pathStr, strBuff](MappedListViewID mappedIdx, uint32 listViewIdx)
-						{
-							RenderItem &item = transferPtr->GetRenderItemFromListviewId(mappedIdx);
-							item.wwiseOriginalsSubpath = pathStr;
-							ListView_SetItemText(transferPtr->GetRenderViewHWND(), listViewIdx, WAAPITransfer::RenderViewSubitemID::WwiseOriginalsSubPath, (LPSTR)strBuff);
-						});
+						transferPtr->SetSelectedOriginalsSubpath(pathStr);
 					}
 
 				} break;
@@ -6,6 +6,8 @@
 #define WM_TRANSFER_THREAD_MSG (WM_USER + 1)
 #define WM_PROGRESS_WINDOW_MSG (WM_USER + 2)
 #define WM_TRANSFER_SELECT_ALL (WM_USER + 3)
+#define WM_WWISE_HIERARCHY_CHANGED (WM_USER + 4)
+#define WM_WWISE_SEARCH_RESULTS (WM_USER + 5)
 
 LRESULT CALLBACK TransferWindow_ReaperKeyboardHook(int code, WPARAM wParam, LPARAM lParam);
 
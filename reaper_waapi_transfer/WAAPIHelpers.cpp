@@ -90,13 +90,9 @@ int WwiseImageList::GetIconForWwiseType(const std::string wwiseType)
 }
 
 
-bool GetAllSelectedWwiseObjects(AK::WwiseAuthoringAPI::AkJson &resultsOut, 
-                                AK::WwiseAuthoringAPI::Client &client, 
-                                bool GetNotes)
+static AK::WwiseAuthoringAPI::AkJson MakeSelectedObjectsOptions(bool getNotes)
 {
     using namespace AK::WwiseAuthoringAPI;
-    AkJson resultsJson;
-    
     AkJson options(AkJson::Map{
         { "return", AkJson::Array{ 
         AkVariant("id"), 
@@ -107,13 +103,30 @@ bool GetAllSelectedWwiseObjects(AK::WwiseAuthoringAPI::AkJson &resultsOut,
         AkVariant("childrenCount"), } }
     });
 
-    if (GetNotes)
+    if (getNotes)
     {
         options["return"].GetArray().push_back(AkVariant("notes"));
     }
 
+    return options;
+}
 
-    return client.Call(ak::wwise::ui::getSelectedObjects, AkJson(AkJson::Map()), options, resultsOut);
+bool GetAllSelectedWwiseObjects(AK::WwiseAuthoringAPI::AkJson &resultsOut, 
+                                AK::WwiseAuthoringAPI::Client &client, 
+                                bool GetNotes)
+{
+    using namespace AK::WwiseAuthoringAPI;
+    return client.Call(ak::wwise::ui::getSelectedObjects, AkJson(AkJson::Map()), MakeSelectedObjectsOptions(GetNotes), resultsOut);
+}
+
+bool GetAllSelectedWwiseObjects(AK::WwiseAuthoringAPI::ResultView &resultsOut,
+                                AK::WwiseAuthoringAPI::AkJson &errorOut,
+                                AK::WwiseAuthoringAPI::Client &client,
+                                bool getNotes)
+{
+    using namespace AK::WwiseAuthoringAPI;
+    return ResultViews::Call(client, ak::wwise::ui::getSelectedObjects, AkJson(AkJson::Map()), MakeSelectedObjectsOptions(getNotes),
+                             resultsOut, errorOut);
 }
 
 void GetWaapiResultsArray(AK::WwiseAuthoringAPI::AkJson::Array &arrayIn,
@@ -149,21 +162,21 @@ void GetWaapiResultsArray(AK::WwiseAuthoringAPI::AkJson::Array &arrayIn,
     }
 }
 
-bool GetChildren(const AK::WwiseAuthoringAPI::AkVariant &path, 
-                 AK::WwiseAuthoringAPI::AkJson &results, 
-                 AK::WwiseAuthoringAPI::Client &client,
-                 bool getNotes)
+static AK::WwiseAuthoringAPI::AkJson MakeChildrenArgs(const AK::WwiseAuthoringAPI::AkVariant &path)
 {
     using namespace AK::WwiseAuthoringAPI;
-    AkJson query;
-    AkJson args(AkJson::Map{
+    return AkJson(AkJson::Map{
         { "from", AkJson::Map{
             { "path", AkJson::Array{ path } } } },
             { "transform",
             { AkJson::Array{ AkJson::Map{ { "select", AkJson::Array{ { "children" } } } } } }
         }
     });
+}
 
+static AK::WwiseAuthoringAPI::AkJson MakeChildrenOptions(bool getNotes)
+{
+    using namespace AK::WwiseAuthoringAPI;
     AkJson options(AkJson::Map{
         { "return", AkJson::Array{
         AkVariant("id"), 
@@ -180,7 +193,167 @@ bool GetChildren(const AK::WwiseAuthoringAPI::AkVariant &path,
         options["return"].GetArray().push_back(AkVariant("notes"));
     }
 
-    return client.Call(ak::wwise::core::object::get, args, options, results);
+    return options;
+}
+
+bool GetChildren(const AK::WwiseAuthoringAPI::AkVariant &path, 
+                 AK::WwiseAuthoringAPI::AkJson &results, 
+                 AK::WwiseAuthoringAPI::Client &client,
+                 bool getNotes)
+{
+    using namespace AK::WwiseAuthoringAPI;
+    return client.Call(ak::wwise::core::object::get, MakeChildrenArgs(path), MakeChildrenOptions(getNotes), results);
+}
+
+bool GetChildren(const AK::WwiseAuthoringAPI::AkVariant &path,
+                 AK::WwiseAuthoringAPI::ResultView &resultsOut,
+                 AK::WwiseAuthoringAPI::AkJson &errorOut,
+                 AK::WwiseAuthoringAPI::Client &client,
+                 bool getNotes)
+{
+    using namespace AK::WwiseAuthoringAPI;
+    return ResultViews::Call(client, ak::wwise::core::object::get, MakeChildrenArgs(path), MakeChildrenOptions(getNotes),
+                             resultsOut, errorOut);
+}
+
+bool GetChildrenOfObjects(const std::vector<std::string> &guids,
+                          AK::WwiseAuthoringAPI::ResultView &resultsOut,
+                          AK::WwiseAuthoringAPI::AkJson &errorOut,
+                          AK::WwiseAuthoringAPI::Client &client)
+{
+    using namespace AK::WwiseAuthoringAPI;
+
+    AkJson::Array ids;
+    ids.reserve(guids.size());
+    for (const std::string &guid : guids)
+    {
+        ids.push_back(AkVariant(guid));
+    }
+
+    AkJson args(AkJson::Map{
+        { "from", AkJson::Map{ { "id", ids } } },
+        { "transform", AkJson::Array{ AkJson::Map{ { "select", AkJson::Array{ AkVariant("children") } } } } }
+    });
+
+    AkJson options(AkJson::Map{
+        { "return", AkJson::Array{
+        AkVariant("id"),
+        AkVariant("name"),
+        AkVariant("type"),
+        AkVariant("parent"),
+        AkVariant("sound:originalWavFilePath")
+    }}
+    });
+
+    return ResultViews::Call(client, ak::wwise::core::object::get, args, options, resultsOut, errorOut);
+}
+
+bool CreateFolderContainers(const std::string &root,
+                            const std::vector<FolderNode> &nodes,
+                            const std::string &containerType,
+                            AK::WwiseAuthoringAPI::AkJson &errorOut,
+                            AK::WwiseAuthoringAPI::Client &client,
+                            size_t &numCallsOut)
+{
+    using namespace AK::WwiseAuthoringAPI;
+
+    numCallsOut = 1;
+    if (client.Call(ak::wwise::core::object::set, MakeFolderSetArgs(root, nodes, containerType),
+                    AkJson(AkJson::Map()), errorOut))
+    {
+        return true;
+    }
+
+    //object.set is wwise 2022.1 and up
+    if (!errorOut.IsMap() || !errorOut.HasKey("uri")
+        || errorOut["uri"].GetVariant().GetString() != "wamp.error.no_such_procedure")
+    {
+        return false;
+    }
+
+    for (const FolderNode &node : nodes)
+    {
+        ++numCallsOut;
+        if (!client.Call(ak::wwise::core::object::create, MakeFolderCreateArgs(root, node, containerType),
+                         AkJson(AkJson::Map()), errorOut))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+//object.get of the objects listed under fromKey ("path" or "id"), returning id, name, type and path
+static bool GetObjectsFrom(const char *fromKey,
+                           const std::vector<std::string> &objects,
+                           AK::WwiseAuthoringAPI::ResultView &resultsOut,
+                           AK::WwiseAuthoringAPI::AkJson &errorOut,
+                           AK::WwiseAuthoringAPI::Client &client)
+{
+    using namespace AK::WwiseAuthoringAPI;
+
+    AkJson::Array objectArray;
+    objectArray.reserve(objects.size());
+    for (const std::string &object : objects)
+    {
+        objectArray.push_back(AkVariant(object));
+    }
+
+    AkJson args(AkJson::Map{
+        { "from", AkJson::Map{ { fromKey, objectArray } } }
+    });
+
+    AkJson options(AkJson::Map{
+        { "return", AkJson::Array{
+        AkVariant("id"),
+        AkVariant("name"),
+        AkVariant("type"),
+        AkVariant("path")
+    }}
+    });
+
+    return ResultViews::Call(client, ak::wwise::core::object::get, args, options, resultsOut, errorOut);
+}
+
+bool GetObjectsFromPaths(const std::vector<std::string> &paths,
+                         AK::WwiseAuthoringAPI::ResultView &resultsOut,
+                         AK::WwiseAuthoringAPI::AkJson &errorOut,
+                         AK::WwiseAuthoringAPI::Client &client)
+{
+    return GetObjectsFrom("path", paths, resultsOut, errorOut, client);
+}
+
+bool GetObjectsFromIds(const std::vector<std::string> &guids,
+                       AK::WwiseAuthoringAPI::ResultView &resultsOut,
+                       AK::WwiseAuthoringAPI::AkJson &errorOut,
+                       AK::WwiseAuthoringAPI::Client &client)
+{
+    return GetObjectsFrom("id", guids, resultsOut, errorOut, client);
+}
+
+bool SearchParentContainers(const std::string &text,
+                            AK::WwiseAuthoringAPI::ResultView &resultsOut,
+                            AK::WwiseAuthoringAPI::AkJson &errorOut,
+                            AK::WwiseAuthoringAPI::Client &client)
+{
+    using namespace AK::WwiseAuthoringAPI;
+
+    AkJson::Array parentTypes;
+    for (const std::string &type : s_wwiseParentTypes)
+    {
+        parentTypes.push_back(AkVariant(type));
+    }
+
+    //search uses wwise's name index, the type filter runs on its matches only
+    AkJson args(AkJson::Map{
+        { "from", AkJson::Map{
+            { "search", AkJson::Array{ AkVariant(text) } } } },
+        { "transform", AkJson::Array{
+            AkJson::Map{ { "where", AkJson::Array{ AkVariant("type:isIn"), parentTypes } } } } }
+    });
+
+    return ResultViews::Call(client, ak::wwise::core::object::get, args, MakeChildrenOptions(false),
+                             resultsOut, errorOut);
 }
 
 bool WaapiImportItems(const AK::WwiseAuthoringAPI::AkJson::Array &items, 
@@ -189,14 +362,31 @@ bool WaapiImportItems(const AK::WwiseAuthoringAPI::AkJson::Array &items,
 {
     using namespace AK::WwiseAuthoringAPI;
 
-    AkJson createArgs(AkJson::Map{
-        { "importOperation", AkVariant(GetImportOperationString(importOperation)) },
-        { "default", AkJson::Map{
-            { "importLanguage", AkVariant("SFX") }
-    } },
-    { "imports", items }
-    });
+    AkJson createArgs = MakeImportArgs(items, importOperation);
     AkJson result;
 
     return client.Call(ak::wwise::core::audio::import, createArgs, AkJson(AkJson::Map()), result, -1);
 }
+
+bool WaapiImportItems(const AK::WwiseAuthoringAPI::AkJson::Array &items,
+                      AK::WwiseAuthoringAPI::Client &client,
+                      WAAPIImportOperation importOperation,
+                      AK::WwiseAuthoringAPI::ResultView &resultsOut)
+{
+    using namespace AK::WwiseAuthoringAPI;
+
+    AkJson createArgs = MakeImportArgs(items, importOperation);
+    AkJson error;
+
+    //without a return list the import only gives back id and name, the ids are matched to items by path
+    AkJson options(AkJson::Map{
+        { "return", AkJson::Array{
+        AkVariant("id"),
+        AkVariant("name"),
+        AkVariant("path"),
+        AkVariant("type")
+    }}
+    });
+
+    return ResultViews::Call(client, ak::wwise::core::audio::import, createArgs, options, resultsOut, error);
+}
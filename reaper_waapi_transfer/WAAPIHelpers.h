@@ -9,8 +9,12 @@
 #include <AK/WwiseAuthoringAPI/waapi.h>
 #include <AK/WwiseAuthoringAPI/AkAutobahn/Client.h>
 
+#include "ResultView.h"
+
 #include "config.h"
 #include "types.h"
+#include "FolderMirror.h"
+#include "ImportPlan.h"
 
 
 //////////////////////////////////////////////////////////////////////////
@@ -29,6 +33,31 @@ bool GetChildren(const AK::WwiseAuthoringAPI::AkVariant &path,
                  AK::WwiseAuthoringAPI::Client &client,
                  bool getNotes = false);
 
+//the same calls returning an undecoded view of the results (see ResultView.h), objects are read with
+//resultsOut.GetObjects() and nothing is copied into AkJson. Use these when the results can be large.
+bool GetAllSelectedWwiseObjects(AK::WwiseAuthoringAPI::ResultView &resultsOut,
+                                AK::WwiseAuthoringAPI::AkJson &errorOut,
+                                AK::WwiseAuthoringAPI::Client &client,
+                                bool getNotes = false);
+
+bool GetChildren(const AK::WwiseAuthoringAPI::AkVariant &path,
+                 AK::WwiseAuthoringAPI::ResultView &resultsOut,
+                 AK::WwiseAuthoringAPI::AkJson &errorOut,
+                 AK::WwiseAuthoringAPI::Client &client,
+                 bool getNotes = false);
+
+//children of all the given objects in one call, with the sounds' original wav path for import pre-flight
+bool GetChildrenOfObjects(const std::vector<std::string> &guids,
+                          AK::WwiseAuthoringAPI::ResultView &resultsOut,
+                          AK::WwiseAuthoringAPI::AkJson &errorOut,
+                          AK::WwiseAuthoringAPI::Client &client);
+
+//search the project for objects usable as import parents (see IsParentContainer) with text in their name
+bool SearchParentContainers(const std::string &text,
+                            AK::WwiseAuthoringAPI::ResultView &resultsOut,
+                            AK::WwiseAuthoringAPI::AkJson &errorOut,
+                            AK::WwiseAuthoringAPI::Client &client);
+
 //get the array for a succesfull call to any of the above functions, results is 'resultsOut' from above functions
 void GetWaapiResultsArray(AK::WwiseAuthoringAPI::AkJson::Array &arrayIn,
                           AK::WwiseAuthoringAPI::AkJson &results);
@@ -41,11 +70,38 @@ inline const std::string &GetResultsErrorMessage(AK::WwiseAuthoringAPI::AkJson &
 }
 
 
+//creates the folder tree under root (guid or path) merged by name, with one object.set or, where wwise doesn't have
+//object.set yet, one object.create per top level folder. numCallsOut is how many calls that took
+bool CreateFolderContainers(const std::string &root,
+                            const std::vector<FolderNode> &nodes,
+                            const std::string &containerType,
+                            AK::WwiseAuthoringAPI::AkJson &errorOut,
+                            AK::WwiseAuthoringAPI::Client &client,
+                            size_t &numCallsOut);
+
+//objects at all the given paths in one call, returns id, name, type and path. paths that don't exist are left out
+bool GetObjectsFromPaths(const std::vector<std::string> &paths,
+                         AK::WwiseAuthoringAPI::ResultView &resultsOut,
+                         AK::WwiseAuthoringAPI::AkJson &errorOut,
+                         AK::WwiseAuthoringAPI::Client &client);
+
+//the same for object guids
+bool GetObjectsFromIds(const std::vector<std::string> &guids,
+                       AK::WwiseAuthoringAPI::ResultView &resultsOut,
+                       AK::WwiseAuthoringAPI::AkJson &errorOut,
+                       AK::WwiseAuthoringAPI::Client &client);
+
 //Import given items, returns if waapi call was successful
 bool WaapiImportItems(const AK::WwiseAuthoringAPI::AkJson::Array &items,
                       AK::WwiseAuthoringAPI::Client &client,
                       WAAPIImportOperation importOperation);
 
+//as above, resultsOut gets the objects the import created or used (id, name, path, type), read them with GetObjects
+bool WaapiImportItems(const AK::WwiseAuthoringAPI::AkJson::Array &items,
+                      AK::WwiseAuthoringAPI::Client &client,
+                      WAAPIImportOperation importOperation,
+                      AK::WwiseAuthoringAPI::ResultView &resultsOut);
+
 //////////////////////////////////////////////////////////////////////////
 
 
@@ -69,27 +125,6 @@ private:
 };
 
 
-inline std::string GetImportOperationString(WAAPIImportOperation operation)
-{
-    switch (operation)
-    {
-    case WAAPIImportOperation::createNew:
-        return std::string("createNew");
-        break;
-    case WAAPIImportOperation::useExisting:
-        return std::string("useExisting");
-        break;
-    case WAAPIImportOperation::replaceExisting:
-        return std::string("replaceExisting");
-        break;
-    default:
-        return std::string();
-        break;
-    }
-}
-
-
-
 //http://the-witness.net/news/2012/11/scopeexit-in-c11/
 template <typename F>
 struct ScopeExit
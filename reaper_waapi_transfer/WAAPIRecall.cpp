@@ -1,8 +1,12 @@
+#include <cstring>
 #include <sstream>
 
 #include "reaper_plugin_functions.h"
 
+#include "AsyncLog.h"
+#include "ImportIdIndex.h"
 #include "Reaper_WAAPI_Transfer.h"
+#include "RenderQueueReader.h"
 #include "WAAPIRecall.h"
 #include "WAAPIHelpers.h"
 #include "config.h"
@@ -17,22 +21,48 @@ WAAPIRecall::WAAPIRecall(HWND hwnd, int recallListId, int statusTextId)
 void WAAPIRecall::UpdateWwiseObjects()
 {
     using namespace AK::WwiseAuthoringAPI;
-    AkJson results;
-    if (!GetAllSelectedWwiseObjects(results, m_client, true))
+
+    //selections with notes can be huge, read them straight from the result text instead of decoding to AkJson
+    ResultView results;
+    AkJson error;
+    if (!GetAllSelectedWwiseObjects(results, error, m_client, true))
     {
         return;
     }
-    
-    AkJson::Array resultsArray;
-    GetWaapiResultsArray(resultsArray, results);
+
+    RefreshImportIdIndexes();
 
     std::vector<RecallItem> validItems;
 
+    //selected objects recalled from the import id index, and the children lookups that cost
+    uint32 numIndexed = 0;
+    uint32 numChildrenLookups = 0;
+
+    //----------------------------------------------------------------
+    //lambda for objects an import id index knows, sound or source guid
+    auto IndexedItemInserter = [this, &validItems, &numIndexed](const rapidjson::Value &item) -> bool
+    {
+        auto found = m_indexedProjects.find(ResultView::GetString(item, "id"));
+        if (found == m_indexedProjects.end() || !fs::is_regular_file(found->second))
+        {
+            return false;
+        }
+
+        RecallItem validItem;
+        validItem.projectPath = found->second;
+        validItem.wwiseGuid   = found->first;
+        validItem.wwiseName   = ResultView::GetString(item, "name");
+
+        validItems.push_back(validItem);
+        ++numIndexed;
+        return true;
+    };
+
     //----------------------------------------------------------------
     //lambda for creating and inserting valid recallitems
-    auto RecallItemInserter = [&validItems](const AkJson &item) -> void
+    auto RecallItemInserter = [&validItems](const rapidjson::Value &item) -> void
     {
-        const std::string notes = item["notes"].GetVariant().GetString();
+        const std::string notes = ResultView::GetString(item, "notes");
         auto noteProjPos = notes.find(PROJ_NOTE_PREFIX);
         if (noteProjPos == notes.npos)
         {
@@ -54,42 +84,48 @@ void WAAPIRecall::UpdateWwiseObjects()
             return;
         }
 
-        validItem.wwiseGuid   = item["id"].GetVariant().GetString();
-        validItem.wwiseName   = item["name"].GetVariant().GetString();
+        validItem.wwiseGuid   = ResultView::GetString(item, "id");
+        validItem.wwiseName   = ResultView::GetString(item, "name");
 
         validItems.push_back(validItem);
     };
     //----------------------------------------------------------------
 
     //Build vector of recall items
-    for (const auto &itemAkMap : resultsArray)
+    for (const auto &item : results.GetObjects().GetArray())
     {
-        const std::string itemType = itemAkMap["type"].GetVariant().GetString();
+        const std::string itemType = ResultView::GetString(item, "type");
         //if its a sound type we need the children (its possible there are multiple sources)
         //todo recursion depth search
-        if (itemType == "Sound" || "MusicTrack")
+        if (itemType == "Sound" || itemType == "MusicTrack")
         {
+            //imported by a transfer, the sound itself is enough to find the project
+            if (IndexedItemInserter(item))
+            {
+                continue;
+            }
+
             //no children, continue
-            if (!itemAkMap["childrenCount"].GetVariant().GetInt32())
+            if (!ResultView::GetInt(item, "childrenCount"))
             {
                 continue;
             }
 
-            AkJson results;
-            if (!GetChildren(itemAkMap["path"].GetVariant().GetString(), results, m_client, true))
+            ++numChildrenLookups;
+            ResultView children;
+            AkJson childrenError;
+            if (!GetChildren(AkVariant(ResultView::GetString(item, "path")), children, childrenError, m_client, true))
             {
-                SetStatusText(GetResultsErrorMessage(results));
+                SetStatusText(GetResultsErrorMessage(childrenError));
                 continue;
             }
             else
             {
-                AkJson::Array resultsArray;
-                GetWaapiResultsArray(resultsArray, results);
-                for (const auto &result : resultsArray)
+                for (const auto &child : children.GetObjects().GetArray())
                 {
-                    if (result["type"].GetVariant().GetString() == "AudioFileSource")
+                    if (std::strcmp(ResultView::GetString(child, "type"), "AudioFileSource") == 0)
                     {
-                        RecallItemInserter(result);
+                        RecallItemInserter(child);
                     }
                 }
             }
@@ -97,10 +133,15 @@ void WAAPIRecall::UpdateWwiseObjects()
         //this is the type notes waapi transfer exports are stored in
         else if (itemType == "AudioFileSource")
         {
-            RecallItemInserter(itemAkMap);
+            if (!IndexedItemInserter(item))
+            {
+                RecallItemInserter(item);
+            }
         }   
     }
 
+    bool selectionChanged = validItems.size() != m_mappedIdToRecallObject.size();
+
     //delete items not in new selection
     for (auto it = m_mappedIdToRecallObject.begin();
          it != m_mappedIdToRecallObject.end();
@@ -114,6 +155,7 @@ void WAAPIRecall::UpdateWwiseObjects()
         if (found == validItems.end())
         {
             it = RemoveRecallItem(it);
+            selectionChanged = true;
         }
         else
         {
@@ -126,8 +168,33 @@ void WAAPIRecall::UpdateWwiseObjects()
         if (m_cachedGuids.find(newItem.wwiseGuid) == m_cachedGuids.end())
         {
             AddRecallItem(newItem);
+            selectionChanged = true;
         }
     }
+
+    //the selection is polled, only log when it changes
+    if (selectionChanged && (numIndexed || numChildrenLookups))
+    {
+        AsyncLog::Write(AsyncLog::Severity::Info, "WAAPIRecall",
+                        ("Recall: " + std::to_string(numIndexed) + " objects from the import id index, "
+                         + std::to_string(numChildrenLookups) + " children lookups").c_str());
+    }
+}
+
+void WAAPIRecall::RefreshImportIdIndexes()
+{
+    //indexes are renamed into place when saved, which touches the directory
+    const fs::path dir = GetImportIdIndexDir();
+    std::error_code error;
+    const fs::file_time_type writeTime = fs::last_write_time(dir, error);
+    if (error || writeTime == m_importIdIndexTime)
+    {
+        return;
+    }
+
+    m_importIdIndexTime = writeTime;
+    m_indexedProjects.clear();
+    LoadImportIdIndexes(dir, m_indexedProjects);
 }
 
 void WAAPIRecall::OpenSelectedProject()
@@ -63,6 +63,9 @@ private:
 
     void AddRecallItem(const RecallItem &item);
 
+    //reloads m_indexedProjects when an import id index was written since the last call
+    void RefreshImportIdIndexes();
+
     RecallMap::iterator RemoveRecallItem(const std::string &wwiseGuid);
     RecallMap::iterator RemoveRecallItem(uint32 mappedId);
     RecallMap::iterator RemoveRecallItem(RecallMap::iterator iter);
@@ -75,5 +78,10 @@ private:
     std::unordered_set<std::string> m_cachedGuids;
 
     std::string m_currentStatusText;
+
+    //sound and source guids from the transfers' import id indexes, to their reaper project
+    //selected objects found in here need no children lookup or notes
+    std::unordered_map<std::string, std::string> m_indexedProjects;
+    fs::file_time_type m_importIdIndexTime{};
 };
 
@@ -2,6 +2,7 @@
 
 #include <string>
 #include <sstream>
+#include <fstream>
 #include <thread>
 #include <algorithm>
 #include <chrono>
@@ -17,6 +18,15 @@
 #include "types.h"
 
 #include "WwiseSettingsReader.h"
+#include "AsyncLog.h"
+#include "Tracing.h"
+#include "WampMetrics.h"
+
+static std::string ToLower(std::string text)
+{
+    std::transform(text.begin(), text.end(), text.begin(), [](char c) { return static_cast<char>(tolower(c)); });
+    return text;
+}
 
 WAAPITransfer::WAAPITransfer(HWND window, int treeId, int statusTextid, int transferWindowId)
     : hwnd(window)
@@ -24,6 +34,12 @@ WAAPITransfer::WAAPITransfer(HWND window, int treeId, int statusTextid, int tran
     , m_statusTextId(statusTextid)
     , m_transferWindowId(transferWindowId)
     , m_progressWindow(0)
+    , m_parentSearch([this](const std::string &query, AK::WwiseAuthoringAPI::ResultView &resultsOut, AK::WwiseAuthoringAPI::AkJson &errorOut)
+        {
+            return SearchParentContainers(query, resultsOut, errorOut, m_client);
+        },
+        //wparam is if the query succeeded
+        [window](bool success) { PostMessage(window, WM_WWISE_SEARCH_RESULTS, success ? TRUE : FALSE, 0); })
 {
     Connect();
 }
@@ -64,6 +80,7 @@ void WAAPITransfer::RecreateWwiseView()
 void WAAPITransfer::RecreateTransferListView()
 {
     ListView_DeleteAllItems(GetRenderViewHWND());
+    m_renderViewChanges.Clear();
 
     //Setup columns
     HWND renderView = GetRenderViewHWND();
@@ -129,6 +146,8 @@ void WAAPITransfer::RecreateTransferListView()
         //update mapped id cached in the render item
         renderItemPair.second.second = AddRenderItemToView(renderItemPair.first, renderItemPair.second.first);
     }
+
+    FlushRenderViewChanges();
 }
 
 
@@ -150,17 +169,380 @@ void WAAPITransfer::SetSelectedRenderParents(MappedListViewID wwiseId)
     {
         SetRenderItemWwiseParent(mappedIndex, wwiseGuid, isMusicSegment);
     });
+
+    FlushRenderViewChanges();
+}
+
+
+void WAAPITransfer::MirrorSelectedTrackFolders(MappedListViewID wwiseId, const std::string &containerType)
+{
+    using namespace AK::WwiseAuthoringAPI;
+
+    WAAPI_TRACE_SCOPE("transfer", "MirrorTrackFolders");
+
+    assert(wwiseId != -1);
+
+    auto wwiseIter = m_wwiseListViewMap.find(wwiseId);
+    assert(wwiseIter != m_wwiseListViewMap.end());
+
+    const std::string rootGuid = wwiseIter->second;
+    const WwiseObject &root = GetWwiseObjectByGUID(rootGuid);
+    if (root.isMusicContainer)
+    {
+        SetStatusText("Track folders can only be mirrored into the Actor-Mixer Hierarchy.");
+        return;
+    }
+
+    std::vector<std::pair<MappedListViewID, const RenderItem*>> selected;
+    ForEachSelectedRenderItem([this, &selected](MappedListViewID mappedIndex, uint32 listItem)
+    {
+        selected.push_back({ mappedIndex, &GetRenderItemFromListviewId(mappedIndex) });
+    });
+
+    if (selected.empty())
+    {
+        SetStatusText("No render items selected.");
+        return;
+    }
+
+    std::vector<const RenderItem*> renderItems;
+    renderItems.reserve(selected.size());
+    for (const auto &item : selected)
+    {
+        renderItems.push_back(item.second);
+    }
+
+    //folders the mirror already has don't need creating, if it isn't loaded everything is sent and merged
+    const std::vector<std::string> folderPaths = CollectTrackFolderPaths(renderItems);
+    const std::vector<FolderNode> missing = BuildFolderTree(folderPaths, [this, &root](const std::string &path)
+    {
+        std::string guid;
+        return m_hierarchy.FindByPath(root.path + '\\' + path, guid);
+    });
+
+    size_t numCalls = 0;
+    if (!missing.empty())
+    {
+        AkJson error;
+        if (!CreateFolderContainers(rootGuid, missing, containerType, error, m_client, numCalls))
+        {
+            SetStatusText("WAAPI Error: " + GetResultsErrorMessage(error));
+            return;
+        }
+    }
+
+    //the mirror hears about new containers asynchronously, ask for the ids
+    //keyed on the lowercase path relative to the root
+    std::unordered_map<std::string, std::string> folderGuids;
+    if (!folderPaths.empty())
+    {
+        std::vector<std::string> absolutePaths;
+        absolutePaths.reserve(folderPaths.size());
+        for (const std::string &path : folderPaths)
+        {
+            absolutePaths.push_back(root.path + '\\' + path);
+        }
+
+        ResultView results;
+        AkJson error;
+        ++numCalls;
+        if (!GetObjectsFromPaths(absolutePaths, results, error, m_client))
+        {
+            SetStatusText("WAAPI Error: " + GetResultsErrorMessage(error));
+            return;
+        }
+
+        //one redraw for however many folders get listed
+        HWND wwiseView = GetWwiseObjectListHWND();
+        SendMessage(wwiseView, WM_SETREDRAW, FALSE, 0);
+
+        const size_t rootPathLength = root.path.size() + 1;
+        for (const rapidjson::Value &object : results.GetObjects().GetArray())
+        {
+            const std::string guid = ResultView::GetString(object, "id");
+            const std::string path = ResultView::GetString(object, "path");
+            if (path.size() <= rootPathLength)
+            {
+                continue;
+            }
+
+            //wwise may spell existing folders in another case than the track names
+            folderGuids[ToLower(path.substr(rootPathLength))] = guid;
+
+            if (s_activeWwiseObjects.find(guid) == s_activeWwiseObjects.end())
+            {
+                WwiseObject wwiseNode;
+                wwiseNode.type = ResultView::GetString(object, "type");
+                wwiseNode.path = path;
+                wwiseNode.name = ResultView::GetString(object, "name");
+                wwiseNode.isMusicContainer = false;
+                CreateWwiseObject(guid, wwiseNode);
+            }
+        }
+
+        SendMessage(wwiseView, WM_SETREDRAW, TRUE, 0);
+        InvalidateRect(wwiseView, nullptr, FALSE);
+    }
+
+    uint32 numUnresolved = 0;
+    for (const auto &item : selected)
+    {
+        const std::string folderPath = GetTrackFolderPath(*item.second);
+        if (folderPath.empty())
+        {
+            SetRenderItemWwiseParent(item.first, rootGuid);
+            continue;
+        }
+
+        auto folderGuid = folderGuids.find(ToLower(folderPath));
+        if (folderGuid == folderGuids.end())
+        {
+            ++numUnresolved;
+            continue;
+        }
+        SetRenderItemWwiseParent(item.first, folderGuid->second);
+    }
+
+    FlushRenderViewChanges();
+
+    std::string status = "Mirrored " + std::to_string(folderPaths.size()) + " track folders ("
+        + std::to_string(CountFolderNodes(missing)) + " sent to Wwise) in " + std::to_string(numCalls) + " calls.";
+    if (numUnresolved)
+    {
+        status += " " + std::to_string(numUnresolved) + " items' folders weren't found in Wwise afterwards.";
+    }
+    SetStatusText(status);
 }
 
+void WAAPITransfer::AssignSelectedParentsFromMapping()
+{
+    WAAPI_TRACE_SCOPE("transfer", "AssignParentsFromMapping");
+
+    std::string error;
+    if (!LoadMapping(error))
+    {
+        SetStatusText(error);
+        return;
+    }
+
+    //the rule of every item first, then each location the rules name is looked up once
+    std::vector<std::pair<MappedListViewID, const MappingRule*>> mapped;
+    std::unordered_map<std::string, std::string> locationGuids;
+    uint32 numUnmatched = 0;
+    ForEachSelectedRenderItem([this, &mapped, &locationGuids, &numUnmatched](MappedListViewID mappedIndex, uint32 listItem)
+    {
+        const MappingRule *rule = m_mapping.Match(GetRenderItemFromListviewId(mappedIndex));
+        if (!rule)
+        {
+            ++numUnmatched;
+            return;
+        }
+        mapped.push_back({ mappedIndex, rule });
+        locationGuids.insert({ rule->importLocation, std::string() });
+    });
+
+    if (mapped.empty())
+    {
+        SetStatusText(numUnmatched ? "No mapping rule matched the selected render items." : "No render items selected.");
+        return;
+    }
+
+    //one redraw for however many parents get listed
+    HWND wwiseView = GetWwiseObjectListHWND();
+    SendMessage(wwiseView, WM_SETREDRAW, FALSE, 0);
+    const bool resolved = ResolveImportLocations(locationGuids, error);
+    SendMessage(wwiseView, WM_SETREDRAW, TRUE, 0);
+    InvalidateRect(wwiseView, nullptr, FALSE);
+
+    if (!resolved)
+    {
+        SetStatusText("WAAPI Error: " + error);
+        return;
+    }
+
+    uint32 numUnresolved = 0;
+    for (const auto &item : mapped)
+    {
+        const MappingRule &rule = *item.second;
+        const std::string &wwiseGuid = locationGuids[rule.importLocation];
+        if (wwiseGuid.empty())
+        {
+            ++numUnresolved;
+            continue;
+        }
+
+        const bool isMusicParent = GetWwiseObjectByGUID(wwiseGuid).isMusicContainer;
+        SetRenderItemWwiseParent(item.first, wwiseGuid, isMusicParent);
+
+        RenderItem &renderItem = GetRenderItemFromListviewId(item.first);
+        renderItem.importOperation = rule.importOperation;
+        renderItem.wwiseLanguageIndex = rule.wwiseLanguageIndex;
+        renderItem.wwiseOriginalsSubpath = rule.originalsSubpath;
+        m_renderViewChanges.SetCell(item.first, RenderViewSubitemID::WaapiImportOperation, GetImportOperationString(rule.importOperation));
+        m_renderViewChanges.SetCell(item.first, RenderViewSubitemID::WwiseLanguage, WwiseLanguages[rule.wwiseLanguageIndex]);
+        m_renderViewChanges.SetCell(item.first, RenderViewSubitemID::WwiseOriginalsSubPath, rule.originalsSubpath);
+
+        //a music parent has made the item music already, anywhere else it can't be
+        if (!isMusicParent)
+        {
+            const ImportObjectType type = rule.importObjectType == ImportObjectType::Music ? ImportObjectType::SFX : rule.importObjectType;
+            renderItem.importObjectType = type;
+            m_renderViewChanges.SetCell(item.first, RenderViewSubitemID::WwiseImportObjectType, GetTextForImportObject(type));
+        }
+    }
+
+    FlushRenderViewChanges();
+
+    std::string status = "Mapped " + std::to_string(mapped.size() - numUnresolved) + " render items.";
+    if (numUnmatched)
+    {
+        status += " " + std::to_string(numUnmatched) + " matched no rule.";
+    }
+    if (numUnresolved)
+    {
+        status += " " + std::to_string(numUnresolved) + " have an import location that isn't in Wwise or can't hold sounds.";
+    }
+    if (m_numMappingConflicts)
+    {
+        status += " " + std::to_string(m_numMappingConflicts) + " rule conflicts, see " + TRANSFER_MAPPING_REPORT_FILENAME + ".";
+    }
+    SetStatusText(status);
+}
+
+bool WAAPITransfer::LoadMapping(std::string &errorOut)
+{
+    const fs::path path = GetTransferDataDir() / TRANSFER_MAPPING_FILENAME;
+
+    std::error_code error;
+    const fs::file_time_type writeTime = fs::last_write_time(path, error);
+    if (error)
+    {
+        errorOut = "No mapping file, rules go in " + path.generic_string() + ".";
+        return false;
+    }
+    if (m_mappingLoaded && writeTime == m_mappingWriteTime)
+    {
+        return true;
+    }
+
+    m_mappingLoaded = false;
+    std::string loadError;
+    if (!m_mapping.Load(path, loadError))
+    {
+        errorOut = "Mapping error: " + loadError;
+        return false;
+    }
+    m_mappingLoaded = true;
+    m_mappingWriteTime = writeTime;
+
+    //checked once per edit of the file, the report stays until the rules stop conflicting
+    const fs::path reportPath = GetTransferDataDir() / TRANSFER_MAPPING_REPORT_FILENAME;
+    const std::vector<std::string> conflicts = m_mapping.GetConflictReport();
+    m_numMappingConflicts = conflicts.size();
+    if (conflicts.empty())
+    {
+        fs::remove(reportPath, error);
+        return true;
+    }
+
+    std::ofstream report(reportPath, std::ios::trunc);
+    for (const std::string &conflict : conflicts)
+    {
+        report << conflict << '\n';
+    }
+    return true;
+}
+
+bool WAAPITransfer::ResolveImportLocations(std::unordered_map<std::string, std::string> &locationGuids, std::string &errorOut)
+{
+    using namespace AK::WwiseAuthoringAPI;
+
+    auto UseObject = [this](const std::string &guid, const std::string &name, const std::string &type,
+                            const std::string &path, std::string &guidOut)
+    {
+        if (!IsParentContainer(type))
+        {
+            return;
+        }
+
+        if (s_activeWwiseObjects.find(guid) == s_activeWwiseObjects.end())
+        {
+            WwiseObject wwiseNode;
+            wwiseNode.type = type;
+            wwiseNode.path = path;
+            wwiseNode.name = name;
+            wwiseNode.isMusicContainer = IsMusicContainer(type);
+            CreateWwiseObject(guid, wwiseNode);
+        }
+        guidOut = guid;
+    };
+
+    //locations the mirror doesn't have, keyed on the lowercase guid or path for matching the results
+    std::vector<std::string> unknownGuids;
+    std::vector<std::string> unknownPaths;
+    std::unordered_map<std::string, std::string*> pending;
+
+    for (auto &location : locationGuids)
+    {
+        const bool isGuid = location.first.front() == '{';
+        if (isGuid && s_activeWwiseObjects.find(location.first) != s_activeWwiseObjects.end())
+        {
+            location.second = location.first;
+            continue;
+        }
+
+        std::string guid = location.first;
+        WwiseHierarchyCache::ObjectInfo info;
+        if ((isGuid || m_hierarchy.FindByPath(location.first, guid)) && m_hierarchy.GetObjectInfo(guid, info))
+        {
+            UseObject(info.guid, info.name, info.type, info.path, location.second);
+            continue;
+        }
+
+        (isGuid ? unknownGuids : unknownPaths).push_back(location.first);
+        pending[ToLower(location.first)] = &location.second;
+    }
+
+    for (const bool byGuid : { false, true })
+    {
+        const std::vector<std::string> &unknown = byGuid ? unknownGuids : unknownPaths;
+        if (unknown.empty())
+        {
+            continue;
+        }
+
+        ResultView results;
+        AkJson error;
+        const bool succeeded = byGuid ? GetObjectsFromIds(unknown, results, error, m_client)
+                                      : GetObjectsFromPaths(unknown, results, error, m_client);
+        if (!succeeded)
+        {
+            errorOut = GetResultsErrorMessage(error);
+            return false;
+        }
+
+        for (const rapidjson::Value &object : results.GetObjects().GetArray())
+        {
+            const std::string guid = ResultView::GetString(object, "id");
+            const std::string path = ResultView::GetString(object, "path");
+
+            auto found = pending.find(ToLower(byGuid ? guid : path));
+            if (found != pending.end())
+            {
+                UseObject(guid, ResultView::GetString(object, "name"), ResultView::GetString(object, "type"), path, *found->second);
+            }
+        }
+    }
+
+    return true;
+}
 
 void WAAPITransfer::SetSelectedImportObjectType(ImportObjectType typeToSet)
 {
     const std::string text = GetTextForImportObject(typeToSet);
-    char strBuff[256];
-    strcpy(strBuff, text.c_str());
     bool musicTypeMismatch = false;
 
-    ForEachSelectedRenderItem([this, &strBuff, &typeToSet, &musicTypeMismatch](MappedListViewID mappedIndex, uint32 listItem)
+    ForEachSelectedRenderItem([this, &text, &typeToSet, &musicTypeMismatch](MappedListViewID mappedIndex, uint32 listItem)
     {
         auto &renderItem = GetRenderItemFromListviewId(mappedIndex);
         bool isParentMusicSegment = false;
@@ -189,9 +571,11 @@ void WAAPITransfer::SetSelectedImportObjectType(ImportObjectType typeToSet)
         }
 
         renderItem.importObjectType = typeToSet;
-        ListView_SetItemText(GetRenderViewHWND(), listItem, RenderViewSubitemID::WwiseImportObjectType, strBuff);
+        m_renderViewChanges.SetCell(mappedIndex, RenderViewSubitemID::WwiseImportObjectType, text);
     });
 
+    FlushRenderViewChanges();
+
     if (musicTypeMismatch)
     {
         SetStatusText("Music segments can only contain music objects.");
@@ -200,18 +584,65 @@ void WAAPITransfer::SetSelectedImportObjectType(ImportObjectType typeToSet)
 
 void WAAPITransfer::SetSelectedDialogLanguage(int wwiseLanguageIndex)
 {
-    char strbuff[MAX_PATH];
-    strcpy(strbuff, WwiseLanguages[wwiseLanguageIndex]);
+    const std::string languageText(WwiseLanguages[wwiseLanguageIndex]);
 
-    ForEachSelectedRenderItem([wwiseLanguageIndex, &strbuff, this](MappedListViewID mapped, uint32 index) 
+    ForEachSelectedRenderItem([wwiseLanguageIndex, &languageText, this](MappedListViewID mapped, uint32 index) 
     {
         GetRenderItemFromListviewId(mapped).wwiseLanguageIndex = wwiseLanguageIndex;
-        ListView_SetItemText(GetRenderViewHWND(), index, RenderViewSubitemID::WwiseLanguage, strbuff);
+        m_renderViewChanges.SetCell(mapped, RenderViewSubitemID::WwiseLanguage, languageText);
+    });
+
+    FlushRenderViewChanges();
+}
+
+void WAAPITransfer::SetSelectedOriginalsSubpath(const std::string &originalsSubpath)
+{
+    ForEachSelectedRenderItem([&originalsSubpath, this](MappedListViewID mapped, uint32 index)
+    {
+        GetRenderItemFromListviewId(mapped).wwiseOriginalsSubpath = originalsSubpath;
+        m_renderViewChanges.SetCell(mapped, RenderViewSubitemID::WwiseOriginalsSubPath, originalsSubpath);
+    });
+
+    FlushRenderViewChanges();
+}
+
+static std::string FormatRenderViewStats(const RenderViewChangeSet::Stats &stats)
+{
+    return std::to_string(stats.cellsPushed) + " pushed of " + std::to_string(stats.cellsRecorded) + " recorded, "
+        + std::to_string(stats.cellsCoalesced) + " coalesced, " + std::to_string(stats.cellsUnchanged) + " unchanged";
+}
+
+void WAAPITransfer::FlushRenderViewChanges()
+{
+    if (!m_renderViewChanges.HasPending())
+    {
+        return;
+    }
+
+    //one repaint for the whole batch instead of one per cell
+    HWND renderView = GetRenderViewHWND();
+    SendMessage(renderView, WM_SETREDRAW, FALSE, 0);
+
+    const RenderViewChangeSet::Stats stats = m_renderViewChanges.Flush([renderView](MappedListViewID mappedId, int column, const std::string &text)
+    {
+        int listItem = ListView_MapIDToIndex(renderView, mappedId);
+        if (listItem != -1)
+        {
+            ListView_SetItemText(renderView, listItem, column, const_cast<LPSTR>(text.c_str()));
+        }
     });
+
+    SendMessage(renderView, WM_SETREDRAW, TRUE, 0);
+    InvalidateRect(renderView, nullptr, FALSE);
+
+    //cells touched by the action, next to its spans in the trace
+    WAAPI_TRACE_INSTANT("reaper", "FlushRenderViewChanges", FormatRenderViewStats(stats).c_str());
 }
 
 void WAAPITransfer::UpdateRenderQueue()
 {
+    WAAPI_TRACE_SCOPE("reaper", "UpdateRenderQueue");
+
     auto projectFilesToAdd = GetRenderQueueProjectFiles();
 
     std::vector<RenderProjectMap::iterator> toDelete;
@@ -244,6 +675,8 @@ void WAAPITransfer::UpdateRenderQueue()
                        AddRenderItemsByProject(path);
                    }
                    });
+
+    FlushRenderViewChanges();
 }
 
 RenderItem &WAAPITransfer::GetRenderItemFromRenderItemId(RenderItemID renderItemId)
@@ -275,6 +708,7 @@ bool WAAPITransfer::Connect()
     AkJson wwiseInfo;
     bool success = false;
 
+    const bool wasConnected = m_client.IsConnected();
     if (success = m_client.Connect("127.0.0.1", g_Waapi_Port))
     {
         //Get Wwise info
@@ -296,6 +730,35 @@ bool WAAPITransfer::Connect()
     {
         SetStatusText("Failed to connect to Waapi on port: " + std::to_string(g_Waapi_Port));
     }
+    else if ((!wasConnected || !m_hierarchy.IsLoaded()) && !m_hierarchy.IsLoading())
+    {
+        //a new connection may be a different project, reload the whole mirror. It's loaded in the background,
+        //parents are checked when importing until it's there
+        m_parentSearch.ClearCache();
+
+        HWND window = hwnd;
+        const auto postRefresh = [this, window]()
+        {
+            if (!m_hierarchyRefreshPosted.exchange(true))
+            {
+                PostMessage(window, WM_WWISE_HIERARCHY_CHANGED, 0, 0);
+            }
+        };
+
+        //set before loading, so changes applied as soon as the load finishes are refreshed too
+        m_hierarchy.SetChangedCallback(postRefresh);
+        m_hierarchy.LoadAsync(m_client, WWISE_HIERARCHY_LOAD_TIMEOUT_MS, [postRefresh](bool loaded)
+        {
+            if (loaded)
+            {
+                postRefresh();
+            }
+            else
+            {
+                AsyncLog::Write(AsyncLog::Severity::Warning, "WAAPITransfer", "Couldn't load the Wwise hierarchy, parents are checked when importing");
+            }
+        });
+    }
 
     return success;
 }
@@ -316,24 +779,53 @@ void WAAPITransfer::RunRenderQueueAndImport()
         return;
     }
     
+    //parents deleted in wwise since they were added, checked against the mirror instead of asking wwise per parent
+    std::vector<std::string> missingParents;
+    if (m_hierarchy.IsLoaded())
+    {
+        for (const auto &wwiseObject : s_activeWwiseObjects)
+        {
+            if (!wwiseObject.second.renderChildren.empty() && !m_hierarchy.Contains(wwiseObject.first))
+            {
+                missingParents.push_back(wwiseObject.first);
+            }
+        }
+    }
+
     //find out how many items haven't been targeted to wwise
     uint64_t numEmptyRenders = std::count_if(s_renderQueueItems.begin(), s_renderQueueItems.end(),
                                              [](const auto &item)
                                              { return item.second.first.wwiseGuid.empty(); });
+
+    uint64_t numMissingParentRenders = 0;
+    for (const std::string &guid : missingParents)
+    {
+        numMissingParentRenders += GetWwiseObjectByGUID(guid).renderChildren.size();
+    }
     
-    if (numEmptyRenders)
+    if (numEmptyRenders || numMissingParentRenders)
     {
         //nothing selected, just return
-        if (numEmptyRenders == s_renderQueueItems.size())
+        if (numEmptyRenders + numMissingParentRenders == s_renderQueueItems.size())
         {
-            SetStatusText("No Wwise parents selected.");
+            SetStatusText(numMissingParentRenders ? "No Wwise parents selected that still exist in Wwise." : "No Wwise parents selected.");
             return;
         }
         else
         {
-            std::string mboxText = std::to_string(numEmptyRenders) 
-                + " items do not have Wwise parents and will be rendered but not imported"
-                  "\nWould you like to render anyway?";
+            std::string mboxText;
+            if (numEmptyRenders)
+            {
+                mboxText += std::to_string(numEmptyRenders)
+                    + " items do not have Wwise parents and will be rendered but not imported\n";
+            }
+            if (numMissingParentRenders)
+            {
+                mboxText += std::to_string(numMissingParentRenders)
+                    + " items have Wwise parents that were deleted in Wwise, their parents will be removed"
+                      " and they will be rendered but not imported\n";
+            }
+            mboxText += "Would you like to render anyway?";
 
             int mboxReturn = MessageBox(g_parentWindow, mboxText.c_str(), 
                                         "WAAPI Transfer", MB_YESNO);
@@ -345,6 +837,33 @@ void WAAPITransfer::RunRenderQueueAndImport()
         }
     }
 
+    for (const std::string &guid : missingParents)
+    {
+        for (const auto &mapped : m_wwiseListViewMap)
+        {
+            if (mapped.second == guid)
+            {
+                RemoveWwiseObject(mapped.first);
+                break;
+            }
+        }
+    }
+
+    //before the pre-flight, it checks items that were imported before against their sounds as they are now
+    LoadImportIdIndex();
+
+    //what the imports will do, one query for the whole queue before anything is rendered
+    if (RunImportPreflight())
+    {
+        std::string preflightText = "Import plan: " + FormatPreflightPlan(m_preflightPlan);
+        if (m_preflightPlan.numUnchanged)
+        {
+            preflightText += ", up to " + std::to_string(m_preflightPlan.numImportCalls - m_preflightPlan.numImportCallsWithoutUnchanged)
+                + " of " + std::to_string(m_preflightPlan.numImportCalls) + " import calls saved";
+        }
+        SetStatusText(preflightText + ".");
+    }
+
     char reaprojectPath[MAX_PATH];
     EnumProjects(-1, reaprojectPath, MAX_PATH);
 
@@ -362,68 +881,428 @@ void WAAPITransfer::RunRenderQueueAndImport()
 
     //success, start import
     m_closeTransferThreadByUser = false;
+    m_transferCancel.Reset();
     std::thread(&WAAPITransfer::WaapiImportLoop, this).detach();
     OpenProgressWindow(hwnd, this);
 }
 
-void WAAPITransfer::SetStatusText(const std::string &status) const
-{
-    SetWindowText(GetStatusTextHWND(), status.c_str());
+bool WAAPITransfer::RunImportPreflight()
+{
+    using namespace AK::WwiseAuthoringAPI;
+
+    WAAPI_TRACE_SCOPE("transfer", "ImportPreflight");
+
+    m_preflightPlan = PreflightPlan();
+    m_numPreflightSkipped = 0;
+    m_numPreflightCallsSaved = 0;
+
+    //same order WaapiImportByProject plans them in, and aimed where it will import them
+    std::vector<RenderItem> retargeted;
+    retargeted.reserve(s_renderQueueItems.size());
+
+    std::vector<const RenderItem*> renderItems;
+    std::vector<std::string> parentGuids;
+    std::unordered_set<std::string> seenParents;
+    for (const auto &project : s_renderQueueCachedProjects)
+    {
+        for (RenderItemID id : project.second)
+        {
+            const RenderItem *renderItem = &GetRenderItemFromRenderItemId(id);
+
+            RenderItem target;
+            if (RetargetToImportedSound(*renderItem, target))
+            {
+                retargeted.push_back(std::move(target));
+                renderItem = &retargeted.back();
+            }
+
+            renderItems.push_back(renderItem);
+            if (!renderItem->wwiseGuid.empty() && seenParents.insert(renderItem->wwiseGuid).second)
+            {
+                parentGuids.push_back(renderItem->wwiseGuid);
+            }
+        }
+    }
+
+    if (parentGuids.empty())
+    {
+        return false;
+    }
+
+    ResultView results;
+    AkJson error;
+    if (!GetChildrenOfObjects(parentGuids, results, error, m_client))
+    {
+        AsyncLog::Write(AsyncLog::Severity::Warning, "WAAPITransfer", "Import pre-flight query failed, importing without it");
+        return false;
+    }
+
+    std::vector<ExistingObject> existingObjects;
+    existingObjects.reserve(results.GetObjects().Size());
+    for (const rapidjson::Value &object : results.GetObjects().GetArray())
+    {
+        ExistingObject existing;
+        existing.guid = ResultView::GetString(object, "id");
+        existing.name = ResultView::GetString(object, "name");
+        existing.type = ResultView::GetString(object, "type");
+        existing.originalWavFilePath = ResultView::GetString(object, "sound:originalWavFilePath");
+
+        auto parent = object.FindMember("parent");
+        if (parent != object.MemberEnd())
+        {
+            existing.parentGuid = ResultView::GetString(parent->value, "id");
+        }
+        existingObjects.push_back(std::move(existing));
+    }
+
+    m_preflightPlan = BuildPreflightPlan(renderItems, existingObjects);
+    return true;
+}
+
+void WAAPITransfer::LoadImportIdIndex()
+{
+    m_importIds = ImportIdIndex();
+    m_importIdsPath.clear();
+    m_numImportsRetargeted = 0;
+
+    char reaprojectPath[MAX_PATH];
+    EnumProjects(-1, reaprojectPath, MAX_PATH);
+
+    //an unsaved project has nothing to key the index on
+    if (!strcmp(reaprojectPath, ""))
+    {
+        return;
+    }
+
+    m_importIdsPath = ImportIdIndex::GetIndexPath(GetImportIdIndexDir(), reaprojectPath);
+    m_importIds.Load(m_importIdsPath);
+    m_importIds.SetReaperProject(reaprojectPath);
+}
+
+bool WAAPITransfer::RetargetToImportedSound(const RenderItem &renderItem, RenderItem &targetOut) const
+{
+    //createNew doesn't touch existing sounds
+    if (renderItem.wwiseGuid.empty() || renderItem.importOperation == WAAPIImportOperation::createNew)
+    {
+        return false;
+    }
+
+    const ImportIdIndex::Entry *entry = m_importIds.Find(renderItem.wwiseGuid, renderItem.outputFileName);
+    WwiseHierarchyCache::ObjectInfo sound;
+    if (!entry || !m_hierarchy.GetObjectInfo(entry->soundGuid, sound) || sound.parentGuid.empty())
+    {
+        return false;
+    }
+
+    //still where the item points, wwise names aren't case sensitive
+    if (sound.parentGuid == renderItem.wwiseGuid && !_stricmp(sound.name.c_str(), renderItem.outputFileName.c_str()))
+    {
+        return false;
+    }
+
+    targetOut = renderItem;
+    targetOut.wwiseGuid = sound.parentGuid;
+    targetOut.outputFileName = sound.name;
+    return true;
+}
+
+void WAAPITransfer::RecordImportedIds(const ImportBatch &batch,
+                                      const std::unordered_map<const RenderItem*, const RenderItem*> &originals,
+                                      const AK::WwiseAuthoringAPI::ResultView &results)
+{
+    using namespace AK::WwiseAuthoringAPI;
+
+    if (m_importIdsPath.empty())
+    {
+        return;
+    }
+
+    struct ImportedObject
+    {
+        std::string guid;
+        std::string name;
+        std::string path;
+        std::string type;
+    };
+    std::vector<ImportedObject> objects;
+    objects.reserve(results.GetObjects().Size());
+    for (const rapidjson::Value &object : results.GetObjects().GetArray())
+    {
+        objects.push_back({ ResultView::GetString(object, "id"),
+                            ResultView::GetString(object, "name"),
+                            ResultView::GetString(object, "path"),
+                            ResultView::GetString(object, "type") });
+    }
+
+    for (const RenderItem *target : batch.renderItems)
+    {
+        //where the import put the sound, when the parent is in the mirror
+        WwiseHierarchyCache::ObjectInfo parent;
+        const std::string soundPath = m_hierarchy.GetObjectInfo(target->wwiseGuid, parent)
+            ? parent.path + '\\' + target->outputFileName
+            : std::string();
+
+        const ImportedObject *sound = nullptr;
+        for (const ImportedObject &object : objects)
+        {
+            const bool matches = !soundPath.empty() && !object.path.empty()
+                ? !_stricmp(object.path.c_str(), soundPath.c_str())
+                : !_stricmp(object.name.c_str(), target->outputFileName.c_str());
+
+            //a source is usually named like its sound, the sound is the one higher up
+            if (matches && object.type != "AudioFileSource" && (!sound || object.path.size() < sound->path.size()))
+            {
+                sound = &object;
+            }
+        }
+
+        if (!sound)
+        {
+            continue;
+        }
+
+        auto original = originals.find(target);
+        const RenderItem &renderItem = original != originals.end() ? *original->second : *target;
+
+        ImportIdIndex::Entry entry;
+        entry.parentGuid = renderItem.wwiseGuid;
+        entry.outputName = renderItem.outputFileName;
+        entry.soundGuid = sound->guid;
+
+        if (!sound->path.empty())
+        {
+            const std::string sourcePrefix = sound->path + '\\';
+            for (const ImportedObject &object : objects)
+            {
+                if (object.type == "AudioFileSource" && object.path.size() > sourcePrefix.size()
+                    && !_strnicmp(object.path.c_str(), sourcePrefix.c_str(), sourcePrefix.size()))
+                {
+                    entry.sourceGuid = object.guid;
+                    break;
+                }
+            }
+        }
+
+        m_importIds.Set(entry);
+    }
+}
+
+void WAAPITransfer::CancelTransferThread()
+{
+    m_cancelRequestedAt = std::chrono::steady_clock::now().time_since_epoch().count();
+    m_closeTransferThreadByUser = true;
+    m_transferCancel.Cancel();
+}
+
+void WAAPITransfer::SetStatusText(const std::string &status) const
+{
+    SetWindowText(GetStatusTextHWND(), status.c_str());
+}
+
+void WAAPITransfer::AddSelectedWwiseObjects()
+{
+    using namespace AK::WwiseAuthoringAPI;
+
+    AkJson results;
+
+    if (!GetAllSelectedWwiseObjects(results, m_client))
+    {
+        SetStatusText("WAAPI Error: " + GetResultsErrorMessage(results));
+        return;
+    }
+    
+    AkJson::Array resultsArray;
+    GetWaapiResultsArray(resultsArray, results);
+
+    uint32 numItemsAdded = 0;
+    for (const auto &result : resultsArray)
+    {
+        const std::string wwiseObjectGuid = result["id"].GetVariant().GetString();
+
+        //check if we already have this item
+        auto cachedGuid = s_activeWwiseObjects.find(wwiseObjectGuid);
+        if (cachedGuid != s_activeWwiseObjects.end())
+        {
+            continue;
+        }
+
+        //check if type is valid for importing audio
+        const std::string wwiseObjectType = result["type"].GetVariant().GetString();
+        if (!IsParentContainer(wwiseObjectType))
+        {
+            continue;
+        }
+
+        WwiseObject wwiseNode;
+        wwiseNode.type = wwiseObjectType;
+        wwiseNode.path = result["path"].GetVariant().GetString();
+        wwiseNode.name = result["name"].GetVariant().GetString();
+        wwiseNode.isMusicContainer = IsMusicContainer(wwiseObjectType);
+
+        CreateWwiseObject(wwiseObjectGuid, wwiseNode);
+        ++numItemsAdded;
+    }
+            
+    if (numItemsAdded)
+    {
+        SetStatusText(std::to_string(numItemsAdded) + " Wwise objects added.");
+    }
+    else
+    {
+        SetStatusText("No new parent Wwise objects selected.");
+    }
+
+}
+
+void WAAPITransfer::RefreshWwiseObjectsFromHierarchy()
+{
+    m_hierarchyRefreshPosted = false;
+    if (!m_hierarchy.IsLoaded())
+    {
+        return;
+    }
+
+    HWND wwiseView = GetWwiseObjectListHWND();
+    uint32 numChanged = 0;
+
+    for (const auto &mapped : m_wwiseListViewMap)
+    {
+        WwiseHierarchyCache::ObjectInfo info;
+        if (!m_hierarchy.GetObjectInfo(mapped.second, info))
+        {
+            //deleted or moved out of the hierarchies, kept until the user removes it or renders
+            continue;
+        }
+
+        WwiseObject &wwiseObject = GetWwiseObjectByGUID(mapped.second);
+        if (wwiseObject.name == info.name && wwiseObject.path == info.path)
+        {
+            continue;
+        }
+
+        const int listItem = ListView_MapIDToIndex(wwiseView, mapped.first);
+        if (wwiseObject.name != info.name)
+        {
+            wwiseObject.name = info.name;
+            for (const RenderItemID &renderId : wwiseObject.renderChildren)
+            {
+                auto renderIt = s_renderQueueItems.find(renderId);
+                if (renderIt != s_renderQueueItems.end())
+                {
+                    renderIt->second.first.wwiseParentName = info.name;
+                    m_renderViewChanges.SetCell(renderIt->second.second, RenderViewSubitemID::WwiseParent, info.name);
+                }
+            }
+
+            if (listItem != -1)
+            {
+                ListView_SetItemText(wwiseView, listItem, WwiseViewSubItemID::Name, const_cast<LPSTR>(wwiseObject.name.c_str()));
+            }
+        }
+
+        wwiseObject.path = info.path;
+        if (listItem != -1)
+        {
+            ListView_SetItemText(wwiseView, listItem, WwiseViewSubItemID::Path, const_cast<LPSTR>(wwiseObject.path.c_str()));
+        }
+        ++numChanged;
+    }
+
+    FlushRenderViewChanges();
+
+    if (numChanged)
+    {
+        SetStatusText(std::to_string(numChanged) + " Wwise objects renamed or moved in Wwise.");
+    }
 }
 
-void WAAPITransfer::AddSelectedWwiseObjects()
+void WAAPITransfer::OnWwiseSearchEdited()
 {
-    using namespace AK::WwiseAuthoringAPI;
+    char text[WWISE_NAME_MAX_LEN];
+    GetWindowText(GetDlgItem(hwnd, IDC_WWISE_SEARCH), text, sizeof(text));
 
-    AkJson results;
+    if (m_parentSearch.SetQuery(text, m_hierarchy.GetRevision()))
+    {
+        ShowWwiseSearchResults();
+    }
+}
 
-    if (!GetAllSelectedWwiseObjects(results, m_client))
+void WAAPITransfer::OnWwiseSearchResults(bool success)
+{
+    if (!success)
     {
-        SetStatusText("WAAPI Error: " + GetResultsErrorMessage(results));
+        SetStatusText("Wwise search failed.");
         return;
     }
-    
-    AkJson::Array resultsArray;
-    GetWaapiResultsArray(resultsArray, results);
+    ShowWwiseSearchResults();
+}
 
-    uint32 numItemsAdded = 0;
-    for (const auto &result : resultsArray)
+void WAAPITransfer::ShowWwiseSearchResults()
+{
+    std::shared_ptr<const WwiseParentSearch::Results> results;
+    if (!m_parentSearch.GetResults(results) || results == m_shownSearchResults)
     {
-        const std::string wwiseObjectGuid = result["id"].GetVariant().GetString();
+        return;
+    }
+    m_shownSearchResults = results;
 
-        //check if we already have this item
-        auto cachedGuid = s_activeWwiseObjects.find(wwiseObjectGuid);
-        if (cachedGuid != s_activeWwiseObjects.end())
-        {
-            continue;
-        }
+    HWND searchBox = GetDlgItem(hwnd, IDC_WWISE_SEARCH);
 
-        //check if type is valid for importing audio
-        const std::string wwiseObjectType = result["type"].GetVariant().GetString();
-        if (!IsParentContainer(wwiseObjectType))
+    //the list is rebuilt under the user's typing, keep their caret where it was
+    DWORD selStart = 0;
+    DWORD selEnd = 0;
+    SendMessage(searchBox, CB_GETEDITSEL, reinterpret_cast<WPARAM>(&selStart), reinterpret_cast<LPARAM>(&selEnd));
+
+    SendMessage(searchBox, WM_SETREDRAW, FALSE, 0);
+    SendMessage(searchBox, CB_RESETCONTENT, 0, 0);
+    for (size_t i = 0; i < results->size(); ++i)
+    {
+        //listed by path, a name prefix would let the combo box autocomplete over the typed text
+        LRESULT item = SendMessage(searchBox, CB_ADDSTRING, 0, reinterpret_cast<LPARAM>((*results)[i].path.c_str()));
+        if (item >= 0)
         {
-            continue;
+            SendMessage(searchBox, CB_SETITEMDATA, item, static_cast<LPARAM>(i));
         }
+    }
+    SendMessage(searchBox, WM_SETREDRAW, TRUE, 0);
 
-        WwiseObject wwiseNode;
-        wwiseNode.type = wwiseObjectType;
-        wwiseNode.path = result["path"].GetVariant().GetString();
-        wwiseNode.name = result["name"].GetVariant().GetString();
-        wwiseNode.isMusicContainer = IsMusicContainer(wwiseObjectType);
+    SendMessage(searchBox, CB_SHOWDROPDOWN, results->empty() ? FALSE : TRUE, 0);
+    SendMessage(searchBox, CB_SETEDITSEL, 0, MAKELPARAM(selStart, selEnd));
 
-        CreateWwiseObject(wwiseObjectGuid, wwiseNode);
-        ++numItemsAdded;
+    //opening the list hides the cursor until the mouse moves
+    SetCursor(LoadCursor(nullptr, IDC_ARROW));
+}
+
+void WAAPITransfer::AddWwiseSearchSelection()
+{
+    HWND searchBox = GetDlgItem(hwnd, IDC_WWISE_SEARCH);
+    const LRESULT selected = SendMessage(searchBox, CB_GETCURSEL, 0, 0);
+    if (selected == CB_ERR || !m_shownSearchResults)
+    {
+        return;
     }
-            
-    if (numItemsAdded)
+
+    const size_t resultIndex = static_cast<size_t>(SendMessage(searchBox, CB_GETITEMDATA, selected, 0));
+    if (resultIndex >= m_shownSearchResults->size())
     {
-        SetStatusText(std::to_string(numItemsAdded) + " Wwise objects added.");
+        return;
     }
-    else
+
+    const WwiseParentSearch::Result &result = (*m_shownSearchResults)[resultIndex];
+    if (s_activeWwiseObjects.find(result.guid) != s_activeWwiseObjects.end())
     {
-        SetStatusText("No new parent Wwise objects selected.");
+        SetStatusText(result.name + " has already been added.");
+        return;
     }
 
+    WwiseObject wwiseNode;
+    wwiseNode.type = result.type;
+    wwiseNode.path = result.path;
+    wwiseNode.name = result.name;
+    wwiseNode.isMusicContainer = IsMusicContainer(result.type);
+
+    CreateWwiseObject(result.guid, wwiseNode);
+    SetStatusText(result.name + " added.");
 }
 
 void WAAPITransfer::RemoveWwiseObject(MappedListViewID toRemove)
@@ -442,6 +1321,8 @@ void WAAPITransfer::RemoveWwiseObject(MappedListViewID toRemove)
         m_wwiseListViewMap.erase(treeIter);
         HWND wwiseView = GetWwiseObjectListHWND();
         ListView_DeleteItem(wwiseView, ListView_MapIDToIndex(wwiseView, toRemove));
+
+        FlushRenderViewChanges();
     }
 }
 
@@ -454,6 +1335,8 @@ void WAAPITransfer::RemoveAllWwiseObjects()
     {
         RemoveRenderItemWwiseParent(it);
     }
+    FlushRenderViewChanges();
+
     ListView_DeleteAllItems(GetWwiseObjectListHWND());
     s_activeWwiseObjects.clear();
     m_wwiseListViewMap.clear();
@@ -463,6 +1346,9 @@ void WAAPITransfer::SetupAndRecreateWindow()
 {
     RecreateTransferListView();
     RecreateWwiseView();
+
+    //the objects kept from the last time the window was open may have changed since
+    RefreshWwiseObjectsFromHierarchy();
 }
 
 
@@ -558,28 +1444,11 @@ MappedListViewID WAAPITransfer::AddRenderItemToView(RenderItemID renderId, const
     int insertedItem = ListView_InsertItem(dlg, &item);
     MappedListViewID mappedId = ListView_MapIndexToID(dlg, insertedItem);
 
-    {
-        const std::string importText = GetTextForImportObject(renderItem.importObjectType);
-        char strBuff[MAX_PATH];
-        strcpy(strBuff, importText.c_str());
-        ListView_SetItemText(dlg, insertedItem, RenderViewSubitemID::WwiseImportObjectType, strBuff);
-    }
-    {
-        char strBuff[MAX_PATH];
-        strcpy(strBuff, WwiseLanguages[renderItem.wwiseLanguageIndex]);
-        ListView_SetItemText(dlg, insertedItem, RenderViewSubitemID::WwiseLanguage, strBuff);
-    }
-    {
-        char strBuff[MAX_PATH];
-        strcpy(strBuff, renderItem.wwiseParentName.c_str());
-        ListView_SetItemText(dlg, insertedItem, RenderViewSubitemID::WwiseParent, strBuff);
-    }
-    {
-        const std::string importString = GetImportOperationString(renderItem.importOperation);
-        char strBuff[MAX_PATH];
-        strcpy(strBuff, importString.c_str());
-        ListView_SetItemText(dlg, insertedItem, RenderViewSubitemID::WaapiImportOperation, strBuff);
-    }
+    //sub items are pushed with the rest of the batch by the caller
+    m_renderViewChanges.SetCell(mappedId, RenderViewSubitemID::WwiseImportObjectType, GetTextForImportObject(renderItem.importObjectType));
+    m_renderViewChanges.SetCell(mappedId, RenderViewSubitemID::WwiseLanguage, WwiseLanguages[renderItem.wwiseLanguageIndex]);
+    m_renderViewChanges.SetCell(mappedId, RenderViewSubitemID::WwiseParent, renderItem.wwiseParentName);
+    m_renderViewChanges.SetCell(mappedId, RenderViewSubitemID::WaapiImportOperation, GetImportOperationString(renderItem.importOperation));
 
     m_renderListViewMap.insert({ mappedId, renderId });
     return mappedId;
@@ -599,6 +1468,7 @@ RenderItemMap::iterator WAAPITransfer::RemoveRenderItemFromList(RenderItemMap::i
     int indexToRemove = ListView_MapIDToIndex(listView, it->second.second);
     //remove from listview 
     ListView_DeleteItem(listView, indexToRemove);
+    m_renderViewChanges.RemoveRow(it->second.second);
     //remove from listview id map
     m_renderListViewMap.erase(it->second.second);
     //remove from render queue items
@@ -612,10 +1482,161 @@ RenderItemMap::iterator WAAPITransfer::RemoveRenderItemFromList(uint32 renderIte
     return RemoveRenderItemFromList(iter);
 }
 
+std::string WAAPITransfer::ReduceRenderQueues()
+{
+    using namespace AK::WwiseAuthoringAPI;
+
+    m_unchangedRegionItems.clear();
+    m_pendingRegionHashes.clear();
+
+    const fs::path hashDir = GetRegionHashDir();
+    uint32 numRegionsSkipped = 0;
+    double secondsSaved = 0.0;
+
+    for (const auto &project : s_renderQueueCachedProjects)
+    {
+        std::vector<const RenderItem*> renderItems;
+        for (RenderItemID id : project.second)
+        {
+            renderItems.push_back(&GetRenderItemFromRenderItemId(id));
+        }
+
+        //hashes are stored even with the toggle off, so turning it on doesn't start with a full render
+        RegionHashes current;
+        if (!current.Compute(project.first, renderItems))
+        {
+            continue;
+        }
+
+        const fs::path storePath = RegionHashes::GetStorePath(hashDir, current.GetReaperProject());
+        RegionHashes stored;
+        stored.Load(storePath);
+
+        std::unordered_set<std::string> unchanged;
+        if (s_renderChangedRegionsOnly)
+        {
+            unchanged = current.FindUnchanged(stored);
+        }
+
+        stored.Merge(current);
+        m_pendingRegionHashes.insert({ project.first, { storePath, std::move(stored) } });
+
+        if (unchanged.empty())
+        {
+            continue;
+        }
+
+        std::vector<const RenderItem*> skippedItems;
+        std::vector<RenderItemID> skippedIds;
+        double skippedAudioSeconds = 0.0;
+        for (RenderItemID id : project.second)
+        {
+            const RenderItem &renderItem = GetRenderItemFromRenderItemId(id);
+            if (unchanged.count(RegionHashes::GetRegionKey(renderItem)))
+            {
+                skippedItems.push_back(&renderItem);
+                skippedIds.push_back(id);
+                skippedAudioSeconds += std::max(0.0, renderItem.outTime - renderItem.inTime);
+            }
+        }
+
+        //nothing left to render, reaper skips a queued render that isn't there
+        std::error_code error;
+        const bool reduced = skippedItems.size() == renderItems.size()
+                             ? fs::remove(project.first, error)
+                             : WriteReducedRenderQueue(project.first, skippedItems);
+        if (!reduced)
+        {
+            const std::string message = "Couldn't skip unchanged regions of " + project.first;
+            AsyncLog::Write(AsyncLog::Severity::Warning, "WAAPITransfer", message.c_str());
+            continue;
+        }
+
+        m_unchangedRegionItems.insert(skippedIds.begin(), skippedIds.end());
+        numRegionsSkipped += static_cast<uint32>(unchanged.size());
+        secondsSaved += s_transferHistory.PredictRenderSeconds(current.GetReaperProject(), skippedAudioSeconds);
+    }
+
+    if (!numRegionsSkipped)
+    {
+        return std::string();
+    }
+
+    return "Skipped " + std::to_string(numRegionsSkipped) + " unchanged regions, about "
+           + std::to_string(static_cast<uint32>(secondsSaved)) + "s of rendering saved";
+}
+
+
+std::string WAAPITransfer::AnalyzeRenderedProject(const RenderProjectMap::value_type &project)
+{
+    using namespace AK::WwiseAuthoringAPI;
+
+    WAAPI_TRACE_SCOPE_DETAIL("transfer", "AnalyzeRenderedProject", project.first.c_str());
+
+    //only what's about to be imported
+    std::vector<RenderItemID> ids;
+    std::vector<fs::path> paths;
+    for (RenderItemID id : project.second)
+    {
+        const RenderItem &renderItem = GetRenderItemFromRenderItemId(id);
+        if (!m_unchangedRegionItems.count(id) && !renderItem.wwiseGuid.empty())
+        {
+            ids.push_back(id);
+            paths.push_back(renderItem.audioFilePath);
+        }
+    }
+
+    if (paths.empty())
+    {
+        return std::string();
+    }
+
+    const auto start = std::chrono::steady_clock::now();
+    std::vector<AudioAnalysis> analyses = AnalyzeWavs(paths, std::max(1u, std::thread::hardware_concurrency()));
+    const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    uint32 numHeldBack = 0;
+    uint64_t numBytes = 0;
+    for (size_t i = 0; i < analyses.size(); ++i)
+    {
+        std::error_code error;
+        const uintmax_t fileSize = fs::file_size(paths[i], error);
+        numBytes += error ? 0 : fileSize;
+
+        const std::string outOfSpec = m_loudnessSpec.Check(analyses[i]);
+        if (!outOfSpec.empty())
+        {
+            m_heldBackItems.insert(ids[i]);
+            ++numHeldBack;
+
+            const std::string message = "Held back " + paths[i].generic_string() + ": " + outOfSpec;
+            AsyncLog::Write(AsyncLog::Severity::Warning, "WAAPITransfer", message.c_str());
+        }
+    }
+
+    m_renderAnalyses.insert(m_renderAnalyses.end(), std::make_move_iterator(analyses.begin()),
+                            std::make_move_iterator(analyses.end()));
+
+    char text[512];
+    snprintf(text, sizeof(text), "Analyzed %s: %u files, %.2f MB in %.2fs, held back %u out of spec",
+             project.first.c_str(), static_cast<uint32>(paths.size()), numBytes / (1024.0 * 1024.0), seconds, numHeldBack);
+    return text;
+}
 
 void WAAPITransfer::WaapiImportLoop()
 {
     using namespace AK::WwiseAuthoringAPI;
+    using Clock = std::chrono::steady_clock;
+
+    WAAPI_TRACE_THREAD_NAME("Transfer");
+
+    //every waapi call made from this thread gives up within a few ms of the user pressing cancel
+    CallScope transferScope(&m_transferCancel);
+
+    auto SecondsSince = [](Clock::time_point start)
+    {
+        return std::chrono::duration<double>(Clock::now() - start).count();
+    };
 
     for (const auto &renderQueueItemPath : s_renderQueueCachedProjects)
     {
@@ -629,6 +1650,76 @@ void WAAPITransfer::WaapiImportLoop()
     EnumProjects(-1, reaprojectPath, MAX_PATH);
     const std::string projSourceNote(PROJ_NOTE_PREFIX + '"' + reaprojectPath + '"');
 
+    const fs::path transferDataDir = GetTransferDataDir();
+    const fs::path historyPath = transferDataDir / TRANSFER_HISTORY_FILENAME;
+    const fs::path logPath = transferDataDir / TRANSFER_LOG_FILENAME;
+    s_transferHistory.Load(historyPath);
+
+    const std::string regionsSkippedText = ReduceRenderQueues();
+
+    m_heldBackItems.clear();
+    m_renderAnalyses.clear();
+    m_analyzeRenders = false;
+    std::string loudnessSpecError;
+    const fs::path loudnessSpecPath = transferDataDir / LOUDNESS_SPEC_FILENAME;
+    if (fs::exists(loudnessSpecPath))
+    {
+        m_analyzeRenders = m_loudnessSpec.Load(loudnessSpecPath, loudnessSpecError);
+    }
+
+    //predict each project up front, remaining time is the sum of the projects still in the queue
+    struct ProjectPrediction
+    {
+        //the history is kept by the project the queued render was made from
+        std::string historyProject;
+        double audioSeconds;
+        uint32 numImportItems;
+        double renderSeconds;
+        double importSeconds;
+    };
+    std::unordered_map<std::string, ProjectPrediction> predictions;
+    double predictedTotalSeconds = 0.0;
+
+    for (const auto &project : s_renderQueueCachedProjects)
+    {
+        ProjectPrediction prediction{};
+        prediction.historyProject = GetQueuedRenderProject(project.first);
+        for (RenderItemID id : project.second)
+        {
+            if (m_unchangedRegionItems.count(id))
+            {
+                continue;
+            }
+
+            const RenderItem &renderItem = GetRenderItemFromRenderItemId(id);
+            prediction.audioSeconds += std::max(0.0, renderItem.outTime - renderItem.inTime);
+            if (!renderItem.wwiseGuid.empty())
+            {
+                ++prediction.numImportItems;
+            }
+        }
+        prediction.renderSeconds = s_transferHistory.PredictRenderSeconds(prediction.historyProject, prediction.audioSeconds);
+        prediction.importSeconds = s_transferHistory.PredictImportSeconds(prediction.historyProject, prediction.numImportItems);
+        predictedTotalSeconds += prediction.renderSeconds + prediction.importSeconds;
+        predictions.insert({ project.first, prediction });
+    }
+
+    AppendTransferLog(logPath, "Transfer started: " + std::to_string(s_renderQueueCachedProjects.size())
+                      + " projects, predicted " + std::to_string(static_cast<uint32>(predictedTotalSeconds)) + "s");
+    if (!regionsSkippedText.empty())
+    {
+        AppendTransferLog(logPath, regionsSkippedText);
+    }
+    if (!loudnessSpecError.empty())
+    {
+        AppendTransferLog(logPath, "Loudness spec not used, renders aren't analysed: " + loudnessSpecError);
+    }
+    if (!m_preflightPlan.items.empty())
+    {
+        AppendTransferLog(logPath, "Import plan: " + FormatPreflightPlan(m_preflightPlan) + ", "
+                          + std::to_string(m_preflightPlan.numImportCalls) + " import calls");
+    }
+
     //start reaper render
     PostMessage(hwnd, WM_TRANSFER_THREAD_MSG, 
                 TRANSFER_THREAD_WPARAM::LAUNCH_RENDER_QUEUE_REQUEST, 0);
@@ -641,6 +1732,36 @@ void WAAPITransfer::WaapiImportLoop()
 
     RenderProjectMap renderQueueProjectsCopy = s_renderQueueCachedProjects;
 
+    const Clock::time_point transferStart = Clock::now();
+
+    //reaper renders the queue one project at a time, a project's render time runs from the previous one finishing
+    Clock::time_point lastRenderFinished = transferStart;
+
+    TransferProgress progress{};
+    progress.projectsTotal = static_cast<uint32>(totalRenderItems);
+
+    auto UpdateProgress = [&]()
+    {
+        const double currentRenderSeconds = SecondsSince(lastRenderFinished);
+
+        double remainingSeconds = 0.0;
+        for (const auto &project : renderQueueProjectsCopy)
+        {
+            const ProjectPrediction &prediction = predictions[project.first];
+            remainingSeconds += prediction.renderSeconds + prediction.importSeconds;
+        }
+
+        TransferProgress snapshot = progress;
+        snapshot.renderSeconds += currentRenderSeconds;
+        snapshot.elapsedSeconds = SecondsSince(transferStart);
+        snapshot.etaSeconds = std::max(0.0, remainingSeconds - currentRenderSeconds);
+
+        std::lock_guard<std::mutex> lock(m_transferProgressMutex);
+        m_transferProgress = snapshot;
+    };
+
+    UpdateProgress();
+
     while (renderQueueActive && !m_closeTransferThreadByUser)
     {
         for (auto iter = renderQueueProjectsCopy.begin();
@@ -658,23 +1779,104 @@ void WAAPITransfer::WaapiImportLoop()
             //reaper deletes the file when it's done rendering
             if (!fs::exists(iter->first))
             {
+                const ProjectPrediction &prediction = predictions[iter->first];
+
+                const double renderSeconds = SecondsSince(lastRenderFinished);
+                lastRenderFinished = Clock::now();
+                progress.renderSeconds += renderSeconds;
+                s_transferHistory.AddRenderSample(prediction.historyProject, prediction.audioSeconds, renderSeconds);
+                WAAPI_TRACE_ELAPSED("reaper", "RenderWait", renderSeconds, iter->first.c_str());
+
+                if (m_analyzeRenders)
+                {
+                    const std::string analysisText = AnalyzeRenderedProject(*iter);
+                    if (!analysisText.empty())
+                    {
+                        AppendTransferLog(logPath, analysisText);
+                    }
+                }
+
+                //rendered files are removed after import when not copying to originals, size them now
+                uint64_t projectBytes = 0;
+                uint32 numImportItems = prediction.numImportItems;
+                for (RenderItemID id : iter->second)
+                {
+                    if (m_unchangedRegionItems.count(id))
+                    {
+                        continue;
+                    }
+                    if (m_heldBackItems.count(id))
+                    {
+                        --numImportItems;
+                        continue;
+                    }
+
+                    const RenderItem &renderItem = GetRenderItemFromRenderItemId(id);
+                    std::error_code error;
+                    const uintmax_t fileSize = fs::file_size(renderItem.audioFilePath, error);
+                    if (!error && !renderItem.wwiseGuid.empty())
+                    {
+                        projectBytes += fileSize;
+                    }
+                }
+
                 int progressBarStep = static_cast<int>
-                    ((++numItemsProcessed / (float)(totalRenderItems * 100.0f)));
+                    ((++numItemsProcessed * 100) / totalRenderItems);
+
+                const Clock::time_point importStart = Clock::now();
+                const bool importSucceeded = WaapiImportByProject(iter->first, projSourceNote);
+                const double importSeconds = SecondsSince(importStart);
+
+                progress.importSeconds += importSeconds;
+                ++progress.projectsDone;
+
+                char logBuff[512];
+                snprintf(logBuff, sizeof(logBuff), "%s %s: %u items, %.2f MB, render %.2fs (%.2fs audio), import %.2fs",
+                         importSucceeded ? "Imported" : "Import failed",
+                         iter->first.c_str(), numImportItems, projectBytes / (1024.0 * 1024.0),
+                         renderSeconds, prediction.audioSeconds, importSeconds);
+                AppendTransferLog(logPath, logBuff);
 
-                if (WaapiImportByProject(iter->first, projSourceNote))
+                if (importSucceeded)
                 {
+                    progress.itemsImported += numImportItems;
+                    progress.bytesImported += projectBytes;
+                    s_transferHistory.AddImportSample(prediction.historyProject, numImportItems, importSeconds);
+
                     //inform main thread with new progress bar %                   
                     PostMessage(hwnd, WM_TRANSFER_THREAD_MSG, TRANSFER_THREAD_WPARAM::IMPORT_SUCCESS, progressBarStep);
 
                     //success, delete backup
                     fs::remove(iter->first + RENDER_QUEUE_BACKUP_APPEND);
 
+                    //what was rendered now matches wwise, the next transfer can skip what stays the same
+                    //except regions with held back files, they have to render again once they're fixed
+                    auto regionHashes = m_pendingRegionHashes.find(iter->first);
+                    if (regionHashes != m_pendingRegionHashes.end())
+                    {
+                        for (RenderItemID id : iter->second)
+                        {
+                            if (m_heldBackItems.count(id))
+                            {
+                                regionHashes->second.second.Forget(RegionHashes::GetRegionKey(GetRenderItemFromRenderItemId(id)));
+                            }
+                        }
+                        if (!regionHashes->second.second.Save(regionHashes->second.first))
+                        {
+                            AsyncLog::Write(AsyncLog::Severity::Warning, "WAAPITransfer", "Couldn't save the region hashes");
+                        }
+                    }
+
 					//if we aren't copying then we should delete files in the reaper export folder
 					if (!ShouldCopyToOriginals())
 					{
 						for (RenderItemID id : iter->second)
 						{
-							fs::remove(GetRenderItemFromRenderItemId(id).audioFilePath);
+							//held back files stay for whoever fixes them
+							if (!m_unchangedRegionItems.count(id) && !m_heldBackItems.count(id))
+							{
+								fs::remove(GetRenderItemFromRenderItemId(id).audioFilePath);
+							}
 						}
 					}
 
@@ -703,6 +1905,8 @@ void WAAPITransfer::WaapiImportLoop()
             {
                 ++iter;
             }
+
+            UpdateProgress();
         }
     }
 
@@ -711,9 +1915,34 @@ void WAAPITransfer::WaapiImportLoop()
         fs::rename(file + RENDER_QUEUE_BACKUP_APPEND, file);
     }
 
+    UpdateProgress();
+    s_transferHistory.Save(historyPath);
+    if (!m_importIdsPath.empty() && !m_importIds.GetEntries().empty() && !m_importIds.Save(m_importIdsPath))
+    {
+        AsyncLog::Write(AsyncLog::Severity::Warning, "WAAPITransfer", "Couldn't save the import id index");
+    }
+    if (m_numImportsRetargeted)
+    {
+        AppendTransferLog(logPath, "Imported " + std::to_string(m_numImportsRetargeted)
+                          + " items onto sounds that were renamed or moved in Wwise, found by id");
+    }
+    WampMetrics::WriteJson((transferDataDir / WAAPI_METRICS_FILENAME).string());
+    if (m_analyzeRenders && !WriteAnalysisReport(transferDataDir / LOUDNESS_REPORT_FILENAME, m_renderAnalyses, m_loudnessSpec))
+    {
+        AsyncLog::Write(AsyncLog::Severity::Warning, "WAAPITransfer", "Couldn't write the loudness report");
+    }
+    if (m_numPreflightSkipped)
+    {
+        AppendTransferLog(logPath, "Skipped " + std::to_string(m_numPreflightSkipped) + " unchanged items, "
+                          + std::to_string(m_numPreflightCallsSaved) + " import calls saved");
+    }
+    AppendTransferLog(logPath, "Transfer finished: " + FormatTransferProgress(GetTransferProgress()));
+
     WPARAM importWparam;
     if (m_closeTransferThreadByUser)
     {
+        const Clock::duration cancelToIdle = Clock::now() - Clock::time_point(Clock::duration(m_cancelRequestedAt.load()));
+        AppendTransferLog(logPath, "Transfer cancelled, idle " + std::to_string(std::chrono::duration_cast<std::chrono::milliseconds>(cancelToIdle).count()) + "ms after cancel");
         importWparam = THREAD_EXIT_BY_USER;
     }
     else
@@ -723,6 +1952,12 @@ void WAAPITransfer::WaapiImportLoop()
     PostMessage(hwnd, WM_TRANSFER_THREAD_MSG, importWparam, 0);
 }
 
+TransferProgress WAAPITransfer::GetTransferProgress() const
+{
+    std::lock_guard<std::mutex> lock(m_transferProgressMutex);
+    return m_transferProgress;
+}
+
 bool WAAPITransfer::WaapiImportByProject(const std::string &projectPath, const std::string &RecallProjectPath)
 {
     auto iter = s_renderQueueCachedProjects.find(projectPath);
@@ -735,108 +1970,85 @@ bool WAAPITransfer::WaapiImportByProject(RenderProjectMap::iterator projectIter,
 {
     using namespace AK::WwiseAuthoringAPI;
 
-    //wwise seems to crash importing a lot of items at once, so let's split it up into 10's for now
-    const std::vector<uint32> &renderIdVec = projectIter->second;
-
-    //we need separate arrays for each import operation
-    AkJson::Array itemsCreateNew;
-    AkJson::Array itemsUseExisting;
-    AkJson::Array itemsReplaceExisting;
+    WAAPI_TRACE_SCOPE_DETAIL("transfer", "WaapiImportByProject", projectIter->first.c_str());
 
-    itemsCreateNew.reserve(WAAPI_IMPORT_BATCH_SIZE);
-    itemsUseExisting.reserve(WAAPI_IMPORT_BATCH_SIZE);
-    itemsReplaceExisting.reserve(WAAPI_IMPORT_BATCH_SIZE);
+    //wwise seems to crash importing a lot of items at once, the plan splits it up into WAAPI_IMPORT_BATCH_SIZE chunks
+    std::vector<const RenderItem*> renderItems;
+    renderItems.reserve(projectIter->second.size());
 
-    bool allSucceeded = true;
-    uint32 const numBatches = static_cast<uint32>(std::ceilf(renderIdVec.size() / static_cast<float>(WAAPI_IMPORT_BATCH_SIZE)));
+    //items whose sound was renamed or moved since it was imported, reserved so the pointers stay put
+    std::vector<RenderItem> retargeted;
+    retargeted.reserve(projectIter->second.size());
+    std::unordered_map<const RenderItem*, const RenderItem*> originals;
 
-    for (uint32 batch = 0; batch < numBatches; ++batch)
+    uint32 numSkipped = 0;
+    for (RenderItemID id : projectIter->second)
     {
-        itemsCreateNew.clear();
-        itemsUseExisting.clear();
-        itemsReplaceExisting.clear();
-
-        uint32 const numItems = std::min(static_cast<uint32>(renderIdVec.size()) - batch * WAAPI_IMPORT_BATCH_SIZE, WAAPI_IMPORT_BATCH_SIZE);
-
-        for (uint32 i = 0; i < numItems; ++i)
+        //its region didn't change and wasn't rendered, wwise already has it
+        if (m_unchangedRegionItems.count(id))
         {
-            const RenderItem &renderItem = GetRenderItemFromRenderItemId(renderIdVec[i + (batch * WAAPI_IMPORT_BATCH_SIZE)]);
-            
-            //check if object has wwise GUID attached
-            if (renderItem.wwiseGuid.empty())
-            {
-                continue;
-            }
-
-            AkJson importItem = AkJson(AkJson::Map{
-                { "audioFile", AkVariant(renderItem.audioFilePath.generic_string()) },
-                { "importLocation", AkVariant(renderItem.wwiseGuid) },
-                { "objectType", AkVariant("Sound") }
-            });
-
-            auto &importMap = importItem.GetMap();
-
-            switch (renderItem.importObjectType)
-            {
-
-            case ImportObjectType::SFX:
-            {
-                importMap.insert({ "objectPath", AkVariant("<Sound SFX>" + renderItem.outputFileName) });
-				importMap.insert({ "audioSourceNotes", AkVariant(RecallProjectPath) });
-            } break;
-
-            case ImportObjectType::Voice:
-            {
-                importMap.insert({ "importLanguage", AkVariant(WwiseLanguages[renderItem.wwiseLanguageIndex]) });
-                importMap.insert({ "objectPath", AkVariant("<Sound Voice>" + renderItem.outputFileName) });
-				importMap.insert({ "audioSourceNotes", AkVariant(RecallProjectPath) });
-            } break;
-
-            case ImportObjectType::Music:
-            {
-                importMap.insert({ "objectPath", AkVariant("<Music Track>" + renderItem.outputFileName) });
-            } break;
-
-            }
-
-			if (!renderItem.wwiseOriginalsSubpath.empty())
-			{
-				//TODO: Check for path correctness
-				importMap.insert({ "originalsSubFolder", AkVariant(renderItem.wwiseOriginalsSubpath) });
-			}
-
-            switch (renderItem.importOperation)
-            {
-            case WAAPIImportOperation::createNew:
-            {
-                itemsCreateNew.push_back(importItem);
-            } break;
+            continue;
+        }
 
-            case WAAPIImportOperation::replaceExisting:
-            {
-                itemsReplaceExisting.push_back(importItem);
-            } break;
+        //rendered out of the loudness spec, wwise keeps what it has
+        if (m_heldBackItems.count(id))
+        {
+            continue;
+        }
 
-            case WAAPIImportOperation::useExisting:
-            {
-                itemsUseExisting.push_back(importItem);
-            } break;
+        const RenderItem &renderItem = GetRenderItemFromRenderItemId(id);
 
+        //same audio as the sound already has, importing it again would only touch the project
+        const PreflightItem *preflightItem = m_preflightPlan.Find(renderItem);
+        if (preflightItem && IsUnchangedImport(renderItem, *preflightItem))
+        {
+            ++numSkipped;
+            continue;
+        }
 
-            }
+        RenderItem target;
+        if (RetargetToImportedSound(renderItem, target))
+        {
+            retargeted.push_back(std::move(target));
+            originals.insert({ &retargeted.back(), &renderItem });
+            renderItems.push_back(&retargeted.back());
+            ++m_numImportsRetargeted;
+            continue;
         }
-        if (!itemsCreateNew.empty())
+        renderItems.push_back(&renderItem);
+    }
+
+    const std::vector<ImportBatch> importPlan = BuildImportPlan(renderItems, RecallProjectPath);
+    if (numSkipped)
+    {
+        std::vector<const RenderItem*> allRenderItems;
+        for (RenderItemID id : projectIter->second)
         {
-            if (!WaapiImportItems(itemsCreateNew, m_client, WAAPIImportOperation::createNew)) allSucceeded = false;
+            allRenderItems.push_back(&GetRenderItemFromRenderItemId(id));
         }
-        if (!itemsReplaceExisting.empty())
+        m_numPreflightSkipped += numSkipped;
+        m_numPreflightCallsSaved += CountImportCalls(allRenderItems) - importPlan.size();
+    }
+
+    bool allSucceeded = true;
+    for (const ImportBatch &batch : importPlan)
+    {
+        WAAPI_TRACE_SCOPE("transfer", "ImportBatch");
+
+        if (m_transferCancel.IsCancelled())
         {
-            if (!WaapiImportItems(itemsReplaceExisting, m_client, WAAPIImportOperation::replaceExisting)) allSucceeded = false;
+            allSucceeded = false;
+            break;
         }
-        if (!itemsUseExisting.empty())
+
+        CallScope batchScope(nullptr, WAAPI_IMPORT_BATCH_TIMEOUT_MS);
+        ResultView results;
+        if (!WaapiImportItems(batch.items, m_client, batch.importOperation, results))
         {
-            if (!WaapiImportItems(itemsUseExisting, m_client, WAAPIImportOperation::useExisting)) allSucceeded = false;
+            allSucceeded = false;
+            continue;
         }
+        RecordImportedIds(batch, originals, results);
     }
 
     return allSucceeded;
@@ -844,14 +2056,15 @@ bool WAAPITransfer::WaapiImportByProject(RenderProjectMap::iterator projectIter,
 
 void WAAPITransfer::SetSelectedImportOperation(WAAPIImportOperation operation)
 {
-    ForEachSelectedRenderItem([this, operation](uint32 mappedIndex, uint32 listItem)
+    const std::string importStr = GetImportOperationString(operation);
+
+    ForEachSelectedRenderItem([this, operation, &importStr](uint32 mappedIndex, uint32 listItem)
     {
         GetRenderItemFromListviewId(mappedIndex).importOperation = operation;
-        const std::string importStr = GetImportOperationString(operation);
-        char operationStrbuff[64];
-        strcpy(operationStrbuff, importStr.c_str());
-        ListView_SetItemText(GetRenderViewHWND(), listItem, WAAPITransfer::RenderViewSubitemID::WaapiImportOperation, operationStrbuff);
+        m_renderViewChanges.SetCell(mappedIndex, WAAPITransfer::RenderViewSubitemID::WaapiImportOperation, importStr);
     });
+
+    FlushRenderViewChanges();
 }
 
 void WAAPITransfer::ForEachSelectedRenderItem(std::function<void(MappedListViewID, uint32)> const& func) const
@@ -886,19 +2099,13 @@ void WAAPITransfer::SetRenderItemWwiseParent(MappedListViewID mappedIndex, const
     item.wwiseGuid = wwiseParentGuid;
     item.wwiseParentName = wwiseParentName;
 
-    char strbuff[WWISE_NAME_MAX_LEN];
-    strcpy(strbuff, wwiseParentName.c_str());
-    int listItem = ListView_MapIDToIndex(GetRenderViewHWND(), mappedIndex);
-    ListView_SetItemText(GetRenderViewHWND(), listItem, RenderViewSubitemID::WwiseParent, strbuff);
+    m_renderViewChanges.SetCell(mappedIndex, RenderViewSubitemID::WwiseParent, wwiseParentName);
 
     //we need to change the import object type if the parent is set to a music track
     if (isMusicSegment)
     {
         item.importObjectType = ImportObjectType::Music;
-        const auto musicStr = GetTextForImportObject(ImportObjectType::Music);
-        char musicStrBuffer[256];
-        strcpy(musicStrBuffer, musicStr.c_str());
-        ListView_SetItemText(GetRenderViewHWND(), listItem, RenderViewSubitemID::WwiseImportObjectType, musicStrBuffer);
+        m_renderViewChanges.SetCell(mappedIndex, RenderViewSubitemID::WwiseImportObjectType, GetTextForImportObject(ImportObjectType::Music));
     }
     else
     {
@@ -907,10 +2114,7 @@ void WAAPITransfer::SetRenderItemWwiseParent(MappedListViewID mappedIndex, const
         if (item.importObjectType == ImportObjectType::Music)
         {
             item.importObjectType = ImportObjectType::SFX;
-            const std::string sfxStr = GetTextForImportObject(ImportObjectType::SFX);
-            char sfxStrBuffer[256];
-            strcpy(sfxStrBuffer, sfxStr.c_str());
-            ListView_SetItemText(GetRenderViewHWND(), listItem, RenderViewSubitemID::WwiseImportObjectType, sfxStrBuffer);
+            m_renderViewChanges.SetCell(mappedIndex, RenderViewSubitemID::WwiseImportObjectType, GetTextForImportObject(ImportObjectType::SFX));
         }
     }
 
@@ -928,11 +2132,7 @@ void WAAPITransfer::RemoveRenderItemWwiseParent(RenderItemMap::iterator it)
     RenderItem &renderItem = it->second.first;
     renderItem.wwiseGuid = "";
 
-    char *noParentStr = "Not set.";
-    auto mappedIndex = it->second.second;
-
-    int listItem = ListView_MapIDToIndex(GetRenderViewHWND(), mappedIndex);
-    ListView_SetItemText(GetRenderViewHWND(), listItem, RenderViewSubitemID::WwiseParent, noParentStr);
+    m_renderViewChanges.SetCell(it->second.second, RenderViewSubitemID::WwiseParent, "Not set.");
 }
 
 void WAAPITransfer::SetRenderItemOutputName(MappedListViewID mappedIndex, const std::string &newOutputName)
@@ -943,10 +2143,8 @@ void WAAPITransfer::SetRenderItemOutputName(MappedListViewID mappedIndex, const
     RenderItem &item = GetRenderItemFromRenderItemId(filePath->second);
     item.outputFileName = newOutputName;
 
-    char strbuff[WWISE_NAME_MAX_LEN];
-    strcpy(strbuff, newOutputName.c_str());
-    int listItem = ListView_MapIDToIndex(GetRenderViewHWND(), mappedIndex);
-    ListView_SetItemText(GetRenderViewHWND(), listItem, 1, strbuff);
+    m_renderViewChanges.SetCell(mappedIndex, 1, newOutputName);
+    FlushRenderViewChanges();
 }
 
 
@@ -962,4 +2160,7 @@ WAAPIImportOperation WAAPITransfer::lastImportOperation = WAAPIImportOperation::
 
 std::unordered_set<std::string> WAAPITransfer::s_originalPathHistory = std::unordered_set<std::string>{};
 
-bool WAAPITransfer::s_copyFilesToWwiseOriginals = true;
\ No newline at end of file
+bool WAAPITransfer::s_copyFilesToWwiseOriginals = true;
+bool WAAPITransfer::s_renderChangedRegionsOnly = true;
+
+TransferHistory WAAPITransfer::s_transferHistory = TransferHistory{};
\ No newline at end of file
@@ -3,12 +3,25 @@
 #include <Commctrl.h>
 #include <AK/WwiseAuthoringAPI/AkAutobahn/Client.h>
 #include <atomic>
+#include <chrono>
+#include <mutex>
 
 #include <vector>
 #include <unordered_map>
 #include <unordered_set>
 
+#include "AudioAnalysis.h"
+#include "CallScope.h"
+#include "ImportIdIndex.h"
+#include "ImportPlan.h"
+#include "RegionHashes.h"
 #include "RenderQueueReader.h"
+#include "RenderViewChangeSet.h"
+#include "ResultView.h"
+#include "TransferMapping.h"
+#include "TransferStats.h"
+#include "WwiseHierarchyCache.h"
+#include "WwiseParentSearch.h"
 #include "config.h"
 #include "types.h"
 
@@ -63,7 +76,10 @@ public:
     void RunRenderQueueAndImport();
 
     //Called when user presses 'Cancel' button whilst extension is importing
-    void CancelTransferThread() { m_closeTransferThreadByUser = true; }
+    void CancelTransferThread();
+
+    //Throughput and ETA of the running transfer, safe to call from the main thread
+    TransferProgress GetTransferProgress() const;
 
     //Set status message at bottom of window
     void SetStatusText(const std::string &status) const;
@@ -71,6 +87,17 @@ public:
     //add objects selected in Wwise authoring app to the wwise object view
     void AddSelectedWwiseObjects();
 
+    //picks up renames and moves of the added wwise objects from the hierarchy mirror
+    //called on main thread for WM_WWISE_HIERARCHY_CHANGED
+    void RefreshWwiseObjectsFromHierarchy();
+
+    //wwise parent search box, see WwiseParentSearch
+    void OnWwiseSearchEdited();
+    void OnWwiseSearchResults(bool success);
+
+    //adds the search result picked in the search box to the wwise object view
+    void AddWwiseSearchSelection();
+
     //remove wwise object from all maps and the tree view
     void RemoveWwiseObject(MappedListViewID toRemove);
     
@@ -87,6 +114,14 @@ public:
     //sets all the selected list view items wwise parents
     void SetSelectedRenderParents(MappedListViewID wwiseTreeItem);
 
+    //mirrors the selected render items' reaper track folders as containerType (ActorMixer or Folder) under the wwise
+    //object and parents each item to its folder, items outside any folder to the object itself
+    void MirrorSelectedTrackFolders(MappedListViewID wwiseTreeItem, const std::string &containerType);
+
+    //sets the selected render items' parent, import type, operation, language and originals subpath from the
+    //mapping file in the transfer data dir, the parents are added to the wwise object view
+    void AssignSelectedParentsFromMapping();
+
     //import as SFX, Music or dialog voice
     void SetSelectedImportObjectType(ImportObjectType type);
 
@@ -96,11 +131,15 @@ public:
     //If render item will create, replace or use existing parent
     void SetSelectedImportOperation(WAAPIImportOperation operation);
 
+    //wwise originals sub folder the selected render items will be copied into
+    void SetSelectedOriginalsSubpath(const std::string &originalsSubpath);
+
     //for each selected list view item apply function accepting a mapped list view id and listview index
     void ForEachSelectedRenderItem(std::function<void(MappedListViewID, uint32)> const& func) const;
 
     //Updates the Wwise parent that the render item will be imported into
     //if wwise parent is a music segment then the render items will have their import object type changed to match
+    //view edits are only recorded, the calling action pushes them with FlushRenderViewChanges
     void SetRenderItemWwiseParent(MappedListViewID mappedIndex, const std::string &wwiseParentGuid, bool isMusicSegment = false);
 
     //used to reset render item wwise parent if user removes a wwise object from the internal list
@@ -122,6 +161,10 @@ public:
 	bool ShouldCopyToOriginals() const { return s_copyFilesToWwiseOriginals; }
 	void SetShouldCopyToOriginals(const bool shouldCopy) { s_copyFilesToWwiseOriginals = shouldCopy; }
 
+    //leave regions that haven't changed since the last successful transfer out of the render, see ReduceRenderQueues
+    static bool ShouldRenderChangedRegionsOnly() { return s_renderChangedRegionsOnly; }
+    static void SetRenderChangedRegionsOnly(bool changedOnly) { s_renderChangedRegionsOnly = changedOnly; }
+
     // last import operation selected 
     static WAAPIImportOperation lastImportOperation;
 
@@ -142,6 +185,49 @@ private:
 
 	std::atomic_bool m_closeTransferThreadByUser{};
 
+    //cancels the waapi call the transfer thread is blocked in, see WaapiImportLoop
+    AK::WwiseAuthoringAPI::CancellationToken m_transferCancel;
+    std::atomic<std::chrono::steady_clock::rep> m_cancelRequestedAt{};
+
+    //what each import will do, built on the main thread before the transfer thread starts and read by it
+    PreflightPlan m_preflightPlan;
+
+    //Unchanged items the transfer thread confirmed and didn't import, and the import calls that saved
+    uint32 m_numPreflightSkipped = 0;
+    size_t m_numPreflightCallsSaved = 0;
+
+    //ids of the current reaper project's imported items, loaded before the transfer thread starts and updated by it
+    //m_importIdsPath is empty for an unsaved reaper project, nothing is recorded then
+    ImportIdIndex m_importIds;
+    fs::path m_importIdsPath;
+
+    //items imported onto a sound found by id after it was renamed or moved in wwise
+    uint32 m_numImportsRetargeted = 0;
+
+    //render items of unchanged regions, left out of the queued renders and not imported, see ReduceRenderQueues
+    std::unordered_set<RenderItemID> m_unchangedRegionItems;
+
+    //render items whose files are out of LOUDNESS_SPEC_FILENAME, rendered but not imported, see AnalyzeRenderedProject
+    std::unordered_set<RenderItemID> m_heldBackItems;
+
+    //set for a transfer when the loudness spec loads, every analysis of the transfer goes in the report
+    LoudnessSpec m_loudnessSpec;
+    bool m_analyzeRenders = false;
+    std::vector<AudioAnalysis> m_renderAnalyses;
+
+    //region hashes of each queued render and the file they go to, saved once its import succeeds
+    std::unordered_map<std::string, std::pair<fs::path, RegionHashes>> m_pendingRegionHashes;
+
+    //TRANSFER_MAPPING_FILENAME, reloaded when the file changes
+    TransferMapping m_mapping;
+    fs::file_time_type m_mappingWriteTime{};
+    bool m_mappingLoaded = false;
+    size_t m_numMappingConflicts = 0;
+
+    //written by the transfer thread, read by the progress window
+    mutable std::mutex m_transferProgressMutex;
+    TransferProgress m_transferProgress{};
+
     //----------------------------------------------------------------
     //Static persistent 
 
@@ -159,18 +245,37 @@ private:
     static WwiseObjectMap s_activeWwiseObjects;
 
 	static bool s_copyFilesToWwiseOriginals;
+    static bool s_renderChangedRegionsOnly;
+
+    //render/import timing per project, persisted in the transfer data dir
+    static TransferHistory s_transferHistory;
 
     //----------------------------------------------------------------
 
     //Socket client for Waapi connection
     AK::WwiseAuthoringAPI::Client m_client;
 
+    //set while a WM_WWISE_HIERARCHY_CHANGED is posted and not handled yet, a burst of changes posts one message
+    std::atomic_bool m_hierarchyRefreshPosted{};
+
+    //mirror of the wwise hierarchies, declared after m_client so it finishes loading and unsubscribes before the client goes away
+    WwiseHierarchyCache m_hierarchy;
+
+    //also declared after m_client so it's destroyed first, it cancels and joins its query thread
+    WwiseParentSearch m_parentSearch;
+
+    //results listed in the search box, item data is the index in here
+    std::shared_ptr<const WwiseParentSearch::Results> m_shownSearchResults;
+
     //Call this on window invocation to add cached wwise objects into tree view
     void RecreateWwiseView();
 
     //Call this on window invocation to add cached render queue objects into tree view
     void RecreateTransferListView();
 
+    //fills the search box list with the search's current results
+    void ShowWwiseSearchResults();
+
     //Add a wwise object to treeview and internal data structures
     MappedListViewID CreateWwiseObject(const std::string &wwiseguid, const WwiseObject &wwiseInfo);
     MappedListViewID AddWwiseObjectToView(const std::string &guid, const WwiseObject &wwiseObject);
@@ -190,6 +295,42 @@ private:
     RenderItemMap::iterator RemoveRenderItemFromList(RenderItemMap::iterator it);
     RenderItemMap::iterator RemoveRenderItemFromList(uint32 renderItemId);
 
+    //classifies every render item against what's already in wwise with one object.get, fills m_preflightPlan
+    //false if the query failed, the plan is left empty and everything is imported as before
+    bool RunImportPreflight();
+
+    //loads m_importIds for the current reaper project
+    void LoadImportIdIndex();
+
+    //hashes the regions of every queued render and rewrites them without the regions that hash the same as after the
+    //last successful transfer, their items go in m_unchangedRegionItems. Returns a transfer log line with the regions
+    //skipped and the render time that saves, empty if none were. Transfer thread, before the render starts
+    std::string ReduceRenderQueues();
+
+    //analyses the files a queued render just rendered on every core, items out of m_loudnessSpec go in
+    //m_heldBackItems. Returns a transfer log line, empty if there was nothing to analyse. Transfer thread, before
+    //the project is imported
+    std::string AnalyzeRenderedProject(const RenderProjectMap::value_type &project);
+
+    //loads the mapping file if it changed since last time and writes its conflict report
+    //false with a message for the status bar if there's no usable mapping
+    bool LoadMapping(std::string &errorOut);
+
+    //guids of import locations (guids or paths), from the hierarchy mirror or else one object.get for the paths and
+    //one for the guids. Locations that can hold sounds are added to the wwise object view, the rest stay empty
+    bool ResolveImportLocations(std::unordered_map<std::string, std::string> &locationGuids, std::string &errorOut);
+
+    //if the item was imported before and its sound has since been renamed or moved in wwise, targetOut is the item
+    //aimed at the sound's current parent and name, so replaceExisting/useExisting update that sound instead of
+    //making a new one next to the old place
+    bool RetargetToImportedSound(const RenderItem &renderItem, RenderItem &targetOut) const;
+
+    //adds the sounds and sources an import call returned to m_importIds
+    //originals maps the batch's retargeted render items back to the items as set up in the transfer window
+    void RecordImportedIds(const ImportBatch &batch,
+                           const std::unordered_map<const RenderItem*, const RenderItem*> &originals,
+                           const AK::WwiseAuthoringAPI::ResultView &results);
+
     //called async to check when a render queue has finished and import all the files
     void WaapiImportLoop();
     
@@ -201,4 +342,10 @@ private:
 
     //Map render queue list item (with mapped index) to the render item id
     std::unordered_map<MappedListViewID, RenderItemID> m_renderListViewMap;
+
+    //Render view cell edits are recorded here and pushed once per action
+    RenderViewChangeSet m_renderViewChanges;
+
+    //Push recorded render view edits with redraw suspended
+    void FlushRenderViewChanges();
 };
@@ -0,0 +1,614 @@
+#include "WwiseHierarchyCache.h"
+
+#include <AK/WwiseAuthoringAPI/waapi.h>
+
+#include "ResultView.h"
+
+namespace
+{
+    const char *HIERARCHY_ROOT_PATHS[] = { "\\Actor-Mixer Hierarchy", "\\Interactive Music Hierarchy" };
+
+    AK::WwiseAuthoringAPI::AkJson MakeReturnOptions()
+    {
+        using namespace AK::WwiseAuthoringAPI;
+        return AkJson(AkJson::Map{
+            { "return", AkJson::Array{
+                AkVariant("id"),
+                AkVariant("name"),
+                AkVariant("type"),
+                AkVariant("parent") } }
+        });
+    }
+
+    std::string GetJsonString(const AK::WwiseAuthoringAPI::AkJson &json, const char *key)
+    {
+        if (!json.IsMap() || !json.HasKey(key))
+        {
+            return std::string();
+        }
+
+        const AK::WwiseAuthoringAPI::AkJson &value = json[key];
+        if (!value.IsVariant() || !value.GetVariant().IsString())
+        {
+            return std::string();
+        }
+        return value.GetVariant().GetString();
+    }
+}
+
+WwiseHierarchyCache::~WwiseHierarchyCache()
+{
+    if (m_loadThread.joinable())
+    {
+        m_loadThread.join();
+    }
+    Unload();
+}
+
+void WwiseHierarchyCache::LoadAsync(AK::WwiseAuthoringAPI::Client &client, int timeoutMs, std::function<void(bool)> onLoaded)
+{
+    if (m_loadThread.joinable())
+    {
+        m_loadThread.join();
+    }
+
+    m_asyncLoading = true;
+    m_loadThread = std::thread([this, &client, timeoutMs, onLoaded]()
+    {
+        const bool loaded = Load(client, timeoutMs);
+        m_asyncLoading = false;
+        if (onLoaded)
+        {
+            onLoaded(loaded);
+        }
+    });
+}
+
+bool WwiseHierarchyCache::Load(AK::WwiseAuthoringAPI::Client &client, int timeoutMs)
+{
+    using namespace AK::WwiseAuthoringAPI;
+
+    Unload();
+    m_client = &client;
+
+    //subscribe before querying, anything that arrives before the hierarchy is loaded is held and applied after it
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_loading = true;
+    }
+
+    const AkJson options = MakeReturnOptions();
+    for (const char *topic : { ak::wwise::core::object::created,
+                               ak::wwise::core::object::preDeleted,
+                               ak::wwise::core::object::nameChanged,
+                               ak::wwise::core::object::childAdded,
+                               ak::wwise::core::object::childRemoved })
+    {
+        uint64_t subscriptionId = 0;
+        AkJson result;
+        auto onEvent = [this, topic](uint64_t, const JsonProvider &event) { OnEvent(topic, event.GetAkJson()); };
+        if (!client.Subscribe(topic, options, onEvent, subscriptionId, result, timeoutMs))
+        {
+            Unload();
+            return false;
+        }
+        m_subscriptions.push_back(subscriptionId);
+    }
+
+    AkJson::Array rootPaths;
+    for (const char *rootPath : HIERARCHY_ROOT_PATHS)
+    {
+        rootPaths.push_back(AkVariant(rootPath));
+    }
+
+    const AkJson args(AkJson::Map{
+        { "from", AkJson::Map{ { "path", rootPaths } } },
+        { "transform", AkJson::Array{ AkJson::Map{ { "select", AkJson::Array{ AkVariant("descendants") } } } } }
+    });
+
+    //a whole project's worth of objects, read it from the result text rather than decoding it to AkJson
+    ResultView results;
+    AkJson error;
+    if (!ResultViews::Call(client, ak::wwise::core::object::get, args, options, results, error, timeoutMs))
+    {
+        Unload();
+        return false;
+    }
+
+    std::vector<PendingEvent> pendingEvents;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        const rapidjson::Value &objects = results.GetObjects();
+        std::vector<std::pair<uint32, std::string>> parents;
+        std::vector<ObjectFields> roots;
+        parents.reserve(objects.Size());
+
+        //create every node first, descendants aren't guaranteed to come after their parent
+        for (const rapidjson::Value &object : objects.GetArray())
+        {
+            ObjectFields fields;
+            fields.guid = ResultView::GetString(object, "id");
+            fields.name = ResultView::GetString(object, "name");
+            fields.type = ResultView::GetString(object, "type");
+            if (fields.guid.empty() || FindNode(fields.guid) != INVALID_NODE)
+            {
+                continue;
+            }
+
+            auto parent = object.FindMember("parent");
+            if (parent != object.MemberEnd())
+            {
+                fields.parentGuid = ResultView::GetString(parent->value, "id");
+                fields.parentName = ResultView::GetString(parent->value, "name");
+            }
+
+            const uint32 index = AddObject(fields, INVALID_NODE);
+            parents.emplace_back(index, fields.parentGuid);
+
+            //the hierarchy roots themselves aren't descendants, they are made from their children's parent
+            if (!fields.parentGuid.empty() && m_guidIndex.find(fields.parentGuid) == m_guidIndex.end())
+            {
+                ObjectFields rootFields;
+                rootFields.guid = fields.parentGuid;
+                rootFields.name = fields.parentName;
+                roots.push_back(rootFields);
+            }
+        }
+
+        for (const ObjectFields &rootFields : roots)
+        {
+            if (FindNode(rootFields.guid) == INVALID_NODE)
+            {
+                const uint32 root = AddObject(rootFields, INVALID_NODE);
+                m_nodes[root].isRoot = true;
+            }
+        }
+
+        for (const auto &child : parents)
+        {
+            const uint32 parent = FindNode(child.second);
+            if (parent != INVALID_NODE)
+            {
+                Link(child.first, parent);
+            }
+        }
+
+        for (uint32 i = 0; i < m_nodes.size(); ++i)
+        {
+            if (m_nodes[i].isRoot)
+            {
+                IndexSubtree(i, true);
+            }
+        }
+
+        pendingEvents.swap(m_pendingEvents);
+        m_loading = false;
+
+        for (const PendingEvent &event : pendingEvents)
+        {
+            ApplyEvent(event.topic, event.json);
+        }
+    }
+
+    m_loaded = true;
+    ++m_revision;
+    return true;
+}
+
+void WwiseHierarchyCache::Unload()
+{
+    if (m_client)
+    {
+        //waits for a running notification handler, so nothing touches the mirror after this
+        for (uint64_t subscriptionId : m_subscriptions)
+        {
+            AK::WwiseAuthoringAPI::AkJson result;
+            m_client->Unsubscribe(subscriptionId, result);
+        }
+    }
+    m_subscriptions.clear();
+    m_client = nullptr;
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    Clear();
+    m_loaded = false;
+}
+
+bool WwiseHierarchyCache::Contains(const std::string &guid) const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    const uint32 index = FindNode(guid);
+    return index != INVALID_NODE && IsAttached(index);
+}
+
+bool WwiseHierarchyCache::GetObjectInfo(const std::string &guid, ObjectInfo &infoOut) const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    const uint32 index = FindNode(guid);
+    if (index == INVALID_NODE || !IsAttached(index))
+    {
+        return false;
+    }
+
+    const Node &node = m_nodes[index];
+    infoOut.guid = node.guid;
+    infoOut.name = node.name;
+    infoOut.type = node.type;
+    infoOut.path = BuildPath(index);
+    infoOut.parentGuid = node.parent != INVALID_NODE ? m_nodes[node.parent].guid : std::string();
+    return true;
+}
+
+bool WwiseHierarchyCache::FindByPath(const std::string &path, std::string &guidOut) const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto found = m_pathIndex.find(path);
+    if (found == m_pathIndex.end())
+    {
+        return false;
+    }
+
+    guidOut = m_nodes[found->second].guid;
+    return true;
+}
+
+size_t WwiseHierarchyCache::GetNumObjects() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_pathIndex.size();
+}
+
+void WwiseHierarchyCache::SetChangedCallback(std::function<void()> callback)
+{
+    std::lock_guard<std::mutex> lock(m_callbackMutex);
+    m_changedCallback = std::move(callback);
+}
+
+uint32 WwiseHierarchyCache::AllocNode()
+{
+    if (!m_freeNodes.empty())
+    {
+        const uint32 index = m_freeNodes.back();
+        m_freeNodes.pop_back();
+        return index;
+    }
+
+    m_nodes.emplace_back();
+    return static_cast<uint32>(m_nodes.size() - 1);
+}
+
+uint32 WwiseHierarchyCache::FindNode(const std::string &guid) const
+{
+    auto found = m_guidIndex.find(guid);
+    return found != m_guidIndex.end() ? found->second : INVALID_NODE;
+}
+
+bool WwiseHierarchyCache::IsAttached(uint32 index) const
+{
+    while (m_nodes[index].parent != INVALID_NODE)
+    {
+        index = m_nodes[index].parent;
+    }
+    return m_nodes[index].isRoot;
+}
+
+std::string WwiseHierarchyCache::BuildPath(uint32 index) const
+{
+    std::vector<uint32> chain;
+    for (uint32 node = index; node != INVALID_NODE; node = m_nodes[node].parent)
+    {
+        chain.push_back(node);
+    }
+
+    std::string path;
+    for (auto it = chain.rbegin(); it != chain.rend(); ++it)
+    {
+        path += '\\';
+        path += m_nodes[*it].name;
+    }
+    return path;
+}
+
+void WwiseHierarchyCache::Link(uint32 index, uint32 parent)
+{
+    Node &node = m_nodes[index];
+    node.parent = parent;
+    node.prevSibling = INVALID_NODE;
+    node.nextSibling = m_nodes[parent].firstChild;
+    if (node.nextSibling != INVALID_NODE)
+    {
+        m_nodes[node.nextSibling].prevSibling = index;
+    }
+    m_nodes[parent].firstChild = index;
+}
+
+void WwiseHierarchyCache::Unlink(uint32 index)
+{
+    Node &node = m_nodes[index];
+    if (node.parent == INVALID_NODE)
+    {
+        return;
+    }
+
+    if (node.prevSibling != INVALID_NODE)
+    {
+        m_nodes[node.prevSibling].nextSibling = node.nextSibling;
+    }
+    else
+    {
+        m_nodes[node.parent].firstChild = node.nextSibling;
+    }
+
+    if (node.nextSibling != INVALID_NODE)
+    {
+        m_nodes[node.nextSibling].prevSibling = node.prevSibling;
+    }
+
+    node.parent = INVALID_NODE;
+    node.prevSibling = INVALID_NODE;
+    node.nextSibling = INVALID_NODE;
+}
+
+void WwiseHierarchyCache::IndexSubtree(uint32 index, bool add)
+{
+    std::vector<uint32> stack{ index };
+    while (!stack.empty())
+    {
+        const uint32 node = stack.back();
+        stack.pop_back();
+
+        const std::string path = BuildPath(node);
+        if (add)
+        {
+            m_pathIndex[path] = node;
+        }
+        else
+        {
+            auto found = m_pathIndex.find(path);
+            if (found != m_pathIndex.end() && found->second == node)
+            {
+                m_pathIndex.erase(found);
+            }
+        }
+
+        for (uint32 child = m_nodes[node].firstChild; child != INVALID_NODE; child = m_nodes[child].nextSibling)
+        {
+            stack.push_back(child);
+        }
+    }
+}
+
+void WwiseHierarchyCache::RemoveSubtree(uint32 index)
+{
+    if (IsAttached(index))
+    {
+        IndexSubtree(index, false);
+    }
+    Unlink(index);
+
+    std::vector<uint32> stack{ index };
+    while (!stack.empty())
+    {
+        const uint32 node = stack.back();
+        stack.pop_back();
+
+        for (uint32 child = m_nodes[node].firstChild; child != INVALID_NODE; child = m_nodes[child].nextSibling)
+        {
+            stack.push_back(child);
+        }
+
+        m_guidIndex.erase(m_nodes[node].guid);
+        m_nodes[node] = Node();
+        m_freeNodes.push_back(node);
+    }
+}
+
+uint32 WwiseHierarchyCache::AddObject(const ObjectFields &fields, uint32 parent)
+{
+    const uint32 index = AllocNode();
+    Node &node = m_nodes[index];
+    node.guid = fields.guid;
+    node.name = fields.name;
+    node.type = fields.type;
+    m_guidIndex[fields.guid] = index;
+
+    if (parent != INVALID_NODE)
+    {
+        Link(index, parent);
+    }
+    return index;
+}
+
+void WwiseHierarchyCache::Clear()
+{
+    m_nodes.clear();
+    m_freeNodes.clear();
+    m_guidIndex.clear();
+    m_pathIndex.clear();
+    m_pendingEvents.clear();
+    m_loading = false;
+}
+
+void WwiseHierarchyCache::OnEvent(const char *topic, const AK::WwiseAuthoringAPI::AkJson &event)
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_loading)
+        {
+            m_pendingEvents.push_back(PendingEvent{ topic, event });
+            return;
+        }
+
+        if (!ApplyEvent(topic, event))
+        {
+            return;
+        }
+    }
+
+    ++m_revision;
+
+    std::function<void()> callback;
+    {
+        std::lock_guard<std::mutex> lock(m_callbackMutex);
+        callback = m_changedCallback;
+    }
+    if (callback)
+    {
+        callback();
+    }
+}
+
+bool WwiseHierarchyCache::ReadFields(const AK::WwiseAuthoringAPI::AkJson &object, ObjectFields &fieldsOut)
+{
+    fieldsOut.guid = GetJsonString(object, "id");
+    fieldsOut.name = GetJsonString(object, "name");
+    fieldsOut.type = GetJsonString(object, "type");
+    if (object.IsMap() && object.HasKey("parent"))
+    {
+        fieldsOut.parentGuid = GetJsonString(object["parent"], "id");
+        fieldsOut.parentName = GetJsonString(object["parent"], "name");
+    }
+    return !fieldsOut.guid.empty();
+}
+
+bool WwiseHierarchyCache::ApplyEvent(const char *topic, const AK::WwiseAuthoringAPI::AkJson &event)
+{
+    using namespace AK::WwiseAuthoringAPI;
+
+    if (!event.IsMap())
+    {
+        return false;
+    }
+
+    const std::string uri(topic);
+
+    //{ object }
+    if (uri == ak::wwise::core::object::created || uri == ak::wwise::core::object::preDeleted)
+    {
+        ObjectFields fields;
+        if (!event.HasKey("object") || !ReadFields(event["object"], fields))
+        {
+            return false;
+        }
+
+        const uint32 existing = FindNode(fields.guid);
+        if (uri == ak::wwise::core::object::preDeleted)
+        {
+            if (existing == INVALID_NODE)
+            {
+                return false;
+            }
+            RemoveSubtree(existing);
+            return true;
+        }
+
+        //only objects created inside a mirrored hierarchy, the childAdded that follows links anything else
+        const uint32 parent = FindNode(fields.parentGuid);
+        if (existing != INVALID_NODE || parent == INVALID_NODE || !IsAttached(parent))
+        {
+            return false;
+        }
+
+        IndexSubtree(AddObject(fields, parent), true);
+        return true;
+    }
+
+    //{ object, newName, oldName }
+    if (uri == ak::wwise::core::object::nameChanged)
+    {
+        ObjectFields fields;
+        if (!event.HasKey("object") || !ReadFields(event["object"], fields))
+        {
+            return false;
+        }
+
+        const uint32 index = FindNode(fields.guid);
+        if (index == INVALID_NODE)
+        {
+            return false;
+        }
+
+        std::string newName = GetJsonString(event, "newName");
+        if (newName.empty())
+        {
+            newName = fields.name;
+        }
+
+        const bool attached = IsAttached(index);
+        if (attached)
+        {
+            IndexSubtree(index, false);
+        }
+        m_nodes[index].name = newName;
+        if (attached)
+        {
+            IndexSubtree(index, true);
+        }
+        return true;
+    }
+
+    //{ parent, child }
+    ObjectFields parentFields;
+    ObjectFields childFields;
+    if (!event.HasKey("parent") || !event.HasKey("child") ||
+        !ReadFields(event["parent"], parentFields) || !ReadFields(event["child"], childFields))
+    {
+        return false;
+    }
+
+    const uint32 parent = FindNode(parentFields.guid);
+    const uint32 child = FindNode(childFields.guid);
+
+    if (uri == ak::wwise::core::object::childRemoved)
+    {
+        if (child == INVALID_NODE || parent == INVALID_NODE || m_nodes[child].parent != parent)
+        {
+            return false;
+        }
+
+        //kept detached, a move is a childRemoved followed by a childAdded and the subtree comes back with it
+        if (IsAttached(child))
+        {
+            IndexSubtree(child, false);
+        }
+        Unlink(child);
+        return true;
+    }
+
+    if (uri == ak::wwise::core::object::childAdded)
+    {
+        if (parent == INVALID_NODE || !IsAttached(parent))
+        {
+            //moved somewhere that isn't mirrored
+            if (child != INVALID_NODE)
+            {
+                RemoveSubtree(child);
+                return true;
+            }
+            return false;
+        }
+
+        if (child == INVALID_NODE)
+        {
+            IndexSubtree(AddObject(childFields, parent), true);
+            return true;
+        }
+
+        if (m_nodes[child].parent == parent)
+        {
+            return false;
+        }
+
+        if (IsAttached(child))
+        {
+            IndexSubtree(child, false);
+        }
+        Unlink(child);
+        Link(child, parent);
+        IndexSubtree(child, true);
+        return true;
+    }
+
+    return false;
+}
@@ -0,0 +1,136 @@
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include <AK/WwiseAuthoringAPI/AkAutobahn/Client.h>
+
+#include "types.h"
+
+//Local mirror of the Actor-Mixer and Interactive Music hierarchies
+//Loaded with one object.get over both hierarchies and kept current from the object created, preDeleted,
+//nameChanged, childAdded and childRemoved notifications, so parent validation and path display don't
+//need a WAAPI call per object and renames/moves in Wwise show up without re-adding anything.
+//Nodes are stored in one vector linked by index, paths are built from the parent chain on demand and
+//indexed for lookups by path.
+//Notifications arrive on the event dispatcher's worker threads, every member is thread safe.
+class WwiseHierarchyCache
+{
+public:
+    struct ObjectInfo
+    {
+        std::string guid;
+        std::string name;
+        std::string type;
+        std::string path;
+        std::string parentGuid;
+    };
+
+    ~WwiseHierarchyCache();
+
+    //loads both hierarchies and subscribes to changes, replacing anything loaded before. Each call gives up
+    //after timeoutMs (-1 waits forever)
+    bool Load(AK::WwiseAuthoringAPI::Client &client, int timeoutMs = -1);
+
+    //Load on a thread of its own so a big project doesn't hold up the caller, onLoaded(success) is called on
+    //that thread when it's done. Waits for a previous load to finish first, the destructor waits too.
+    void LoadAsync(AK::WwiseAuthoringAPI::Client &client, int timeoutMs, std::function<void(bool)> onLoaded);
+
+    bool IsLoading() const { return m_asyncLoading; }
+
+    //unsubscribes and drops the mirror, the client has to still be alive
+    void Unload();
+
+    bool IsLoaded() const { return m_loaded; }
+
+    //if the object is in one of the mirrored hierarchies
+    bool Contains(const std::string &guid) const;
+
+    bool GetObjectInfo(const std::string &guid, ObjectInfo &infoOut) const;
+    bool FindByPath(const std::string &path, std::string &guidOut) const;
+
+    size_t GetNumObjects() const;
+
+    //incremented by every applied change
+    uint64_t GetRevision() const { return m_revision; }
+
+    //called on a worker thread after a change was applied, keep it short (post a message)
+    void SetChangedCallback(std::function<void()> callback);
+
+private:
+    static constexpr uint32 INVALID_NODE = ~0u;
+
+    struct Node
+    {
+        std::string guid;
+        std::string name;
+        std::string type;
+
+        uint32 parent = INVALID_NODE;
+        uint32 firstChild = INVALID_NODE;
+        uint32 prevSibling = INVALID_NODE;
+        uint32 nextSibling = INVALID_NODE;
+
+        //hierarchy roots have no parent, other parentless nodes were moved out and are waiting for a childAdded
+        bool isRoot = false;
+    };
+
+    struct ObjectFields
+    {
+        std::string guid;
+        std::string name;
+        std::string type;
+        std::string parentGuid;
+        std::string parentName;
+    };
+
+    struct PendingEvent
+    {
+        const char *topic;
+        AK::WwiseAuthoringAPI::AkJson json;
+    };
+
+    //all below with m_mutex held
+    uint32 AllocNode();
+    uint32 FindNode(const std::string &guid) const;
+    bool IsAttached(uint32 index) const;
+    std::string BuildPath(uint32 index) const;
+    void Link(uint32 index, uint32 parent);
+    void Unlink(uint32 index);
+    void IndexSubtree(uint32 index, bool add);
+    void RemoveSubtree(uint32 index);
+    uint32 AddObject(const ObjectFields &fields, uint32 parent);
+    void Clear();
+
+    //notification handlers
+    void OnEvent(const char *topic, const AK::WwiseAuthoringAPI::AkJson &event);
+    static bool ReadFields(const AK::WwiseAuthoringAPI::AkJson &object, ObjectFields &fieldsOut);
+    bool ApplyEvent(const char *topic, const AK::WwiseAuthoringAPI::AkJson &event);
+
+    mutable std::mutex m_mutex;
+    std::vector<Node> m_nodes;
+    std::vector<uint32> m_freeNodes;
+    std::unordered_map<std::string, uint32> m_guidIndex;
+    std::unordered_map<std::string, uint32> m_pathIndex;
+
+    //notifications received while Load's object.get is in flight
+    bool m_loading = false;
+    std::vector<PendingEvent> m_pendingEvents;
+
+    std::atomic<bool> m_loaded{ false };
+    std::atomic<uint64_t> m_revision{ 0 };
+
+    AK::WwiseAuthoringAPI::Client *m_client = nullptr;
+    std::vector<uint64_t> m_subscriptions;
+
+    std::mutex m_callbackMutex;
+    std::function<void()> m_changedCallback;
+
+    std::thread m_loadThread;
+    std::atomic<bool> m_asyncLoading{ false };
+};
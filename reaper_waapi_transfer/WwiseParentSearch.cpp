@@ -0,0 +1,224 @@
+#include "WwiseParentSearch.h"
+
+#include <algorithm>
+
+#include "config.h"
+
+WwiseParentSearch::WwiseParentSearch(SearchFunction search, ResultsCallback onResults)
+    : m_search(std::move(search))
+    , m_onResults(std::move(onResults))
+{
+}
+
+WwiseParentSearch::~WwiseParentSearch()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_exit = true;
+        if (m_runningToken)
+        {
+            m_runningToken->Cancel();
+        }
+    }
+    m_wake.notify_all();
+
+    if (m_worker.joinable())
+    {
+        m_worker.join();
+    }
+}
+
+bool WwiseParentSearch::SetQuery(const std::string &text, uint64_t hierarchyRevision)
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_query = text;
+    m_revision = hierarchyRevision;
+    m_queryTime = std::chrono::steady_clock::now();
+    m_hasPending = false;
+
+    //whatever is running was for an older query
+    if (m_runningToken)
+    {
+        m_runningToken->Cancel();
+    }
+
+    if (text.size() < WWISE_SEARCH_MIN_CHARS)
+    {
+        m_results = std::make_shared<const Results>();
+        return true;
+    }
+
+    m_results = FindCached(text, hierarchyRevision);
+    if (m_results)
+    {
+        return true;
+    }
+
+    m_hasPending = true;
+    if (!m_worker.joinable())
+    {
+        m_worker = std::thread(&WwiseParentSearch::WorkerLoop, this);
+    }
+    lock.unlock();
+
+    m_wake.notify_one();
+    return false;
+}
+
+bool WwiseParentSearch::GetResults(std::shared_ptr<const Results> &resultsOut) const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    resultsOut = m_results;
+    return resultsOut != nullptr;
+}
+
+void WwiseParentSearch::ClearCache()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_cache.clear();
+    m_cacheIndex.clear();
+}
+
+void WwiseParentSearch::WorkerLoop()
+{
+    for (;;)
+    {
+        std::string query;
+        uint64_t revision;
+        std::shared_ptr<AK::WwiseAuthoringAPI::CancellationToken> token;
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_wake.wait(lock, [this] { return m_exit || m_hasPending; });
+
+            //every edit pushes the search back, until the text has been left alone for the debounce time
+            const std::chrono::milliseconds debounce(WWISE_SEARCH_DEBOUNCE_MS);
+            while (!m_exit && m_hasPending && std::chrono::steady_clock::now() < m_queryTime + debounce)
+            {
+                m_wake.wait_until(lock, m_queryTime + debounce);
+            }
+
+            if (m_exit)
+            {
+                return;
+            }
+            if (!m_hasPending)
+            {
+                continue;
+            }
+
+            query = m_query;
+            revision = m_revision;
+            m_hasPending = false;
+
+            token = std::make_shared<AK::WwiseAuthoringAPI::CancellationToken>();
+            m_runningToken = token;
+        }
+
+        Results results;
+        const bool success = RunQuery(query, *token, results);
+
+        bool current;
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_runningToken.reset();
+
+            if (success)
+            {
+                auto sharedResults = std::make_shared<const Results>(std::move(results));
+                AddCached(query, revision, sharedResults);
+
+                current = query == m_query && revision == m_revision;
+                if (current)
+                {
+                    m_results = sharedResults;
+                }
+            }
+            else
+            {
+                current = !token->IsCancelled() && query == m_query && revision == m_revision;
+            }
+        }
+
+        if (current && m_onResults)
+        {
+            m_onResults(success);
+        }
+    }
+}
+
+bool WwiseParentSearch::RunQuery(const std::string &query, const AK::WwiseAuthoringAPI::CancellationToken &token, Results &resultsOut)
+{
+    using namespace AK::WwiseAuthoringAPI;
+
+    CallScope scope(&token, WWISE_SEARCH_TIMEOUT_MS);
+
+    ResultView results;
+    AkJson error;
+    if (!m_search(query, results, error))
+    {
+        return false;
+    }
+
+    const rapidjson::Value &objects = results.GetObjects();
+    resultsOut.reserve(objects.Size());
+    for (const rapidjson::Value &object : objects.GetArray())
+    {
+        Result result;
+        result.guid = ResultView::GetString(object, "id");
+        result.name = ResultView::GetString(object, "name");
+        result.type = ResultView::GetString(object, "type");
+        result.path = ResultView::GetString(object, "path");
+        resultsOut.push_back(std::move(result));
+    }
+
+    //shortest paths first, the containers nearest the top of the hierarchy are the likeliest targets
+    std::sort(resultsOut.begin(), resultsOut.end(), [](const Result &a, const Result &b)
+    {
+        return a.path.size() != b.path.size() ? a.path.size() < b.path.size() : a.path < b.path;
+    });
+
+    if (resultsOut.size() > WWISE_SEARCH_MAX_RESULTS)
+    {
+        resultsOut.resize(WWISE_SEARCH_MAX_RESULTS);
+    }
+    return true;
+}
+
+std::shared_ptr<const WwiseParentSearch::Results> WwiseParentSearch::FindCached(const std::string &query, uint64_t revision)
+{
+    auto found = m_cacheIndex.find(query);
+    if (found == m_cacheIndex.end())
+    {
+        return nullptr;
+    }
+
+    //something changed in wwise since, the results may be missing objects
+    if (found->second->revision != revision)
+    {
+        m_cache.erase(found->second);
+        m_cacheIndex.erase(found);
+        return nullptr;
+    }
+
+    m_cache.splice(m_cache.begin(), m_cache, found->second);
+    return m_cache.front().results;
+}
+
+void WwiseParentSearch::AddCached(const std::string &query, uint64_t revision, std::shared_ptr<const Results> results)
+{
+    auto found = m_cacheIndex.find(query);
+    if (found != m_cacheIndex.end())
+    {
+        m_cache.erase(found->second);
+        m_cacheIndex.erase(found);
+    }
+
+    m_cache.push_front(CacheEntry{ query, revision, std::move(results) });
+    m_cacheIndex[query] = m_cache.begin();
+
+    if (m_cache.size() > WWISE_SEARCH_CACHE_SIZE)
+    {
+        m_cacheIndex.erase(m_cache.back().query);
+        m_cache.pop_back();
+    }
+}
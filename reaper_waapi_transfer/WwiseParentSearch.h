@@ -0,0 +1,100 @@
+#pragma once
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include <AK/WwiseAuthoringAPI/AkAutobahn/Client.h>
+#include "CallScope.h"
+#include "ResultView.h"
+
+#include "types.h"
+
+//Type-ahead search for import parents by name, run in Wwise (object.get from search, filtered to parent container types)
+//Edits are debounced on the worker thread, only the last query typed is sent. A query still running when the next one
+//is sent is cancelled. Results are kept in a small LRU cache keyed on the query text, so going back to a previous
+//query (backspace) shows its results straight away without a call.
+class WwiseParentSearch
+{
+public:
+    struct Result
+    {
+        std::string guid;
+        std::string name;
+        std::string type;
+        std::string path;
+    };
+    typedef std::vector<Result> Results;
+
+    //runs a query on the worker thread, see SearchParentContainers
+    typedef std::function<bool(const std::string &query, AK::WwiseAuthoringAPI::ResultView &resultsOut,
+                               AK::WwiseAuthoringAPI::AkJson &errorOut)> SearchFunction;
+
+    //called on the worker thread when the current query's results are in or it failed, keep it short (post a message)
+    typedef std::function<void(bool success)> ResultsCallback;
+
+    WwiseParentSearch(SearchFunction search, ResultsCallback onResults);
+    ~WwiseParentSearch();
+
+    WwiseParentSearch(const WwiseParentSearch&) = delete;
+    WwiseParentSearch &operator=(const WwiseParentSearch&) = delete;
+
+    //main thread, on every edit of the search text
+    //cached results are valid while the hierarchy revision is unchanged (see WwiseHierarchyCache::GetRevision)
+    //returns true if the results for text are available from GetResults right away, otherwise they're searched for
+    //once the text hasn't changed for WWISE_SEARCH_DEBOUNCE_MS
+    bool SetQuery(const std::string &text, uint64_t hierarchyRevision);
+
+    //main thread, results of the current query, false if they aren't in yet
+    bool GetResults(std::shared_ptr<const Results> &resultsOut) const;
+
+    //drop everything cached, for a new connection
+    void ClearCache();
+
+private:
+    struct CacheEntry
+    {
+        std::string query;
+        uint64_t revision;
+        std::shared_ptr<const Results> results;
+    };
+    typedef std::list<CacheEntry> CacheList;
+
+    void WorkerLoop();
+    bool RunQuery(const std::string &query, const AK::WwiseAuthoringAPI::CancellationToken &token, Results &resultsOut);
+
+    //with m_mutex held
+    std::shared_ptr<const Results> FindCached(const std::string &query, uint64_t revision);
+    void AddCached(const std::string &query, uint64_t revision, std::shared_ptr<const Results> results);
+
+    const SearchFunction m_search;
+    const ResultsCallback m_onResults;
+
+    mutable std::mutex m_mutex;
+    std::condition_variable m_wake;
+    std::thread m_worker;
+    bool m_exit = false;
+
+    //what the user typed last, the revision it was typed at and when
+    std::string m_query;
+    uint64_t m_revision = 0;
+    std::chrono::steady_clock::time_point m_queryTime;
+    std::shared_ptr<const Results> m_results;
+
+    //m_query has no results yet, cleared when the worker picks it up
+    bool m_hasPending = false;
+
+    //token of the query the worker is running, cancelled when it's superseded
+    std::shared_ptr<AK::WwiseAuthoringAPI::CancellationToken> m_runningToken;
+
+    //most recently used at the front
+    CacheList m_cache;
+    std::unordered_map<std::string, CacheList::iterator> m_cacheIndex;
+};
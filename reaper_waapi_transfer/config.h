@@ -13,6 +13,65 @@ const std::string RENDER_QUEUE_BACKUP_APPEND = ".wpbak";
 
 constexpr uint32 WAAPI_IMPORT_BATCH_SIZE = 10;
 constexpr int WAAPI_DEFAULT_PORT = 8080;
+//an import batch that takes longer than this is abandoned, its items are reported as failed
+constexpr int WAAPI_IMPORT_BATCH_TIMEOUT_MS = 5 * 60 * 1000;
+
+//wwise parent search box, queries are sent once typing pauses for the debounce time
+constexpr uint32 WWISE_SEARCH_DEBOUNCE_MS = 250;
+constexpr size_t WWISE_SEARCH_MIN_CHARS = 2;
+constexpr size_t WWISE_SEARCH_MAX_RESULTS = 200;
+constexpr size_t WWISE_SEARCH_CACHE_SIZE = 64;
+constexpr int WWISE_SEARCH_TIMEOUT_MS = 10 * 1000;
+
+//the hierarchy mirror loads in the background after connecting, a project that takes longer isn't mirrored
+constexpr int WWISE_HIERARCHY_LOAD_TIMEOUT_MS = 60 * 1000;
+
+//mapping rule automaton, built DFA states are dropped past the first limit and the conflict search gives up at the second
+constexpr size_t RULE_AUTOMATON_MAX_STATES = 16384;
+constexpr size_t RULE_CONFLICT_SEARCH_MAX_STATES = 65536;
+
+//transfer time prediction, defaults are used until a project has some history
+constexpr double TRANSFER_DEFAULT_RENDER_RATIO = 0.1;
+constexpr double TRANSFER_DEFAULT_IMPORT_SECONDS_PER_ITEM = 0.05;
+constexpr double TRANSFER_HISTORY_SMOOTHING = 0.3;
+
+//projects kept in the history file, the ones transferred longest ago are dropped
+constexpr size_t TRANSFER_HISTORY_MAX_PROJECTS = 256;
+
+const std::string TRANSFER_HISTORY_FILENAME = "history.txt";
+const std::string TRANSFER_LOG_FILENAME = "transfer.log";
+
+//wwise ids of imported render items, one file per reaper project in this sub directory of the transfer data dir
+const std::string IMPORT_ID_INDEX_DIRNAME = "import_ids";
+const std::string IMPORT_ID_INDEX_EXTENSION = ".ids";
+
+//region content hashes from the last successful transfer of each reaper project, see RegionHashes.h
+const std::string REGION_HASH_DIRNAME = "region_hashes";
+const std::string REGION_HASH_EXTENSION = ".regions";
+
+//render item to wwise parent rules in the transfer data dir (see TransferMapping.h), conflicts found in them are
+//written to the report next to it
+const std::string TRANSFER_MAPPING_FILENAME = "mapping.json";
+const std::string TRANSFER_MAPPING_REPORT_FILENAME = "mapping_conflicts.txt";
+
+//limits rendered files have to stay in to be imported (see AudioAnalysis.h), the analysis only runs when the spec
+//file is in the transfer data dir. The levels of every analysed file are written to the report after each transfer
+const std::string LOUDNESS_SPEC_FILENAME = "loudness_spec.json";
+const std::string LOUDNESS_REPORT_FILENAME = "loudness_report.json";
+
+//chrome trace files written by the "write trace" action, a timestamp is appended
+const std::string TRACE_FILENAME_PREFIX = "trace_";
+
+//per uri waapi call metrics, rewritten after every transfer and by the metrics report action
+const std::string WAAPI_METRICS_FILENAME = "waapi_metrics.json";
+
+//wamp session captures written by the capture action, replay them with tools/waapi_replay_server
+const std::string WAAPI_CAPTURE_FILENAME_PREFIX = "capture_";
+
+//wamp client log, rotated once it reaches WAAPI_LOG_MAX_BYTES
+const std::string WAAPI_LOG_FILENAME = "waapi.log";
+constexpr size_t WAAPI_LOG_MAX_BYTES = 1024 * 1024;
+constexpr int WAAPI_LOG_NUM_BACKUPS = 3;
 
 // TODO: CMake ?
 #define WT_VERSION 0x00010A
@@ -21,7 +80,7 @@ constexpr int WAAPI_DEFAULT_PORT = 8080;
 #define WT_VERSION_MINOR ((WT_VERSION & 0x00FF00) >> 8)
 #define WT_VERSION_INCREMENTAL (WT_VERSION & 0x0000FF)
 
-static const char *WwiseLanguages[] =
+inline constexpr const char *WwiseLanguages[] =
 {
     "English(US)",
     "English(UK)",
@@ -3,6 +3,7 @@
 #include <unordered_map>
 #include <unordered_set>
 #include <string>
+#include <vector>
 #include <assert.h>
 
 using uint32 = std::uint32_t;
@@ -26,18 +27,31 @@ using int16 = std::int16_t;
 		#undef FILESYSTEM_EXPERIMENTAL
 		#define FILESYSTEM_EXPERIMENTAL (1)
 	#endif
+#elif defined(__has_include)
+	//gcc/clang, used by the command line tools
+	#if __has_include(<filesystem>) && __cplusplus >= 201703L
+		#undef FILESYSTEM_NATIVE
+		#define FILESYSTEM_NATIVE (1)
+	#elif __has_include(<experimental/filesystem>)
+		#undef FILESYSTEM_EXPERIMENTAL
+		#define FILESYSTEM_EXPERIMENTAL (1)
+	#endif
 #endif
 
 
 #if FILESYSTEM_EXPERIMENTAL
-	#include <filesystem>
+	#ifdef _MSC_VER
+		#include <filesystem>
+	#else
+		#include <experimental/filesystem>
+	#endif
 	namespace fs = std::experimental::filesystem;
 #elif FILESYSTEM_NATIVE
 	#include <filesystem> 
 	namespace fs = std::filesystem;
 #elif FILESYSTEM_BOOST
 	namespace fs = boost::filesystem;
-#elif
+#else
 	#error Could not find a std::filesystem implementation!
 #endif
 
@@ -92,8 +106,15 @@ struct RenderItem
     int reaperRegionId;
     int regionMatrixOffset;
 
+    //name of the region rendered, empty for custom bounds
+    std::string regionName;
+
     //optional based on flags
     std::string trackStemGuid;
+    std::string trackName;
+
+    //names of the reaper folder tracks the stem's track is in, outermost first
+    std::vector<std::string> trackFolders;
     double inTime, outTime;
 };
 
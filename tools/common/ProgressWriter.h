@@ -0,0 +1,46 @@
+#pragma once
+#include <chrono>
+#include <cstdio>
+#include <mutex>
+
+#include <rapidjson/writer.h>
+#include <rapidjson/stringbuffer.h>
+
+using JsonWriter = rapidjson::Writer<rapidjson::StringBuffer>;
+
+//One JSON object per line on stdout, safe to call from any thread. Every line has the event name and the seconds
+//since the writer was made, writeFields adds the rest.
+//Shared by the command line tools so build machines can read their output the same way.
+class ProgressWriter
+{
+public:
+    ProgressWriter() : m_start(std::chrono::steady_clock::now()) {}
+
+    template <typename F>
+    void Emit(const char *event, F &&writeFields)
+    {
+        rapidjson::StringBuffer buffer;
+        JsonWriter writer(buffer);
+        writer.StartObject();
+        writer.Key("event");
+        writer.String(event);
+        writer.Key("time");
+        writer.Double(GetElapsedSeconds());
+        writeFields(writer);
+        writer.EndObject();
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+        fputs(buffer.GetString(), stdout);
+        fputc('\n', stdout);
+        fflush(stdout);
+    }
+
+    double GetElapsedSeconds() const
+    {
+        return std::chrono::duration<double>(std::chrono::steady_clock::now() - m_start).count();
+    }
+
+private:
+    std::mutex m_mutex;
+    std::chrono::steady_clock::time_point m_start;
+};
@@ -0,0 +1,67 @@
+#include "TimerQueue.h"
+
+TimerQueue::TimerQueue()
+    : m_thread(&TimerQueue::Run, this)
+{
+}
+
+TimerQueue::~TimerQueue()
+{
+    Stop();
+}
+
+void TimerQueue::Post(Clock::time_point due, std::function<void()> task)
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (!m_running)
+        {
+            return;
+        }
+        m_tasks.emplace(due, std::move(task));
+    }
+    m_condition.notify_one();
+}
+
+void TimerQueue::Stop()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_running = false;
+        m_tasks.clear();
+    }
+    m_condition.notify_all();
+
+    if (m_thread.joinable())
+    {
+        m_thread.join();
+    }
+}
+
+void TimerQueue::Run()
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+    while (m_running)
+    {
+        if (m_tasks.empty())
+        {
+            m_condition.wait(lock);
+            continue;
+        }
+
+        auto next = m_tasks.begin();
+        if (next->first > Clock::now())
+        {
+            //woken early if a task with an earlier due time is posted
+            m_condition.wait_until(lock, next->first);
+            continue;
+        }
+
+        std::function<void()> task = std::move(next->second);
+        m_tasks.erase(next);
+
+        lock.unlock();
+        task();
+        lock.lock();
+    }
+}
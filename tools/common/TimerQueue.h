@@ -0,0 +1,35 @@
+#pragma once
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <thread>
+
+//Runs tasks on one background thread once their due time passes, in due time order.
+//Used by the local servers to hold responses back for their simulated or recorded latency.
+class TimerQueue
+{
+public:
+    using Clock = std::chrono::steady_clock;
+
+    TimerQueue();
+    ~TimerQueue();
+
+    TimerQueue(const TimerQueue&) = delete;
+    TimerQueue &operator=(const TimerQueue&) = delete;
+
+    void Post(Clock::time_point due, std::function<void()> task);
+
+    //drops the tasks that haven't run yet and joins the thread
+    void Stop();
+
+private:
+    void Run();
+
+    std::mutex m_mutex;
+    std::condition_variable m_condition;
+    std::multimap<Clock::time_point, std::function<void()>> m_tasks;
+    bool m_running = true;
+    std::thread m_thread;
+};
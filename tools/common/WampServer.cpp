@@ -0,0 +1,392 @@
+#include <cstring>
+
+#include <rapidjson/writer.h>
+#include <rapidjson/stringbuffer.h>
+
+#include <AK/WwiseAuthoringAPI/AkAutobahn/civetweb.h>
+
+#include "WampServer.h"
+
+//https://wamp-proto.org/_static/gen/wamp_latest.html#message-codes-and-direction
+enum WampMessageCode
+{
+    WampHello = 1,
+    WampWelcome = 2,
+    WampGoodbye = 6,
+    WampError = 8,
+    WampSubscribe = 32,
+    WampSubscribed = 33,
+    WampUnsubscribe = 34,
+    WampUnsubscribed = 35,
+    WampCall = 48,
+    WampResult = 50
+};
+
+using JsonWriter = rapidjson::Writer<rapidjson::StringBuffer>;
+
+static const rapidjson::Value &GetEmptyObject()
+{
+    static const rapidjson::Value s_emptyObject(rapidjson::kObjectType);
+    return s_emptyObject;
+}
+
+static bool GetRequestId(const rapidjson::Value &message, rapidjson::SizeType index, uint64_t &requestIdOut)
+{
+    if (message.Size() <= index || !message[index].IsUint64())
+    {
+        return false;
+    }
+    requestIdOut = message[index].GetUint64();
+    return true;
+}
+
+const rapidjson::Value &WampServer::Call::GetArgs() const
+{
+    //[CALL, Request|id, Options|dict, Procedure|uri, Arguments|list, ArgumentsKw|dict]
+    if (message.Size() > 5 && message[5].IsObject())
+    {
+        return message[5];
+    }
+    return GetEmptyObject();
+}
+
+const rapidjson::Value &WampServer::Call::GetOptions() const
+{
+    if (message.Size() > 2 && message[2].IsObject())
+    {
+        return message[2];
+    }
+    return GetEmptyObject();
+}
+
+WampServer::~WampServer()
+{
+    Stop();
+}
+
+bool WampServer::Start(uint32_t port, uint32_t numThreads, std::string &errorOut)
+{
+    if (m_context)
+    {
+        errorOut = "already started";
+        return false;
+    }
+
+    const std::string portString = std::to_string(port);
+    const std::string threadsString = std::to_string(numThreads ? numThreads : 1);
+
+    //civetweb closes idle websockets after websocket_timeout_ms, wwise doesn't so keep them for a day
+    //frames go out as a header and a payload, with Nagle on every reply would wait on the client's delayed ACK
+    const char *options[] = {
+        "listening_ports", portString.c_str(),
+        "num_threads", threadsString.c_str(),
+        "websocket_timeout_ms", "86400000",
+        "tcp_nodelay", "1",
+        nullptr
+    };
+
+    mg_callbacks callbacks;
+    memset(&callbacks, 0, sizeof(callbacks));
+
+    m_context = mg_start(&callbacks, this, options);
+    if (!m_context)
+    {
+        errorOut = "couldn't listen on port " + portString;
+        return false;
+    }
+
+    mg_set_websocket_handler(m_context, "/waapi",
+                             &WampServer::OnWebsocketConnect,
+                             &WampServer::OnWebsocketReady,
+                             &WampServer::OnWebsocketData,
+                             &WampServer::OnWebsocketClose,
+                             this);
+    return true;
+}
+
+void WampServer::Stop()
+{
+    if (m_context)
+    {
+        //joins the connection threads, every close handler has run once this returns
+        mg_stop(m_context);
+        m_context = nullptr;
+    }
+}
+
+size_t WampServer::GetNumConnections() const
+{
+    std::lock_guard<std::mutex> lock(m_connectionsMutex);
+    return m_connections.size();
+}
+
+int WampServer::OnWebsocketConnect(const mg_connection *, void *)
+{
+    //accept everything, there is no subprotocol negotiation in AkAutobahn
+    return 0;
+}
+
+void WampServer::OnWebsocketReady(mg_connection *conn, void *userData)
+{
+    WampServer *server = static_cast<WampServer*>(userData);
+
+    std::unique_ptr<Connection> connection(new Connection());
+    connection->id = server->m_nextConnectionId++;
+    connection->conn = conn;
+    mg_set_user_connection_data(conn, connection.get());
+
+    const ConnectionId id = connection->id;
+    {
+        std::lock_guard<std::mutex> lock(server->m_connectionsMutex);
+        server->m_connections.emplace(id, std::move(connection));
+    }
+
+    if (server->m_connectionHandler)
+    {
+        server->m_connectionHandler(id, true);
+    }
+}
+
+int WampServer::OnWebsocketData(mg_connection *conn, int bits, char *data, size_t dataLen, void *userData)
+{
+    WampServer *server = static_cast<WampServer*>(userData);
+    Connection *connection = static_cast<Connection*>(mg_get_user_connection_data(conn));
+    if (!connection)
+    {
+        return 0;
+    }
+
+    const int opcode = bits & 0x0F;
+    const bool isFinal = (bits & 0x80) != 0;
+
+    switch (opcode)
+    {
+    case WEBSOCKET_OPCODE_CONNECTION_CLOSE:
+        return 0;
+
+    case WEBSOCKET_OPCODE_PING:
+        mg_websocket_write(conn, WEBSOCKET_OPCODE_PONG, data, dataLen);
+        return 1;
+
+    case WEBSOCKET_OPCODE_PONG:
+        return 1;
+
+    case WEBSOCKET_OPCODE_TEXT:
+    case WEBSOCKET_OPCODE_BINARY:
+    case WEBSOCKET_OPCODE_CONTINUATION:
+    {
+        if (isFinal && connection->fragments.empty())
+        {
+            return server->HandleMessage(*connection, data, dataLen) ? 1 : 0;
+        }
+
+        connection->fragments.append(data, dataLen);
+        if (!isFinal)
+        {
+            return 1;
+        }
+
+        std::string message;
+        message.swap(connection->fragments);
+        return server->HandleMessage(*connection, message.data(), message.size()) ? 1 : 0;
+    }
+
+    default:
+        return 1;
+    }
+}
+
+void WampServer::OnWebsocketClose(const mg_connection *conn, void *userData)
+{
+    WampServer *server = static_cast<WampServer*>(userData);
+    Connection *connection = static_cast<Connection*>(mg_get_user_connection_data(conn));
+    if (!connection)
+    {
+        return;
+    }
+
+    const ConnectionId id = connection->id;
+    {
+        std::lock_guard<std::mutex> lock(server->m_connectionsMutex);
+        server->m_connections.erase(id);
+    }
+
+    if (server->m_connectionHandler)
+    {
+        server->m_connectionHandler(id, false);
+    }
+}
+
+bool WampServer::HandleMessage(Connection &connection, const char *data, size_t dataLen)
+{
+    std::unique_ptr<Call> call(new Call());
+    rapidjson::Document &message = call->message;
+    message.Parse(data, dataLen);
+
+    if (message.HasParseError() || !message.IsArray() || message.Empty() || !message[0].IsInt())
+    {
+        //not WAMP, ignore it like a router would
+        return true;
+    }
+
+    rapidjson::StringBuffer buffer;
+    JsonWriter writer(buffer);
+    uint64_t requestId = 0;
+
+    switch (message[0].GetInt())
+    {
+    case WampHello:
+    {
+        //[WELCOME, Session|id, Details|dict]
+        writer.StartArray();
+        writer.Int(WampWelcome);
+        writer.Uint64(m_nextSessionId++);
+        writer.StartObject();
+        writer.Key("roles");
+        writer.StartObject();
+        writer.Key("broker");
+        writer.StartObject();
+        writer.EndObject();
+        writer.Key("dealer");
+        writer.StartObject();
+        writer.EndObject();
+        writer.EndObject();
+        writer.EndObject();
+        writer.EndArray();
+    } break;
+
+    case WampGoodbye:
+    {
+        //[GOODBYE, Details|dict, Reason|uri]
+        writer.StartArray();
+        writer.Int(WampGoodbye);
+        writer.StartObject();
+        writer.EndObject();
+        writer.String("wamp.close.goodbye_and_out");
+        writer.EndArray();
+    } break;
+
+    case WampSubscribe:
+    {
+        //[SUBSCRIBED, SUBSCRIBE.Request|id, Subscription|id]
+        if (!GetRequestId(message, 1, requestId))
+        {
+            return true;
+        }
+        writer.StartArray();
+        writer.Int(WampSubscribed);
+        writer.Uint64(requestId);
+        writer.Uint64(m_nextSubscriptionId++);
+        writer.EndArray();
+    } break;
+
+    case WampUnsubscribe:
+    {
+        //[UNSUBSCRIBED, UNSUBSCRIBE.Request|id]
+        if (!GetRequestId(message, 1, requestId))
+        {
+            return true;
+        }
+        writer.StartArray();
+        writer.Int(WampUnsubscribed);
+        writer.Uint64(requestId);
+        writer.EndArray();
+    } break;
+
+    case WampCall:
+    {
+        if (!GetRequestId(message, 1, requestId) || message.Size() < 4 || !message[3].IsString())
+        {
+            return true;
+        }
+
+        call->connection = connection.id;
+        call->requestId = requestId;
+        call->procedure = message[3].GetString();
+        call->messageBytes = dataLen;
+        call->received = std::chrono::steady_clock::now();
+
+        if (!m_callHandler)
+        {
+            rapidjson::Value kwargs(rapidjson::kObjectType);
+            SendError(connection.id, requestId, "wamp.error.no_such_procedure", kwargs);
+            return true;
+        }
+
+        return m_callHandler(std::move(call));
+    }
+
+    default:
+        return true;
+    }
+
+    return SendRaw(connection.id, std::string(buffer.GetString(), buffer.GetSize()));
+}
+
+bool WampServer::SendResult(ConnectionId connection, uint64_t requestId, const rapidjson::Value &kwargs)
+{
+    //[RESULT, CALL.Request|id, Details|dict, YIELD.Arguments|list, YIELD.ArgumentsKw|dict]
+    rapidjson::StringBuffer buffer;
+    JsonWriter writer(buffer);
+    writer.StartArray();
+    writer.Int(WampResult);
+    writer.Uint64(requestId);
+    writer.StartObject();
+    writer.EndObject();
+    writer.StartArray();
+    writer.EndArray();
+    kwargs.Accept(writer);
+    writer.EndArray();
+
+    return SendRaw(connection, std::string(buffer.GetString(), buffer.GetSize()));
+}
+
+bool WampServer::SendError(ConnectionId connection, uint64_t requestId, const char *errorUri, const rapidjson::Value &kwargs)
+{
+    //[ERROR, CALL, CALL.Request|id, Details|dict, Error|uri, Arguments|list, ArgumentsKw|dict]
+    rapidjson::StringBuffer buffer;
+    JsonWriter writer(buffer);
+    writer.StartArray();
+    writer.Int(WampError);
+    writer.Int(WampCall);
+    writer.Uint64(requestId);
+    writer.StartObject();
+    writer.EndObject();
+    writer.String(errorUri);
+    writer.StartArray();
+    writer.EndArray();
+    kwargs.Accept(writer);
+    writer.EndArray();
+
+    return SendRaw(connection, std::string(buffer.GetString(), buffer.GetSize()));
+}
+
+bool WampServer::Close(ConnectionId connection)
+{
+    std::lock_guard<std::mutex> lock(m_connectionsMutex);
+
+    auto found = m_connections.find(connection);
+    if (found == m_connections.end() || found->second->closed)
+    {
+        return false;
+    }
+
+    //1000, normal closure
+    const char closeStatus[] = { '\x03', '\xE8' };
+    mg_websocket_write(found->second->conn, WEBSOCKET_OPCODE_CONNECTION_CLOSE, closeStatus, sizeof(closeStatus));
+    found->second->closed = true;
+    return true;
+}
+
+bool WampServer::SendRaw(ConnectionId connection, const std::string &message)
+{
+    std::lock_guard<std::mutex> lock(m_connectionsMutex);
+
+    auto found = m_connections.find(connection);
+    if (found == m_connections.end() || found->second->closed)
+    {
+        return false;
+    }
+
+    return mg_websocket_write(found->second->conn, WEBSOCKET_OPCODE_TEXT, message.data(), message.size()) > 0;
+}
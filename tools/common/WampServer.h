@@ -0,0 +1,105 @@
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+#include <rapidjson/document.h>
+
+struct mg_context;
+struct mg_connection;
+
+//Just enough of WAMP over websocket (on the bundled civetweb) for AkAutobahn's Client to talk to a local tool:
+//HELLO/WELCOME, CALL/RESULT/ERROR, SUBSCRIBE/UNSUBSCRIBE (no events are ever published) and GOODBYE.
+//There is no router, every call goes to one handler which may answer from any thread.
+class WampServer
+{
+public:
+    using ConnectionId = uint64_t;
+
+    struct Call
+    {
+        ConnectionId connection = 0;
+        uint64_t requestId = 0;
+        std::string procedure;
+        size_t messageBytes = 0;
+        std::chrono::steady_clock::time_point received;
+
+        //whole CALL message, use GetArgs/GetOptions
+        rapidjson::Document message;
+
+        //ArgumentsKw, an empty object if the call had none
+        const rapidjson::Value &GetArgs() const;
+        const rapidjson::Value &GetOptions() const;
+    };
+
+    //called on the connection's civetweb thread, reply with SendResult/SendError now or later.
+    //return false to drop the connection without answering.
+    using CallHandler = std::function<bool(std::unique_ptr<Call>)>;
+
+    //connected is false when the connection has closed, called on the connection's civetweb thread
+    using ConnectionHandler = std::function<void(ConnectionId, bool connected)>;
+
+    WampServer() = default;
+    ~WampServer();
+
+    WampServer(const WampServer&) = delete;
+    WampServer &operator=(const WampServer&) = delete;
+
+    //set before Start
+    void SetCallHandler(CallHandler handler) { m_callHandler = std::move(handler); }
+    void SetConnectionHandler(ConnectionHandler handler) { m_connectionHandler = std::move(handler); }
+
+    //listens for websocket connections on /waapi, numThreads is the civetweb worker count (one per connection)
+    bool Start(uint32_t port, uint32_t numThreads, std::string &errorOut);
+    void Stop();
+
+    //thread safe, return false if the connection has gone
+    bool SendResult(ConnectionId connection, uint64_t requestId, const rapidjson::Value &kwargs);
+    bool SendError(ConnectionId connection, uint64_t requestId, const char *errorUri, const rapidjson::Value &kwargs);
+
+    //a whole serialized WAMP message, for tools that already have the json
+    bool SendRaw(ConnectionId connection, const std::string &message);
+
+    //sends a websocket close frame, nothing more is sent on the connection
+    bool Close(ConnectionId connection);
+
+    size_t GetNumConnections() const;
+
+private:
+    struct Connection
+    {
+        ConnectionId id = 0;
+        mg_connection *conn = nullptr;
+
+        //set by Close, the entry stays until civetweb reports the close
+        bool closed = false;
+
+        //continuation frames of a fragmented message, only touched on the connection's thread
+        std::string fragments;
+    };
+
+    static int OnWebsocketConnect(const mg_connection *conn, void *userData);
+    static void OnWebsocketReady(mg_connection *conn, void *userData);
+    static int OnWebsocketData(mg_connection *conn, int bits, char *data, size_t dataLen, void *userData);
+    static void OnWebsocketClose(const mg_connection *conn, void *userData);
+
+    bool HandleMessage(Connection &connection, const char *data, size_t dataLen);
+
+    mg_context *m_context = nullptr;
+
+    CallHandler m_callHandler;
+    ConnectionHandler m_connectionHandler;
+
+    //held while writing so a connection can't close under a send from another thread
+    mutable std::mutex m_connectionsMutex;
+    std::unordered_map<ConnectionId, std::unique_ptr<Connection>> m_connections;
+
+    std::atomic<ConnectionId> m_nextConnectionId{ 1 };
+    std::atomic<uint64_t> m_nextSessionId{ 1 };
+    std::atomic<uint64_t> m_nextSubscriptionId{ 1 };
+};
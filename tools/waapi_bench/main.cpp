@@ -0,0 +1,2176 @@
+//Benchmarks for the WAAPI client and the plugin's building blocks, kept out of waapi_transfer_cli so the tool the
+//build machines run only does transfers and keeps the normal allocator. Each bench prints its numbers to stdout as
+//one JSON object per line and exits with 1 if the results it checks come out wrong. The ones that talk to WAAPI are
+//meant to be run against waapi_mock_server.
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <condition_variable>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <fstream>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <rapidjson/document.h>
+
+#include <AK/WwiseAuthoringAPI/waapi.h>
+#include <AK/WwiseAuthoringAPI/AkAutobahn/Client.h>
+
+#include "AsyncLog.h"
+#include "AudioAnalysis.h"
+#include "CallScope.h"
+#include "EventDispatcher.h"
+#include "ImportIdIndex.h"
+#include "ImportPlan.h"
+#include "JSONHelpers.h"
+#include "PendingTable.h"
+#include "ProgressWriter.h"
+#include "ReceivePool.h"
+#include "RenderQueueParser.h"
+#include "RenderQueueWriter.h"
+#include "RenderViewChangeSet.h"
+#include "ResultView.h"
+#include "SendQueue.h"
+#include "Tracing.h"
+#include "WampMetrics.h"
+#include "WwiseHierarchyCache.h"
+#include "WwiseParentSearch.h"
+#include "config.h"
+#include "types.h"
+
+//allocations made on this thread, for the benches that count them. Per thread so counting is free of contention.
+//With glibc malloc itself is counted, so rapidjson's pool chunks and parse stacks are too, elsewhere only new is
+static thread_local uint64_t t_numAllocations = 0;
+
+#if defined(__GLIBC__)
+extern "C" void *__libc_malloc(size_t size);
+extern "C" void *__libc_calloc(size_t count, size_t size);
+extern "C" void *__libc_realloc(void *memory, size_t size);
+
+extern "C" void *malloc(size_t size)
+{
+    ++t_numAllocations;
+    return __libc_malloc(size);
+}
+
+extern "C" void *calloc(size_t count, size_t size)
+{
+    ++t_numAllocations;
+    return __libc_calloc(count, size);
+}
+
+extern "C" void *realloc(void *memory, size_t size)
+{
+    ++t_numAllocations;
+    return __libc_realloc(memory, size);
+}
+#else
+void *operator new(size_t size)
+{
+    ++t_numAllocations;
+    if (void *memory = std::malloc(size ? size : 1))
+    {
+        return memory;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void *memory) noexcept
+{
+    std::free(memory);
+}
+#endif
+
+enum ExitCode
+{
+    ExitSuccess = 0,
+    ExitBenchFailed = 1,
+    ExitBadArguments = 2,
+    ExitConnectionFailed = 3
+};
+
+struct BenchOptions
+{
+    //WAAPI the cancel, hierarchy and search benches connect to
+    std::string host = "127.0.0.1";
+    uint32 port = WAAPI_DEFAULT_PORT;
+
+    //threads the analysis bench analyses on at once
+    uint32 jobs = std::max(1u, std::thread::hardware_concurrency());
+
+    //serializes import calls of this many items, for timing the send path's serializer
+    uint32 serializeItems = 0;
+
+    //decodes an object.get result of this many objects, for timing ResultView against AkJson
+    uint32 resultViewObjects = 0;
+
+    //receives this many thousand small frames, and a thousandth as many large, for counting allocations
+    uint32 receiveFrames = 0;
+
+    //queues every track of a made up project for this many regions, for timing WriteQueuedRender
+    uint32 queueRegions = 0;
+
+    //analyses made up files this many seconds long, for timing AnalyzeWav
+    uint32 analysisSeconds = 0;
+
+    //completes requests on up to this many threads at once, for timing contention on the receive path
+    uint32 pendingThreads = 0;
+
+    //sends messages from 1, 4, 16... up to this many threads at once, for timing the send queue
+    uint32 sendThreads = 0;
+
+    //logs from 1 to this many threads at once, for timing AsyncLog against logging on the calling thread
+    uint32 logThreads = 0;
+
+    //indexes this many made up imports, for checking the lookups the import id index saves
+    uint32 importIds = 0;
+
+    //runs this many traced spans, for timing the tracing macros while off and on
+    uint32 traceSpans = 0;
+
+    //edits a render view of this many rows, for checking and timing RenderViewChangeSet
+    uint32 renderViewRows = 0;
+
+    //receives this many results among events for a slow handler, for timing head of line blocking
+    uint32 eventResults = 0;
+
+    //cancels this many calls to a slow WAAPI (waapi_mock_server --latency), for timing cancel to idle
+    uint32 cancelCalls = 0;
+
+    //loads the hierarchy mirror with this timeout in ms, for timing and checking WwiseHierarchyCache
+    uint32 hierarchyTimeoutMs = 0;
+
+    //types this many queries into the parent search, for timing WwiseParentSearch
+    uint32 searchQueries = 0;
+
+    bool UsesWaapi() const
+    {
+        return cancelCalls || hierarchyTimeoutMs || searchQueries;
+    }
+};
+
+static void PrintUsage()
+{
+    fprintf(stderr,
+            "usage: waapi_bench <bench>... [options]\n"
+            "\n"
+            "Each bench prints JSON lines to stdout, several given run one after another.\n"
+            "\n"
+            "Send and receive path:\n"
+            "  --serialize <n>       serialize a small call and import calls of up to n items for sending,\n"
+            "                        streamed and through a rapidjson document, exit code 1 if the texts\n"
+            "                        differ\n"
+            "  --result-view <n>     decode an object.get result of n objects with notes to AkJson and as a\n"
+            "                        ResultView, exit code 1 if they read differently\n"
+            "  --receive <n>         receive n thousand small frames and n large ones through the receive pool\n"
+            "                        and through a new string and document each, exit code 1 if they parse\n"
+            "                        differently\n"
+            "  --pending <n>         send and complete requests through the pending table and call metrics\n"
+            "                        on 1 to n threads, against a mutex and map\n"
+            "  --send <n>            push messages to a session's send queue from 1, 4, 16... up to n threads\n"
+            "                        with one thread draining it, against a mutex and deque\n"
+            "  --events <n>          receive n results among events for a slow and an ordered subscription,\n"
+            "                        with the handlers run inline and through the event dispatcher, exit code 1\n"
+            "                        if results wait on the slow handler or events are lost or out of order\n"
+            "  --log <n>             log short and long messages to a file from 1 to n threads, through the\n"
+            "                        async log and on the calling thread\n"
+            "  --trace <n>           time n small spans without tracing, with tracing off and on, exit code 1\n"
+            "                        if tracing off costs 1%% or more\n"
+            "\n"
+            "Against WAAPI (start waapi_mock_server first):\n"
+            "  --cancel <n>          cancel n calls waiting on a slow WAAPI (waapi_mock_server --latency 2000)\n"
+            "                        and time until each returns, exit code 1 if one doesn't return promptly\n"
+            "                        or the client is unusable after\n"
+            "  --hierarchy <ms>      load the hierarchy mirror in the background giving up after ms, check its\n"
+            "                        paths against object.get, exit code 1 if it didn't load or doesn't match\n"
+            "  --search <n>          type n queries into the parent search and repeat them, against\n"
+            "                        waapi_mock_server --generate 2000x100, exit code 1 if a query is searched\n"
+            "                        more than once or its results are wrong\n"
+            "  --host <address>      WAAPI host (default 127.0.0.1)\n"
+            "  --port <port>         WAAPI port (default %d)\n"
+            "\n"
+            "Plugin:\n"
+            "  --queue <n>           queue a render of n regions by every track of a generated project,\n"
+            "                        exit code 1 if an output isn't named the way reaper names it\n"
+            "  --analysis <s>        analyse generated 16 bit, 24 bit and float wavs s seconds long, one\n"
+            "                        thread then --jobs threads\n"
+            "  --jobs <n>            threads for --analysis (default: hardware threads)\n"
+            "  --import-ids <n>      save and load import id indexes of n generated imports, count the\n"
+            "                        lookups recall and re-imports make with and without them\n"
+            "  --render-view <n>     edit every row of an n row render view through the change set and\n"
+            "                        straight to the view, exit code 1 if the wrong cells are pushed\n"
+            "\n"
+            "Allocations are counted per thread, with glibc every malloc, elsewhere every operator new.\n"
+            "exit codes: 0 success, 1 a bench's check failed, 2 bad arguments, 3 couldn't connect\n",
+            WAAPI_DEFAULT_PORT);
+}
+
+static bool ParseArgs(int argc, char **argv, BenchOptions &options)
+{
+    for (int i = 1; i < argc; ++i)
+    {
+        const std::string arg = argv[i];
+        const bool hasValue = i + 1 < argc;
+
+        if (arg == "--host" && hasValue) options.host = argv[++i];
+        else if (arg == "--port" && hasValue) options.port = static_cast<uint32>(std::atoi(argv[++i]));
+        else if (arg == "--jobs" && hasValue) options.jobs = std::max(1, std::atoi(argv[++i]));
+        else if (arg == "--serialize" && hasValue) options.serializeItems = static_cast<uint32>(std::max(1, std::atoi(argv[++i])));
+        else if (arg == "--result-view" && hasValue) options.resultViewObjects = static_cast<uint32>(std::max(1, std::atoi(argv[++i])));
+        else if (arg == "--receive" && hasValue) options.receiveFrames = static_cast<uint32>(std::max(1, std::atoi(argv[++i])));
+        else if (arg == "--pending" && hasValue) options.pendingThreads = static_cast<uint32>(std::max(1, std::atoi(argv[++i])));
+        else if (arg == "--send" && hasValue) options.sendThreads = static_cast<uint32>(std::max(1, std::atoi(argv[++i])));
+        else if (arg == "--events" && hasValue) options.eventResults = static_cast<uint32>(std::max(1, std::atoi(argv[++i])));
+        else if (arg == "--log" && hasValue) options.logThreads = static_cast<uint32>(std::max(1, std::atoi(argv[++i])));
+        else if (arg == "--trace" && hasValue) options.traceSpans = static_cast<uint32>(std::max(1, std::atoi(argv[++i])));
+        else if (arg == "--cancel" && hasValue) options.cancelCalls = static_cast<uint32>(std::max(1, std::atoi(argv[++i])));
+        else if (arg == "--hierarchy" && hasValue) options.hierarchyTimeoutMs = static_cast<uint32>(std::max(1, std::atoi(argv[++i])));
+        else if (arg == "--search" && hasValue) options.searchQueries = static_cast<uint32>(std::max(1, std::atoi(argv[++i])));
+        else if (arg == "--queue" && hasValue) options.queueRegions = static_cast<uint32>(std::max(1, std::atoi(argv[++i])));
+        else if (arg == "--analysis" && hasValue) options.analysisSeconds = static_cast<uint32>(std::max(1, std::atoi(argv[++i])));
+        else if (arg == "--import-ids" && hasValue) options.importIds = static_cast<uint32>(std::max(1, std::atoi(argv[++i])));
+        else if (arg == "--render-view" && hasValue) options.renderViewRows = static_cast<uint32>(std::max(1, std::atoi(argv[++i])));
+        else
+        {
+            if (arg != "--help" && arg != "-h")
+            {
+                fprintf(stderr, "unknown option %s\n", arg.c_str());
+            }
+            return false;
+        }
+    }
+
+    return options.serializeItems || options.resultViewObjects || options.receiveFrames || options.pendingThreads ||
+        options.sendThreads || options.eventResults || options.logThreads || options.traceSpans || options.queueRegions ||
+        options.analysisSeconds || options.importIds || options.renderViewRows || options.UsesWaapi();
+}
+
+//a made up guid numbered n
+static std::string MakeBenchGuid(uint64_t n)
+{
+    char guid[40];
+    snprintf(guid, sizeof(guid), "{00000000-0000-0000-0000-%012llx}", static_cast<unsigned long long>(n));
+    return guid;
+}
+
+//a WAMP CALL of audio.import with numItems generated items, as the transfer sends them
+static AK::WwiseAuthoringAPI::AkJson MakeBenchImportCall(uint32 numItems)
+{
+    using namespace AK::WwiseAuthoringAPI;
+
+    AkJson::Array items;
+    for (uint32 i = 0; i < numItems; ++i)
+    {
+        RenderItem renderItem{};
+        renderItem.outputFileName = "VO_Hero_" + std::to_string(i);
+        renderItem.audioFilePath = "C:\\projects\\bench\\renders\\" + renderItem.outputFileName + ".wav";
+        renderItem.wwiseGuid = MakeBenchGuid(i / 100);
+        renderItem.wwiseOriginalsSubpath = "Dialog\\Hero";
+        renderItem.importObjectType = i % 2 ? ImportObjectType::Voice : ImportObjectType::SFX;
+        items.push_back(MakeImportItem(renderItem, "reaper bench.rpp"));
+    }
+
+    return AkJson(AkJson::Array{
+        AkVariant(48),
+        AkVariant(static_cast<uint64_t>(numItems) + 1),
+        AkJson(AkJson::Map()),
+        AkVariant(ak::wwise::core::audio::import),
+        AkJson(AkJson::Array()),
+        MakeImportArgs(items, WAAPIImportOperation::useExisting)
+    });
+}
+
+//the send path before AppendAkJsonText: a document, its text, a copy for the send queue and one for SendUTF8
+static void SendThroughDocument(const AK::WwiseAuthoringAPI::AkJson &message, std::string &sentOut)
+{
+    using namespace AK::WwiseAuthoringAPI;
+
+    rapidjson::Document document;
+    JSONHelpers::ToRapidJson(message, document, document.GetAllocator());
+    const std::string text = JSONHelpers::GetJsonText(document);
+    auto sendBuffer = std::make_shared<std::vector<char>>(text.c_str(), text.c_str() + text.length() + 1);
+    sentOut = std::string(sendBuffer->data(), sendBuffer->size() - 1);
+}
+
+//the send path now, see makeSendBuffer and session::sendThread in autobahn.cpp
+static void SendStreamed(const AK::WwiseAuthoringAPI::AkJson &message, size_t &lastSizeInOut, std::string &sentOut)
+{
+    using namespace AK::WwiseAuthoringAPI;
+
+    auto sendBuffer = std::make_shared<std::vector<char>>();
+    sendBuffer->reserve(lastSizeInOut + 1);
+    JSONHelpers::AppendAkJsonText(message, *sendBuffer);
+    lastSizeInOut = sendBuffer->size();
+    sendBuffer->push_back('\0');
+    sentOut.assign(sendBuffer->data(), sendBuffer->size() - 1);
+}
+
+//a small object.get call and import calls of 10, 100... up to maxItems items, each serialized for sending the old
+//and the new way about a million items' worth of times. False if the two texts ever differ
+static bool BenchSerialize(uint32 maxItems, ProgressWriter &progress)
+{
+    using namespace AK::WwiseAuthoringAPI;
+    using Clock = std::chrono::steady_clock;
+
+    std::vector<std::pair<uint32, AkJson>> messages;
+    messages.emplace_back(0, AkJson(AkJson::Array{
+        AkVariant(48),
+        AkVariant(1),
+        AkJson(AkJson::Map{ { "return", AkJson::Array{ AkVariant("id"), AkVariant("name"), AkVariant("type") } } }),
+        AkVariant(ak::wwise::core::object::get),
+        AkJson(AkJson::Array()),
+        AkJson(AkJson::Map{ { "from", AkJson::Map{ { "path", AkJson::Array{ AkVariant("\\Actor-Mixer Hierarchy\\Default Work Unit") } } } } })
+    }));
+    for (uint32 numItems = 10; numItems < maxItems * 10; numItems *= 10)
+    {
+        messages.emplace_back(std::min(numItems, maxItems), MakeBenchImportCall(std::min(numItems, maxItems)));
+    }
+
+    bool identical = true;
+    for (const auto &message : messages)
+    {
+        const uint32 numSends = std::max(10u, 1000000 / std::max(1u, message.first * 10));
+
+        std::string documentText;
+        uint64_t allocationsBefore = t_numAllocations;
+        Clock::time_point start = Clock::now();
+        for (uint32 i = 0; i < numSends; ++i)
+        {
+            SendThroughDocument(message.second, documentText);
+        }
+        const double documentSeconds = std::chrono::duration<double>(Clock::now() - start).count();
+        const uint64_t documentAllocations = t_numAllocations - allocationsBefore;
+
+        std::string streamedText;
+        size_t lastSize = 0;
+        allocationsBefore = t_numAllocations;
+        start = Clock::now();
+        for (uint32 i = 0; i < numSends; ++i)
+        {
+            SendStreamed(message.second, lastSize, streamedText);
+        }
+        const double streamedSeconds = std::chrono::duration<double>(Clock::now() - start).count();
+        const uint64_t streamedAllocations = t_numAllocations - allocationsBefore;
+
+        identical = identical && streamedText == documentText;
+
+        progress.Emit("serialize", [&](JsonWriter &writer)
+        {
+            writer.Key("items");
+            writer.Uint(message.first);
+            writer.Key("bytes");
+            writer.Uint64(streamedText.size());
+            writer.Key("sends");
+            writer.Uint(numSends);
+            writer.Key("documentMicroseconds");
+            writer.Double(documentSeconds * 1e6 / numSends);
+            writer.Key("streamedMicroseconds");
+            writer.Double(streamedSeconds * 1e6 / numSends);
+            writer.Key("documentAllocations");
+            writer.Double(static_cast<double>(documentAllocations) / numSends);
+            writer.Key("streamedAllocations");
+            writer.Double(static_cast<double>(streamedAllocations) / numSends);
+            writer.Key("identical");
+            writer.Bool(streamedText == documentText);
+        });
+    }
+
+    return identical;
+}
+
+//the RESULT text of an object.get returning numObjects sounds with their notes
+static std::string MakeBenchObjectGetResult(uint32 numObjects)
+{
+    std::string text = "[50,7,{},[],{\"return\":[";
+    char object[512];
+    for (uint32 i = 0; i < numObjects; ++i)
+    {
+        snprintf(object, sizeof(object),
+            "%s{\"id\":\"%s\",\"name\":\"VO_Hero_%06u\",\"type\":\"Sound\","
+            "\"path\":\"\\\\Actor-Mixer Hierarchy\\\\Default Work Unit\\\\Dialog_%03u\\\\VO_Hero_%06u\","
+            "\"notes\":\"Rendered from reaper bench.rpp, region %u, take %u. Keep the breath at the start.\"}",
+            i ? "," : "", MakeBenchGuid(i).c_str(), i, i / 1000, i, i, i % 7);
+        text += object;
+    }
+    text += "]}]";
+    return text;
+}
+
+//an object.get result of numObjects objects with notes decoded the way got_msg does for Client::Call, to an AkJson
+//tree, and the way it does for ResultViews::Call, parsed in place, then each object's fields read by the caller.
+//Best of three rounds. False if the two read any field differently
+static bool BenchResultView(uint32 numObjects, ProgressWriter &progress)
+{
+    using namespace AK::WwiseAuthoringAPI;
+    using Clock = std::chrono::steady_clock;
+
+    const std::string payload = MakeBenchObjectGetResult(numObjects);
+    const char *fields[] = { "id", "name", "type", "path", "notes" };
+
+    double akJsonSeconds = 0.0;
+    double viewSeconds = 0.0;
+    uint64_t akJsonAllocations = 0;
+    uint64_t viewAllocations = 0;
+    bool matched = true;
+
+    for (int round = 0; round < 3; ++round)
+    {
+        //the callers only look at the fields, so neither side copies them out while being measured
+        size_t akJsonBytesRead = 0;
+        AkJson message;
+        uint64_t allocationsBefore = t_numAllocations;
+        Clock::time_point start = Clock::now();
+        {
+            ReceivePool::ParseScope parse;
+            ReceivePool::Document &document = parse.GetDocument();
+            document.Parse(payload.c_str());
+            JSONHelpers::FromRapidJson(document, message);
+        }
+        for (AkJson &object : message[4]["return"].GetArray())
+        {
+            for (const char *field : fields)
+            {
+                akJsonBytesRead += object[field].GetVariant().GetString().size();
+            }
+        }
+        const double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+        akJsonSeconds = round ? std::min(akJsonSeconds, seconds) : seconds;
+        akJsonAllocations = t_numAllocations - allocationsBefore;
+
+        size_t viewBytesRead = 0;
+        ResultView view;
+        allocationsBefore = t_numAllocations;
+        start = Clock::now();
+        {
+            int64_t code = 0;
+            uint64_t requestId = 0;
+            ResultViews::PeekHeader(payload, code, requestId);
+
+            //as ResultViews::Deliver keeps it
+            auto viewMessage = std::make_shared<ResultView::Message>();
+            viewMessage->text = payload;
+            viewMessage->document.ParseInsitu(&viewMessage->text[0]);
+            view = ResultView(std::move(viewMessage));
+        }
+        for (const rapidjson::Value &object : view.GetObjects().GetArray())
+        {
+            for (const char *field : fields)
+            {
+                viewBytesRead += strlen(ResultView::GetString(object, field));
+            }
+        }
+        const double viewRoundSeconds = std::chrono::duration<double>(Clock::now() - start).count();
+        viewSeconds = round ? std::min(viewSeconds, viewRoundSeconds) : viewRoundSeconds;
+        viewAllocations = t_numAllocations - allocationsBefore;
+
+        AkJson::Array &akJsonObjects = message[4]["return"].GetArray();
+        const rapidjson::Value &viewObjects = view.GetObjects();
+        matched = matched && akJsonBytesRead == viewBytesRead && akJsonObjects.size() == numObjects && viewObjects.Size() == numObjects;
+        for (uint32 i = 0; matched && i < numObjects; ++i)
+        {
+            for (const char *field : fields)
+            {
+                matched = matched && akJsonObjects[i][field].GetVariant().GetString() == ResultView::GetString(viewObjects[i], field);
+            }
+        }
+    }
+
+    progress.Emit("resultView", [&](JsonWriter &writer)
+    {
+        writer.Key("objects");
+        writer.Uint(numObjects);
+        writer.Key("bytes");
+        writer.Uint64(payload.size());
+        writer.Key("akJsonMs");
+        writer.Double(akJsonSeconds * 1000.0);
+        writer.Key("viewMs");
+        writer.Double(viewSeconds * 1000.0);
+        writer.Key("akJsonAllocations");
+        writer.Uint64(akJsonAllocations);
+        writer.Key("viewAllocations");
+        writer.Uint64(viewAllocations);
+        writer.Key("matched");
+        writer.Bool(matched);
+    });
+
+    return matched;
+}
+
+//what got_msg reads of a frame, to check both receive paths parsed the same thing
+static uint64_t GetBenchFrameDigest(const rapidjson::Value &message)
+{
+    if (!message.IsArray() || message.Size() < 5 || !message[1].IsUint64() || !message[4].IsObject())
+    {
+        return 0;
+    }
+    auto objects = message[4].FindMember("return");
+    return message[1].GetUint64() * 1000003 + (objects != message[4].MemberEnd() ? objects->value.Size() : 0);
+}
+
+//n thousand small RESULT frames, n large (1000 object) ones and a few huge (8000 object) ones received the way
+//WebSocketClient::OnMessage and got_msg do, through the thread's frame buffer and parser arena, and the way they did
+//before, a new string and document per frame. False if the two ever parse a frame differently or the thread keeps
+//more than MAX_RETAINED_FRAME_BYTES of frame buffer after a huge one
+static bool BenchReceive(uint32 thousands, ProgressWriter &progress)
+{
+    using namespace AK::WwiseAuthoringAPI;
+    using Clock = std::chrono::steady_clock;
+
+    struct FrameKind
+    {
+        const char *name;
+        std::string text;
+        uint32 count;
+    };
+
+    FrameKind kinds[] = {
+        { "small", "[50,42,{},[],{\"return\":[{\"id\":\"" + MakeBenchGuid(42) + "\",\"name\":\"VO_Hero_000042\"}]}]", thousands * 1000 },
+        { "large", MakeBenchObjectGetResult(1000), thousands },
+        { "huge", MakeBenchObjectGetResult(8000), std::max(1u, thousands / 100) }
+    };
+
+    bool matched = true;
+    for (const FrameKind &kind : kinds)
+    {
+        uint64_t plainDigest = 0;
+        uint64_t allocationsBefore = t_numAllocations;
+        Clock::time_point start = Clock::now();
+        for (uint32 i = 0; i < kind.count; ++i)
+        {
+            const std::string frame(kind.text.data(), kind.text.size());
+            rapidjson::Document document;
+            document.Parse(frame.c_str());
+            plainDigest += GetBenchFrameDigest(document);
+        }
+        const double plainSeconds = std::chrono::duration<double>(Clock::now() - start).count();
+        const uint64_t plainAllocations = t_numAllocations - allocationsBefore;
+
+        uint64_t pooledDigest = 0;
+        size_t retainedFrameBytes = 0;
+        allocationsBefore = t_numAllocations;
+        start = Clock::now();
+        for (uint32 i = 0; i < kind.count; ++i)
+        {
+            std::string &frame = ReceivePool::AcquireFrame(kind.text.data(), kind.text.size());
+            {
+                ReceivePool::ParseScope parse;
+                ReceivePool::Document &document = parse.GetDocument();
+                document.Parse(frame.c_str());
+                pooledDigest += GetBenchFrameDigest(document);
+            }
+            ReceivePool::ReleaseFrame(frame);
+            retainedFrameBytes = std::max(retainedFrameBytes, frame.capacity());
+        }
+        const double pooledSeconds = std::chrono::duration<double>(Clock::now() - start).count();
+        const uint64_t pooledAllocations = t_numAllocations - allocationsBefore;
+
+        matched = matched && plainDigest == pooledDigest && plainDigest != 0 &&
+            retainedFrameBytes <= ReceivePool::MAX_RETAINED_FRAME_BYTES;
+
+        progress.Emit("receive", [&](JsonWriter &writer)
+        {
+            writer.Key("frames");
+            writer.String(kind.name);
+            writer.Key("count");
+            writer.Uint(kind.count);
+            writer.Key("bytes");
+            writer.Uint64(kind.text.size());
+            writer.Key("plainMicroseconds");
+            writer.Double(plainSeconds * 1e6 / kind.count);
+            writer.Key("pooledMicroseconds");
+            writer.Double(pooledSeconds * 1e6 / kind.count);
+            writer.Key("plainAllocations");
+            writer.Uint64(plainAllocations);
+            writer.Key("pooledAllocations");
+            writer.Uint64(pooledAllocations);
+            writer.Key("retainedFrameBytes");
+            writer.Uint64(retainedFrameBytes);
+            writer.Key("matched");
+            writer.Bool(plainDigest == pooledDigest && plainDigest != 0);
+        });
+    }
+
+    return matched;
+}
+
+//a project with numRegions regions and 64 tracks in folders of eight, an item on every track in every region
+static bool MakeBenchQueueProject(const fs::path &path, uint32 numRegions, RenderQueueSelection &selectionOut)
+{
+    const uint32 numTracks = 64;
+    const uint32 tracksPerFolder = 8;
+
+    std::ofstream project(path, std::ios::trunc);
+    project << "<REAPER_PROJECT 0.1 \"6.0/x64\" 0\n"
+            << "  RENDER_FILE \"Renders\"\n"
+            << "  RENDER_PATTERN $region\n"
+            << "  RENDER_RANGE 1 0 0 18 1000\n"
+            << "  RENDER_STEMS 0\n";
+
+    char guid[64];
+    std::vector<std::string> trackGuids;
+    for (uint32 track = 0; track < numTracks; ++track)
+    {
+        snprintf(guid, sizeof(guid), "{00000000-0000-0000-0000-%012u}", track);
+        trackGuids.push_back(guid);
+    }
+
+    selectionOut.regions.clear();
+    selectionOut.renderPattern = "$region-$folders-$track";
+    for (uint32 region = 0; region < numRegions; ++region)
+    {
+        project << "  MARKER " << region + 1 << ' ' << region * 4 << " \"Region " << region << "\" 1 0 1 R\n"
+                << "  MARKER " << region + 1 << ' ' << region * 4 + 3 << " \"\" 1\n";
+        selectionOut.regions.push_back(RenderQueueSelection::Region{ region + 1, trackGuids, region % 10 == 0 });
+    }
+
+    for (uint32 track = 0; track < numTracks; ++track)
+    {
+        const bool opensFolder = track % tracksPerFolder == 0;
+        const bool closesFolder = track % tracksPerFolder == tracksPerFolder - 1;
+        project << "  <TRACK " << trackGuids[track] << "\n"
+                << "    NAME \"Track " << track << "\"\n"
+                << "    ISBUS " << (opensFolder ? 1 : closesFolder ? 2 : 0) << ' ' << (opensFolder ? 1 : closesFolder ? -1 : 0) << "\n"
+                << "    <FXCHAIN\n      SHOW 0\n    >\n";
+        for (uint32 region = 0; region < numRegions; ++region)
+        {
+            project << "    <ITEM\n"
+                    << "      POSITION " << region * 4 << "\n"
+                    << "      LENGTH 3\n"
+                    << "      <SOURCE WAVE\n        FILE \"Media/take_" << track << '_' << region << ".wav\"\n      >\n"
+                    << "    >\n";
+        }
+        project << "  >\n";
+    }
+    project << ">\n";
+    return project.good();
+}
+
+//the file names reaper gives MakeBenchQueueProject's regions under "$region-$folders-$track", written out by hand
+//rather than through RenderPattern so a wrong prediction can't agree with itself. Every region renders tracks 0 to 63
+//in project order, every tenth region the master mix first. Folder tracks (every eighth) are at the top so their
+//$folders is empty, and the master mix has no $track
+static std::vector<std::string> MakeBenchQueueExpectedNames(uint32 numRegions)
+{
+    std::vector<std::string> names;
+    char name[64];
+    for (uint32 region = 0; region < numRegions; ++region)
+    {
+        if (region % 10 == 0)
+        {
+            snprintf(name, sizeof(name), "Region %u--", region);
+            names.push_back(name);
+        }
+        for (uint32 track = 0; track < 64; ++track)
+        {
+            if (track % 8 == 0)
+            {
+                snprintf(name, sizeof(name), "Region %u--Track %u", region, track);
+            }
+            else
+            {
+                snprintf(name, sizeof(name), "Region %u-Track %u-Track %u", region, track - track % 8, track);
+            }
+            names.push_back(name);
+        }
+    }
+    return names;
+}
+
+//times WriteQueuedRender on a generated project, then checks the outputs it wrote and what reading the queued render
+//back gives against the names reaper would render
+static bool BenchQueue(uint32 numRegions, ProgressWriter &progress)
+{
+    using Clock = std::chrono::steady_clock;
+    auto ElapsedMs = [](Clock::time_point start)
+    {
+        return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+    };
+
+    const fs::path directory = fs::temp_directory_path() / "waapi_transfer_bench_queue";
+    std::error_code error;
+    fs::create_directories(directory, error);
+    const fs::path projectPath = directory / "bench.rpp";
+    const fs::path queuePath = directory / "qrender_bench.rpp";
+
+    RenderQueueSelection selection;
+    if (!MakeBenchQueueProject(projectPath, numRegions, selection))
+    {
+        fprintf(stderr, "couldn't write %s\n", projectPath.generic_string().c_str());
+        return false;
+    }
+
+    std::vector<RenderItem> outputs;
+    std::string queueError;
+    auto start = Clock::now();
+    const bool queued = WriteQueuedRender(projectPath, selection, queuePath, outputs, queueError);
+    const double writeMs = ElapsedMs(start);
+    if (!queued)
+    {
+        fprintf(stderr, "queueing failed: %s\n", queueError.c_str());
+        fs::remove_all(directory, error);
+        return false;
+    }
+
+    RenderQueueMatchStats stats;
+    start = Clock::now();
+    const std::vector<RenderItem> parsed = ParseRenderQueue(queuePath, &stats);
+    const double parseMs = ElapsedMs(start);
+
+    const std::vector<std::string> expectedNames = MakeBenchQueueExpectedNames(numRegions);
+    const fs::path renderDirectory = directory / "Renders";
+    uint32 numMismatched = 0;
+    for (size_t i = 0; i < expectedNames.size(); ++i)
+    {
+        const fs::path expectedPath = renderDirectory / (expectedNames[i] + ".wav");
+        const bool writtenMatches = i < outputs.size() && outputs[i].audioFilePath == expectedPath;
+        const bool parsedMatches = i < parsed.size() && parsed[i].audioFilePath == expectedPath;
+        if (!writtenMatches || !parsedMatches)
+        {
+            if (numMismatched < 5)
+            {
+                fprintf(stderr, "output %zu: expected %s, wrote %s, read back %s\n", i, expectedPath.generic_string().c_str(),
+                        i < outputs.size() ? outputs[i].audioFilePath.generic_string().c_str() : "nothing",
+                        i < parsed.size() ? parsed[i].audioFilePath.generic_string().c_str() : "nothing");
+            }
+            ++numMismatched;
+        }
+    }
+
+    progress.Emit("queue", [&](JsonWriter &writer)
+    {
+        writer.Key("regions");
+        writer.Uint(numRegions);
+        writer.Key("outputs");
+        writer.Uint64(outputs.size());
+        writer.Key("projectBytes");
+        writer.Uint64(fs::file_size(projectPath, error));
+        writer.Key("writeMs");
+        writer.Double(writeMs);
+        writer.Key("parseMs");
+        writer.Double(parseMs);
+        writer.Key("matchedByName");
+        writer.Uint(stats.numMatchedByName);
+        writer.Key("mismatched");
+        writer.Uint(numMismatched);
+    });
+
+    fs::remove_all(directory, error);
+    return numMismatched == 0 && outputs.size() == expectedNames.size() && parsed.size() == expectedNames.size() &&
+           stats.numMatchedByName == expectedNames.size();
+}
+
+//a stereo 48k wav of a sine under noise, bitsPerSample 16, 24 or 32 for float
+static bool MakeBenchWav(const fs::path &path, uint32 bitsPerSample, uint32 seconds)
+{
+    const uint32 sampleRate = 48000;
+    const uint32 numChannels = 2;
+    const uint32 bytesPerSample = bitsPerSample / 8;
+    const uint64_t numFrames = static_cast<uint64_t>(sampleRate) * seconds;
+    const uint32 dataSize = static_cast<uint32>(numFrames * numChannels * bytesPerSample);
+
+    std::ofstream wav(path, std::ios::binary | std::ios::trunc);
+    auto Write32 = [&wav](uint32 value) { wav.write(reinterpret_cast<const char*>(&value), 4); };
+    auto Write16 = [&wav](uint16 value) { wav.write(reinterpret_cast<const char*>(&value), 2); };
+
+    wav.write("RIFF", 4);
+    Write32(36 + dataSize);
+    wav.write("WAVEfmt ", 8);
+    Write32(16);
+    Write16(bitsPerSample == 32 ? 3 : 1);
+    Write16(numChannels);
+    Write32(sampleRate);
+    Write32(sampleRate * numChannels * bytesPerSample);
+    Write16(static_cast<uint16>(numChannels * bytesPerSample));
+    Write16(static_cast<uint16>(bitsPerSample));
+    wav.write("data", 4);
+    Write32(dataSize);
+
+    std::vector<char> buffer;
+    uint32 noise = 1;
+    for (uint64_t frameStart = 0; frameStart < numFrames; frameStart += sampleRate)
+    {
+        buffer.clear();
+        const uint64_t frameEnd = std::min<uint64_t>(numFrames, frameStart + sampleRate);
+        for (uint64_t frame = frameStart; frame < frameEnd; ++frame)
+        {
+            for (uint32 channel = 0; channel < numChannels; ++channel)
+            {
+                noise = noise * 1664525u + 1013904223u;
+                const double x = 0.4 * std::sin(frame * 0.0654) + 0.1 * (static_cast<int32_t>(noise) / 2147483648.0);
+
+                char sample[4];
+                if (bitsPerSample == 32)
+                {
+                    const float value = static_cast<float>(x);
+                    memcpy(sample, &value, 4);
+                }
+                else
+                {
+                    const int32_t value = static_cast<int32_t>(x * (bitsPerSample == 16 ? 32767.0 : 8388607.0));
+                    memcpy(sample, &value, 4);
+                }
+                buffer.insert(buffer.end(), sample, sample + bytesPerSample);
+            }
+        }
+        wav.write(buffer.data(), buffer.size());
+    }
+    return wav.good();
+}
+
+//times AnalyzeWav on one thread per sample format, then all formats on every job at once
+static bool BenchAnalysis(uint32 numSeconds, uint32 numJobs, ProgressWriter &progress)
+{
+    using Clock = std::chrono::steady_clock;
+
+    const fs::path directory = fs::temp_directory_path() / "waapi_transfer_bench_analysis";
+    std::error_code error;
+    fs::create_directories(directory, error);
+
+    const uint32 formats[] = { 16, 24, 32 };
+    std::vector<fs::path> paths;
+    uint64_t totalBytes = 0;
+    bool succeeded = true;
+    for (uint32 bitsPerSample : formats)
+    {
+        const fs::path path = directory / ("bench_" + std::to_string(bitsPerSample) + ".wav");
+        if (!MakeBenchWav(path, bitsPerSample, numSeconds))
+        {
+            fprintf(stderr, "couldn't write %s\n", path.generic_string().c_str());
+            fs::remove_all(directory, error);
+            return false;
+        }
+
+        //once to page it in, the bench is the analysis and not the disk
+        AnalyzeWav(path);
+
+        const auto start = Clock::now();
+        const AudioAnalysis analysis = AnalyzeWav(path);
+        const double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+        const uint64_t bytes = fs::file_size(path, error);
+        succeeded &= analysis.error.empty();
+
+        progress.Emit("analysis", [&](JsonWriter &writer)
+        {
+            writer.Key("format");
+            writer.String(bitsPerSample == 32 ? "float" : bitsPerSample == 24 ? "int24" : "int16");
+            writer.Key("bytes");
+            writer.Uint64(bytes);
+            writer.Key("ms");
+            writer.Double(seconds * 1000.0);
+            writer.Key("gbPerSecond");
+            writer.Double(bytes / seconds / 1e9);
+            writer.Key("truePeakDb");
+            writer.Double(analysis.truePeakDb);
+            writer.Key("integratedLufs");
+            writer.Double(analysis.integratedLufs);
+        });
+
+        for (uint32 i = 0; i < numJobs; ++i)
+        {
+            paths.push_back(path);
+            totalBytes += bytes;
+        }
+    }
+
+    const auto start = Clock::now();
+    AnalyzeWavs(paths, numJobs);
+    const double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+
+    progress.Emit("analysisParallel", [&](JsonWriter &writer)
+    {
+        writer.Key("jobs");
+        writer.Uint(numJobs);
+        writer.Key("files");
+        writer.Uint64(paths.size());
+        writer.Key("bytes");
+        writer.Uint64(totalBytes);
+        writer.Key("ms");
+        writer.Double(seconds * 1000.0);
+        writer.Key("gbPerSecond");
+        writer.Double(totalBytes / seconds / 1e9);
+        writer.Key("gbPerSecondPerJob");
+        writer.Double(totalBytes / seconds / 1e9 / numJobs);
+    });
+
+    fs::remove_all(directory, error);
+    return succeeded;
+}
+
+//a receive thread getting a result every millisecond, each with a nameChanged event for one of 50 objects (a 5ms
+//handler, standing in for a UI refresh) and an object.created event whose handler checks they come in order. Run
+//once calling the handlers inline like the session used to and once through EventDispatcher. Reports how long
+//results waited behind the events. False if dispatched results waited more than a few milliseconds, or an
+//object.created event was lost or reordered, or an object's last name didn't reach the slow handler
+static bool BenchEvents(uint32 numResults, ProgressWriter &progress)
+{
+    using namespace AK::WwiseAuthoringAPI;
+    using Clock = std::chrono::steady_clock;
+
+    const uint32 numObjects = 50;
+    const auto slowHandlerTime = std::chrono::milliseconds(5);
+    const double maxDispatchedWaitMs = 5.0;
+
+    bool passed = true;
+    for (bool dispatched : { false, true })
+    {
+        std::mutex namesMutex;
+        std::map<std::string, std::string> lastNames;
+        std::atomic<uint32> numRenames{ 0 };
+        std::atomic<uint32> numCreated{ 0 };
+        std::atomic<bool> ordered{ true };
+
+        EventDispatcher::Handler renamed = [&](uint64_t, const JsonProvider &event)
+        {
+            std::this_thread::sleep_for(slowHandlerTime);
+            const AkJson &kwargs = event.GetAkJson();
+            std::lock_guard<std::mutex> lock(namesMutex);
+            lastNames[kwargs["object"]["id"].GetVariant().GetString()] = kwargs["newName"].GetVariant().GetString();
+            ++numRenames;
+        };
+        EventDispatcher::Handler created = [&](uint64_t, const JsonProvider &event)
+        {
+            const uint32 sequence = static_cast<uint32>(static_cast<int64_t>(event.GetAkJson()["sequence"].GetVariant()));
+            if (sequence != numCreated.fetch_add(1))
+            {
+                ordered = false;
+            }
+        };
+
+        //the session only ever sees the wrapped handlers, which queue onto the strands and return
+        const int session = 0;
+        if (dispatched)
+        {
+            std::shared_ptr<EventDispatcher::Strand> strand;
+            renamed = EventDispatcher::Wrap(ak::wwise::core::object::nameChanged, renamed, strand);
+            EventDispatcher::Attach(&session, 1, strand);
+            created = EventDispatcher::Wrap(ak::wwise::core::object::created, created, strand);
+            EventDispatcher::Attach(&session, 2, strand);
+        }
+
+        std::map<std::string, std::string> expectedNames;
+        std::vector<double> waitMs;
+        waitMs.reserve(numResults);
+
+        const Clock::time_point start = Clock::now();
+        for (uint32 i = 0; i < numResults; ++i)
+        {
+            const Clock::time_point arrival = start + std::chrono::milliseconds(i);
+            std::this_thread::sleep_until(arrival);
+
+            const std::string objectId = MakeBenchGuid(i % numObjects);
+            const std::string newName = "VO_Hero_" + std::to_string(i);
+            expectedNames[objectId] = newName;
+
+            const AkJson renameEvent(AkJson::Map{
+                { "object", AkJson::Map{ { "id", AkVariant(objectId) } } },
+                { "newName", AkVariant(newName) }
+            });
+            renamed(1, JsonProvider(renameEvent));
+
+            const AkJson createEvent(AkJson::Map{ { "sequence", AkVariant(i) } });
+            created(2, JsonProvider(createEvent));
+
+            //the result behind the two events completes its call now
+            waitMs.push_back(std::chrono::duration<double, std::milli>(Clock::now() - arrival).count());
+        }
+
+        //let the strands drain, the renames coalesce so there are fewer of them than events
+        const Clock::time_point drainDeadline = Clock::now() + std::chrono::seconds(10);
+        bool drained = false;
+        while (!drained && Clock::now() < drainDeadline)
+        {
+            {
+                std::lock_guard<std::mutex> lock(namesMutex);
+                drained = numCreated == numResults && lastNames == expectedNames;
+            }
+            if (!drained)
+            {
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            }
+        }
+        const double drainMs = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+
+        if (dispatched)
+        {
+            EventDispatcher::CloseAll(&session);
+        }
+
+        std::sort(waitMs.begin(), waitMs.end());
+        const double medianMs = waitMs[waitMs.size() / 2];
+        const double p99Ms = waitMs[std::min(waitMs.size() - 1, waitMs.size() * 99 / 100)];
+
+        progress.Emit("events", [&](JsonWriter &writer)
+        {
+            writer.Key("handlers");
+            writer.String(dispatched ? "dispatched" : "inline");
+            writer.Key("results");
+            writer.Uint(numResults);
+            writer.Key("resultWaitMedianMs");
+            writer.Double(medianMs);
+            writer.Key("resultWaitP99Ms");
+            writer.Double(p99Ms);
+            writer.Key("renamesHandled");
+            writer.Uint(numRenames);
+            writer.Key("totalMs");
+            writer.Double(drainMs);
+            writer.Key("ordered");
+            writer.Bool(ordered && drained);
+        });
+
+        passed = passed && ordered && drained && (!dispatched || p99Ms <= maxDispatchedWaitMs);
+    }
+
+    return passed;
+}
+
+//ops per second of numThreads threads each running numOps of RunOp(thread, op) at once
+template <typename RunOp>
+static double MeasureOpsPerSecond(uint32 numThreads, uint32 numOps, RunOp runOp)
+{
+    const auto start = std::chrono::steady_clock::now();
+    std::vector<std::thread> threads;
+    for (uint32 thread = 0; thread < numThreads; ++thread)
+    {
+        threads.emplace_back([&runOp, thread, numOps]()
+        {
+            for (uint32 op = 0; op < numOps; ++op)
+            {
+                runOp(thread, op);
+            }
+        });
+    }
+    for (std::thread &thread : threads)
+    {
+        thread.join();
+    }
+    const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    return static_cast<double>(numThreads) * numOps / seconds;
+}
+
+//a request sent and answered the way the session records it: pending table insert, metrics on send, metrics on
+//response, pending table complete. Every thread is its own session. The mutex version is what both were before
+static void BenchPending(uint32 maxThreads, ProgressWriter &progress)
+{
+    using namespace AK::WwiseAuthoringAPI;
+
+    const uint32 numOps = 200000;
+    std::atomic<uint64_t> nextId{ 0 };
+
+    struct Request
+    {
+        uint32 value = 0;
+    };
+    PendingTable<Request> table(1024);
+    std::vector<uint32> owners(maxThreads);
+
+    //the session's requests and the metrics as they were: a mutex around each
+    std::mutex sessionMutex;
+    std::unordered_map<uint64_t, Request> sessionPending;
+    struct LockedRequest
+    {
+        std::string uri;
+        std::chrono::steady_clock::time_point sent;
+    };
+    std::mutex mutex;
+    std::unordered_map<uint64_t, LockedRequest> lockedPending;
+    std::map<std::string, WampMetrics::UriMetrics> lockedUris;
+    const std::string uri = "ak.wwise.core.object.get";
+
+    for (uint32 numThreads = 1; ; numThreads = std::min(maxThreads, numThreads * 2))
+    {
+        const double lockFree = MeasureOpsPerSecond(numThreads, numOps, [&](uint32 thread, uint32)
+        {
+            const uint64_t id = ++nextId;
+            table.Insert(id, &owners[thread], [](Request &request) { request.value = 1; });
+            WampMetrics::OnRequestSent(id, WampMetrics::RequestKind::Call, uri, 64);
+            WampMetrics::OnResponse(id, true);
+            table.Complete(id, &owners[thread], [](Request &request) { request.value = 0; });
+        });
+
+        const double locked = MeasureOpsPerSecond(numThreads, numOps, [&](uint32, uint32)
+        {
+            const uint64_t id = ++nextId;
+            {
+                std::lock_guard<std::mutex> lock(sessionMutex);
+                sessionPending[id].value = 1;
+            }
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                WampMetrics::UriMetrics &metrics = lockedUris[uri];
+                ++metrics.requests;
+                metrics.bytesSent += 64;
+                lockedPending[id] = LockedRequest{ uri, std::chrono::steady_clock::now() };
+            }
+
+            const auto now = std::chrono::steady_clock::now();
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                auto request = lockedPending.find(id);
+                lockedUris[request->second.uri].latency.Record(static_cast<uint64_t>(
+                    std::chrono::duration_cast<std::chrono::microseconds>(now - request->second.sent).count()));
+                lockedPending.erase(request);
+            }
+            std::lock_guard<std::mutex> lock(sessionMutex);
+            sessionPending.erase(id);
+        });
+
+        progress.Emit("pending", [&](JsonWriter &writer)
+        {
+            writer.Key("threads");
+            writer.Uint(numThreads);
+            writer.Key("lockFreeOpsPerSecond");
+            writer.Double(lockFree);
+            writer.Key("mutexOpsPerSecond");
+            writer.Double(locked);
+        });
+
+        if (numThreads == maxThreads)
+        {
+            break;
+        }
+    }
+
+    WampMetrics::Reset();
+}
+
+//messages a second from numProducers threads pushing numMessages each, with one thread draining them the way the
+//session's send thread does. The mutex version is what the session did before: lock, queue, notify per message
+static void BenchSend(uint32 maxProducers, ProgressWriter &progress)
+{
+    using namespace AK::WwiseAuthoringAPI;
+
+    const uint32 numMessages = 100000;
+    const SendQueue::Buffer message = std::make_shared<std::vector<char>>(256, 'x');
+
+    const char session = 0;
+    SendQueue *queue = SendQueues::Acquire(&session);
+    if (!queue)
+    {
+        return;
+    }
+
+    std::mutex mutex;
+    std::condition_variable wakeEvent;
+    std::deque<SendQueue::Buffer> lockedQueue;
+
+    for (uint32 numProducers = 1; ; numProducers = std::min(maxProducers, numProducers * 4))
+    {
+        const uint64_t total = static_cast<uint64_t>(numProducers) * numMessages;
+
+        auto start = std::chrono::steady_clock::now();
+        std::thread consumer([&]()
+        {
+            SendQueue::Buffer buffer;
+            for (uint64_t popped = 0; popped < total; )
+            {
+                queue->Wait([]() { return false; });
+                while (queue->Pop(buffer))
+                {
+                    ++popped;
+                }
+            }
+        });
+        MeasureOpsPerSecond(numProducers, numMessages, [&](uint32, uint32)
+        {
+            SendQueues::Push(&session, message);
+        });
+        consumer.join();
+        const double lockFree = total / std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+        start = std::chrono::steady_clock::now();
+        consumer = std::thread([&]()
+        {
+            for (uint64_t popped = 0; popped < total; ++popped)
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                wakeEvent.wait(lock, [&]() { return !lockedQueue.empty(); });
+                SendQueue::Buffer buffer = std::move(lockedQueue.front());
+                lockedQueue.pop_front();
+            }
+        });
+        MeasureOpsPerSecond(numProducers, numMessages, [&](uint32, uint32)
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            lockedQueue.push_back(message);
+            wakeEvent.notify_one();
+        });
+        consumer.join();
+        const double locked = total / std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+        progress.Emit("send", [&](JsonWriter &writer)
+        {
+            writer.Key("producers");
+            writer.Uint(numProducers);
+            writer.Key("lockFreeMessagesPerSecond");
+            writer.Double(lockFree);
+            writer.Key("mutexMessagesPerSecond");
+            writer.Double(locked);
+        });
+
+        if (numProducers == maxProducers)
+        {
+            break;
+        }
+    }
+
+    SendQueues::Release(&session);
+}
+
+//messages a second logged to a file from numThreads threads, each message different so none are folded as repeats.
+//The async log is timed up to its flush: the rate the callers get back and the rate that reached the file, the
+//rest were dropped on a full ring. The calling thread version formats and writes under a lock like the Logger
+//sink did before. Long messages are the size of a failed import's error, they spill over several cells
+static bool BenchLog(uint32 maxThreads, ProgressWriter &progress)
+{
+    using namespace AK::WwiseAuthoringAPI;
+
+    const uint32 numMessages = 20000;
+    const fs::path asyncPath = fs::temp_directory_path() / "waapi_transfer_bench_async.log";
+    const fs::path syncPath = fs::temp_directory_path() / "waapi_transfer_bench_sync.log";
+
+    std::FILE *syncFile = std::fopen(syncPath.string().c_str(), "wb");
+    if (!syncFile || !AsyncLog::OpenFile(asyncPath.string(), 0, 0))
+    {
+        if (syncFile)
+        {
+            std::fclose(syncFile);
+        }
+        return false;
+    }
+
+    std::mutex syncMutex;
+    std::string syncLine;
+    const auto logOnCallingThread = [&](const char *text)
+    {
+        const auto now = std::chrono::system_clock::now();
+        const std::time_t seconds = std::chrono::system_clock::to_time_t(now);
+        std::lock_guard<std::mutex> lock(syncMutex);
+        char prefix[64];
+        std::strftime(prefix, sizeof(prefix), "%Y-%m-%d %H:%M:%S [W] AkAutobahn: ", std::localtime(&seconds));
+        syncLine.assign(prefix);
+        syncLine += text;
+        syncLine += '\n';
+        std::fwrite(syncLine.data(), 1, syncLine.size(), syncFile);
+    };
+
+    for (const size_t messageLength : { size_t(60), size_t(2000) })
+    {
+        const std::string padding(messageLength, 'x');
+        for (uint32 numThreads = 1; ; numThreads = std::min(maxThreads, numThreads * 2))
+        {
+            const uint64_t droppedBefore = AsyncLog::GetNumDropped();
+            auto start = std::chrono::steady_clock::now();
+            MeasureOpsPerSecond(numThreads, numMessages, [&](uint32 thread, uint32 op)
+            {
+                thread_local std::string text;
+                text = "thread " + std::to_string(thread) + " message " + std::to_string(op) + " ";
+                text.append(padding, 0, messageLength - std::min(messageLength, text.size()));
+                AsyncLog::Write(AsyncLog::Severity::Warning, "AkAutobahn", text.c_str());
+            });
+            AsyncLog::Flush();
+            const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+            const uint64_t total = static_cast<uint64_t>(numThreads) * numMessages;
+            const uint64_t dropped = AsyncLog::GetNumDropped() - droppedBefore;
+
+            const double sync = MeasureOpsPerSecond(numThreads, numMessages, [&](uint32 thread, uint32 op)
+            {
+                thread_local std::string text;
+                text = "thread " + std::to_string(thread) + " message " + std::to_string(op) + " ";
+                text.append(padding, 0, messageLength - std::min(messageLength, text.size()));
+                logOnCallingThread(text.c_str());
+            });
+
+            progress.Emit("log", [&](JsonWriter &writer)
+            {
+                writer.Key("threads");
+                writer.Uint(numThreads);
+                writer.Key("messageLength");
+                writer.Uint64(messageLength);
+                writer.Key("asyncMessagesPerSecond");
+                writer.Double(total / seconds);
+                writer.Key("asyncWrittenPerSecond");
+                writer.Double((total - dropped) / seconds);
+                writer.Key("asyncDropped");
+                writer.Uint64(dropped);
+                writer.Key("callingThreadMessagesPerSecond");
+                writer.Double(sync);
+            });
+
+            if (numThreads == maxThreads)
+            {
+                break;
+            }
+        }
+    }
+
+    AsyncLog::CloseFile();
+    std::fclose(syncFile);
+
+    std::error_code error;
+    fs::remove(asyncPath, error);
+    fs::remove(syncPath, error);
+    return true;
+}
+
+//the work in a span: formatting a batch of call messages, a microsecond or so. Still cheaper than anything the
+//session traces, the smallest of those is a websocket write
+static size_t FormatBenchCalls(char *buffer, size_t size, uint32 op)
+{
+    size_t total = 0;
+    for (uint32 call = 0; call < 8; ++call)
+    {
+        const int length = snprintf(buffer, size, "[48,%u,{},\"ak.wwise.core.object.get\",[],{\"from\":{\"id\":"
+                                    "[\"{00000000-0000-0000-0000-%012u}\"]},\"options\":{\"return\":[\"id\",\"name\"]}}]",
+                                    op, call);
+        total += length > 0 ? static_cast<size_t>(length) : 0;
+    }
+    return total;
+}
+
+//seconds for numSpans spans of FormatBenchCalls without a span, with tracing off and with it on. Then threads that record and exit, their rings have to be reused instead of piling up
+static bool BenchTrace(uint32 numSpans, ProgressWriter &progress)
+{
+    using namespace AK::WwiseAuthoringAPI;
+
+    char buffer[256];
+    size_t checksum = 0;
+    const auto timeSpans = [&](bool traced)
+    {
+        const auto start = std::chrono::steady_clock::now();
+        for (uint32 op = 0; op < numSpans; ++op)
+        {
+            if (traced)
+            {
+                WAAPI_TRACE_SCOPE("bench", "FormatBenchCalls");
+                checksum += FormatBenchCalls(buffer, sizeof(buffer), op);
+            }
+            else
+            {
+                checksum += FormatBenchCalls(buffer, sizeof(buffer), op);
+            }
+        }
+        return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    };
+
+    //runs alternate so each pair sees the same clock speed and cache state, the median pair is reported
+    const int numRuns = 15;
+    std::vector<double> untracedRuns, offRatios, onRatios;
+    for (int run = 0; run < numRuns; ++run)
+    {
+        Tracing::SetEnabled(false);
+        const double untracedRun = timeSpans(false);
+        const double tracingOffRun = timeSpans(true);
+        Tracing::SetEnabled(true);
+        const double tracingOnRun = timeSpans(true);
+
+        untracedRuns.push_back(untracedRun);
+        offRatios.push_back(tracingOffRun / untracedRun);
+        onRatios.push_back(tracingOnRun / untracedRun);
+    }
+    for (std::vector<double> *runs : { &untracedRuns, &offRatios, &onRatios })
+    {
+        std::nth_element(runs->begin(), runs->begin() + numRuns / 2, runs->end());
+    }
+    const double untraced = untracedRuns[numRuns / 2];
+    const double tracingOff = untraced * offRatios[numRuns / 2];
+    const double tracingOn = untraced * onRatios[numRuns / 2];
+
+    const uint32 numThreads = 64;
+    for (uint32 thread = 0; thread < numThreads; ++thread)
+    {
+        std::thread([]() { WAAPI_TRACE_INSTANT("bench", "thread", nullptr); }).join();
+    }
+    Tracing::SetEnabled(false);
+    Tracing::Clear();
+
+    //this thread's ring, and the ones kept for exited threads
+    const size_t numRings = Tracing::GetNumThreadRings();
+    const double offPercent = (tracingOff - untraced) / untraced * 100.0;
+
+    progress.Emit("trace", [&](JsonWriter &writer)
+    {
+        writer.Key("spans");
+        writer.Uint(numSpans);
+        writer.Key("untracedNsPerSpan");
+        writer.Double(untraced / numSpans * 1e9);
+        writer.Key("tracingOffNsPerSpan");
+        writer.Double(tracingOff / numSpans * 1e9);
+        writer.Key("tracingOnNsPerSpan");
+        writer.Double(tracingOn / numSpans * 1e9);
+        writer.Key("tracingOffPercent");
+        writer.Double(offPercent);
+        writer.Key("exitedThreads");
+        writer.Uint(numThreads);
+        writer.Key("ringsHeld");
+        writer.Uint64(numRings);
+        writer.Key("checksum");
+        writer.Uint64(checksum);
+    });
+
+    return offPercent < 1.0 && numRings <= 1 + Tracing::MAX_EXITED_RINGS;
+}
+
+//the render view's editable columns, as RenderViewSubitemID numbers them
+static const int BENCH_RENDER_VIEW_COLUMNS = 4;
+
+//a render view of numRows rows edited the way the context menu actions do: filled, a language every row already
+//shows, an object type set twice per row, then a subpath with one row in a hundred removed before the flush, and
+//an operation on only those rows, removed again before the flush.
+//Each action goes through the change set and, like before it, straight to a stand in view, one call per edit.
+//False if the change set pushes anything but the cells that changed
+static bool BenchRenderView(uint32 numRows, ProgressWriter &progress)
+{
+    using Clock = std::chrono::steady_clock;
+    using View = std::vector<std::array<std::string, BENCH_RENDER_VIEW_COLUMNS>>;
+
+    View changeSetView(numRows);
+    View directView(numRows);
+    uint64_t numViewCalls = 0;
+
+    RenderViewChangeSet changes;
+    auto applyCell = [&changeSetView, &numViewCalls](MappedListViewID row, int column, const std::string &text)
+    {
+        changeSetView[row][column] = text;
+        ++numViewCalls;
+    };
+
+    struct Action
+    {
+        const char *name;
+        RenderViewChangeSet::Stats expected;
+        std::function<void(const RenderViewChangeSet::ApplyCellFunc&)> edit;
+        std::vector<MappedListViewID> removedRows;
+    };
+
+    std::vector<MappedListViewID> removedRows;
+    for (uint32 row = 50; row < numRows; row += 100)
+    {
+        removedRows.push_back(static_cast<MappedListViewID>(row));
+    }
+
+    const uint32 n = numRows;
+    const uint32 numRemoved = static_cast<uint32>(removedRows.size());
+    std::vector<Action> actions = {
+        { "fill", { 4 * n, 0, 0, 4 * n }, [n](const RenderViewChangeSet::ApplyCellFunc &set)
+        {
+            for (uint32 row = 0; row < n; ++row)
+            {
+                set(row, 0, "Sound SFX");
+                set(row, 1, "Create");
+                set(row, 2, "SFX");
+                set(row, 3, "Region " + std::to_string(row));
+            }
+        }, {} },
+        { "language", { n, 0, n, 0 }, [n](const RenderViewChangeSet::ApplyCellFunc &set)
+        {
+            for (uint32 row = 0; row < n; ++row)
+            {
+                set(row, 2, "SFX");
+            }
+        }, {} },
+        { "objectType", { 2 * n, n, 0, n }, [n](const RenderViewChangeSet::ApplyCellFunc &set)
+        {
+            for (uint32 row = 0; row < n; ++row)
+            {
+                set(row, 0, "Music Track");
+                set(row, 0, "Sound Voice");
+            }
+        }, {} },
+        { "subpathAndRemove", { n, 0, 0, n - numRemoved }, [n](const RenderViewChangeSet::ApplyCellFunc &set)
+        {
+            for (uint32 row = 0; row < n; ++row)
+            {
+                set(row, 3, "Dialog\\Region " + std::to_string(row));
+            }
+        }, removedRows },
+        { "removedOnly", { numRemoved, 0, 0, 0 }, [&removedRows](const RenderViewChangeSet::ApplyCellFunc &set)
+        {
+            for (MappedListViewID row : removedRows)
+            {
+                set(row, 1, "Replace");
+            }
+        }, removedRows },
+    };
+
+    bool matched = true;
+    for (const Action &action : actions)
+    {
+        const uint64_t viewCallsBefore = numViewCalls;
+
+        Clock::time_point start = Clock::now();
+        action.edit([&changes](MappedListViewID row, int column, const std::string &text) { changes.SetCell(row, column, text); });
+        for (MappedListViewID row : action.removedRows)
+        {
+            changes.RemoveRow(row);
+        }
+        const bool pendingBeforeFlush = changes.HasPending();
+        const RenderViewChangeSet::Stats stats = changes.Flush(applyCell);
+        const double changeSetMs = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+
+        //the way the actions used to edit the view, every edit straight to it
+        uint64_t numDirectCalls = 0;
+        start = Clock::now();
+        action.edit([&directView, &numDirectCalls](MappedListViewID row, int column, const std::string &text)
+        {
+            directView[row][column] = text;
+            ++numDirectCalls;
+        });
+        const double directMs = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+
+        const bool statsMatch = stats.cellsRecorded == action.expected.cellsRecorded &&
+                                stats.cellsCoalesced == action.expected.cellsCoalesced &&
+                                stats.cellsUnchanged == action.expected.cellsUnchanged &&
+                                stats.cellsPushed == action.expected.cellsPushed &&
+                                numViewCalls - viewCallsBefore == stats.cellsPushed && !changes.HasPending() &&
+                                pendingBeforeFlush == (stats.cellsPushed + stats.cellsUnchanged > 0);
+        matched = matched && statsMatch;
+
+        progress.Emit("renderViewAction", [&](JsonWriter &writer)
+        {
+            writer.Key("action");
+            writer.String(action.name);
+            writer.Key("rows");
+            writer.Uint(numRows);
+            writer.Key("recorded");
+            writer.Uint(stats.cellsRecorded);
+            writer.Key("coalesced");
+            writer.Uint(stats.cellsCoalesced);
+            writer.Key("unchanged");
+            writer.Uint(stats.cellsUnchanged);
+            writer.Key("pushed");
+            writer.Uint(stats.cellsPushed);
+            writer.Key("directCalls");
+            writer.Uint64(numDirectCalls);
+            writer.Key("changeSetMs");
+            writer.Double(changeSetMs);
+            writer.Key("directMs");
+            writer.Double(directMs);
+            writer.Key("matched");
+            writer.Bool(statsMatch);
+        });
+    }
+
+    //rows removed before the flush keep the subpath the fill gave them, every other row matches the direct view
+    uint32 numWrongRows = 0;
+    for (uint32 row = 0, nextRemoved = 0; row < numRows; ++row)
+    {
+        const bool removed = nextRemoved < numRemoved && removedRows[nextRemoved] == static_cast<MappedListViewID>(row);
+        if (removed)
+        {
+            ++nextRemoved;
+        }
+
+        const bool rowMatches = removed ? changeSetView[row][3] == "Region " + std::to_string(row)
+                                        : changeSetView[row] == directView[row];
+        if (!rowMatches)
+        {
+            ++numWrongRows;
+        }
+    }
+
+    progress.Emit("renderView", [&](JsonWriter &writer)
+    {
+        writer.Key("rows");
+        writer.Uint(numRows);
+        writer.Key("viewCalls");
+        writer.Uint64(numViewCalls);
+        writer.Key("cellsRecorded");
+        writer.Uint(changes.GetTotalStats().cellsRecorded);
+        writer.Key("wrongRows");
+        writer.Uint(numWrongRows);
+    });
+
+    return matched && numWrongRows == 0;
+}
+
+//n imports spread over reaper projects a hundred items each, saved and loaded back like the plugin does. Recall is
+//given every imported sound plus a quarter as many made by hand in wwise: without the index each one with children
+//costs an object.get, with it only the ones not imported by a transfer do. Re-imports find their sound by parent
+//and output name instead of by path. False if anything saved doesn't load back the same
+static bool BenchImportIds(uint32 numImports, ProgressWriter &progress)
+{
+    const uint32 itemsPerProject = 100;
+    const fs::path directory = fs::temp_directory_path() / "waapi_transfer_bench_import_ids";
+
+    std::error_code error;
+    fs::remove_all(directory, error);
+    fs::create_directories(directory, error);
+
+    std::vector<ImportIdIndex> indexes;
+    uint64_t nextGuid = 1;
+    for (uint32 item = 0; item < numImports; ++item)
+    {
+        if (item % itemsPerProject == 0)
+        {
+            indexes.emplace_back();
+            indexes.back().SetReaperProject("C:\\projects\\bench_" + std::to_string(indexes.size()) + ".rpp");
+        }
+
+        ImportIdIndex::Entry entry;
+        entry.parentGuid = MakeBenchGuid(nextGuid++);
+        entry.outputName = "Region " + std::to_string(item) + "-Track";
+        entry.soundGuid = MakeBenchGuid(nextGuid++);
+        entry.sourceGuid = item % 10 ? MakeBenchGuid(nextGuid++) : std::string();
+        indexes.back().Set(entry);
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    for (const ImportIdIndex &index : indexes)
+    {
+        if (!index.Save(ImportIdIndex::GetIndexPath(directory, index.GetReaperProject())))
+        {
+            fs::remove_all(directory, error);
+            return false;
+        }
+    }
+    const double saveSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    start = std::chrono::steady_clock::now();
+    std::unordered_map<std::string, std::string> objectProjects;
+    LoadImportIdIndexes(directory, objectProjects);
+    const double loadSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    //recall: every sound the transfers imported, then the hand made ones
+    uint32 numMismatches = 0;
+    uint32 lookupsWithIndex = 0;
+    uint32 numSelected = 0;
+    start = std::chrono::steady_clock::now();
+    for (const ImportIdIndex &index : indexes)
+    {
+        for (const auto &entry : index.GetEntries())
+        {
+            ++numSelected;
+            auto found = objectProjects.find(entry.second.soundGuid);
+            if (found == objectProjects.end())
+            {
+                ++lookupsWithIndex;
+            }
+            if (found == objectProjects.end() || found->second != index.GetReaperProject() ||
+                (!entry.second.sourceGuid.empty() && objectProjects.count(entry.second.sourceGuid) == 0))
+            {
+                ++numMismatches;
+            }
+        }
+    }
+    for (uint32 item = 0; item < numImports / 4; ++item, ++numSelected)
+    {
+        if (objectProjects.find(MakeBenchGuid(nextGuid++)) == objectProjects.end())
+        {
+            ++lookupsWithIndex;
+        }
+    }
+    const double recallSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    //re-imports: each item's sound by the parent and name it was imported with, from the index loaded back
+    uint32 reimportsById = 0;
+    for (const ImportIdIndex &saved : indexes)
+    {
+        ImportIdIndex loaded;
+        loaded.Load(ImportIdIndex::GetIndexPath(directory, saved.GetReaperProject()));
+        for (const auto &entry : saved.GetEntries())
+        {
+            const ImportIdIndex::Entry *found = loaded.Find(entry.second.parentGuid, entry.second.outputName);
+            if (found && found->soundGuid == entry.second.soundGuid && found->sourceGuid == entry.second.sourceGuid)
+            {
+                ++reimportsById;
+            }
+            else
+            {
+                ++numMismatches;
+            }
+        }
+    }
+
+    progress.Emit("importIds", [&](JsonWriter &writer)
+    {
+        writer.Key("imports");
+        writer.Uint(numImports);
+        writer.Key("indexes");
+        writer.Uint64(indexes.size());
+        writer.Key("saveSeconds");
+        writer.Double(saveSeconds);
+        writer.Key("loadSeconds");
+        writer.Double(loadSeconds);
+        writer.Key("recallSelected");
+        writer.Uint(numSelected);
+        writer.Key("recallLookupsWithoutIndex");
+        writer.Uint(numSelected);
+        writer.Key("recallLookupsWithIndex");
+        writer.Uint(lookupsWithIndex);
+        writer.Key("recallSeconds");
+        writer.Double(recallSeconds);
+        writer.Key("reimportsById");
+        writer.Uint(reimportsById);
+        writer.Key("mismatches");
+        writer.Uint(numMismatches);
+    });
+
+    fs::remove_all(directory, error);
+    return numMismatches == 0 && lookupsWithIndex == numImports / 4;
+}
+
+//twice the session's table of requests waiting for a response (MAX_PENDING_REQUESTS in autobahn.cpp)
+static const uint32 CANCEL_BURST_CALLS = 2048;
+
+//calls getInfo on a WAAPI slower than the cancel (waapi_mock_server --latency 2000) under a CallScope like the
+//transfer's, cancels it from this thread 50 to 150ms in and times until the call returns. Then cancels a burst of
+//more calls than the session can have waiting on a response, and checks the client still answers while their
+//responses are on their way. False if a call wasn't cancelled, took longer than a few wait slices to return or the
+//client stopped working
+static bool BenchCancel(uint32 numCalls, AK::WwiseAuthoringAPI::Client &client, ProgressWriter &progress)
+{
+    using namespace AK::WwiseAuthoringAPI;
+    using Clock = std::chrono::steady_clock;
+
+    const double maxReturnMs = WAIT_SLICE_MS * 5.0;
+
+    std::vector<double> returnMs;
+    uint32 numAnswered = 0;
+    for (uint32 i = 0; i < numCalls; ++i)
+    {
+        CancellationToken token;
+        std::atomic<bool> answered{ false };
+        Clock::time_point returned;
+
+        std::thread caller([&]()
+        {
+            CallScope scope(&token);
+            AkJson result;
+            answered = client.Call(ak::wwise::core::getInfo, AkJson(AkJson::Map()), AkJson(AkJson::Map()), result);
+            returned = Clock::now();
+        });
+
+        std::this_thread::sleep_for(std::chrono::milliseconds(50 + (i * 37) % 100));
+        const Clock::time_point cancelled = Clock::now();
+        token.Cancel();
+        caller.join();
+
+        if (answered)
+        {
+            ++numAnswered;
+            continue;
+        }
+        returnMs.push_back(std::chrono::duration<double, std::milli>(returned - cancelled).count());
+    }
+
+    //cancelled as soon as they're sent, so each one only gets its slot back if cancelling frees it
+    {
+        CancellationToken burstToken;
+        burstToken.Cancel();
+        CallScope scope(&burstToken);
+        for (uint32 i = 0; i < CANCEL_BURST_CALLS; ++i)
+        {
+            AkJson result;
+            client.Call(ak::wwise::core::getInfo, AkJson(AkJson::Map()), AkJson(AkJson::Map()), result);
+        }
+    }
+
+    //the cancelled calls' responses are still on their way, a call made now has to wait behind them and succeed
+    AkJson info;
+    const bool usable = client.Call(ak::wwise::core::getInfo, AkJson(AkJson::Map()), AkJson(AkJson::Map()), info, 30000) &&
+        info.HasKey("displayName");
+
+    std::sort(returnMs.begin(), returnMs.end());
+    const double medianMs = returnMs.empty() ? 0.0 : returnMs[returnMs.size() / 2];
+    const double worstMs = returnMs.empty() ? 0.0 : returnMs.back();
+
+    progress.Emit("cancel", [&](JsonWriter &writer)
+    {
+        writer.Key("calls");
+        writer.Uint(numCalls);
+        writer.Key("burstCalls");
+        writer.Uint(CANCEL_BURST_CALLS);
+        writer.Key("answeredBeforeCancel");
+        writer.Uint(numAnswered);
+        writer.Key("medianMs");
+        writer.Double(medianMs);
+        writer.Key("maxMs");
+        writer.Double(worstMs);
+        writer.Key("usableAfter");
+        writer.Bool(usable);
+    });
+
+    return numAnswered == 0 && worstMs <= maxReturnMs && usable;
+}
+
+//loads the hierarchy mirror the way the plugin does on connect, on its own thread with a timeout, and times how long
+//the caller was held up and how long the load took. Then reads every object's id and path with object.get and looks
+//each up in the mirror both ways. False if the load failed or timed out, or any object is missing or has another path
+static bool BenchHierarchy(int timeoutMs, AK::WwiseAuthoringAPI::Client &client, ProgressWriter &progress)
+{
+    using namespace AK::WwiseAuthoringAPI;
+    using Clock = std::chrono::steady_clock;
+
+    WwiseHierarchyCache cache;
+    std::mutex loadMutex;
+    std::condition_variable loadDone;
+    bool done = false;
+    bool loaded = false;
+
+    const Clock::time_point start = Clock::now();
+    cache.LoadAsync(client, timeoutMs, [&](bool success)
+    {
+        std::lock_guard<std::mutex> lock(loadMutex);
+        loaded = success;
+        done = true;
+        loadDone.notify_all();
+    });
+    const double blockedMs = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+    {
+        std::unique_lock<std::mutex> lock(loadMutex);
+        loadDone.wait(lock, [&done] { return done; });
+    }
+    const double loadMs = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+
+    uint32 numQueried = 0;
+    uint32 numMismatched = 0;
+    if (loaded)
+    {
+        const AkJson args(AkJson::Map{
+            { "from", AkJson::Map{ { "path", AkJson::Array{ AkVariant("\\Actor-Mixer Hierarchy"), AkVariant("\\Interactive Music Hierarchy") } } } },
+            { "transform", AkJson::Array{ AkJson::Map{ { "select", AkJson::Array{ AkVariant("descendants") } } } } }
+        });
+        const AkJson getOptions(AkJson::Map{ { "return", AkJson::Array{ AkVariant("id"), AkVariant("path") } } });
+
+        ResultView objects;
+        AkJson error;
+        if (!ResultViews::Call(client, ak::wwise::core::object::get, args, getOptions, objects, error, timeoutMs))
+        {
+            loaded = false;
+        }
+
+        for (const rapidjson::Value &object : objects.GetObjects().GetArray())
+        {
+            ++numQueried;
+            const std::string guid = ResultView::GetString(object, "id");
+            const std::string path = ResultView::GetString(object, "path");
+
+            WwiseHierarchyCache::ObjectInfo info;
+            std::string foundGuid;
+            if (!cache.GetObjectInfo(guid, info) || info.path != path || !cache.FindByPath(path, foundGuid) || foundGuid != guid)
+            {
+                ++numMismatched;
+            }
+        }
+    }
+
+    progress.Emit("hierarchy", [&](JsonWriter &writer)
+    {
+        writer.Key("loaded");
+        writer.Bool(loaded);
+        writer.Key("objects");
+        writer.Uint64(cache.GetNumObjects());
+        writer.Key("queried");
+        writer.Uint(numQueried);
+        writer.Key("mismatched");
+        writer.Uint(numMismatched);
+        writer.Key("blockedMs");
+        writer.Double(blockedMs);
+        writer.Key("loadMs");
+        writer.Double(loadMs);
+    });
+
+    cache.Unload();
+    return loaded && numQueried && numMismatched == 0;
+}
+
+//the search box's object.get, as SearchParentContainers in WAAPIHelpers.cpp sends it
+static bool SearchBenchParents(const std::string &query, AK::WwiseAuthoringAPI::ResultView &resultsOut,
+                               AK::WwiseAuthoringAPI::AkJson &errorOut, AK::WwiseAuthoringAPI::Client &client)
+{
+    using namespace AK::WwiseAuthoringAPI;
+
+    AkJson::Array parentTypes;
+    for (const char *type : { "Folder", "WorkUnit", "RandomSequenceContainer", "BlendContainer", "ActorMixer",
+                              "SwitchContainer", "MusicSegment", "MusicSwitchContainer", "MusicPlaylistContainer" })
+    {
+        parentTypes.push_back(AkVariant(type));
+    }
+
+    const AkJson args(AkJson::Map{
+        { "from", AkJson::Map{ { "search", AkJson::Array{ AkVariant(query) } } } },
+        { "transform", AkJson::Array{ AkJson::Map{ { "where", AkJson::Array{ AkVariant("type:isIn"), parentTypes } } } } }
+    });
+    const AkJson searchOptions(AkJson::Map{
+        { "return", AkJson::Array{ AkVariant("id"), AkVariant("name"), AkVariant("path"), AkVariant("type") } }
+    });
+
+    return ResultViews::Call(client, ak::wwise::core::object::get, args, searchOptions, resultsOut, errorOut);
+}
+
+//types Generated_0000, Generated_0001... into WwiseParentSearch a key every 80ms, each matching ten of the actor-mixers
+//waapi_mock_server --generate 2000x100 makes among its 200k objects, and times from the last key to the results.
+//Then types them all again, which the cache answers. Last a query is superseded by another just after it was sent.
+//False if any typed query was searched more than once, a repeat wasn't answered from the cache, results were
+//announced for the superseded query or any results don't match their query
+static bool BenchSearch(uint32 numQueries, AK::WwiseAuthoringAPI::Client &client, ProgressWriter &progress)
+{
+    using namespace AK::WwiseAuthoringAPI;
+    using Clock = std::chrono::steady_clock;
+
+    //distinct queries, the last two are kept for superseding
+    numQueries = std::min(numQueries, 198u);
+
+    std::atomic<uint32> numSearches{ 0 };
+    std::atomic<uint32> numFailed{ 0 };
+    std::mutex notifyMutex;
+    std::condition_variable notified;
+    uint32 numNotified = 0;
+
+    WwiseParentSearch search(
+        [&](const std::string &query, ResultView &resultsOut, AkJson &errorOut)
+        {
+            ++numSearches;
+            const bool success = SearchBenchParents(query, resultsOut, errorOut, client);
+            numFailed += success ? 0 : 1;
+            return success;
+        },
+        [&](bool)
+        {
+            std::lock_guard<std::mutex> lock(notifyMutex);
+            ++numNotified;
+            notified.notify_all();
+        });
+
+    const auto keyInterval = std::chrono::milliseconds(80);
+    uint32 numKeys = 0;
+    uint32 numWrong = 0;
+
+    //types query and waits for its results, the time from the last key to them
+    auto Type = [&](const std::string &query, uint32 &numNotifiedOut) -> double
+    {
+        Clock::time_point lastKey;
+        for (size_t length = 1; length <= query.size(); ++length)
+        {
+            if (length > 1)
+            {
+                std::this_thread::sleep_for(keyInterval);
+            }
+            ++numKeys;
+            lastKey = Clock::now();
+            search.SetQuery(query.substr(0, length), 0);
+        }
+
+        std::shared_ptr<const WwiseParentSearch::Results> results;
+        std::unique_lock<std::mutex> lock(notifyMutex);
+        notified.wait_for(lock, std::chrono::seconds(30), [&] { return search.GetResults(results); });
+        numNotifiedOut = numNotified;
+        return std::chrono::duration<double, std::milli>(Clock::now() - lastKey).count();
+    };
+
+    auto IsRight = [](const std::string &query, const std::shared_ptr<const WwiseParentSearch::Results> &results)
+    {
+        if (!results || results->size() != 10)
+        {
+            return false;
+        }
+        for (const WwiseParentSearch::Result &result : *results)
+        {
+            if (result.type != "ActorMixer" || result.name.compare(0, query.size(), query) != 0)
+            {
+                return false;
+            }
+        }
+        return true;
+    };
+
+    std::vector<std::string> queries;
+    std::vector<std::shared_ptr<const WwiseParentSearch::Results>> typedResults;
+    std::vector<double> resultMs;
+    char query[32];
+    for (uint32 i = 0; i < numQueries; ++i)
+    {
+        snprintf(query, sizeof(query), "Generated_%04u", i);
+        queries.push_back(query);
+
+        uint32 notifiedNow = 0;
+        resultMs.push_back(Type(queries.back(), notifiedNow));
+
+        std::shared_ptr<const WwiseParentSearch::Results> results;
+        search.GetResults(results);
+        typedResults.push_back(results);
+        numWrong += IsRight(queries.back(), results) ? 0 : 1;
+    }
+    const uint32 numTypedSearches = numSearches;
+
+    //again, straight from the cache
+    double repeatMaxMicroseconds = 0.0;
+    uint32 numRepeatMisses = 0;
+    for (size_t i = 0; i < queries.size(); ++i)
+    {
+        const Clock::time_point start = Clock::now();
+        const bool cached = search.SetQuery(queries[i], 0);
+        std::shared_ptr<const WwiseParentSearch::Results> results;
+        search.GetResults(results);
+        repeatMaxMicroseconds = std::max(repeatMaxMicroseconds, std::chrono::duration<double, std::micro>(Clock::now() - start).count());
+        numRepeatMisses += cached && results == typedResults[i] ? 0 : 1;
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(WWISE_SEARCH_DEBOUNCE_MS + 100));
+    const uint32 numRepeatSearches = numSearches - numTypedSearches;
+
+    //a query sent and then typed over while Wwise is still searching
+    uint32 notifiedBefore;
+    {
+        std::lock_guard<std::mutex> lock(notifyMutex);
+        notifiedBefore = numNotified;
+    }
+    const uint32 searchesBefore = numSearches;
+    search.SetQuery("Generated_0198", 0);
+    while (numSearches == searchesBefore)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    uint32 notifiedAfter = 0;
+    const double supersedingMs = Type("Generated_0199", notifiedAfter);
+    std::shared_ptr<const WwiseParentSearch::Results> supersedingResults;
+    search.GetResults(supersedingResults);
+    const bool supersededRight = notifiedAfter == notifiedBefore + 1 && IsRight("Generated_0199", supersedingResults);
+
+    std::sort(resultMs.begin(), resultMs.end());
+
+    progress.Emit("search", [&](JsonWriter &writer)
+    {
+        writer.Key("queries");
+        writer.Uint(numQueries);
+        writer.Key("keys");
+        writer.Uint(numKeys);
+        writer.Key("searches");
+        writer.Uint(numTypedSearches);
+        writer.Key("resultMedianMs");
+        writer.Double(resultMs[resultMs.size() / 2]);
+        writer.Key("resultMaxMs");
+        writer.Double(resultMs.back());
+        writer.Key("repeatSearches");
+        writer.Uint(numRepeatSearches);
+        writer.Key("repeatMaxMicroseconds");
+        writer.Double(repeatMaxMicroseconds);
+        writer.Key("supersededCancelled");
+        writer.Uint(numFailed);
+        writer.Key("supersedingMs");
+        writer.Double(supersedingMs);
+        writer.Key("wrong");
+        writer.Uint(numWrong + numRepeatMisses + (supersededRight ? 0 : 1));
+    });
+
+    return numTypedSearches == numQueries && numWrong == 0 && numRepeatMisses == 0 && numRepeatSearches == 0 && supersededRight;
+}
+
+int main(int argc, char **argv)
+{
+    using namespace AK::WwiseAuthoringAPI;
+
+    BenchOptions options;
+    if (!ParseArgs(argc, argv, options))
+    {
+        PrintUsage();
+        return ExitBadArguments;
+    }
+
+    ProgressWriter progress;
+    bool succeeded = true;
+
+    if (options.serializeItems)
+    {
+        succeeded &= BenchSerialize(options.serializeItems, progress);
+    }
+
+    if (options.resultViewObjects)
+    {
+        succeeded &= BenchResultView(options.resultViewObjects, progress);
+    }
+
+    if (options.receiveFrames)
+    {
+        succeeded &= BenchReceive(options.receiveFrames, progress);
+    }
+
+    if (options.pendingThreads)
+    {
+        BenchPending(options.pendingThreads, progress);
+    }
+
+    if (options.sendThreads)
+    {
+        BenchSend(options.sendThreads, progress);
+    }
+
+    if (options.eventResults)
+    {
+        succeeded &= BenchEvents(options.eventResults, progress);
+    }
+
+    if (options.logThreads)
+    {
+        succeeded &= BenchLog(options.logThreads, progress);
+    }
+
+    if (options.traceSpans)
+    {
+        succeeded &= BenchTrace(options.traceSpans, progress);
+    }
+
+    if (options.queueRegions)
+    {
+        succeeded &= BenchQueue(options.queueRegions, progress);
+    }
+
+    if (options.analysisSeconds)
+    {
+        succeeded &= BenchAnalysis(options.analysisSeconds, options.jobs, progress);
+    }
+
+    if (options.importIds)
+    {
+        succeeded &= BenchImportIds(options.importIds, progress);
+    }
+
+    if (options.renderViewRows)
+    {
+        succeeded &= BenchRenderView(options.renderViewRows, progress);
+    }
+
+    if (options.UsesWaapi())
+    {
+        Client client;
+        if (!client.Connect(options.host.c_str(), options.port))
+        {
+            fprintf(stderr, "couldn't connect to WAAPI at %s:%u\n", options.host.c_str(), options.port);
+            return ExitConnectionFailed;
+        }
+
+        if (options.cancelCalls)
+        {
+            succeeded &= BenchCancel(options.cancelCalls, client, progress);
+        }
+
+        if (options.hierarchyTimeoutMs)
+        {
+            succeeded &= BenchHierarchy(static_cast<int>(options.hierarchyTimeoutMs), client, progress);
+        }
+
+        if (options.searchQueries)
+        {
+            succeeded &= BenchSearch(options.searchQueries, client, progress);
+        }
+
+        client.Disconnect();
+    }
+
+    AsyncLog::Shutdown();
+    return succeeded ? ExitSuccess : ExitBenchFailed;
+}
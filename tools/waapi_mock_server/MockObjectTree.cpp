@@ -0,0 +1,220 @@
+#include <algorithm>
+#include <cctype>
+#include <cstdio>
+
+#include "MockObjectTree.h"
+
+MockObjectTree::MockObjectTree(uint32 seed)
+    : m_root(new MockObject())
+    , m_guidRandom(seed)
+{
+    //the project root isn't a real object, it only exists to hang the hierarchies off
+    m_root->type = "Project";
+}
+
+void MockObjectTree::CreateDefaultHierarchy()
+{
+    static const char *hierarchies[] = {
+        "Actor-Mixer Hierarchy",
+        "Interactive Music Hierarchy",
+        "Events",
+        "Switches",
+        "States",
+        "Game Parameters",
+        "Master-Mixer Hierarchy"
+    };
+
+    for (const char *hierarchy : hierarchies)
+    {
+        MockObject *folder = FindChild(m_root.get(), hierarchy);
+        if (!folder)
+        {
+            folder = CreateChild(m_root.get(), hierarchy, "Folder");
+        }
+        if (!FindChild(folder, "Default Work Unit"))
+        {
+            CreateChild(folder, "Default Work Unit", "WorkUnit");
+        }
+    }
+}
+
+bool MockObjectTree::LoadJson(const rapidjson::Value &json, const std::string &parentPath, std::string &errorOut)
+{
+    MockObject *parent = parentPath.empty() ? m_root.get() : FindByPath(parentPath);
+    if (!parent)
+    {
+        errorOut = "parent '" + parentPath + "' doesn't exist";
+        return false;
+    }
+
+    if (!json.IsArray())
+    {
+        errorOut = "expected an array of objects under '" + parent->path + "'";
+        return false;
+    }
+
+    for (const rapidjson::Value &child : json.GetArray())
+    {
+        if (!child.IsObject() || !child.HasMember("name") || !child["name"].IsString())
+        {
+            errorOut = "object under '" + parent->path + "' has no name";
+            return false;
+        }
+
+        const std::string name = child["name"].GetString();
+        const std::string type = child.HasMember("type") && child["type"].IsString() ? child["type"].GetString() : "ActorMixer";
+
+        MockObject *object = FindChild(parent, name);
+        if (!object)
+        {
+            object = CreateChild(parent, name, type);
+        }
+
+        if (child.HasMember("notes") && child["notes"].IsString())
+        {
+            object->notes = child["notes"].GetString();
+        }
+
+        if (child.HasMember("children") && !LoadJson(child["children"], object->path, errorOut))
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+void MockObjectTree::Generate(uint32 numContainers, uint32 soundsPerContainer)
+{
+    CreateDefaultHierarchy();
+    MockObject *workUnit = FindByPath("\\Actor-Mixer Hierarchy\\Default Work Unit");
+
+    char name[64];
+    for (uint32 container = 0; container < numContainers; ++container)
+    {
+        snprintf(name, sizeof(name), "Generated_%05u", container);
+        MockObject *mixer = FindChild(workUnit, name);
+        if (!mixer)
+        {
+            mixer = CreateChild(workUnit, name, "ActorMixer");
+        }
+
+        for (uint32 sound = 0; sound < soundsPerContainer; ++sound)
+        {
+            snprintf(name, sizeof(name), "Generated_%05u_%04u", container, sound);
+            if (!FindChild(mixer, name))
+            {
+                CreateChild(mixer, name, "Sound");
+            }
+        }
+    }
+}
+
+MockObject *MockObjectTree::Find(const std::string &idOrPath) const
+{
+    if (idOrPath.empty())
+    {
+        return nullptr;
+    }
+    return idOrPath[0] == '{' ? FindById(idOrPath) : FindByPath(idOrPath);
+}
+
+MockObject *MockObjectTree::FindById(const std::string &id) const
+{
+    //WAAPI guids are case insensitive, ours are always upper case
+    std::string upperId = id;
+    std::transform(upperId.begin(), upperId.end(), upperId.begin(), [](char c) { return static_cast<char>(toupper(c)); });
+
+    auto found = m_byId.find(upperId);
+    return found != m_byId.end() ? found->second : nullptr;
+}
+
+MockObject *MockObjectTree::FindByPath(const std::string &path) const
+{
+    auto found = m_byPath.find(path);
+    return found != m_byPath.end() ? found->second : nullptr;
+}
+
+MockObject *MockObjectTree::FindChild(const MockObject *parent, const std::string &name) const
+{
+    return FindByPath(parent->path + "\\" + name);
+}
+
+MockObject *MockObjectTree::CreateChild(MockObject *parent, const std::string &name, const std::string &type)
+{
+    std::unique_ptr<MockObject> object(new MockObject());
+    object->id = MakeGuid();
+    object->name = name;
+    object->type = type;
+    object->path = parent->path + "\\" + name;
+    object->parent = parent;
+
+    MockObject *created = object.get();
+    m_byId.emplace(created->id, created);
+    m_byPath.emplace(created->path, created);
+    parent->children.push_back(std::move(object));
+    return created;
+}
+
+void MockObjectTree::Remove(MockObject *object)
+{
+    if (!object || object == m_root.get())
+    {
+        return;
+    }
+
+    Unindex(object);
+
+    auto &siblings = object->parent->children;
+    siblings.erase(std::remove_if(siblings.begin(), siblings.end(),
+                                  [object](const std::unique_ptr<MockObject> &sibling) { return sibling.get() == object; }),
+                   siblings.end());
+}
+
+void MockObjectTree::GetDescendants(const MockObject *object, std::vector<MockObject*> &objectsOut) const
+{
+    for (const auto &child : object->children)
+    {
+        objectsOut.push_back(child.get());
+        GetDescendants(child.get(), objectsOut);
+    }
+}
+
+void MockObjectTree::GetOfType(const std::string &type, std::vector<MockObject*> &objectsOut) const
+{
+    std::vector<MockObject*> all;
+    GetDescendants(m_root.get(), all);
+
+    for (MockObject *object : all)
+    {
+        if (object->type == type)
+        {
+            objectsOut.push_back(object);
+        }
+    }
+}
+
+std::string MockObjectTree::MakeGuid()
+{
+    const uint64_t high = m_guidRandom();
+    const uint64_t low = m_guidRandom();
+
+    char guid[40];
+    snprintf(guid, sizeof(guid), "{%08X-%04X-%04X-%04X-%012llX}",
+             static_cast<uint32>(high >> 32),
+             static_cast<uint32>((high >> 16) & 0xFFFF),
+             static_cast<uint32>(high & 0xFFFF),
+             static_cast<uint32>(low >> 48),
+             static_cast<unsigned long long>(low & 0xFFFFFFFFFFFFull));
+    return guid;
+}
+
+void MockObjectTree::Unindex(MockObject *object)
+{
+    for (const auto &child : object->children)
+    {
+        Unindex(child.get());
+    }
+    m_byId.erase(object->id);
+    m_byPath.erase(object->path);
+}
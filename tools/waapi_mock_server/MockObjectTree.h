@@ -0,0 +1,73 @@
+#pragma once
+#include <cstdint>
+#include <memory>
+#include <random>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <rapidjson/document.h>
+
+#include "types.h"
+
+struct MockObject
+{
+    std::string id;
+    std::string name;
+    std::string type;
+    std::string notes;
+    std::string path;
+
+    //sounds and audio sources
+    std::string language;
+    std::string audioFile;
+
+    MockObject *parent = nullptr;
+    std::vector<std::unique_ptr<MockObject>> children;
+};
+
+//In memory stand in for a wwise project. Paths are "\Actor-Mixer Hierarchy\Default Work Unit\name" like WAAPI,
+//ids are "{GUID}" strings generated from the seed so two runs with the same seed and calls get the same ids.
+//Not thread safe.
+class MockObjectTree
+{
+public:
+    explicit MockObjectTree(uint32 seed);
+
+    //the physical folders and default work units of a new project
+    void CreateDefaultHierarchy();
+
+    //[{ "name": "SFX", "type": "ActorMixer", "notes": "", "children": [...] }, ...]
+    //the top level array holds children of parentPath, objects that already exist are merged by name
+    bool LoadJson(const rapidjson::Value &json, const std::string &parentPath, std::string &errorOut);
+
+    //numContainers actor mixers of soundsPerContainer sounds each under the default actor-mixer work unit,
+    //for benchmarking queries against a big project
+    void Generate(uint32 numContainers, uint32 soundsPerContainer);
+
+    //"{GUID}" or "\path", nullptr if not found
+    MockObject *Find(const std::string &idOrPath) const;
+    MockObject *FindById(const std::string &id) const;
+    MockObject *FindByPath(const std::string &path) const;
+    MockObject *FindChild(const MockObject *parent, const std::string &name) const;
+
+    MockObject *CreateChild(MockObject *parent, const std::string &name, const std::string &type);
+
+    //removes the object and everything under it
+    void Remove(MockObject *object);
+
+    void GetDescendants(const MockObject *object, std::vector<MockObject*> &objectsOut) const;
+    void GetOfType(const std::string &type, std::vector<MockObject*> &objectsOut) const;
+
+    MockObject *GetRoot() const { return m_root.get(); }
+    size_t GetNumObjects() const { return m_byId.size(); }
+
+private:
+    std::string MakeGuid();
+    void Unindex(MockObject *object);
+
+    std::unique_ptr<MockObject> m_root;
+    std::unordered_map<std::string, MockObject*> m_byId;
+    std::unordered_map<std::string, MockObject*> m_byPath;
+    std::mt19937_64 m_guidRandom;
+};
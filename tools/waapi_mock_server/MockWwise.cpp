@@ -0,0 +1,1119 @@
+#include <algorithm>
+#include <cctype>
+#include <cstdio>
+#include <iterator>
+
+#include "MockWwise.h"
+
+namespace Procedures
+{
+    const char *getInfo = "ak.wwise.core.getInfo";
+    const char *getSelectedObjects = "ak.wwise.ui.getSelectedObjects";
+    const char *objectGet = "ak.wwise.core.object.get";
+    const char *audioImport = "ak.wwise.core.audio.import";
+    const char *objectSet = "ak.wwise.core.object.set";
+    const char *objectCreate = "ak.wwise.core.object.create";
+}
+
+namespace Errors
+{
+    const char *noSuchProcedure = "wamp.error.no_such_procedure";
+    const char *schemaValidation = "ak.wwise.schema_validation_failed";
+    const char *invalidObject = "ak.wwise.invalid_object";
+    const char *fileNotFound = "ak.wwise.file_not_found";
+    const char *injected = "ak.wwise.mock.injected_fault";
+}
+
+using Clock = std::chrono::steady_clock;
+
+static bool GetStringArray(const rapidjson::Value &json, std::vector<std::string> &valuesOut)
+{
+    if (!json.IsArray())
+    {
+        return false;
+    }
+    for (const rapidjson::Value &value : json.GetArray())
+    {
+        if (!value.IsString())
+        {
+            return false;
+        }
+        valuesOut.push_back(value.GetString());
+    }
+    return true;
+}
+
+static std::string ToLower(std::string text)
+{
+    std::transform(text.begin(), text.end(), text.begin(), [](char c) { return static_cast<char>(tolower(c)); });
+    return text;
+}
+
+//"<Sound SFX>name" type names used in import object paths to object types
+static std::string GetTypeFromPathTypeName(const std::string &typeName)
+{
+    static const std::map<std::string, std::string> s_typeNames = {
+        { "Sound SFX", "Sound" },
+        { "Sound Voice", "Sound" },
+        { "Music Track", "MusicTrack" },
+        { "Music Segment", "MusicSegment" },
+        { "Actor-Mixer", "ActorMixer" },
+        { "Random Container", "RandomSequenceContainer" },
+        { "Sequence Container", "RandomSequenceContainer" },
+        { "Switch Container", "SwitchContainer" },
+        { "Blend Container", "BlendContainer" },
+        { "Virtual Folder", "Folder" },
+        { "Work Unit", "WorkUnit" }
+    };
+
+    auto found = s_typeNames.find(typeName);
+    if (found != s_typeNames.end())
+    {
+        return found->second;
+    }
+
+    std::string type;
+    std::copy_if(typeName.begin(), typeName.end(), std::back_inserter(type), [](char c) { return c != ' ' && c != '-'; });
+    return type;
+}
+
+bool MockServerConfig::LoadJson(const rapidjson::Value &json, std::string &errorOut)
+{
+    if (!json.IsObject())
+    {
+        errorOut = "config is not an object";
+        return false;
+    }
+
+    struct NumberField
+    {
+        const char *key;
+        double *value;
+    };
+
+    const NumberField numberFields[] = {
+        { "latencyMs", &latencyMs },
+        { "jitterMs", &jitterMs },
+        { "perCallCostMs", &perCallCostMs },
+        { "perItemCostMs", &perItemCostMs },
+        { "maxCallsPerSecond", &maxCallsPerSecond },
+        { "maxItemsPerSecond", &maxItemsPerSecond },
+        { "maxBytesPerSecond", &maxBytesPerSecond },
+        { "errorRate", &errorRate },
+        { "dropRate", &dropRate },
+        { "slowRate", &slowRate },
+        { "slowFactor", &slowFactor }
+    };
+
+    for (const NumberField &field : numberFields)
+    {
+        auto member = json.FindMember(field.key);
+        if (member == json.MemberEnd())
+        {
+            continue;
+        }
+        if (!member->value.IsNumber())
+        {
+            errorOut = std::string(field.key) + " is not a number";
+            return false;
+        }
+        *field.value = member->value.GetDouble();
+    }
+
+    auto member = json.FindMember("disconnectAfterCalls");
+    if (member != json.MemberEnd())
+    {
+        if (!member->value.IsUint())
+        {
+            errorOut = "disconnectAfterCalls is not a positive integer";
+            return false;
+        }
+        disconnectAfterCalls = member->value.GetUint();
+    }
+
+    member = json.FindMember("seed");
+    if (member != json.MemberEnd())
+    {
+        if (!member->value.IsUint())
+        {
+            errorOut = "seed is not a positive integer";
+            return false;
+        }
+        seed = member->value.GetUint();
+    }
+
+    member = json.FindMember("checkAudioFiles");
+    if (member != json.MemberEnd())
+    {
+        if (!member->value.IsBool())
+        {
+            errorOut = "checkAudioFiles is not a bool";
+            return false;
+        }
+        checkAudioFiles = member->value.GetBool();
+    }
+
+    member = json.FindMember("faultProcedures");
+    if (member != json.MemberEnd() && !GetStringArray(member->value, faultProcedures))
+    {
+        errorOut = "faultProcedures is not an array of strings";
+        return false;
+    }
+
+    member = json.FindMember("unavailableProcedures");
+    if (member != json.MemberEnd() && !GetStringArray(member->value, unavailableProcedures))
+    {
+        errorOut = "unavailableProcedures is not an array of strings";
+        return false;
+    }
+
+    member = json.FindMember("selection");
+    if (member != json.MemberEnd() && !GetStringArray(member->value, selection))
+    {
+        errorOut = "selection is not an array of strings";
+        return false;
+    }
+
+    return true;
+}
+
+MockWwise::MockWwise(const MockServerConfig &config, MockObjectTree &objectTree)
+    : m_config(config)
+    , m_objectTree(objectTree)
+    , m_random(config.seed)
+{
+}
+
+MockWwise::~MockWwise()
+{
+    Detach();
+}
+
+void MockWwise::Attach(WampServer &server)
+{
+    m_server = &server;
+    m_running = true;
+
+    server.SetCallHandler([this](std::unique_ptr<WampServer::Call> call) { return OnCall(std::move(call)); });
+    server.SetConnectionHandler([this](WampServer::ConnectionId connection, bool connected) { OnConnection(connection, connected); });
+
+    m_processThread = std::thread(&MockWwise::ProcessThread, this);
+}
+
+void MockWwise::Detach()
+{
+    if (!m_running)
+    {
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(m_callMutex);
+        m_running = false;
+    }
+    m_callCondition.notify_all();
+
+    m_processThread.join();
+    m_responses.Stop();
+}
+
+bool MockWwise::OnCall(std::unique_ptr<WampServer::Call> call)
+{
+    if (m_config.disconnectAfterCalls)
+    {
+        std::lock_guard<std::mutex> lock(m_connectionMutex);
+        if (++m_connectionCalls[call->connection] >= m_config.disconnectAfterCalls)
+        {
+            fprintf(stderr, "fault: disconnecting connection %llu on call %u (%s)\n",
+                    static_cast<unsigned long long>(call->connection), m_config.disconnectAfterCalls, call->procedure.c_str());
+            m_server->Close(call->connection);
+            return false;
+        }
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(m_callMutex);
+        m_calls.push_back(std::move(call));
+    }
+    m_callCondition.notify_one();
+    return true;
+}
+
+void MockWwise::OnConnection(WampServer::ConnectionId connection, bool connected)
+{
+    fprintf(stderr, "connection %llu %s\n", static_cast<unsigned long long>(connection), connected ? "opened" : "closed");
+
+    if (!connected)
+    {
+        std::lock_guard<std::mutex> lock(m_connectionMutex);
+        m_connectionCalls.erase(connection);
+    }
+}
+
+void MockWwise::ProcessThread()
+{
+    for (;;)
+    {
+        std::unique_ptr<WampServer::Call> call;
+        {
+            std::unique_lock<std::mutex> lock(m_callMutex);
+            m_callCondition.wait(lock, [this]() { return !m_running || !m_calls.empty(); });
+            if (!m_running)
+            {
+                return;
+            }
+            call = std::move(m_calls.front());
+            m_calls.pop_front();
+        }
+
+        Process(*call);
+    }
+}
+
+void MockWwise::ScheduleResponse(std::unique_ptr<Response> response, double delayMs)
+{
+    const TimerQueue::Clock::time_point due = TimerQueue::Clock::now() + std::chrono::microseconds(static_cast<int64_t>(delayMs * 1000.0));
+
+    std::shared_ptr<Response> sharedResponse(std::move(response));
+    m_responses.Post(due, [this, sharedResponse]()
+    {
+        if (sharedResponse->errorUri.empty())
+        {
+            m_server->SendResult(sharedResponse->connection, sharedResponse->requestId, sharedResponse->kwargs);
+        }
+        else
+        {
+            m_server->SendError(sharedResponse->connection, sharedResponse->requestId, sharedResponse->errorUri.c_str(), sharedResponse->kwargs);
+        }
+    });
+}
+
+void MockWwise::Process(WampServer::Call &call)
+{
+    const Clock::time_point start = Clock::now();
+
+    //faults are drawn before the work so an injected error leaves the tree alone, a dropped reply doesn't
+    bool drop = false;
+    bool injectError = false;
+    bool slow = false;
+    if (IsFaultTarget(call.procedure))
+    {
+        drop = m_config.dropRate > 0.0 && Random01() < m_config.dropRate;
+        injectError = !drop && m_config.errorRate > 0.0 && Random01() < m_config.errorRate;
+        slow = m_config.slowRate > 0.0 && Random01() < m_config.slowRate;
+    }
+
+    std::unique_ptr<Response> response(new Response());
+    response->connection = call.connection;
+    response->requestId = call.requestId;
+    response->kwargs.SetObject();
+
+    Outcome outcome;
+    if (injectError)
+    {
+        outcome.errorUri = Errors::injected;
+        outcome.errorMessage = "Injected fault for " + call.procedure;
+    }
+    else if (std::find(m_config.unavailableProcedures.begin(), m_config.unavailableProcedures.end(), call.procedure) !=
+             m_config.unavailableProcedures.end())
+    {
+        outcome.errorUri = Errors::noSuchProcedure;
+        outcome.errorMessage = "The mock server is standing in for a Wwise without " + call.procedure;
+    }
+    else if (call.procedure == Procedures::getInfo)
+    {
+        outcome = GetInfo(call, response->kwargs);
+    }
+    else if (call.procedure == Procedures::getSelectedObjects)
+    {
+        outcome = GetSelectedObjects(call, response->kwargs);
+    }
+    else if (call.procedure == Procedures::objectGet)
+    {
+        outcome = GetObjects(call, response->kwargs);
+    }
+    else if (call.procedure == Procedures::audioImport)
+    {
+        outcome = Import(call, response->kwargs);
+    }
+    else if (call.procedure == Procedures::objectSet)
+    {
+        outcome = SetObjects(call, response->kwargs);
+    }
+    else if (call.procedure == Procedures::objectCreate)
+    {
+        outcome = CreateObject(call, response->kwargs);
+    }
+    else
+    {
+        outcome.errorUri = Errors::noSuchProcedure;
+        outcome.errorMessage = "The mock server doesn't implement " + call.procedure;
+    }
+
+    //processing time is the cost model, stretched to whichever throughput cap is tightest
+    double processingMs = m_config.perCallCostMs + m_config.perItemCostMs * outcome.items;
+    if (m_config.maxCallsPerSecond > 0.0)
+    {
+        processingMs = std::max(processingMs, 1000.0 / m_config.maxCallsPerSecond);
+    }
+    if (m_config.maxItemsPerSecond > 0.0)
+    {
+        processingMs = std::max(processingMs, outcome.items * 1000.0 / m_config.maxItemsPerSecond);
+    }
+    if (m_config.maxBytesPerSecond > 0.0)
+    {
+        processingMs = std::max(processingMs, outcome.bytes * 1000.0 / m_config.maxBytesPerSecond);
+    }
+
+    std::this_thread::sleep_until(start + std::chrono::microseconds(static_cast<int64_t>(processingMs * 1000.0)));
+
+    double latencyMs = m_config.latencyMs;
+    if (m_config.jitterMs > 0.0)
+    {
+        latencyMs += Random01() * m_config.jitterMs;
+    }
+    if (slow)
+    {
+        latencyMs *= m_config.slowFactor;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(m_statsMutex);
+        MockProcedureStats &stats = m_stats[call.procedure];
+        ++stats.calls;
+        stats.items += outcome.items;
+        stats.errors += !outcome.errorUri.empty() && !injectError ? 1 : 0;
+        stats.injectedErrors += injectError ? 1 : 0;
+        stats.dropped += drop ? 1 : 0;
+        stats.slowed += slow ? 1 : 0;
+        stats.processingMs += std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+    }
+
+    if (drop)
+    {
+        return;
+    }
+
+    if (!outcome.errorUri.empty())
+    {
+        //WAAPI errors carry the reason in ArgumentsKw.message
+        response->errorUri = outcome.errorUri;
+        response->kwargs.SetObject();
+        response->kwargs.AddMember("message", rapidjson::Value(outcome.errorMessage.c_str(), response->kwargs.GetAllocator()),
+                                   response->kwargs.GetAllocator());
+    }
+
+    ScheduleResponse(std::move(response), latencyMs);
+}
+
+MockWwise::Outcome MockWwise::GetInfo(const WampServer::Call &, rapidjson::Document &resultOut)
+{
+    auto &allocator = resultOut.GetAllocator();
+
+    rapidjson::Value version(rapidjson::kObjectType);
+    version.AddMember("displayName", "v2019.1.0.6947 (mock)", allocator);
+    version.AddMember("year", 2019, allocator);
+    version.AddMember("major", 1, allocator);
+    version.AddMember("minor", 0, allocator);
+    version.AddMember("build", 6947, allocator);
+    version.AddMember("nickname", "", allocator);
+
+    resultOut.AddMember("displayName", "Wwise (mock)", allocator);
+    resultOut.AddMember("branch", "mock", allocator);
+    resultOut.AddMember("version", version, allocator);
+    resultOut.AddMember("apiVersion", 1, allocator);
+    resultOut.AddMember("isCommandLine", true, allocator);
+    resultOut.AddMember("objectCount", static_cast<uint64_t>(m_objectTree.GetNumObjects()), allocator);
+
+    return Outcome();
+}
+
+MockWwise::Outcome MockWwise::GetSelectedObjects(const WampServer::Call &call, rapidjson::Document &resultOut)
+{
+    std::vector<MockObject*> objects;
+    for (const std::string &selected : m_config.selection)
+    {
+        if (MockObject *object = m_objectTree.Find(selected))
+        {
+            objects.push_back(object);
+        }
+    }
+
+    WriteObjects(objects, call, "objects", resultOut);
+
+    Outcome outcome;
+    outcome.items = objects.size();
+    return outcome;
+}
+
+MockWwise::Outcome MockWwise::GetObjects(const WampServer::Call &call, rapidjson::Document &resultOut)
+{
+    Outcome outcome;
+    const rapidjson::Value &args = call.GetArgs();
+
+    auto from = args.FindMember("from");
+    if (from == args.MemberEnd() || !from->value.IsObject() || from->value.MemberCount() != 1)
+    {
+        outcome.errorUri = Errors::schemaValidation;
+        outcome.errorMessage = "from must have exactly one of id, path, ofType or search";
+        return outcome;
+    }
+
+    const std::string fromKind = from->value.MemberBegin()->name.GetString();
+    std::vector<std::string> fromValues;
+    if (!GetStringArray(from->value.MemberBegin()->value, fromValues))
+    {
+        outcome.errorUri = Errors::schemaValidation;
+        outcome.errorMessage = "from." + fromKind + " must be an array of strings";
+        return outcome;
+    }
+
+    std::vector<MockObject*> objects;
+    if (fromKind == "id" || fromKind == "path")
+    {
+        for (const std::string &value : fromValues)
+        {
+            MockObject *object = fromKind == "id" ? m_objectTree.FindById(value) : m_objectTree.FindByPath(value);
+            if (object)
+            {
+                objects.push_back(object);
+            }
+        }
+    }
+    else if (fromKind == "ofType")
+    {
+        for (const std::string &type : fromValues)
+        {
+            m_objectTree.GetOfType(type, objects);
+        }
+    }
+    else if (fromKind == "search")
+    {
+        std::vector<MockObject*> all;
+        m_objectTree.GetDescendants(m_objectTree.GetRoot(), all);
+
+        for (const std::string &search : fromValues)
+        {
+            const std::string lowerSearch = ToLower(search);
+            for (MockObject *object : all)
+            {
+                if (ToLower(object->name).find(lowerSearch) != std::string::npos)
+                {
+                    objects.push_back(object);
+                }
+            }
+        }
+    }
+    else
+    {
+        outcome.errorUri = Errors::schemaValidation;
+        outcome.errorMessage = "from." + fromKind + " isn't supported by the mock server";
+        return outcome;
+    }
+
+    auto transforms = args.FindMember("transform");
+    if (transforms != args.MemberEnd())
+    {
+        if (!transforms->value.IsArray())
+        {
+            outcome.errorUri = Errors::schemaValidation;
+            outcome.errorMessage = "transform must be an array";
+            return outcome;
+        }
+
+        for (const rapidjson::Value &transform : transforms->value.GetArray())
+        {
+            if (!transform.IsObject() || transform.MemberCount() != 1)
+            {
+                outcome.errorUri = Errors::schemaValidation;
+                outcome.errorMessage = "each transform must be an object with one key";
+                return outcome;
+            }
+
+            const std::string transformKind = transform.MemberBegin()->name.GetString();
+            const rapidjson::Value &transformValue = transform.MemberBegin()->value;
+            std::vector<MockObject*> transformed;
+
+            if (transformKind == "select")
+            {
+                std::vector<std::string> selectors;
+                GetStringArray(transformValue, selectors);
+
+                for (MockObject *object : objects)
+                {
+                    for (const std::string &selector : selectors)
+                    {
+                        if (selector == "children")
+                        {
+                            for (const auto &child : object->children)
+                            {
+                                transformed.push_back(child.get());
+                            }
+                        }
+                        else if (selector == "descendants")
+                        {
+                            m_objectTree.GetDescendants(object, transformed);
+                        }
+                        else if (selector == "parent")
+                        {
+                            if (object->parent && object->parent != m_objectTree.GetRoot())
+                            {
+                                transformed.push_back(object->parent);
+                            }
+                        }
+                        else if (selector == "ancestors")
+                        {
+                            for (MockObject *parent = object->parent; parent && parent != m_objectTree.GetRoot(); parent = parent->parent)
+                            {
+                                transformed.push_back(parent);
+                            }
+                        }
+                    }
+                }
+            }
+            else if (transformKind == "where")
+            {
+                //["name:contains", "text"] or ["type:isIn", ["Sound", ...]]
+                if (!transformValue.IsArray() || transformValue.Size() != 2 || !transformValue[0].IsString())
+                {
+                    outcome.errorUri = Errors::schemaValidation;
+                    outcome.errorMessage = "where must be [condition, value]";
+                    return outcome;
+                }
+
+                const std::string condition = transformValue[0].GetString();
+                if (condition == "name:contains" && transformValue[1].IsString())
+                {
+                    const std::string lowerText = ToLower(transformValue[1].GetString());
+                    for (MockObject *object : objects)
+                    {
+                        if (ToLower(object->name).find(lowerText) != std::string::npos)
+                        {
+                            transformed.push_back(object);
+                        }
+                    }
+                }
+                else if (condition == "type:isIn")
+                {
+                    std::vector<std::string> types;
+                    GetStringArray(transformValue[1], types);
+                    for (MockObject *object : objects)
+                    {
+                        if (std::find(types.begin(), types.end(), object->type) != types.end())
+                        {
+                            transformed.push_back(object);
+                        }
+                    }
+                }
+                else
+                {
+                    outcome.errorUri = Errors::schemaValidation;
+                    outcome.errorMessage = "where " + condition + " isn't supported by the mock server";
+                    return outcome;
+                }
+            }
+            else if (transformKind == "distinct")
+            {
+                for (MockObject *object : objects)
+                {
+                    if (std::find(transformed.begin(), transformed.end(), object) == transformed.end())
+                    {
+                        transformed.push_back(object);
+                    }
+                }
+            }
+            else
+            {
+                outcome.errorUri = Errors::schemaValidation;
+                outcome.errorMessage = "transform " + transformKind + " isn't supported by the mock server";
+                return outcome;
+            }
+
+            objects.swap(transformed);
+        }
+    }
+
+    WriteObjects(objects, call, "return", resultOut);
+    outcome.items = objects.size();
+    return outcome;
+}
+
+MockWwise::Outcome MockWwise::Import(const WampServer::Call &call, rapidjson::Document &resultOut)
+{
+    struct PendingImport
+    {
+        MockObject *parent;
+
+        //typed path segments below parent, the last one is the imported object
+        std::vector<std::pair<std::string, std::string>> createPath;
+
+        std::string audioFile;
+        std::string language;
+        std::string notes;
+    };
+
+    Outcome outcome;
+    const rapidjson::Value &args = call.GetArgs();
+
+    std::string importOperation = "useExisting";
+    auto operation = args.FindMember("importOperation");
+    if (operation != args.MemberEnd() && operation->value.IsString())
+    {
+        importOperation = operation->value.GetString();
+    }
+    if (importOperation != "useExisting" && importOperation != "createNew" && importOperation != "replaceExisting")
+    {
+        outcome.errorUri = Errors::schemaValidation;
+        outcome.errorMessage = "unknown importOperation " + importOperation;
+        return outcome;
+    }
+
+    auto imports = args.FindMember("imports");
+    if (imports == args.MemberEnd() || !imports->value.IsArray())
+    {
+        outcome.errorUri = Errors::schemaValidation;
+        outcome.errorMessage = "imports must be an array";
+        return outcome;
+    }
+
+    static const rapidjson::Value s_noDefaults(rapidjson::kObjectType);
+    auto defaultsMember = args.FindMember("default");
+    const rapidjson::Value &defaults = defaultsMember != args.MemberEnd() && defaultsMember->value.IsObject() ? defaultsMember->value : s_noDefaults;
+
+    //validate everything first, WAAPI fails the whole call without touching the project
+    std::vector<PendingImport> pending;
+    for (const rapidjson::Value &item : imports->value.GetArray())
+    {
+        auto GetField = [&item, &defaults](const char *key) -> std::string
+        {
+            if (item.IsObject() && item.HasMember(key) && item[key].IsString())
+            {
+                return item[key].GetString();
+            }
+            if (defaults.HasMember(key) && defaults[key].IsString())
+            {
+                return defaults[key].GetString();
+            }
+            return std::string();
+        };
+
+        PendingImport import;
+        import.audioFile = GetField("audioFile");
+        import.language = GetField("importLanguage");
+        import.notes = GetField("audioSourceNotes");
+        const std::string importLocation = GetField("importLocation");
+        const std::string objectPath = GetField("objectPath");
+
+        if (import.audioFile.empty() || objectPath.empty())
+        {
+            outcome.errorUri = Errors::schemaValidation;
+            outcome.errorMessage = "imports need an audioFile and objectPath";
+            return outcome;
+        }
+
+        const bool absolutePath = objectPath[0] == '\\';
+        import.parent = absolutePath ? m_objectTree.GetRoot() : m_objectTree.Find(importLocation);
+        if (!import.parent)
+        {
+            outcome.errorUri = Errors::invalidObject;
+            outcome.errorMessage = "importLocation " + importLocation + " doesn't exist";
+            return outcome;
+        }
+
+        //"\Existing\<Actor-Mixer>New\<Sound SFX>Name", untyped segments have to exist already
+        size_t segmentStart = absolutePath ? 1 : 0;
+        while (segmentStart <= objectPath.size())
+        {
+            size_t segmentEnd = objectPath.find('\\', segmentStart);
+            if (segmentEnd == std::string::npos)
+            {
+                segmentEnd = objectPath.size();
+            }
+
+            const std::string segment = objectPath.substr(segmentStart, segmentEnd - segmentStart);
+            segmentStart = segmentEnd + 1;
+
+            if (segment.empty())
+            {
+                continue;
+            }
+
+            if (segment[0] == '<')
+            {
+                const size_t typeEnd = segment.find('>');
+                if (typeEnd == std::string::npos || typeEnd + 1 == segment.size())
+                {
+                    outcome.errorUri = Errors::schemaValidation;
+                    outcome.errorMessage = "bad objectPath segment " + segment;
+                    return outcome;
+                }
+                import.createPath.emplace_back(GetTypeFromPathTypeName(segment.substr(1, typeEnd - 1)), segment.substr(typeEnd + 1));
+            }
+            else if (!import.createPath.empty())
+            {
+                outcome.errorUri = Errors::schemaValidation;
+                outcome.errorMessage = "objectPath segment " + segment + " needs a type";
+                return outcome;
+            }
+            else
+            {
+                import.parent = m_objectTree.FindChild(import.parent, segment);
+                if (!import.parent)
+                {
+                    outcome.errorUri = Errors::invalidObject;
+                    outcome.errorMessage = "objectPath " + objectPath + " doesn't exist";
+                    return outcome;
+                }
+            }
+        }
+
+        if (import.createPath.empty())
+        {
+            outcome.errorUri = Errors::schemaValidation;
+            outcome.errorMessage = "objectPath " + objectPath + " has no typed object to import";
+            return outcome;
+        }
+
+        std::error_code error;
+        const uintmax_t fileSize = fs::file_size(fs::u8path(import.audioFile), error);
+        if (!error)
+        {
+            outcome.bytes += fileSize;
+        }
+        else if (m_config.checkAudioFiles)
+        {
+            outcome.errorUri = Errors::fileNotFound;
+            outcome.errorMessage = "audio file " + import.audioFile + " doesn't exist";
+            return outcome;
+        }
+
+        pending.push_back(std::move(import));
+    }
+
+    auto &allocator = resultOut.GetAllocator();
+    rapidjson::Value objects(rapidjson::kArrayType);
+
+    for (const PendingImport &import : pending)
+    {
+        MockObject *parent = import.parent;
+        for (size_t i = 0; i + 1 < import.createPath.size(); ++i)
+        {
+            MockObject *existing = m_objectTree.FindChild(parent, import.createPath[i].second);
+            parent = existing ? existing : m_objectTree.CreateChild(parent, import.createPath[i].second, import.createPath[i].first);
+        }
+
+        const std::string &type = import.createPath.back().first;
+        std::string name = import.createPath.back().second;
+        MockObject *object = m_objectTree.FindChild(parent, name);
+
+        if (object && importOperation == "replaceExisting")
+        {
+            m_objectTree.Remove(object);
+            object = nullptr;
+        }
+        else if (object && importOperation == "createNew")
+        {
+            //wwise keeps the existing object and numbers the new one
+            const std::string baseName = name;
+            char suffix[16];
+            for (int i = 1; m_objectTree.FindChild(parent, name); ++i)
+            {
+                snprintf(suffix, sizeof(suffix), "_%02d", i);
+                name = baseName + suffix;
+            }
+            object = nullptr;
+        }
+
+        if (!object)
+        {
+            object = m_objectTree.CreateChild(parent, name, type);
+        }
+        object->language = import.language;
+
+        //one source per language, a reimport replaces it
+        const std::string sourceName = fs::u8path(import.audioFile).stem().u8string();
+        for (const auto &child : object->children)
+        {
+            if (child->type == "AudioFileSource" && child->language == import.language)
+            {
+                m_objectTree.Remove(child.get());
+                break;
+            }
+        }
+
+        MockObject *source = m_objectTree.CreateChild(object, sourceName, "AudioFileSource");
+        source->language = import.language;
+        source->audioFile = import.audioFile;
+        source->notes = import.notes;
+
+        rapidjson::Value imported(rapidjson::kObjectType);
+        imported.AddMember("id", rapidjson::Value(object->id.c_str(), allocator), allocator);
+        imported.AddMember("name", rapidjson::Value(object->name.c_str(), allocator), allocator);
+        imported.AddMember("path", rapidjson::Value(object->path.c_str(), allocator), allocator);
+        objects.PushBack(imported, allocator);
+    }
+
+    resultOut.AddMember("objects", objects, allocator);
+    outcome.items = pending.size();
+    return outcome;
+}
+
+//objects in a "children" array and everything below them
+static size_t CountChildren(const rapidjson::Value &children)
+{
+    size_t count = 0;
+    if (children.IsArray())
+    {
+        for (const rapidjson::Value &child : children.GetArray())
+        {
+            ++count;
+            if (child.IsObject() && child.HasMember("children"))
+            {
+                count += CountChildren(child["children"]);
+            }
+        }
+    }
+    return count;
+}
+
+//only merge is modelled, anything else that would hit an existing object is refused
+static bool CheckNameConflict(const rapidjson::Value &args, MockObjectTree &tree, const MockObject *parent,
+                              const rapidjson::Value &children, std::string &errorOut)
+{
+    std::string onNameConflict = "fail";
+    auto member = args.FindMember("onNameConflict");
+    if (member != args.MemberEnd() && member->value.IsString())
+    {
+        onNameConflict = member->value.GetString();
+    }
+
+    if (onNameConflict == "merge")
+    {
+        return true;
+    }
+    if (onNameConflict != "fail")
+    {
+        errorOut = "onNameConflict " + onNameConflict + " isn't supported by the mock server";
+        return false;
+    }
+
+    for (const rapidjson::Value &child : children.GetArray())
+    {
+        if (child.IsObject() && child.HasMember("name") && child["name"].IsString()
+            && tree.FindChild(parent, child["name"].GetString()))
+        {
+            errorOut = std::string("an object named ") + child["name"].GetString() + " already exists under " + parent->path;
+            return false;
+        }
+    }
+    return true;
+}
+
+MockWwise::Outcome MockWwise::SetObjects(const WampServer::Call &call, rapidjson::Document &resultOut)
+{
+    Outcome outcome;
+    const rapidjson::Value &args = call.GetArgs();
+
+    //{ "objects": [{ "object": "{GUID}" or "\path", "children": [{ "type", "name", "children" }] }] }
+    //only creating children is modelled, property and reference changes are ignored
+    auto objects = args.FindMember("objects");
+    if (objects == args.MemberEnd() || !objects->value.IsArray())
+    {
+        outcome.errorUri = Errors::schemaValidation;
+        outcome.errorMessage = "objects must be an array";
+        return outcome;
+    }
+
+    //validate everything first, WAAPI fails the whole call without touching the project
+    std::vector<std::pair<MockObject*, const rapidjson::Value*>> targets;
+    for (const rapidjson::Value &object : objects->value.GetArray())
+    {
+        if (!object.IsObject() || !object.HasMember("object") || !object["object"].IsString())
+        {
+            outcome.errorUri = Errors::schemaValidation;
+            outcome.errorMessage = "each entry in objects needs an object";
+            return outcome;
+        }
+
+        MockObject *target = m_objectTree.Find(object["object"].GetString());
+        if (!target)
+        {
+            outcome.errorUri = Errors::invalidObject;
+            outcome.errorMessage = std::string("object ") + object["object"].GetString() + " doesn't exist";
+            return outcome;
+        }
+
+        auto children = object.FindMember("children");
+        if (children == object.MemberEnd())
+        {
+            continue;
+        }
+        if (!children->value.IsArray())
+        {
+            outcome.errorUri = Errors::schemaValidation;
+            outcome.errorMessage = "children must be an array";
+            return outcome;
+        }
+        if (!CheckNameConflict(args, m_objectTree, target, children->value, outcome.errorMessage))
+        {
+            outcome.errorUri = Errors::invalidObject;
+            return outcome;
+        }
+
+        targets.push_back({ target, &children->value });
+        outcome.items += CountChildren(children->value);
+    }
+
+    for (const auto &target : targets)
+    {
+        if (!m_objectTree.LoadJson(*target.second, target.first->path, outcome.errorMessage))
+        {
+            outcome.errorUri = Errors::schemaValidation;
+            return outcome;
+        }
+    }
+
+    resultOut.AddMember("objects", rapidjson::Value(rapidjson::kArrayType), resultOut.GetAllocator());
+    return outcome;
+}
+
+MockWwise::Outcome MockWwise::CreateObject(const WampServer::Call &call, rapidjson::Document &resultOut)
+{
+    Outcome outcome;
+    const rapidjson::Value &args = call.GetArgs();
+
+    if (!args.HasMember("parent") || !args["parent"].IsString() || !args.HasMember("name") || !args["name"].IsString()
+        || !args.HasMember("type") || !args["type"].IsString())
+    {
+        outcome.errorUri = Errors::schemaValidation;
+        outcome.errorMessage = "object.create needs a parent, type and name";
+        return outcome;
+    }
+
+    MockObject *parent = m_objectTree.Find(args["parent"].GetString());
+    if (!parent)
+    {
+        outcome.errorUri = Errors::invalidObject;
+        outcome.errorMessage = std::string("parent ") + args["parent"].GetString() + " doesn't exist";
+        return outcome;
+    }
+
+    //the created object is the one entry of a children array, so LoadJson can make it and what's below it
+    rapidjson::Document created;
+    created.SetArray();
+    created.PushBack(rapidjson::Value(args, created.GetAllocator()), created.GetAllocator());
+
+    if (!CheckNameConflict(args, m_objectTree, parent, created, outcome.errorMessage))
+    {
+        outcome.errorUri = Errors::invalidObject;
+        return outcome;
+    }
+
+    outcome.items = CountChildren(created);
+    if (!m_objectTree.LoadJson(created, parent->path, outcome.errorMessage))
+    {
+        outcome.errorUri = Errors::schemaValidation;
+        return outcome;
+    }
+
+    const MockObject *object = m_objectTree.FindChild(parent, args["name"].GetString());
+    auto &allocator = resultOut.GetAllocator();
+    resultOut.AddMember("id", rapidjson::Value(object->id.c_str(), allocator), allocator);
+    resultOut.AddMember("name", rapidjson::Value(object->name.c_str(), allocator), allocator);
+    return outcome;
+}
+
+void MockWwise::WriteObjects(const std::vector<MockObject*> &objects, const WampServer::Call &call,
+                             const char *key, rapidjson::Document &resultOut) const
+{
+    std::vector<std::string> fields;
+    const rapidjson::Value &options = call.GetOptions();
+    auto returnFields = options.FindMember("return");
+    if (returnFields == options.MemberEnd() || !GetStringArray(returnFields->value, fields))
+    {
+        fields = { "id", "name" };
+    }
+
+    auto &allocator = resultOut.GetAllocator();
+    rapidjson::Value results(rapidjson::kArrayType);
+    results.Reserve(static_cast<rapidjson::SizeType>(objects.size()), allocator);
+
+    for (const MockObject *object : objects)
+    {
+        rapidjson::Value result(rapidjson::kObjectType);
+
+        for (const std::string &field : fields)
+        {
+            rapidjson::Value fieldName(field.c_str(), allocator);
+
+            if (field == "id") result.AddMember(fieldName, rapidjson::Value(object->id.c_str(), allocator), allocator);
+            else if (field == "name") result.AddMember(fieldName, rapidjson::Value(object->name.c_str(), allocator), allocator);
+            else if (field == "type") result.AddMember(fieldName, rapidjson::Value(object->type.c_str(), allocator), allocator);
+            else if (field == "path") result.AddMember(fieldName, rapidjson::Value(object->path.c_str(), allocator), allocator);
+            else if (field == "notes") result.AddMember(fieldName, rapidjson::Value(object->notes.c_str(), allocator), allocator);
+            else if (field == "childrenCount") result.AddMember(fieldName, static_cast<uint32>(object->children.size()), allocator);
+            else if (field == "parent" && object->parent && object->parent != m_objectTree.GetRoot())
+            {
+                rapidjson::Value parent(rapidjson::kObjectType);
+                parent.AddMember("id", rapidjson::Value(object->parent->id.c_str(), allocator), allocator);
+                parent.AddMember("name", rapidjson::Value(object->parent->name.c_str(), allocator), allocator);
+                result.AddMember(fieldName, parent, allocator);
+            }
+            else if (field == "sound:originalWavFilePath" && !object->audioFile.empty())
+            {
+                result.AddMember(fieldName, rapidjson::Value(object->audioFile.c_str(), allocator), allocator);
+            }
+            //anything else is left out, like WAAPI does for properties an object doesn't have
+        }
+
+        results.PushBack(result, allocator);
+    }
+
+    resultOut.AddMember(rapidjson::Value(key, allocator), results, allocator);
+}
+
+bool MockWwise::IsFaultTarget(const std::string &procedure) const
+{
+    return m_config.faultProcedures.empty() ||
+        std::find(m_config.faultProcedures.begin(), m_config.faultProcedures.end(), procedure) != m_config.faultProcedures.end();
+}
+
+double MockWwise::Random01()
+{
+    return std::uniform_real_distribution<double>(0.0, 1.0)(m_random);
+}
+
+std::map<std::string, MockProcedureStats> MockWwise::GetStats() const
+{
+    std::lock_guard<std::mutex> lock(m_statsMutex);
+    return m_stats;
+}
+
+std::string MockWwise::FormatStats() const
+{
+    const auto stats = GetStats();
+
+    std::string report;
+    char line[256];
+
+    snprintf(line, sizeof(line), "%-32s %7s %8s %7s %8s %7s %6s %12s\n",
+             "procedure", "calls", "items", "errors", "injected", "dropped", "slow", "busy ms");
+    report += line;
+
+    for (const auto &procedure : stats)
+    {
+        const MockProcedureStats &procedureStats = procedure.second;
+        snprintf(line, sizeof(line), "%-32s %7llu %8llu %7llu %8llu %7llu %6llu %12.1f\n",
+                 procedure.first.c_str(),
+                 static_cast<unsigned long long>(procedureStats.calls),
+                 static_cast<unsigned long long>(procedureStats.items),
+                 static_cast<unsigned long long>(procedureStats.errors),
+                 static_cast<unsigned long long>(procedureStats.injectedErrors),
+                 static_cast<unsigned long long>(procedureStats.dropped),
+                 static_cast<unsigned long long>(procedureStats.slowed),
+                 procedureStats.processingMs);
+        report += line;
+    }
+
+    return report;
+}
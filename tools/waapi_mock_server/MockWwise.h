@@ -0,0 +1,156 @@
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <map>
+#include <mutex>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <rapidjson/document.h>
+
+#include "MockObjectTree.h"
+#include "TimerQueue.h"
+#include "WampServer.h"
+
+//How the mock behaves, every field can come from the config file (same key names) or the command line.
+//
+//Calls are processed one at a time like wwise does on its main thread: perCallCostMs + perItemCostMs * items,
+//stretched to respect the throughput caps. latencyMs (+ jitter) is added after processing and overlaps between
+//calls, so pipelined clients hide it but not the processing cost.
+struct MockServerConfig
+{
+    double latencyMs = 0.0;
+    double jitterMs = 0.0;
+    double perCallCostMs = 0.0;
+    double perItemCostMs = 0.0;
+
+    //0 is unlimited. bytes are the sizes of the imported audio files
+    double maxCallsPerSecond = 0.0;
+    double maxItemsPerSecond = 0.0;
+    double maxBytesPerSecond = 0.0;
+
+    //fault injection, rates are the chance per call (0-1)
+    double errorRate = 0.0;
+    double dropRate = 0.0;
+    double slowRate = 0.0;
+    double slowFactor = 10.0;
+
+    //close the connection on receiving this many calls (counted per connection), 0 never does
+    uint32 disconnectAfterCalls = 0;
+
+    //faults only hit these procedures, empty hits all of them
+    std::vector<std::string> faultProcedures;
+
+    //answered with wamp.error.no_such_procedure, like a Wwise version from before they were added
+    std::vector<std::string> unavailableProcedures;
+
+    //fail imports of audio files that don't exist, off so plans can be benchmarked without rendering
+    bool checkAudioFiles = false;
+
+    //paths or ids returned by ak.wwise.ui.getSelectedObjects
+    std::vector<std::string> selection;
+
+    //seeds the fault/jitter random numbers and the object ids
+    uint32 seed = 1;
+
+    //reads the keys present in the json object over the top of the current values
+    bool LoadJson(const rapidjson::Value &json, std::string &errorOut);
+};
+
+struct MockProcedureStats
+{
+    uint64_t calls = 0;
+    uint64_t items = 0;
+    uint64_t errors = 0;
+    uint64_t injectedErrors = 0;
+    uint64_t dropped = 0;
+    uint64_t slowed = 0;
+    double processingMs = 0.0;
+};
+
+//WAAPI stand in: ak.wwise.core.getInfo, ak.wwise.ui.getSelectedObjects, ak.wwise.core.object.get,
+//ak.wwise.core.object.set/create (creating children only) and ak.wwise.core.audio.import over an in memory object
+//tree, with the latency and fault model from MockServerConfig.
+class MockWwise
+{
+public:
+    MockWwise(const MockServerConfig &config, MockObjectTree &objectTree);
+    ~MockWwise();
+
+    //installs the call handler and starts the processing threads, call before server.Start
+    void Attach(WampServer &server);
+    void Detach();
+
+    std::map<std::string, MockProcedureStats> GetStats() const;
+    std::string FormatStats() const;
+
+private:
+    struct Response
+    {
+        WampServer::ConnectionId connection;
+        uint64_t requestId;
+
+        //empty for a result
+        std::string errorUri;
+        rapidjson::Document kwargs;
+    };
+
+    //what a procedure handler produced, items is the work it did for the cost model
+    struct Outcome
+    {
+        std::string errorUri;
+        std::string errorMessage;
+        size_t items = 0;
+        uint64_t bytes = 0;
+    };
+
+    bool OnCall(std::unique_ptr<WampServer::Call> call);
+    void OnConnection(WampServer::ConnectionId connection, bool connected);
+
+    void ProcessThread();
+
+    void Process(WampServer::Call &call);
+    void ScheduleResponse(std::unique_ptr<Response> response, double delayMs);
+
+    Outcome GetInfo(const WampServer::Call &call, rapidjson::Document &resultOut);
+    Outcome GetSelectedObjects(const WampServer::Call &call, rapidjson::Document &resultOut);
+    Outcome GetObjects(const WampServer::Call &call, rapidjson::Document &resultOut);
+    Outcome Import(const WampServer::Call &call, rapidjson::Document &resultOut);
+    Outcome SetObjects(const WampServer::Call &call, rapidjson::Document &resultOut);
+    Outcome CreateObject(const WampServer::Call &call, rapidjson::Document &resultOut);
+
+    void WriteObjects(const std::vector<MockObject*> &objects, const WampServer::Call &call,
+                      const char *key, rapidjson::Document &resultOut) const;
+
+    bool IsFaultTarget(const std::string &procedure) const;
+    double Random01();
+
+    const MockServerConfig m_config;
+    MockObjectTree &m_objectTree;
+    WampServer *m_server = nullptr;
+
+    std::atomic<bool> m_running{ false };
+
+    //calls waiting for the processing thread, in arrival order
+    std::mutex m_callMutex;
+    std::condition_variable m_callCondition;
+    std::deque<std::unique_ptr<WampServer::Call>> m_calls;
+    std::thread m_processThread;
+
+    //processed calls waiting out their latency
+    TimerQueue m_responses;
+
+    //only used on the processing thread so a seed gives the same faults for the same call order
+    std::mt19937 m_random;
+
+    //calls received per connection for disconnectAfterCalls
+    std::mutex m_connectionMutex;
+    std::map<WampServer::ConnectionId, uint32> m_connectionCalls;
+
+    mutable std::mutex m_statsMutex;
+    std::map<std::string, MockProcedureStats> m_stats;
+};
@@ -0,0 +1,242 @@
+//Local WAAPI stand in for benchmarking and fault testing the transfer without Wwise.
+//Serves ak.wwise.core.getInfo, ak.wwise.ui.getSelectedObjects, ak.wwise.core.object.get, ak.wwise.core.object.set,
+//ak.wwise.core.object.create and ak.wwise.core.audio.import over an in memory project, with configurable latency,
+//cost, throughput caps and faults.
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <csignal>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <thread>
+
+#include <rapidjson/document.h>
+
+#include "MockObjectTree.h"
+#include "MockWwise.h"
+#include "WampServer.h"
+#include "config.h"
+#include "types.h"
+
+enum ExitCode
+{
+    ExitSuccess = 0,
+    ExitBadArguments = 2,
+    ExitListenFailed = 3
+};
+
+struct MockOptions
+{
+    uint32 port = WAAPI_DEFAULT_PORT;
+    uint32 threads = 8;
+    fs::path configFile;
+    fs::path treeFile;
+    uint32 generateContainers = 0;
+    uint32 generateSounds = 0;
+
+    //0 runs until interrupted
+    double durationSeconds = 0.0;
+
+    MockServerConfig server;
+};
+
+static std::atomic<bool> s_interrupted{ false };
+
+static void OnInterrupt(int)
+{
+    s_interrupted = true;
+}
+
+static void PrintUsage()
+{
+    fprintf(stderr,
+            "usage: waapi_mock_server [options]\n"
+            "\n"
+            "  --port <port>              listen port (default %d)\n"
+            "  --threads <n>              connections served at once (default 8)\n"
+            "  --config <file>            json with any MockServerConfig field (see MockWwise.h), flags override it\n"
+            "  --tree <file>              objects to add to the default hierarchy (see MockObjectTree.h)\n"
+            "  --generate <n>x<m>         add n actor-mixers of m sounds each\n"
+            "  --select <path|id>         object returned by getSelectedObjects, repeatable\n"
+            "  --duration <seconds>       exit after this long, default runs until ctrl+c\n"
+            "\n"
+            "  --latency <ms>             added to every response, overlaps between calls\n"
+            "  --jitter <ms>              random extra latency up to this\n"
+            "  --call-cost <ms>           processing time per call, calls are processed one at a time\n"
+            "  --item-cost <ms>           processing time per imported or returned object\n"
+            "  --max-calls <n>            calls per second cap\n"
+            "  --max-items <n>            items per second cap\n"
+            "  --max-bytes <n>            imported audio bytes per second cap\n"
+            "\n"
+            "  --error-rate <0-1>         chance a call fails with ak.wwise.mock.injected_fault\n"
+            "  --drop-rate <0-1>          chance a call is processed but never answered\n"
+            "  --slow-rate <0-1>          chance a response takes --slow-factor times the latency\n"
+            "  --slow-factor <x>          (default 10)\n"
+            "  --disconnect-after <n>     close each connection on its nth call\n"
+            "  --fault-procedure <uri>    only inject faults into this procedure, repeatable\n"
+            "  --unavailable <uri>        answer this procedure with no_such_procedure, repeatable\n"
+            "  --check-files              fail imports of audio files that don't exist\n"
+            "  --seed <n>                 seeds faults, jitter and object ids (default 1)\n",
+            WAAPI_DEFAULT_PORT);
+}
+
+static bool ReadJsonFile(const fs::path &path, rapidjson::Document &documentOut, std::string &errorOut)
+{
+    std::ifstream file(path);
+    if (!file.is_open())
+    {
+        errorOut = "couldn't open " + path.generic_string();
+        return false;
+    }
+
+    std::stringstream contents;
+    contents << file.rdbuf();
+    documentOut.Parse(contents.str().c_str());
+    if (documentOut.HasParseError())
+    {
+        errorOut = path.generic_string() + " isn't valid json (offset " + std::to_string(documentOut.GetErrorOffset()) + ")";
+        return false;
+    }
+    return true;
+}
+
+static bool ParseArgs(int argc, char **argv, MockOptions &options)
+{
+    //the config file is loaded first so the flags override it wherever they are
+    for (int i = 1; i + 1 < argc; ++i)
+    {
+        if (std::string(argv[i]) == "--config")
+        {
+            options.configFile = argv[i + 1];
+
+            rapidjson::Document config;
+            std::string error;
+            if (!ReadJsonFile(options.configFile, config, error) || !options.server.LoadJson(config, error))
+            {
+                fprintf(stderr, "config error: %s\n", error.c_str());
+                return false;
+            }
+        }
+    }
+
+    MockServerConfig &server = options.server;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        const std::string arg = argv[i];
+        const bool hasValue = i + 1 < argc;
+
+        if (arg == "--config" && hasValue) ++i;
+        else if (arg == "--port" && hasValue) options.port = static_cast<uint32>(std::atoi(argv[++i]));
+        else if (arg == "--threads" && hasValue) options.threads = static_cast<uint32>(std::max(1, std::atoi(argv[++i])));
+        else if (arg == "--tree" && hasValue) options.treeFile = argv[++i];
+        else if (arg == "--generate" && hasValue)
+        {
+            unsigned containers = 0;
+            unsigned sounds = 0;
+            if (sscanf(argv[++i], "%ux%u", &containers, &sounds) != 2)
+            {
+                fprintf(stderr, "--generate expects <containers>x<sounds>\n");
+                return false;
+            }
+            options.generateContainers = containers;
+            options.generateSounds = sounds;
+        }
+        else if (arg == "--select" && hasValue) server.selection.push_back(argv[++i]);
+        else if (arg == "--duration" && hasValue) options.durationSeconds = std::atof(argv[++i]);
+        else if (arg == "--latency" && hasValue) server.latencyMs = std::atof(argv[++i]);
+        else if (arg == "--jitter" && hasValue) server.jitterMs = std::atof(argv[++i]);
+        else if (arg == "--call-cost" && hasValue) server.perCallCostMs = std::atof(argv[++i]);
+        else if (arg == "--item-cost" && hasValue) server.perItemCostMs = std::atof(argv[++i]);
+        else if (arg == "--max-calls" && hasValue) server.maxCallsPerSecond = std::atof(argv[++i]);
+        else if (arg == "--max-items" && hasValue) server.maxItemsPerSecond = std::atof(argv[++i]);
+        else if (arg == "--max-bytes" && hasValue) server.maxBytesPerSecond = std::atof(argv[++i]);
+        else if (arg == "--error-rate" && hasValue) server.errorRate = std::atof(argv[++i]);
+        else if (arg == "--drop-rate" && hasValue) server.dropRate = std::atof(argv[++i]);
+        else if (arg == "--slow-rate" && hasValue) server.slowRate = std::atof(argv[++i]);
+        else if (arg == "--slow-factor" && hasValue) server.slowFactor = std::atof(argv[++i]);
+        else if (arg == "--disconnect-after" && hasValue) server.disconnectAfterCalls = static_cast<uint32>(std::atoi(argv[++i]));
+        else if (arg == "--fault-procedure" && hasValue) server.faultProcedures.push_back(argv[++i]);
+        else if (arg == "--unavailable" && hasValue) server.unavailableProcedures.push_back(argv[++i]);
+        else if (arg == "--check-files") server.checkAudioFiles = true;
+        else if (arg == "--seed" && hasValue) server.seed = static_cast<uint32>(std::strtoul(argv[++i], nullptr, 10));
+        else
+        {
+            if (arg != "--help" && arg != "-h")
+            {
+                fprintf(stderr, "unknown option %s\n", arg.c_str());
+            }
+            return false;
+        }
+    }
+
+    return true;
+}
+
+int main(int argc, char **argv)
+{
+    MockOptions options;
+    if (!ParseArgs(argc, argv, options))
+    {
+        PrintUsage();
+        return ExitBadArguments;
+    }
+
+    MockObjectTree objectTree(options.server.seed);
+    objectTree.CreateDefaultHierarchy();
+
+    if (!options.treeFile.empty())
+    {
+        rapidjson::Document tree;
+        std::string error;
+        if (!ReadJsonFile(options.treeFile, tree, error) || !objectTree.LoadJson(tree, std::string(), error))
+        {
+            fprintf(stderr, "tree error: %s\n", error.c_str());
+            return ExitBadArguments;
+        }
+    }
+
+    if (options.generateContainers)
+    {
+        objectTree.Generate(options.generateContainers, options.generateSounds);
+    }
+
+    MockWwise mock(options.server, objectTree);
+    WampServer server;
+    mock.Attach(server);
+
+    std::string error;
+    if (!server.Start(options.port, options.threads, error))
+    {
+        fprintf(stderr, "%s\n", error.c_str());
+        return ExitListenFailed;
+    }
+
+    fprintf(stderr, "mock WAAPI listening on port %u with %zu objects\n", options.port, objectTree.GetNumObjects());
+
+    std::signal(SIGINT, OnInterrupt);
+    std::signal(SIGTERM, OnInterrupt);
+
+    const auto start = std::chrono::steady_clock::now();
+    while (!s_interrupted)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+
+        if (options.durationSeconds > 0.0 &&
+            std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count() >= options.durationSeconds)
+        {
+            break;
+        }
+    }
+
+    //stop taking calls before the mock's threads go away
+    server.Stop();
+    mock.Detach();
+
+    fputs(mock.FormatStats().c_str(), stdout);
+    return ExitSuccess;
+}
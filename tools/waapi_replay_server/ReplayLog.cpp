@@ -0,0 +1,215 @@
+#include <algorithm>
+#include <cstdio>
+#include <map>
+#include <utility>
+
+#include <rapidjson/document.h>
+#include <rapidjson/writer.h>
+#include <rapidjson/stringbuffer.h>
+
+#include "WampCapture.h"
+#include "ReplayLog.h"
+
+//WAMP message codes the log cares about
+enum ReplayMessageCode
+{
+    ReplayHello = 1,
+    ReplayError = 8,
+    ReplayCall = 48,
+    ReplayResult = 50
+};
+
+static std::string Serialize(const rapidjson::Value &value)
+{
+    rapidjson::StringBuffer buffer;
+    rapidjson::Writer<rapidjson::StringBuffer> writer(buffer);
+    value.Accept(writer);
+    return std::string(buffer.GetString(), buffer.GetSize());
+}
+
+bool ReplayLog::Load(const std::string &path, std::string &errorOut)
+{
+    using namespace AK::WwiseAuthoringAPI;
+
+    WampCapture::Reader reader;
+    if (!reader.Open(path, errorOut))
+    {
+        return false;
+    }
+
+    m_exchanges.clear();
+    m_numSessions = 0;
+    m_numFrames = 0;
+
+    //(session, request id) of calls waiting for their response
+    std::map<std::pair<uint32, uint64_t>, size_t> pending;
+
+    //current session of each capture stream, a stream gets a new session on every HELLO.
+    //a capture started mid session has no HELLO for it, that session starts at the stream's first frame.
+    std::map<uint32, uint32> streamSessions;
+
+    WampCapture::Frame frame;
+    while (reader.Next(frame))
+    {
+        ++m_numFrames;
+
+        rapidjson::Document message;
+        message.Parse(frame.payload.c_str(), frame.payload.size());
+        if (message.HasParseError() || !message.IsArray() || message.Empty() || !message[0].IsInt())
+        {
+            continue;
+        }
+
+        const int code = message[0].GetInt();
+
+        auto streamSession = streamSessions.find(frame.stream);
+        if (streamSession == streamSessions.end() || (frame.direction == WampCapture::Direction::Sent && code == ReplayHello))
+        {
+            streamSession = streamSessions.insert_or_assign(frame.stream, m_numSessions++).first;
+        }
+        const uint32 session = streamSession->second;
+
+        if (frame.direction == WampCapture::Direction::Sent)
+        {
+            if (code == ReplayHello)
+            {
+                //nothing to replay, the server answers HELLO itself
+            }
+            else if (code == ReplayCall && message.Size() >= 4 && message[1].IsUint64() && message[3].IsString())
+            {
+                //[CALL, Request|id, Options|dict, Procedure|uri, Arguments|list, ArgumentsKw|dict]
+                RecordedExchange exchange;
+                exchange.procedure = message[3].GetString();
+                exchange.requestKey = MakeRequestKey(message);
+                exchange.callTimeUs = frame.timeUs;
+                exchange.session = session;
+
+                pending[{ session, message[1].GetUint64() }] = m_exchanges.size();
+                m_exchanges.push_back(std::move(exchange));
+            }
+            continue;
+        }
+
+        //[RESULT, CALL.Request|id, ...] or [ERROR, CALL, CALL.Request|id, ...]
+        rapidjson::SizeType idIndex = 0;
+        if (code == ReplayResult)
+        {
+            idIndex = 1;
+        }
+        else if (code == ReplayError && message.Size() > 2 && message[1].IsInt() && message[1].GetInt() == ReplayCall)
+        {
+            idIndex = 2;
+        }
+
+        if (!idIndex || message.Size() <= idIndex || !message[idIndex].IsUint64())
+        {
+            continue;
+        }
+
+        auto call = pending.find({ session, message[idIndex].GetUint64() });
+        if (call == pending.end())
+        {
+            continue;
+        }
+
+        RecordedExchange &exchange = m_exchanges[call->second];
+        exchange.response = std::move(frame.payload);
+        exchange.isError = code == ReplayError;
+        exchange.responseTimeUs = frame.timeUs;
+        pending.erase(call);
+    }
+
+    if (!m_numFrames)
+    {
+        errorOut = path + " has no frames";
+        return false;
+    }
+
+    //serial service time, walking responses in the order wwise produced them
+    std::vector<RecordedExchange*> answered;
+    for (RecordedExchange &exchange : m_exchanges)
+    {
+        if (exchange.HasResponse())
+        {
+            answered.push_back(&exchange);
+        }
+    }
+    std::sort(answered.begin(), answered.end(), [](const RecordedExchange *a, const RecordedExchange *b)
+    {
+        return a->responseTimeUs < b->responseTimeUs;
+    });
+
+    uint64_t freeAtUs = 0;
+    for (RecordedExchange *exchange : answered)
+    {
+        const uint64_t startUs = std::max(exchange->callTimeUs, freeAtUs);
+        exchange->serviceUs = exchange->responseTimeUs > startUs ? exchange->responseTimeUs - startUs : 0;
+        freeAtUs = exchange->responseTimeUs;
+    }
+
+    return true;
+}
+
+std::string ReplayLog::MakeRequestKey(const rapidjson::Value &callMessage)
+{
+    //[CALL, Request|id, Options|dict, Procedure|uri, Arguments|list, ArgumentsKw|dict]
+    std::string requestKey = callMessage[3].GetString();
+    requestKey += '|' + Serialize(callMessage[2]);
+    if (callMessage.Size() > 5)
+    {
+        requestKey += '|' + Serialize(callMessage[5]);
+    }
+    return requestKey;
+}
+
+uint64_t ReplayLog::GetRecordedSpanUs() const
+{
+    uint64_t firstCallUs = UINT64_MAX;
+    uint64_t lastResponseUs = 0;
+    for (const RecordedExchange &exchange : m_exchanges)
+    {
+        firstCallUs = std::min(firstCallUs, exchange.callTimeUs);
+        if (exchange.HasResponse())
+        {
+            lastResponseUs = std::max(lastResponseUs, exchange.responseTimeUs);
+        }
+    }
+    return lastResponseUs > firstCallUs ? lastResponseUs - firstCallUs : 0;
+}
+
+bool ReplayLog::Dump(const std::string &path, std::string &errorOut)
+{
+    using namespace AK::WwiseAuthoringAPI;
+
+    WampCapture::Reader reader;
+    if (!reader.Open(path, errorOut))
+    {
+        return false;
+    }
+
+    WampCapture::Frame frame;
+    while (reader.Next(frame))
+    {
+        rapidjson::StringBuffer buffer;
+        rapidjson::Writer<rapidjson::StringBuffer> writer(buffer);
+        writer.StartObject();
+        writer.Key("ms");
+        writer.Double(frame.timeUs / 1000.0);
+        writer.Key("dir");
+        writer.String(frame.direction == WampCapture::Direction::Sent ? "sent" : "received");
+        writer.Key("stream");
+        writer.Uint(frame.stream);
+        writer.Key("bytes");
+        writer.Uint64(frame.payload.size());
+
+        //the payload is already json, embed it as is so the line stays parseable
+        writer.Key("msg");
+        writer.RawValue(frame.payload.c_str(), frame.payload.size(), rapidjson::kArrayType);
+        writer.EndObject();
+
+        fputs(buffer.GetString(), stdout);
+        fputc('\n', stdout);
+    }
+
+    return true;
+}
@@ -0,0 +1,59 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <rapidjson/document.h>
+
+#include "types.h"
+
+//One recorded call and what wwise answered
+struct RecordedExchange
+{
+    std::string procedure;
+
+    //procedure, kwargs and options serialized, calls with the same key were the same request
+    std::string requestKey;
+
+    //microseconds since the capture started
+    uint64_t callTimeUs = 0;
+    uint64_t responseTimeUs = 0;
+
+    //time wwise spent on this call alone: from when it was free (or the call arrived) to the response.
+    //wwise handles calls one at a time, so this is what a serial replay charges per call.
+    uint64_t serviceUs = 0;
+
+    //raw RESULT or ERROR message, empty if the call was never answered (the client timed out)
+    std::string response;
+    bool isError = false;
+
+    //which recorded session made the call, in the order the sessions started
+    uint32 session = 0;
+
+    bool HasResponse() const { return !response.empty(); }
+};
+
+//Calls and responses paired up from a WampCapture file (see WampCapture.h in AkAutobahn)
+class ReplayLog
+{
+public:
+    bool Load(const std::string &path, std::string &errorOut);
+
+    const std::vector<RecordedExchange> &GetExchanges() const { return m_exchanges; }
+    uint32 GetNumSessions() const { return m_numSessions; }
+    uint64_t GetNumFrames() const { return m_numFrames; }
+
+    //first call to last response, the wall time the recorded client spent waiting on wwise
+    uint64_t GetRecordedSpanUs() const;
+
+    //prints every frame as one JSON object per line
+    static bool Dump(const std::string &path, std::string &errorOut);
+
+    //RecordedExchange::requestKey for a parsed CALL message
+    static std::string MakeRequestKey(const rapidjson::Value &callMessage);
+
+private:
+    std::vector<RecordedExchange> m_exchanges;
+    uint32 m_numSessions = 0;
+    uint64_t m_numFrames = 0;
+};
@@ -0,0 +1,193 @@
+#include <algorithm>
+
+#include <rapidjson/writer.h>
+#include <rapidjson/stringbuffer.h>
+
+#include "ReplayServer.h"
+
+using Clock = TimerQueue::Clock;
+
+ReplayServer::ReplayServer(const ReplayLog &log, const ReplayOptions &options)
+    : m_log(log)
+    , m_options(options)
+    , m_used(log.GetExchanges().size(), false)
+{
+    const std::vector<RecordedExchange> &exchanges = m_log.GetExchanges();
+    for (size_t i = 0; i < exchanges.size(); ++i)
+    {
+        m_byRequest[exchanges[i].requestKey].push_back(i);
+        m_byProcedure[exchanges[i].procedure].push_back(i);
+    }
+}
+
+ReplayServer::~ReplayServer()
+{
+    Detach();
+}
+
+void ReplayServer::Attach(WampServer &server)
+{
+    m_server = &server;
+    server.SetCallHandler([this](std::unique_ptr<WampServer::Call> call) { return OnCall(std::move(call)); });
+}
+
+void ReplayServer::Detach()
+{
+    m_responses.Stop();
+}
+
+bool ReplayServer::IsFinished() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_numUsed == m_used.size() && m_responsesInFlight == 0;
+}
+
+ReplayStats ReplayServer::GetStats() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    ReplayStats stats = m_stats;
+    stats.remaining = m_used.size() - m_numUsed;
+    if (stats.calls && m_lastResponse > m_firstCall)
+    {
+        stats.spanSeconds = std::chrono::duration<double>(m_lastResponse - m_firstCall).count();
+    }
+    return stats;
+}
+
+bool ReplayServer::OnCall(std::unique_ptr<WampServer::Call> call)
+{
+    const Clock::time_point now = Clock::now();
+    const std::string requestKey = ReplayLog::MakeRequestKey(call->message);
+
+    std::unique_lock<std::mutex> lock(m_mutex);
+
+    if (!m_stats.calls++)
+    {
+        m_firstCall = now;
+    }
+
+    bool exact = false;
+    const RecordedExchange *exchange = Match(requestKey, call->procedure, exact);
+    if (!exchange)
+    {
+        ++m_stats.unmatched;
+        lock.unlock();
+
+        rapidjson::Document kwargs(rapidjson::kObjectType);
+        kwargs.AddMember("message", rapidjson::Value(("No recorded call left for " + call->procedure).c_str(), kwargs.GetAllocator()),
+                         kwargs.GetAllocator());
+        m_server->SendError(call->connection, call->requestId, "ak.wwise.replay.unmatched_call", kwargs);
+        return true;
+    }
+
+    m_stats.exactMatches += exact ? 1 : 0;
+    m_stats.procedureMatches += exact ? 0 : 1;
+
+    if (!exchange->HasResponse())
+    {
+        //the recorded client timed out on this one, let the new one do the same
+        ++m_stats.unanswered;
+        return true;
+    }
+
+    const auto ToDuration = [this](uint64_t microseconds)
+    {
+        return std::chrono::microseconds(static_cast<int64_t>(microseconds / m_options.speed));
+    };
+
+    Clock::time_point due = now;
+    switch (m_options.timing)
+    {
+    case ReplayTiming::Serial:
+        due = std::max(now, m_serverFreeAt) + ToDuration(exchange->serviceUs);
+        m_serverFreeAt = due;
+        break;
+
+    case ReplayTiming::Recorded:
+        due = now + ToDuration(exchange->responseTimeUs - exchange->callTimeUs);
+        break;
+
+    case ReplayTiming::None:
+        break;
+    }
+
+    ++m_responsesInFlight;
+    lock.unlock();
+
+    const WampServer::ConnectionId connection = call->connection;
+    std::shared_ptr<std::string> response = std::make_shared<std::string>(MakeResponse(*exchange, call->requestId));
+
+    m_responses.Post(due, [this, connection, response]()
+    {
+        m_server->SendRaw(connection, *response);
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_lastResponse = Clock::now();
+        --m_responsesInFlight;
+    });
+
+    return true;
+}
+
+const RecordedExchange *ReplayServer::Match(const std::string &requestKey, const std::string &procedure, bool &exactOut)
+{
+    const std::vector<RecordedExchange> &exchanges = m_log.GetExchanges();
+
+    //queues hold every exchange twice (by request and by procedure), skip the ones the other queue used
+    const auto PopUnused = [this](std::deque<size_t> &queue) -> size_t
+    {
+        while (!queue.empty())
+        {
+            const size_t index = queue.front();
+            queue.pop_front();
+            if (!m_used[index])
+            {
+                return index;
+            }
+        }
+        return SIZE_MAX;
+    };
+
+    size_t index = SIZE_MAX;
+
+    auto byRequest = m_byRequest.find(requestKey);
+    if (byRequest != m_byRequest.end())
+    {
+        index = PopUnused(byRequest->second);
+    }
+
+    exactOut = index != SIZE_MAX;
+
+    if (index == SIZE_MAX && !m_options.exactOnly)
+    {
+        auto byProcedure = m_byProcedure.find(procedure);
+        if (byProcedure != m_byProcedure.end())
+        {
+            index = PopUnused(byProcedure->second);
+        }
+    }
+
+    if (index == SIZE_MAX)
+    {
+        return nullptr;
+    }
+
+    m_used[index] = true;
+    ++m_numUsed;
+    return &exchanges[index];
+}
+
+std::string ReplayServer::MakeResponse(const RecordedExchange &exchange, uint64_t requestId)
+{
+    rapidjson::Document message;
+    message.Parse(exchange.response.c_str(), exchange.response.size());
+
+    //[RESULT, CALL.Request|id, ...] or [ERROR, CALL, CALL.Request|id, ...], the log only keeps well formed ones
+    message[exchange.isError ? 2 : 1].SetUint64(requestId);
+
+    rapidjson::StringBuffer buffer;
+    rapidjson::Writer<rapidjson::StringBuffer> writer(buffer);
+    message.Accept(writer);
+    return std::string(buffer.GetString(), buffer.GetSize());
+}
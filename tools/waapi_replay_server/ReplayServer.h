@@ -0,0 +1,101 @@
+#pragma once
+#include <atomic>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "ReplayLog.h"
+#include "TimerQueue.h"
+#include "WampServer.h"
+
+enum class ReplayTiming
+{
+    //recorded service times on one virtual wwise thread, a client that pipelines better finishes sooner
+    Serial,
+
+    //each response after its recorded round trip, whatever else is in flight
+    Recorded,
+
+    //respond immediately, measures the client alone
+    None
+};
+
+struct ReplayOptions
+{
+    ReplayTiming timing = ReplayTiming::Serial;
+
+    //recorded times are divided by this
+    double speed = 1.0;
+
+    //only answer calls whose procedure and arguments match a recorded call exactly
+    bool exactOnly = false;
+};
+
+struct ReplayStats
+{
+    uint64_t calls = 0;
+    uint64_t exactMatches = 0;
+    uint64_t procedureMatches = 0;
+    uint64_t unmatched = 0;
+
+    //matched calls that wwise never answered in the recording, they get no answer now either
+    uint64_t unanswered = 0;
+
+    //recorded calls the client hasn't made (yet)
+    uint64_t remaining = 0;
+
+    //first call received to last response sent
+    double spanSeconds = 0.0;
+};
+
+//Answers calls with the responses from a ReplayLog. A call takes the next unused recorded exchange with the
+//same request key, or failing that the next one for the same procedure, so a client build that batches
+//differently still gets plausible answers. Request ids are rewritten to the caller's.
+class ReplayServer
+{
+public:
+    ReplayServer(const ReplayLog &log, const ReplayOptions &options);
+    ~ReplayServer();
+
+    //installs the call handler, call before server.Start
+    void Attach(WampServer &server);
+    void Detach();
+
+    //every recorded call has been made and answered
+    bool IsFinished() const;
+
+    ReplayStats GetStats() const;
+
+private:
+    bool OnCall(std::unique_ptr<WampServer::Call> call);
+
+    //next unused exchange, nullptr if none is left
+    const RecordedExchange *Match(const std::string &requestKey, const std::string &procedure, bool &exactOut);
+
+    //the recorded response with its request id replaced
+    static std::string MakeResponse(const RecordedExchange &exchange, uint64_t requestId);
+
+    const ReplayLog &m_log;
+    const ReplayOptions m_options;
+    WampServer *m_server = nullptr;
+    TimerQueue m_responses;
+
+    mutable std::mutex m_mutex;
+
+    //indices into the log's exchanges in recorded order
+    std::unordered_map<std::string, std::deque<size_t>> m_byRequest;
+    std::unordered_map<std::string, std::deque<size_t>> m_byProcedure;
+    std::vector<bool> m_used;
+    size_t m_numUsed = 0;
+
+    //serial timing, when the virtual wwise thread is free again
+    TimerQueue::Clock::time_point m_serverFreeAt;
+
+    TimerQueue::Clock::time_point m_firstCall;
+    TimerQueue::Clock::time_point m_lastResponse;
+    ReplayStats m_stats;
+
+    std::atomic<size_t> m_responsesInFlight{ 0 };
+};
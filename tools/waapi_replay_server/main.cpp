@@ -0,0 +1,193 @@
+//Replays a captured WAAPI session (see WampCapture.h in AkAutobahn) to a client build, answering its calls
+//with the recorded responses and timings. Run a transfer against it to compare the client stack with the
+//recording, --max-ratio turns it into a pass/fail throughput check.
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <csignal>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <thread>
+
+#include "ReplayLog.h"
+#include "ReplayServer.h"
+#include "WampServer.h"
+#include "config.h"
+#include "types.h"
+
+enum ExitCode
+{
+    ExitSuccess = 0,
+    ExitTooSlow = 1,
+    ExitBadArguments = 2,
+    ExitListenFailed = 3
+};
+
+struct ReplayCliOptions
+{
+    std::string captureFile;
+    uint32 port = WAAPI_DEFAULT_PORT;
+    uint32 threads = 8;
+    ReplayOptions replay;
+    bool dump = false;
+    bool exitWhenDone = false;
+    double durationSeconds = 0.0;
+
+    //replay span over recorded span above this fails the run, 0 doesn't check
+    double maxRatio = 0.0;
+};
+
+static std::atomic<bool> s_interrupted{ false };
+
+static void OnInterrupt(int)
+{
+    s_interrupted = true;
+}
+
+static void PrintUsage()
+{
+    fprintf(stderr,
+            "usage: waapi_replay_server [options] <capture.wampcap>\n"
+            "\n"
+            "  --port <port>              listen port (default %d)\n"
+            "  --threads <n>              connections served at once (default 8)\n"
+            "  --timing <mode>            serial (default): recorded wwise time per call, one call at a time\n"
+            "                             recorded: each call's recorded round trip\n"
+            "                             none: answer immediately\n"
+            "  --speed <x>                divide recorded times by x (default 1)\n"
+            "  --exact-only               don't answer calls that differ from the recording\n"
+            "  --exit-when-done           exit once every recorded call has been replayed\n"
+            "  --duration <seconds>       exit after this long\n"
+            "  --max-ratio <r>            exit code 1 if the replay took more than r times the recording\n"
+            "  --dump                     print the capture as JSON lines and exit\n"
+            "\n"
+            "exit codes: 0 success, 1 slower than --max-ratio, 2 bad arguments, 3 couldn't listen\n",
+            WAAPI_DEFAULT_PORT);
+}
+
+static bool ParseArgs(int argc, char **argv, ReplayCliOptions &options)
+{
+    for (int i = 1; i < argc; ++i)
+    {
+        const std::string arg = argv[i];
+        const bool hasValue = i + 1 < argc;
+
+        if (arg == "--port" && hasValue) options.port = static_cast<uint32>(std::atoi(argv[++i]));
+        else if (arg == "--threads" && hasValue) options.threads = static_cast<uint32>(std::max(1, std::atoi(argv[++i])));
+        else if (arg == "--timing" && hasValue)
+        {
+            const std::string timing = argv[++i];
+            if (timing == "serial") options.replay.timing = ReplayTiming::Serial;
+            else if (timing == "recorded") options.replay.timing = ReplayTiming::Recorded;
+            else if (timing == "none") options.replay.timing = ReplayTiming::None;
+            else
+            {
+                fprintf(stderr, "unknown timing %s\n", timing.c_str());
+                return false;
+            }
+        }
+        else if (arg == "--speed" && hasValue) options.replay.speed = std::max(0.001, std::atof(argv[++i]));
+        else if (arg == "--exact-only") options.replay.exactOnly = true;
+        else if (arg == "--exit-when-done") options.exitWhenDone = true;
+        else if (arg == "--duration" && hasValue) options.durationSeconds = std::atof(argv[++i]);
+        else if (arg == "--max-ratio" && hasValue) options.maxRatio = std::atof(argv[++i]);
+        else if (arg == "--dump") options.dump = true;
+        else if (arg == "--help" || arg == "-h") return false;
+        else if (!arg.empty() && arg[0] == '-')
+        {
+            fprintf(stderr, "unknown option %s\n", arg.c_str());
+            return false;
+        }
+        else options.captureFile = arg;
+    }
+
+    return !options.captureFile.empty();
+}
+
+int main(int argc, char **argv)
+{
+    ReplayCliOptions options;
+    if (!ParseArgs(argc, argv, options))
+    {
+        PrintUsage();
+        return ExitBadArguments;
+    }
+
+    std::string error;
+    if (options.dump)
+    {
+        if (!ReplayLog::Dump(options.captureFile, error))
+        {
+            fprintf(stderr, "%s\n", error.c_str());
+            return ExitBadArguments;
+        }
+        return ExitSuccess;
+    }
+
+    ReplayLog log;
+    if (!log.Load(options.captureFile, error))
+    {
+        fprintf(stderr, "%s\n", error.c_str());
+        return ExitBadArguments;
+    }
+
+    const double recordedSeconds = log.GetRecordedSpanUs() / 1000000.0;
+    fprintf(stderr, "loaded %zu calls from %u sessions (%llu frames), recorded span %.3f s\n",
+            log.GetExchanges().size(), log.GetNumSessions(), static_cast<unsigned long long>(log.GetNumFrames()), recordedSeconds);
+
+    ReplayServer replay(log, options.replay);
+    WampServer server;
+    replay.Attach(server);
+
+    if (!server.Start(options.port, options.threads, error))
+    {
+        fprintf(stderr, "%s\n", error.c_str());
+        return ExitListenFailed;
+    }
+
+    fprintf(stderr, "replaying on port %u\n", options.port);
+
+    std::signal(SIGINT, OnInterrupt);
+    std::signal(SIGTERM, OnInterrupt);
+
+    const auto start = std::chrono::steady_clock::now();
+    while (!s_interrupted)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+
+        if (options.exitWhenDone && replay.IsFinished())
+        {
+            break;
+        }
+        if (options.durationSeconds > 0.0 &&
+            std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count() >= options.durationSeconds)
+        {
+            break;
+        }
+    }
+
+    server.Stop();
+    replay.Detach();
+
+    const ReplayStats stats = replay.GetStats();
+    const double ratio = recordedSeconds > 0.0 ? stats.spanSeconds / recordedSeconds : 0.0;
+
+    printf("calls %llu: exact %llu, by procedure %llu, unmatched %llu, unanswered %llu, not replayed %llu\n",
+           static_cast<unsigned long long>(stats.calls),
+           static_cast<unsigned long long>(stats.exactMatches),
+           static_cast<unsigned long long>(stats.procedureMatches),
+           static_cast<unsigned long long>(stats.unmatched),
+           static_cast<unsigned long long>(stats.unanswered),
+           static_cast<unsigned long long>(stats.remaining));
+    printf("replay span %.3f s, recorded span %.3f s, ratio %.3f\n", stats.spanSeconds, recordedSeconds, ratio);
+
+    if (options.maxRatio > 0.0 && ratio > options.maxRatio)
+    {
+        printf("slower than the allowed ratio %.3f\n", options.maxRatio);
+        return ExitTooSlow;
+    }
+
+    return ExitSuccess;
+}
@@ -0,0 +1,883 @@
+//Headless render queue -> wwise transfer for build machines.
+//Parses qrender RPP files, maps the render items to wwise parents with a mapping file and imports
+//them over WAAPI. Progress is written to stdout as one JSON object per line.
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include <AK/WwiseAuthoringAPI/waapi.h>
+#include <AK/WwiseAuthoringAPI/AkAutobahn/Client.h>
+
+#include "WampCapture.h"
+#include "AsyncLog.h"
+#include "AudioAnalysis.h"
+#include "FolderMirror.h"
+#include "RenderQueueParser.h"
+#include "ImportPlan.h"
+#include "ProgressWriter.h"
+#include "ResultView.h"
+#include "TransferMapping.h"
+#include "config.h"
+#include "types.h"
+
+enum ExitCode
+{
+    ExitSuccess = 0,
+    ExitTransferFailed = 1,
+    ExitBadArguments = 2,
+    ExitConnectionFailed = 3
+};
+
+struct CliOptions
+{
+    std::vector<fs::path> renderQueueFiles;
+    fs::path mappingFile;
+    std::string host = "127.0.0.1";
+    uint32 port = WAAPI_DEFAULT_PORT;
+
+    //parser threads
+    uint32 jobs = std::max(1u, std::thread::hardware_concurrency());
+
+    //import calls in flight at once
+    uint32 pipelineDepth = 2;
+
+    int timeoutMs = -1;
+    std::string recallNote;
+    bool dryRun = false;
+
+    //the inputs are projects that haven't been rendered, their outputs are predicted from the render pattern
+    //and planned without importing
+    bool predict = false;
+
+    //records the wamp session for tools/waapi_replay_server
+    std::string captureFile;
+
+    //wwise path the reaper track folders are mirrored under, empty doesn't mirror
+    std::string mirrorRoot;
+    std::string mirrorType = "ActorMixer";
+
+    //mirrors this many made up folders under mirrorRoot and exits, for timing hierarchy creation
+    uint32 benchMirrorFolders = 0;
+
+    //prints the mapping's rule conflicts and exits
+    bool rulesReport = false;
+
+    //maps this many made up items with the mapping and exits, for timing the rule automaton
+    uint32 benchRulesItems = 0;
+
+    //files out of the spec aren't imported, the report gets the levels of every file. Either analyses the files
+    std::string loudnessSpecFile;
+    std::string analysisReportFile;
+};
+
+static void PrintUsage()
+{
+    fprintf(stderr,
+            "usage: waapi_transfer_cli --mapping <mapping.json> [options] <qrender.rpp>...\n"
+            "       waapi_transfer_cli --mapping <mapping.json> --predict [options] <project.rpp>...\n"
+            "       waapi_transfer_cli --mirror-root <path> [options] <qrender.rpp>...\n"
+            "       waapi_transfer_cli --mirror-root <path> --bench-mirror <n> [options]\n"
+            "       waapi_transfer_cli --mapping <mapping.json> --rules-report | --bench-rules <n>\n"
+            "\n"
+            "  --mapping <file>      render item to wwise mapping (see TransferMapping.h)\n"
+            "  --host <address>      WAAPI host (default 127.0.0.1)\n"
+            "  --port <port>         WAAPI port (default %d)\n"
+            "  --jobs <n>            render queue files parsed and wavs analysed in parallel\n"
+            "                        (default: hardware threads)\n"
+            "  --pipeline <n>        import calls in flight at once (default 2)\n"
+            "  --timeout <ms>        per call timeout, -1 waits forever (default -1)\n"
+            "  --recall-note <text>  audio source notes for SFX and voice imports\n"
+            "  --dry-run             parse and plan only, don't connect to wwise\n"
+            "  --predict             plan the files rendering the projects would make, from their render\n"
+            "                        pattern, implies --dry-run\n"
+            "  --loudness-spec <file>\n"
+            "                        analyse the rendered files and don't import the ones out of the\n"
+            "                        spec's limits (see AudioAnalysis.h)\n"
+            "  --analysis-report <file>\n"
+            "                        write the peaks, loudness and dc offset of the analysed files\n"
+            "  --capture <file>      record the WAAPI session for waapi_replay_server\n"
+            "  --mirror-root <path>  create the reaper track folders under this wwise object and import\n"
+            "                        stems in folders into them, the mapping is optional then\n"
+            "  --mirror-type <type>  ActorMixer or Folder (default ActorMixer)\n"
+            "  --bench-mirror <n>    mirror n generated folders under --mirror-root twice, checking what is there after\n"
+            "                        each, and exit, exit code 1 if a folder is missing, doubled or of another type\n"
+            "                        (against waapi_mock_server --unavailable ak.wwise.core.object.set it times\n"
+            "                        the object.create fallback)\n"
+            "  --rules-report        list mapping rules that overlap, never apply or can't match and exit,\n"
+            "                        exit code 1 if there are any\n"
+            "  --bench-rules <n>     map n generated items with the mapping and exit\n"
+            "\n"
+            "exit codes: 0 success, 1 some imports failed or files were out of spec (--predict: some\n"
+            "            outputs unpredicted or unmapped), 2 bad arguments, 3 couldn't connect\n",
+            WAAPI_DEFAULT_PORT);
+}
+
+static bool ParseArgs(int argc, char **argv, CliOptions &options)
+{
+    for (int i = 1; i < argc; ++i)
+    {
+        const std::string arg = argv[i];
+        const bool hasValue = i + 1 < argc;
+
+        if (arg == "--mapping" && hasValue) options.mappingFile = argv[++i];
+        else if (arg == "--host" && hasValue) options.host = argv[++i];
+        else if (arg == "--port" && hasValue) options.port = static_cast<uint32>(std::atoi(argv[++i]));
+        else if (arg == "--jobs" && hasValue) options.jobs = std::max(1, std::atoi(argv[++i]));
+        else if (arg == "--pipeline" && hasValue) options.pipelineDepth = std::max(1, std::atoi(argv[++i]));
+        else if (arg == "--timeout" && hasValue) options.timeoutMs = std::atoi(argv[++i]);
+        else if (arg == "--recall-note" && hasValue) options.recallNote = argv[++i];
+        else if (arg == "--dry-run") options.dryRun = true;
+        else if (arg == "--predict") options.predict = options.dryRun = true;
+        else if (arg == "--capture" && hasValue) options.captureFile = argv[++i];
+        else if (arg == "--mirror-root" && hasValue) options.mirrorRoot = argv[++i];
+        else if (arg == "--mirror-type" && hasValue) options.mirrorType = argv[++i];
+        else if (arg == "--bench-mirror" && hasValue) options.benchMirrorFolders = static_cast<uint32>(std::max(1, std::atoi(argv[++i])));
+        else if (arg == "--rules-report") options.rulesReport = true;
+        else if (arg == "--bench-rules" && hasValue) options.benchRulesItems = static_cast<uint32>(std::max(1, std::atoi(argv[++i])));
+        else if (arg == "--loudness-spec" && hasValue) options.loudnessSpecFile = argv[++i];
+        else if (arg == "--analysis-report" && hasValue) options.analysisReportFile = argv[++i];
+        else if (arg == "--help" || arg == "-h") return false;
+        else if (!arg.empty() && arg[0] == '-')
+        {
+            fprintf(stderr, "unknown option %s\n", arg.c_str());
+            return false;
+        }
+        else options.renderQueueFiles.push_back(arg);
+    }
+
+    if (options.mirrorType != "ActorMixer" && options.mirrorType != "Folder")
+    {
+        fprintf(stderr, "--mirror-type must be ActorMixer or Folder\n");
+        return false;
+    }
+
+    if (options.benchMirrorFolders)
+    {
+        return !options.mirrorRoot.empty();
+    }
+    if (options.rulesReport || options.benchRulesItems)
+    {
+        return !options.mappingFile.empty();
+    }
+    return (!options.mappingFile.empty() || !options.mirrorRoot.empty()) && !options.renderQueueFiles.empty();
+}
+
+//items in n generated folders, a hundred to a group folder, standing in for a big reaper project
+static std::vector<RenderItem> MakeBenchMirrorItems(uint32 numFolders)
+{
+    std::vector<RenderItem> items(numFolders);
+    char name[32];
+    for (uint32 i = 0; i < numFolders; ++i)
+    {
+        snprintf(name, sizeof(name), "Group_%03u", i / 100);
+        items[i].trackFolders.push_back(name);
+        snprintf(name, sizeof(name), "Folder_%05u", i);
+        items[i].trackFolders.push_back(name);
+    }
+    return items;
+}
+
+//items named the way game audio usually is, VO_<character>_<line> and SFX_<category>_<variation>,
+//in a region per fifty items and on a track per character or category
+static std::vector<RenderItem> MakeBenchRuleItems(uint32 numItems)
+{
+    static const char *characters[] = { "Hero", "Villain", "Guard", "Merchant", "Narrator" };
+    static const char *categories[] = { "Door", "Footstep", "Weapon", "Impact", "Ambience", "UI" };
+    const uint32 numCharacters = sizeof(characters) / sizeof(characters[0]);
+    const uint32 numCategories = sizeof(categories) / sizeof(categories[0]);
+
+    std::vector<RenderItem> items(numItems);
+    char name[64];
+    for (uint32 i = 0; i < numItems; ++i)
+    {
+        if (i % 3 == 0)
+        {
+            snprintf(name, sizeof(name), "VO_%s_%05u", characters[i % numCharacters], i);
+            items[i].trackName = std::string(characters[i % numCharacters]) + " Dialog";
+        }
+        else
+        {
+            snprintf(name, sizeof(name), "SFX_%s_%02u", categories[i % numCategories], i % 100);
+            items[i].trackName = std::string(categories[i % numCategories]) + " Foley";
+        }
+        items[i].outputFileName = name;
+
+        snprintf(name, sizeof(name), "Region %u", i / 50);
+        items[i].regionName = name;
+    }
+    return items;
+}
+
+//one rule at a time with GlobMatch, what mapping did before the automaton. false if a rule uses regexes
+static bool MatchRulesOneByOne(const TransferMapping &mapping, const RenderItem &item, bool &matchedOut)
+{
+    const std::string *fields[MappingFieldCount] = { &item.outputFileName, &item.regionName, &item.trackName };
+
+    matchedOut = false;
+    for (size_t rule = 0; rule < mapping.GetNumRules() && !matchedOut; ++rule)
+    {
+        const MappingRule &mappingRule = mapping.GetRule(rule);
+        matchedOut = true;
+        for (int field = 0; field < MappingFieldCount; ++field)
+        {
+            if (mappingRule.isRegex[field])
+            {
+                return false;
+            }
+            if (!mappingRule.patterns[field].empty()
+                && !GlobMatch(mappingRule.patterns[field].c_str(), fields[field]->c_str()))
+            {
+                matchedOut = false;
+                break;
+            }
+        }
+    }
+    return true;
+}
+
+//times mapping the items twice, the first pass builds the DFA states, and once more matching the rules one by one
+static void BenchRules(TransferMapping &mapping, const std::vector<RenderItem> &items, ProgressWriter &progress)
+{
+    using Clock = std::chrono::steady_clock;
+    auto ElapsedMs = [](Clock::time_point start)
+    {
+        return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+    };
+
+    size_t numMatched = 0;
+    auto start = Clock::now();
+    for (const RenderItem &item : items)
+    {
+        numMatched += mapping.Match(item) ? 1 : 0;
+    }
+    const double coldMs = ElapsedMs(start);
+
+    start = Clock::now();
+    for (const RenderItem &item : items)
+    {
+        mapping.Match(item);
+    }
+    const double warmMs = ElapsedMs(start);
+
+    bool hasOneByOne = true;
+    start = Clock::now();
+    for (const RenderItem &item : items)
+    {
+        bool matched;
+        if (!MatchRulesOneByOne(mapping, item, matched))
+        {
+            hasOneByOne = false;
+            break;
+        }
+    }
+    const double oneByOneMs = ElapsedMs(start);
+
+    progress.Emit("rules", [&](JsonWriter &writer)
+    {
+        writer.Key("items");
+        writer.Uint64(items.size());
+        writer.Key("rules");
+        writer.Uint64(mapping.GetNumRules());
+        writer.Key("mapped");
+        writer.Uint64(numMatched);
+        writer.Key("states");
+        writer.Uint64(mapping.GetNumAutomatonStates());
+        writer.Key("coldMs");
+        writer.Double(coldMs);
+        writer.Key("warmMs");
+        writer.Double(warmMs);
+        if (hasOneByOne)
+        {
+            writer.Key("oneByOneMs");
+            writer.Double(oneByOneMs);
+        }
+    });
+}
+
+//creates the items' track folders under the mirror root, see CreateFolderContainers in the plugin's WAAPIHelpers
+static bool MirrorTrackFolders(const CliOptions &options, const std::vector<const RenderItem*> &items,
+                               AK::WwiseAuthoringAPI::Client &client, ProgressWriter &progress)
+{
+    using namespace AK::WwiseAuthoringAPI;
+
+    const auto start = std::chrono::steady_clock::now();
+
+    //existing folders are merged by name, no need to look them up first
+    const std::vector<std::string> folderPaths = CollectTrackFolderPaths(items);
+    const std::vector<FolderNode> nodes = BuildFolderTree(folderPaths, [](const std::string&) { return false; });
+
+    uint32 numCalls = 0;
+    AkJson result;
+    bool succeeded = true;
+    if (!nodes.empty())
+    {
+        ++numCalls;
+        succeeded = client.Call(ak::wwise::core::object::set, MakeFolderSetArgs(options.mirrorRoot, nodes, options.mirrorType),
+                                AkJson(AkJson::Map()), result, options.timeoutMs);
+
+        //object.set is wwise 2022.1 and up
+        if (!succeeded && result.IsMap() && result.HasKey("uri")
+            && result["uri"].GetVariant().GetString() == "wamp.error.no_such_procedure")
+        {
+            succeeded = true;
+            for (const FolderNode &node : nodes)
+            {
+                ++numCalls;
+                if (!client.Call(ak::wwise::core::object::create, MakeFolderCreateArgs(options.mirrorRoot, node, options.mirrorType),
+                                 AkJson(AkJson::Map()), result, options.timeoutMs))
+                {
+                    succeeded = false;
+                    break;
+                }
+            }
+        }
+    }
+
+    const double mirrorMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+    progress.Emit("mirrored", [&](JsonWriter &writer)
+    {
+        writer.Key("folders");
+        writer.Uint64(folderPaths.size());
+        writer.Key("calls");
+        writer.Uint(numCalls);
+        writer.Key("ok");
+        writer.Bool(succeeded);
+        writer.Key("ms");
+        writer.Double(mirrorMs);
+
+        if (!succeeded && result.IsMap() && result.HasKey("message"))
+        {
+            writer.Key("message");
+            writer.String(result["message"].GetVariant().GetString().c_str());
+        }
+    });
+
+    return succeeded;
+}
+
+//reads back the containers under the mirror root: every folder the items need has to be there once with the mirror
+//type, and nothing else. False if any is missing, doubled, of another type or not one of the items' folders
+static bool CheckMirroredFolders(const CliOptions &options, const std::vector<const RenderItem*> &items,
+                                 AK::WwiseAuthoringAPI::Client &client, ProgressWriter &progress)
+{
+    using namespace AK::WwiseAuthoringAPI;
+
+    std::unordered_map<std::string, uint32> numFound;
+    for (const std::string &folderPath : CollectTrackFolderPaths(items))
+    {
+        numFound[options.mirrorRoot + '\\' + folderPath] = 0;
+    }
+
+    const AkJson args(AkJson::Map{
+        { "from", AkJson::Map{ { "path", AkJson::Array{ AkVariant(options.mirrorRoot) } } } },
+        { "transform", AkJson::Array{ AkJson::Map{ { "select", AkJson::Array{ AkVariant("descendants") } } } } }
+    });
+    const AkJson getOptions(AkJson::Map{ { "return", AkJson::Array{ AkVariant("path"), AkVariant("type") } } });
+
+    ResultView objects;
+    AkJson error;
+    const bool read = ResultViews::Call(client, ak::wwise::core::object::get, args, getOptions, objects, error, options.timeoutMs);
+
+    uint32 numUnexpected = 0;
+    uint32 numWrongType = 0;
+    for (const rapidjson::Value &object : objects.GetObjects().GetArray())
+    {
+        auto found = numFound.find(ResultView::GetString(object, "path"));
+        if (found == numFound.end())
+        {
+            ++numUnexpected;
+            continue;
+        }
+        ++found->second;
+        numWrongType += options.mirrorType == ResultView::GetString(object, "type") ? 0 : 1;
+    }
+
+    uint32 numMissing = 0;
+    uint32 numDoubled = 0;
+    for (const auto &found : numFound)
+    {
+        numMissing += found.second == 0 ? 1 : 0;
+        numDoubled += found.second > 1 ? 1 : 0;
+    }
+
+    progress.Emit("mirrorChecked", [&](JsonWriter &writer)
+    {
+        writer.Key("objects");
+        writer.Uint(objects.GetObjects().Size());
+        writer.Key("missing");
+        writer.Uint(numMissing);
+        writer.Key("doubled");
+        writer.Uint(numDoubled);
+        writer.Key("wrongType");
+        writer.Uint(numWrongType);
+        writer.Key("unexpected");
+        writer.Uint(numUnexpected);
+    });
+
+    return read && numMissing == 0 && numDoubled == 0 && numWrongType == 0 && numUnexpected == 0;
+}
+
+//parses every render queue file on options.jobs threads, results are in the same order as the files
+//with --predict numFailedOut counts the projects whose outputs couldn't be predicted
+static std::vector<std::vector<RenderItem>> ParseRenderQueues(const CliOptions &options, ProgressWriter &progress,
+                                                              uint32 &numFailedOut)
+{
+    const size_t numFiles = options.renderQueueFiles.size();
+    std::vector<std::vector<RenderItem>> projects(numFiles);
+    std::atomic<size_t> nextFile{ 0 };
+    std::atomic<uint32> numFailed{ 0 };
+
+    auto ParseWorker = [&]()
+    {
+        for (size_t i = nextFile++; i < numFiles; i = nextFile++)
+        {
+            const fs::path &path = options.renderQueueFiles[i];
+            if (options.predict)
+            {
+                std::string predictError;
+                projects[i] = PredictRenderOutputs(path, predictError);
+                if (!predictError.empty())
+                {
+                    ++numFailed;
+                }
+
+                const size_t numItems = projects[i].size();
+                progress.Emit("predicted", [&](JsonWriter &writer)
+                {
+                    writer.Key("project");
+                    writer.String(path.generic_string().c_str());
+                    writer.Key("items");
+                    writer.Uint64(numItems);
+                    if (!predictError.empty())
+                    {
+                        writer.Key("message");
+                        writer.String(predictError.c_str());
+                    }
+                });
+                continue;
+            }
+
+            RenderQueueMatchStats matchStats;
+            projects[i] = ParseRenderQueue(path, &matchStats);
+
+            const size_t numItems = projects[i].size();
+            progress.Emit("parsed", [&](JsonWriter &writer)
+            {
+                writer.Key("project");
+                writer.String(path.generic_string().c_str());
+                writer.Key("items");
+                writer.Uint64(numItems);
+                writer.Key("matchedByName");
+                writer.Uint(matchStats.numMatchedByName);
+                writer.Key("matchedByPosition");
+                writer.Uint(matchStats.numMatchedByPosition);
+                writer.Key("unmatched");
+                writer.Uint(matchStats.numUnmatched);
+            });
+        }
+    };
+
+    const size_t numThreads = std::min<size_t>(options.jobs, numFiles);
+    std::vector<std::thread> threads;
+    for (size_t i = 1; i < numThreads; ++i)
+    {
+        threads.emplace_back(ParseWorker);
+    }
+    ParseWorker();
+
+    for (std::thread &thread : threads)
+    {
+        thread.join();
+    }
+
+    numFailedOut = numFailed;
+    return projects;
+}
+
+//analyses the files about to be imported on options.jobs threads and drops the ones out of spec from projectItems
+//returns how many were dropped
+static uint32 HoldBackOutOfSpec(const CliOptions &options, const LoudnessSpec &spec,
+                                std::vector<std::vector<const RenderItem*>> &projectItems, ProgressWriter &progress)
+{
+    std::vector<fs::path> paths;
+    for (const std::vector<const RenderItem*> &items : projectItems)
+    {
+        for (const RenderItem *item : items)
+        {
+            paths.push_back(item->audioFilePath);
+        }
+    }
+
+    const auto start = std::chrono::steady_clock::now();
+    const std::vector<AudioAnalysis> analyses = AnalyzeWavs(paths, options.jobs);
+    const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    uint32 numOutOfSpec = 0;
+    size_t analysisIndex = 0;
+    for (std::vector<const RenderItem*> &items : projectItems)
+    {
+        std::vector<const RenderItem*> inSpec;
+        for (const RenderItem *item : items)
+        {
+            const std::string outOfSpec = spec.Check(analyses[analysisIndex++]);
+            if (outOfSpec.empty())
+            {
+                inSpec.push_back(item);
+                continue;
+            }
+
+            ++numOutOfSpec;
+            progress.Emit("skipped", [&](JsonWriter &writer)
+            {
+                writer.Key("file");
+                writer.String(item->audioFilePath.generic_string().c_str());
+                writer.Key("reason");
+                writer.String("out of spec");
+                writer.Key("message");
+                writer.String(outOfSpec.c_str());
+            });
+        }
+        items = std::move(inSpec);
+    }
+
+    progress.Emit("analyzed", [&](JsonWriter &writer)
+    {
+        writer.Key("files");
+        writer.Uint64(analyses.size());
+        writer.Key("outOfSpec");
+        writer.Uint(numOutOfSpec);
+        writer.Key("seconds");
+        writer.Double(seconds);
+    });
+
+    if (!options.analysisReportFile.empty() && !WriteAnalysisReport(options.analysisReportFile, analyses, spec))
+    {
+        progress.Emit("error", [&](JsonWriter &writer)
+        {
+            writer.Key("message");
+            writer.String(("couldn't write analysis report " + options.analysisReportFile).c_str());
+        });
+    }
+    return numOutOfSpec;
+}
+
+int main(int argc, char **argv)
+{
+    using namespace AK::WwiseAuthoringAPI;
+
+    CliOptions options;
+    if (!ParseArgs(argc, argv, options))
+    {
+        PrintUsage();
+        return ExitBadArguments;
+    }
+
+    TransferMapping mapping;
+    std::string mappingError;
+    if (!options.mappingFile.empty() && !mapping.Load(options.mappingFile, mappingError))
+    {
+        fprintf(stderr, "mapping error: %s\n", mappingError.c_str());
+        return ExitBadArguments;
+    }
+
+    LoudnessSpec loudnessSpec;
+    std::string loudnessSpecError;
+    if (!options.loudnessSpecFile.empty() && !loudnessSpec.Load(options.loudnessSpecFile, loudnessSpecError))
+    {
+        fprintf(stderr, "loudness spec error: %s\n", loudnessSpecError.c_str());
+        return ExitBadArguments;
+    }
+
+    ProgressWriter progress;
+
+    if (options.rulesReport)
+    {
+        const std::vector<std::string> conflicts = mapping.GetConflictReport();
+        for (const std::string &conflict : conflicts)
+        {
+            progress.Emit("conflict", [&](JsonWriter &writer)
+            {
+                writer.Key("message");
+                writer.String(conflict.c_str());
+            });
+        }
+        progress.Emit("rulesChecked", [&](JsonWriter &writer)
+        {
+            writer.Key("rules");
+            writer.Uint64(mapping.GetNumRules());
+            writer.Key("conflicts");
+            writer.Uint64(conflicts.size());
+        });
+        return conflicts.empty() ? ExitSuccess : ExitTransferFailed;
+    }
+
+    if (options.benchRulesItems)
+    {
+        BenchRules(mapping, MakeBenchRuleItems(options.benchRulesItems), progress);
+        return ExitSuccess;
+    }
+
+    if (options.benchMirrorFolders)
+    {
+        const std::vector<RenderItem> benchItems = MakeBenchMirrorItems(options.benchMirrorFolders);
+        std::vector<const RenderItem*> benchItemPointers;
+        for (const RenderItem &item : benchItems)
+        {
+            benchItemPointers.push_back(&item);
+        }
+
+        Client client;
+        if (!client.Connect(options.host.c_str(), options.port))
+        {
+            fprintf(stderr, "couldn't connect to WAAPI at %s:%u\n", options.host.c_str(), options.port);
+            return ExitConnectionFailed;
+        }
+
+        //the second time everything is there already and has to be merged into, not made again
+        bool succeeded = true;
+        for (int pass = 0; pass < 2 && succeeded; ++pass)
+        {
+            succeeded = MirrorTrackFolders(options, benchItemPointers, client, progress) &&
+                CheckMirroredFolders(options, benchItemPointers, client, progress);
+        }
+        client.Disconnect();
+        AsyncLog::Shutdown();
+        return succeeded ? ExitSuccess : ExitTransferFailed;
+    }
+
+    uint32 numUnpredictable = 0;
+    std::vector<std::vector<RenderItem>> projects = ParseRenderQueues(options, progress, numUnpredictable);
+
+    //map items and drop the ones we can't import
+    uint32 numUnmapped = 0;
+    uint32 numMissing = 0;
+    std::vector<ImportBatch> plan;
+    std::vector<std::string> batchProjects;
+    std::vector<const RenderItem*> mirrorItems;
+    std::vector<std::vector<const RenderItem*>> projectImportItems(projects.size());
+
+    for (size_t projectIndex = 0; projectIndex < projects.size(); ++projectIndex)
+    {
+        std::vector<const RenderItem*> &importItems = projectImportItems[projectIndex];
+
+        for (RenderItem &item : projects[projectIndex])
+        {
+            //stems in track folders go into the mirrored folders, anything else into the root unless the mapping says
+            bool mapped = mapping.Apply(item);
+            if (!options.mirrorRoot.empty())
+            {
+                const std::string folderPath = GetTrackFolderPath(item);
+                if (!folderPath.empty())
+                {
+                    item.wwiseGuid = options.mirrorRoot + '\\' + folderPath;
+                    mapped = true;
+                }
+                else if (!mapped)
+                {
+                    item.wwiseGuid = options.mirrorRoot;
+                    mapped = true;
+                }
+            }
+
+            const char *skipReason = nullptr;
+            if (!mapped)
+            {
+                skipReason = "unmapped";
+                ++numUnmapped;
+            }
+            else if (!options.predict && !fs::exists(item.audioFilePath))
+            {
+                skipReason = "missing";
+                ++numMissing;
+            }
+
+            if (skipReason)
+            {
+                progress.Emit("skipped", [&](JsonWriter &writer)
+                {
+                    writer.Key("file");
+                    writer.String(item.audioFilePath.generic_string().c_str());
+                    writer.Key("reason");
+                    writer.String(skipReason);
+                });
+                continue;
+            }
+
+            importItems.push_back(&item);
+        }
+    }
+
+    //predicted outputs haven't been rendered yet, there's nothing to analyse
+    uint32 numOutOfSpec = 0;
+    if (!options.predict && (!options.loudnessSpecFile.empty() || !options.analysisReportFile.empty()))
+    {
+        numOutOfSpec = HoldBackOutOfSpec(options, loudnessSpec, projectImportItems, progress);
+    }
+
+    for (size_t projectIndex = 0; projectIndex < projects.size(); ++projectIndex)
+    {
+        const std::vector<const RenderItem*> &importItems = projectImportItems[projectIndex];
+        mirrorItems.insert(mirrorItems.end(), importItems.begin(), importItems.end());
+
+        for (ImportBatch &batch : BuildImportPlan(importItems, options.recallNote))
+        {
+            plan.push_back(std::move(batch));
+            batchProjects.push_back(options.renderQueueFiles[projectIndex].generic_string());
+        }
+    }
+
+    size_t numPlannedItems = 0;
+    for (const ImportBatch &batch : plan)
+    {
+        numPlannedItems += batch.renderItems.size();
+    }
+
+    progress.Emit("planned", [&](JsonWriter &writer)
+    {
+        writer.Key("batches");
+        writer.Uint64(plan.size());
+        writer.Key("items");
+        writer.Uint64(numPlannedItems);
+        writer.Key("unmapped");
+        writer.Uint(numUnmapped);
+        writer.Key("missing");
+        writer.Uint(numMissing);
+        writer.Key("outOfSpec");
+        writer.Uint(numOutOfSpec);
+    });
+
+    //a predicted plan is only good if every output was predicted and goes somewhere
+    if (options.predict)
+    {
+        return numUnpredictable || numUnmapped ? ExitTransferFailed : ExitSuccess;
+    }
+
+    if (options.dryRun)
+    {
+        return numMissing || numOutOfSpec ? ExitTransferFailed : ExitSuccess;
+    }
+
+    if (!options.captureFile.empty() && !WampCapture::Start(options.captureFile))
+    {
+        progress.Emit("error", [&](JsonWriter &writer)
+        {
+            writer.Key("message");
+            writer.String(("couldn't open capture file " + options.captureFile).c_str());
+        });
+        return ExitBadArguments;
+    }
+
+    Client client;
+    if (!client.Connect(options.host.c_str(), options.port))
+    {
+        WampCapture::Stop();
+        progress.Emit("error", [&](JsonWriter &writer)
+        {
+            writer.Key("message");
+            writer.String(("couldn't connect to WAAPI at " + options.host + ":" + std::to_string(options.port)).c_str());
+        });
+        return ExitConnectionFailed;
+    }
+
+    //the folders have to be there before anything is imported into them
+    if (!options.mirrorRoot.empty() && !MirrorTrackFolders(options, mirrorItems, client, progress))
+    {
+        client.Disconnect();
+        WampCapture::Stop();
+        AsyncLog::Shutdown();
+        return ExitTransferFailed;
+    }
+
+    //each worker keeps one call in flight, so the depth is the number of workers
+    std::atomic<size_t> nextBatch{ 0 };
+    std::atomic<uint32> numFailedBatches{ 0 };
+    std::atomic<size_t> numImportedItems{ 0 };
+
+    auto ImportWorker = [&]()
+    {
+        for (size_t i = nextBatch++; i < plan.size(); i = nextBatch++)
+        {
+            const ImportBatch &batch = plan[i];
+            const auto callStart = std::chrono::steady_clock::now();
+
+            AkJson result;
+            const bool succeeded = client.Call(ak::wwise::core::audio::import,
+                                               MakeImportArgs(batch.items, batch.importOperation),
+                                               AkJson(AkJson::Map()), result, options.timeoutMs);
+
+            const double callMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - callStart).count();
+
+            if (succeeded)
+            {
+                numImportedItems += batch.renderItems.size();
+            }
+            else
+            {
+                ++numFailedBatches;
+            }
+
+            progress.Emit("batch", [&](JsonWriter &writer)
+            {
+                writer.Key("index");
+                writer.Uint64(i);
+                writer.Key("project");
+                writer.String(batchProjects[i].c_str());
+                writer.Key("operation");
+                writer.String(GetImportOperationString(batch.importOperation).c_str());
+                writer.Key("items");
+                writer.Uint64(batch.renderItems.size());
+                writer.Key("ok");
+                writer.Bool(succeeded);
+                writer.Key("ms");
+                writer.Double(callMs);
+
+                if (!succeeded && result.IsMap() && result.HasKey("message"))
+                {
+                    writer.Key("message");
+                    writer.String(result["message"].GetVariant().GetString().c_str());
+                }
+            });
+        }
+    };
+
+    const size_t numWorkers = std::min<size_t>(options.pipelineDepth, std::max<size_t>(plan.size(), 1));
+    std::vector<std::thread> workers;
+    for (size_t i = 1; i < numWorkers; ++i)
+    {
+        workers.emplace_back(ImportWorker);
+    }
+    ImportWorker();
+
+    for (std::thread &worker : workers)
+    {
+        worker.join();
+    }
+
+    client.Disconnect();
+    WampCapture::Stop();
+    AsyncLog::Shutdown();
+
+    const bool allSucceeded = numFailedBatches == 0 && numMissing == 0 && numOutOfSpec == 0;
+    progress.Emit("done", [&](JsonWriter &writer)
+    {
+        writer.Key("ok");
+        writer.Bool(allSucceeded);
+        writer.Key("imported");
+        writer.Uint64(numImportedItems);
+        writer.Key("failedBatches");
+        writer.Uint(numFailedBatches);
+        writer.Key("seconds");
+        writer.Double(progress.GetElapsedSeconds());
+    });
+
+    return allSucceeded ? ExitSuccess : ExitTransferFailed;
+}